@@ -0,0 +1,30 @@
+include_guard(GLOBAL)
+
+# rapidjson skips whitespaces with SIMD only if asked to. The instruction set
+# is taken from the target architecture flags (e.g. -march=native), so the
+# binaries stay portable by default.
+include(CheckCXXSourceCompiles)
+
+function(_userver_check_cpu_macro macro result)
+  check_cxx_source_compiles("
+    #ifndef ${macro}
+    #error ${macro} is not defined
+    #endif
+    int main() {}
+  " ${result})
+endfunction()
+
+_userver_check_cpu_macro(__SSE4_2__ USERVER_HAS_SSE42)
+_userver_check_cpu_macro(__SSE2__ USERVER_HAS_SSE2)
+_userver_check_cpu_macro(__ARM_NEON USERVER_HAS_NEON)
+
+if (USERVER_HAS_SSE42)
+  set(USERVER_RAPIDJSON_SIMD_DEFINITIONS RAPIDJSON_SSE42)
+elseif (USERVER_HAS_SSE2)
+  set(USERVER_RAPIDJSON_SIMD_DEFINITIONS RAPIDJSON_SSE2)
+elseif (USERVER_HAS_NEON)
+  set(USERVER_RAPIDJSON_SIMD_DEFINITIONS RAPIDJSON_NEON)
+else()
+  set(USERVER_RAPIDJSON_SIMD_DEFINITIONS "")
+endif()
+message(STATUS "rapidjson SIMD: ${USERVER_RAPIDJSON_SIMD_DEFINITIONS}")
@@ -25,6 +25,7 @@ async def test_ok(call, gate, mockserver):
     response = await call()
     assert response.status == 200
     assert response.text == body
+    assert 'X-YaRequestId' in response.headers
     assert mock.times_called == 1
 
 
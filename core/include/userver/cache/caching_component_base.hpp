@@ -76,6 +76,11 @@ namespace components {
 /// If both `update-interval` and `full-update-interval` are present,
 /// `full-and-incremental` types is assumed. Otherwise `only-full` is used.
 ///
+/// ### Incremental updates of big caches
+///  Set() publishes a whole new T, so an incremental update that copies the
+///  current contents costs O(size). Use cache::PersistentMap as T (or a part
+///  of it) and SetModifiedCopy() to apply only the delta.
+///
 /// @see `dump::Dumper` for more info on persistent cache dumps and
 /// corresponding config options.
 
@@ -119,6 +124,16 @@ class CachingComponentBase : public LoggableComponentBase,
   template <typename... Args>
   void Emplace(Args&&... args);
 
+  /// @brief Publishes a modified copy of the current cache contents.
+  ///
+  /// Copies the current contents (or default-constructs T if the cache is
+  /// empty), calls `modifier(T&)` on the copy and Set()s the result. With a
+  /// structure sharing T, e.g. cache::PersistentMap, the copy is O(1) and an
+  /// incremental update costs O(delta * log(size)) instead of a full copy,
+  /// while the readers keep their snapshot.
+  template <typename Modifier>
+  void SetModifiedCopy(Modifier&& modifier);
+
   void Clear();
 
   /// Whether Get() is expected to return nullptr.
@@ -229,6 +244,18 @@ void CachingComponentBase<T>::Emplace(Args&&... args) {
   Set(std::make_unique<T>(std::forward<Args>(args)...));
 }
 
+template <typename T>
+template <typename Modifier>
+void CachingComponentBase<T>::SetModifiedCopy(Modifier&& modifier) {
+  std::unique_ptr<T> value;
+  {
+    const auto current = GetUnsafe();
+    value = current ? std::make_unique<T>(*current) : std::make_unique<T>();
+  }
+  std::forward<Modifier>(modifier)(*value);
+  Set(std::move(value));
+}
+
 template <typename T>
 void CachingComponentBase<T>::Clear() {
   cache_.Assign(std::make_unique<const T>());
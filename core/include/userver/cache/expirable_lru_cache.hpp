@@ -7,6 +7,7 @@
 #include <chrono>
 #include <optional>
 
+#include <userver/cache/impl/in_flight_loads.hpp>
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
@@ -72,7 +73,8 @@ class ExpirableLruCache final {
   };
 
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
-                    const Equal& equal = Equal());
+                    const Equal& equal = Equal(),
+                    EvictionPolicy policy = EvictionPolicy::kLru);
 
   ~ExpirableLruCache();
 
@@ -89,10 +91,22 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /**
+   * Sets for how long after the max lifetime an expired value is still
+   * returned by GetOptional() and Get() while it is being updated in
+   * background. Works only if background update mode is kEnabled, 0 disables
+   * serving of the expired values.
+   */
+  void SetStaleWhileRevalidate(
+      std::chrono::milliseconds stale_while_revalidate);
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
    * stored in cache if "read_mode" is kUseCache.
+   *
+   * Concurrent calls for the same missing key are coalesced: only one of them
+   * calls update_func(key), the others wait for its result or exception.
    */
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
@@ -101,7 +115,8 @@ class ExpirableLruCache final {
    * Update value in cache by "update_func" if background update mode is
    * kEnabled and "key" is in cache and not expired but its lifetime ends soon.
    * @returns value by key if key is in cache and not expired, or std::nullopt
-   * otherwise
+   * otherwise. An expired value is returned and updated in background if it
+   * expired less than SetStaleWhileRevalidate() ago.
    */
   std::optional<Value> GetOptional(const Key& key,
                                    const UpdateValueFunc& update_func);
@@ -134,6 +149,10 @@ class ExpirableLruCache final {
 
   size_t GetSizeApproximate() const;
 
+  /// @returns the number of new items that were not admitted into the cache,
+  /// see cache::EvictionPolicy::kTinyLfu
+  std::size_t GetAdmissionRejections() const;
+
   /// Clear cache
   void Invalidate();
 
@@ -158,21 +177,29 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  bool CanServeStale(std::chrono::steady_clock::time_point update_time,
+                     std::chrono::steady_clock::time_point now) const;
+
   cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<std::chrono::milliseconds> stale_while_revalidate_{
+      std::chrono::milliseconds(0)};
   impl::ExpirableLruCacheStatistics stats_;
   concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+  impl::InFlightLoads<Key, Value, Hash, Equal> in_flight_loads_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
-    size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
-      mutex_set_{ways, way_size, hash, equal} {}
+    size_t ways, size_t way_size, const Hash& hash, const Equal& equal,
+    EvictionPolicy policy)
+    : lru_(ways, way_size, hash, equal, policy),
+      mutex_set_{ways, way_size, hash, equal},
+      in_flight_loads_{ways, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -202,6 +229,12 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetStaleWhileRevalidate(
+    std::chrono::milliseconds stale_while_revalidate) {
+  stale_while_revalidate_ = stale_while_revalidate;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
@@ -211,20 +244,25 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     return std::move(*opt_old_value);
   }
 
-  auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
-  // Test one more time - concurrent ExpirableLruCache::Get()
-  // might have put the value
-  auto old_value = lru_.Get(key);
-  if (old_value && !IsExpired(old_value->update_time, now)) {
-    return std::move(old_value->value);
-  }
-
-  auto value = update_func(key);
-  if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
-  }
-  return value;
+  return in_flight_loads_.Run(
+      key,
+      [&] {
+        auto mutex = mutex_set_.GetMutexForKey(key);
+        std::lock_guard lock(mutex);
+        // Test one more time - concurrent ExpirableLruCache::Get()
+        // or UpdateInBackground() might have put the value
+        auto old_value = lru_.Get(key);
+        if (old_value && !IsExpired(old_value->update_time, now)) {
+          return std::move(old_value->value);
+        }
+
+        auto value = update_func(key);
+        if (read_mode == ReadMode::kUseCache) {
+          lru_.Put(key, {value, now});
+        }
+        return value;
+      },
+      [this] { impl::CacheLoadCoalesced(stats_); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -244,6 +282,11 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
       return std::move(old_value->value);
     } else {
       impl::CacheStale(stats_);
+
+      if (CanServeStale(old_value->update_time, now)) {
+        UpdateInBackground(key, update_func);
+        return std::move(old_value->value);
+      }
     }
   }
   impl::CacheMiss(stats_);
@@ -331,6 +374,12 @@ size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
   return lru_.GetSize();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetAdmissionRejections()
+    const {
+  return lru_.GetAdmissionRejections();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
   lru_.Invalidate();
@@ -381,6 +430,17 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::CanServeStale(
+    std::chrono::steady_clock::time_point update_time,
+    std::chrono::steady_clock::time_point now) const {
+  auto max_lifetime = max_lifetime_.load();
+  auto stale_while_revalidate = stale_while_revalidate_.load();
+  return (background_update_mode_.load() == BackgroundUpdateMode::kEnabled) &&
+         max_lifetime.count() != 0 && stale_while_revalidate.count() != 0 &&
+         now <= update_time + max_lifetime + stale_while_revalidate;
+}
+
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
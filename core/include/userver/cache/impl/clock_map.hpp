@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/persistent_map.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// A map with the CLOCK (second chance) eviction. Lookups do not take locks:
+/// the index is a cache::PersistentMap in an rcu::Variable, and a hit only
+/// sets the access bit of the entry. Insertions and erasures copy the path
+/// to the changed entry under the rcu::Variable writer lock.
+template <typename T, typename U, typename Hash, typename Equal>
+class ClockMap final {
+ public:
+  ClockMap(std::size_t max_size, const Hash& hash, const Equal& equal)
+      : max_size_(max_size),
+        index_(rcu::DestructionType::kSync, hash, equal) {
+    UASSERT(max_size_ > 0);
+  }
+
+  void Put(const T& key, U value) {
+    auto index = index_.StartWrite();
+    auto entry = std::make_shared<Entry>(key, std::move(value));
+
+    const auto it = index->find(key);
+    if (it != index->end()) {
+      // Overwriting counts as an access
+      entry->slot = it->second->slot;
+      entry->referenced.store(true, std::memory_order_relaxed);
+    } else {
+      if (index->size() >= max_size_) Evict(*index);
+      entry->slot = AllocateSlot();
+    }
+
+    ring_[entry->slot] = entry;
+    index->insert_or_assign(key, std::move(entry));
+    index.Commit();
+  }
+
+  /// Calls `func(const U&)` on the value, marks the entry as recently used
+  /// @returns whether the key was found
+  template <typename Function>
+  bool Visit(const T& key, Function&& func) const {
+    const auto index = index_.Read();
+    const auto it = index->find(key);
+    if (it == index->end()) return false;
+
+    auto& entry = *it->second;
+    // Avoid writing to a shared cache line if the bit is already set
+    if (!entry.referenced.load(std::memory_order_relaxed)) {
+      entry.referenced.store(true, std::memory_order_relaxed);
+    }
+    func(entry.value);
+    return true;
+  }
+
+  std::optional<U> Get(const T& key) const {
+    std::optional<U> result;
+    Visit(key, [&result](const U& value) { result.emplace(value); });
+    return result;
+  }
+
+  /// Returns the value if `validator(value)` holds, erases the entry
+  /// otherwise. Only the erasure takes the lock.
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator&& validator) {
+    std::optional<U> result;
+    const void* invalid = nullptr;
+    {
+      const auto index = index_.Read();
+      const auto it = index->find(key);
+      if (it == index->end()) return std::nullopt;
+
+      const auto& entry = *it->second;
+      if (!validator(entry.value)) {
+        invalid = &entry;
+      } else {
+        if (!entry.referenced.load(std::memory_order_relaxed)) {
+          entry.referenced.store(true, std::memory_order_relaxed);
+        }
+        result.emplace(entry.value);
+      }
+    }
+
+    if (invalid) {
+      auto index = index_.StartWrite();
+      const auto it = index->find(key);
+      // The entry might have been replaced in the meantime
+      if (it == index->end() || it->second.get() != invalid) return result;
+      EraseFrom(*index, key);
+      index.Commit();
+    }
+    return result;
+  }
+
+  void Erase(const T& key) {
+    auto index = index_.StartWrite();
+    if (!EraseFrom(*index, key)) return;
+    index.Commit();
+  }
+
+  void Clear() {
+    auto index = index_.StartWrite();
+    index->clear();
+    ring_.clear();
+    free_slots_.clear();
+    hand_ = 0;
+    index.Commit();
+  }
+
+  /// Calls `func(const T&, const U&)` for all the items of a snapshot
+  template <typename Function>
+  void VisitAll(Function&& func) const {
+    const auto index = index_.Read();
+    for (const auto& [key, entry] : *index) func(key, entry->value);
+  }
+
+  std::size_t GetSize() const {
+    const auto index = index_.Read();
+    return index->size();
+  }
+
+  void SetMaxSize(std::size_t max_size) {
+    UASSERT(max_size > 0);
+    auto index = index_.StartWrite();
+    max_size_ = max_size;
+    while (index->size() > max_size_) Evict(*index);
+
+    // Compact the ring, keeping the order of the entries after the hand
+    std::vector<std::shared_ptr<Entry>> ring;
+    ring.reserve(index->size());
+    for (std::size_t i = 0; i < ring_.size(); ++i) {
+      auto& entry = ring_[(hand_ + i) % ring_.size()];
+      if (!entry) continue;
+      entry->slot = ring.size();
+      ring.push_back(std::move(entry));
+    }
+    ring_ = std::move(ring);
+    free_slots_.clear();
+    hand_ = 0;
+    index.Commit();
+  }
+
+ private:
+  struct Entry final {
+    Entry(const T& key, U&& value) : key(key), value(std::move(value)) {}
+
+    const T key;
+    const U value;
+    mutable std::atomic<bool> referenced{false};
+    // Guarded by the rcu::Variable writer lock
+    std::size_t slot{0};
+  };
+
+  using Index = PersistentMap<T, std::shared_ptr<Entry>, Hash, Equal>;
+
+  std::size_t AllocateSlot() {
+    if (!free_slots_.empty()) {
+      const auto slot = free_slots_.back();
+      free_slots_.pop_back();
+      return slot;
+    }
+    ring_.emplace_back();
+    return ring_.size() - 1;
+  }
+
+  // Moves the hand until an entry without the access bit is found, clearing
+  // the bits on the way, and evicts it. The hand is left past the freed slot,
+  // so an entry put into it is the last one to be checked.
+  void Evict(Index& index) {
+    UASSERT(!index.empty());
+    while (true) {
+      if (hand_ >= ring_.size()) hand_ = 0;
+      auto& entry = ring_[hand_++];
+      if (entry && !entry->referenced.exchange(false)) {
+        EraseFrom(index, entry->key);
+        return;
+      }
+    }
+  }
+
+  bool EraseFrom(Index& index, const T& key) {
+    const auto it = index.find(key);
+    if (it == index.end()) return false;
+
+    const auto slot = it->second->slot;
+    UASSERT(ring_[slot] == it->second);
+    // `key` might be owned by the entry
+    auto entry = std::move(ring_[slot]);
+    free_slots_.push_back(slot);
+    index.erase(key);
+    return true;
+  }
+
+  std::size_t max_size_;
+  rcu::Variable<Index> index_;
+  std::vector<std::shared_ptr<Entry>> ring_;
+  std::vector<std::size_t> free_slots_;
+  std::size_t hand_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
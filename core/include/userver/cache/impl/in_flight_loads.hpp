@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Thrown to the tasks that wait for a load that was interrupted by the
+/// cancellation of the loading task, they retry the load themselves.
+class InFlightLoadInterrupted final : public std::runtime_error {
+ public:
+  InFlightLoadInterrupted()
+      : std::runtime_error("in-flight cache load was interrupted") {}
+};
+
+/// Deduplicates concurrent loads of the same key: the first task to request
+/// a key runs the load, the tasks that request the key while it is loading
+/// wait for the result of that load. An exception thrown by the load is
+/// rethrown in all the waiting tasks, unless the loading task was cancelled:
+/// then one of the waiting tasks loads the key instead.
+///
+/// The keys are split between `ways` independently locked shards.
+template <typename Key, typename Value, typename Hash, typename Equal>
+class InFlightLoads final : Hash {
+ public:
+  InFlightLoads(std::size_t ways, const Hash& hash, const Equal& equal)
+      : Hash(hash), shards_(ways, hash, equal) {}
+
+  /// Calls `load()` or waits for the result of a concurrent load of `key`,
+  /// calls `on_coalesced()` in the latter case.
+  template <typename Load, typename OnCoalesced>
+  Value Run(const Key& key, Load&& load, OnCoalesced&& on_coalesced);
+
+ private:
+  struct Shard final {
+    Shard(const Hash& hash, const Equal& equal) : loads(0, hash, equal) {}
+
+    engine::Mutex mutex;
+    std::unordered_map<Key, std::vector<engine::Promise<Value>>, Hash, Equal>
+        loads;
+  };
+
+  Shard& GetShard(const Key& key) {
+    return shards_[Hash::operator()(key) % shards_.size()];
+  }
+
+  template <typename Load>
+  Value DoLoad(Shard& shard, const Key& key, Load& load);
+
+  utils::FixedArray<Shard> shards_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Load, typename OnCoalesced>
+Value InFlightLoads<Key, Value, Hash, Equal>::Run(const Key& key, Load&& load,
+                                                  OnCoalesced&& on_coalesced) {
+  auto& shard = GetShard(key);
+  for (;;) {
+    engine::Future<Value> future;
+    {
+      std::lock_guard lock(shard.mutex);
+      auto [it, inserted] = shard.loads.try_emplace(key);
+      if (!inserted) future = it->second.emplace_back().get_future();
+    }
+    if (!future.valid()) return DoLoad(shard, key, load);
+
+    on_coalesced();
+    try {
+      return future.get();
+    } catch (const InFlightLoadInterrupted&) {
+      // The loading task was cancelled, the key is not loading anymore
+    }
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Load>
+Value InFlightLoads<Key, Value, Hash, Equal>::DoLoad(Shard& shard,
+                                                     const Key& key,
+                                                     Load& load) {
+  std::optional<Value> value;
+  std::exception_ptr error;
+  bool is_interrupted = false;
+  try {
+    value.emplace(load());
+  } catch (const engine::WaitInterruptedException&) {
+    error = std::current_exception();
+    is_interrupted = true;
+  } catch (...) {
+    error = std::current_exception();
+    is_interrupted = engine::current_task::ShouldCancel();
+  }
+
+  std::vector<engine::Promise<Value>> waiters;
+  {
+    std::lock_guard lock(shard.mutex);
+    const auto it = shard.loads.find(key);
+    UASSERT(it != shard.loads.end());
+    waiters = std::move(it->second);
+    shard.loads.erase(it);
+  }
+
+  // The cancellation of this task says nothing about the key, the waiting
+  // tasks retry instead of failing with it
+  const auto waiters_error =
+      is_interrupted ? std::make_exception_ptr(InFlightLoadInterrupted{})
+                     : error;
+  for (auto& waiter : waiters) {
+    if (waiters_error) {
+      waiter.set_exception(waiters_error);
+    } else {
+      waiter.set_value(*value);
+    }
+  }
+
+  if (error) std::rethrow_exception(error);
+  return std::move(*value);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
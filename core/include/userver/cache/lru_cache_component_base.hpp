@@ -22,13 +22,15 @@ namespace cache {
 namespace impl {
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size);
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::size_t admission_rejections);
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 formats::json::Value GetCacheStatisticsAsJson(
     const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
   return GetCacheStatisticsAsJson(cache.GetStatistics(),
-                                  cache.GetSizeApproximate());
+                                  cache.GetSizeApproximate(),
+                                  cache.GetAdmissionRejections());
 }
 
 testsuite::ComponentControl& FindComponentControl(
@@ -67,7 +69,10 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// background-update | update the entries that are past half of their lifetime in background | false
+/// stale-while-revalidate | how long after the lifetime an entry is still returned while it is updated in background (0 is never); requires background-update | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// eviction-policy | `lru`, `clock` or `tiny-lfu`, see cache::EvictionPolicy | lru
 ///
 /// ## Example usage:
 ///
@@ -136,8 +141,9 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
     : LoggableComponentBase(config, context),
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
-      cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+      cache_(std::make_shared<Cache>(
+          static_config_.ways, static_config_.GetWaySize(), Hash{}, Equal{},
+          static_config_.eviction_policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -147,6 +153,7 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetStaleWhileRevalidate(static_config_.config.stale_while_revalidate);
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -217,6 +224,7 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetStaleWhileRevalidate(config.stale_while_revalidate);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -19,6 +19,20 @@ enum class BackgroundUpdateMode {
   kDisabled,
 };
 
+/// Eviction policy of cache::NWayLRU
+enum class EvictionPolicy {
+  /// Least recently used, each lookup takes the mutex of its way
+  kLru,
+  /// CLOCK (second chance), lookups are lock-free and only set an access bit
+  kClock,
+  /// W-TinyLFU, see cache::CachePolicy::kTinyLFU. Each lookup takes the mutex
+  /// of its way, the scans over cold keys do not flush the hot ones
+  kTinyLfu,
+};
+
+EvictionPolicy Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<EvictionPolicy>);
+
 struct LruCacheConfig final {
   explicit LruCacheConfig(const yaml_config::YamlConfig& config);
   explicit LruCacheConfig(const components::ComponentConfig& config);
@@ -30,6 +44,7 @@ struct LruCacheConfig final {
   std::size_t size;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  std::chrono::milliseconds stale_while_revalidate;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
@@ -44,6 +59,7 @@ struct LruCacheConfigStatic final {
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  EvictionPolicy eviction_policy;
 };
 
 std::unordered_map<std::string, LruCacheConfig> ParseLruCacheConfigSet(
@@ -15,6 +15,7 @@ struct ExpirableLruCacheStatisticsBase final {
   std::atomic<std::size_t> misses{0};
   std::atomic<std::size_t> stale{0};
   std::atomic<std::size_t> background_updates{0};
+  std::atomic<std::size_t> coalesced_loads{0};
 
   ExpirableLruCacheStatisticsBase();
 
@@ -39,6 +40,8 @@ void CacheMiss(ExpirableLruCacheStatistics& stats);
 
 void CacheStale(ExpirableLruCacheStatistics& stats);
 
+void CacheLoadCoalesced(ExpirableLruCacheStatistics& stats);
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
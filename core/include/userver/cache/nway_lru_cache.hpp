@@ -1,9 +1,13 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
+#include <userver/cache/impl/clock_map.hpp>
+#include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_map.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
@@ -14,12 +18,17 @@ USERVER_NAMESPACE_BEGIN
 namespace cache {
 
 /// @ingroup userver_containers
+///
+/// With EvictionPolicy::kClock the lookups do not take the mutexes of the
+/// ways, only the updates do. With EvictionPolicy::kTinyLfu each way is a
+/// cache::LruMap with cache::CachePolicy::kTinyLFU.
 template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class NWayLRU final {
  public:
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
-          const Equal& equal = Equal());
+          const Equal& equal = Equal(),
+          EvictionPolicy policy = EvictionPolicy::kLru);
 
   void Put(const T& key, U value);
 
@@ -42,6 +51,10 @@ class NWayLRU final {
 
   size_t GetSize() const;
 
+  /// @returns the number of new items that were not admitted into the cache
+  /// with EvictionPolicy::kTinyLfu, 0 for the other policies
+  std::size_t GetAdmissionRejections() const;
+
   void UpdateWaySize(size_t way_size);
 
   void Write(dump::Writer& writer) const;
@@ -53,17 +66,30 @@ class NWayLRU final {
 
  private:
   struct Way {
-    Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
+    Way(Way&& other) noexcept
+        : cache(std::move(other.cache)),
+          clock(std::move(other.clock)),
+          tiny_lfu(std::move(other.tiny_lfu)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
     Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
 
     mutable engine::Mutex mutex;
     LruMap<T, U, Hash, Equal> cache;
+    // Used instead of `cache` and `mutex` with EvictionPolicy::kClock
+    std::unique_ptr<impl::ClockMap<T, U, Hash, Equal>> clock;
+    // Used instead of `cache` with EvictionPolicy::kTinyLfu
+    std::unique_ptr<LruMap<T, U, Hash, Equal, CachePolicy::kTinyLFU>> tiny_lfu;
   };
 
   Way& GetWay(const T& key);
 
+  // Calls func with the LruMap of the way under the way mutex
+  template <typename Function>
+  static decltype(auto) WithLockedMap(const Way& way, Function&& func);
+  template <typename Function>
+  static decltype(auto) WithLockedMap(Way& way, Function&& func);
+
   void NotifyDumper();
 
   std::vector<Way> caches_;
@@ -73,21 +99,32 @@ class NWayLRU final {
 
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
-                                 const Eq& equal)
+                                 const Eq& equal, EvictionPolicy policy)
     : caches_(), hash_fn_(hash) {
   caches_.reserve(ways);
   for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  for (auto& way : caches_) {
+    if (policy == EvictionPolicy::kClock) {
+      way.clock = std::make_unique<impl::ClockMap<T, U, Hash, Eq>>(
+          way_size, hash, equal);
+    } else if (policy == EvictionPolicy::kTinyLfu) {
+      way.tiny_lfu = std::make_unique<
+          LruMap<T, U, Hash, Eq, CachePolicy::kTinyLFU>>(way_size, hash, equal);
+    } else {
+      way.cache.SetMaxSize(way_size);
+    }
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
-  {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Put(key, std::move(value));
+  if (way.clock) {
+    way.clock->Put(key, std::move(value));
+  } else {
+    WithLockedMap(way, [&](auto& cache) { cache.Put(key, std::move(value)); });
   }
   NotifyDumper();
 }
@@ -97,23 +134,27 @@ template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
   auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
-  auto* value = way.cache.Get(key);
+  if (way.clock) return way.clock->Get(key, validator);
 
-  if (value) {
-    if (validator(*value)) return *value;
-    way.cache.Erase(key);
-  }
+  return WithLockedMap(way, [&](auto& cache) -> std::optional<U> {
+    auto* value = cache.Get(key);
 
-  return std::nullopt;
+    if (value) {
+      if (validator(*value)) return *value;
+      cache.Erase(key);
+    }
+
+    return std::nullopt;
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
-  {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Erase(key);
+  if (way.clock) {
+    way.clock->Erase(key);
+  } else {
+    WithLockedMap(way, [&key](auto& cache) { cache.Erase(key); });
   }
   NotifyDumper();
 }
@@ -121,15 +162,25 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
   auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  if (way.clock) {
+    U result = default_value;
+    way.clock->Visit(key, [&result](const U& value) { result = value; });
+    return result;
+  }
+
+  return WithLockedMap(way, [&](auto& cache) {
+    return cache.GetOr(key, default_value);
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Clear();
+    if (way.clock) {
+      way.clock->Clear();
+      continue;
+    }
+    WithLockedMap(way, [](auto& cache) { cache.Clear(); });
   }
   NotifyDumper();
 }
@@ -138,8 +189,11 @@ template <typename T, typename U, typename Hash, typename Eq>
 template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.VisitAll(func);
+    if (way.clock) {
+      way.clock->VisitAll(func);
+      continue;
+    }
+    WithLockedMap(way, [&func](const auto& cache) { cache.VisitAll(func); });
   }
 }
 
@@ -147,17 +201,37 @@ template <typename T, typename U, typename Hash, typename Eq>
 size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
+    if (way.clock) {
+      size += way.clock->GetSize();
+      continue;
+    }
+    size += WithLockedMap(way, [](const auto& cache) {
+      return cache.GetSize();
+    });
   }
   return size;
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+std::size_t NWayLRU<T, U, Hash, Eq>::GetAdmissionRejections() const {
+  std::size_t rejections{0};
+  for (const auto& way : caches_) {
+    if (way.clock) continue;
+    rejections += WithLockedMap(way, [](const auto& cache) {
+      return cache.GetAdmissionRejections();
+    });
+  }
+  return rejections;
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
+    if (way.clock) {
+      way.clock->SetMaxSize(way_size);
+      continue;
+    }
+    WithLockedMap(way, [way_size](auto& cache) { cache.SetMaxSize(way_size); });
   }
 }
 
@@ -168,18 +242,50 @@ typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
   return caches_[n];
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+decltype(auto) NWayLRU<T, U, Hash, Eq>::WithLockedMap(const Way& way,
+                                                      Function&& func) {
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  if (way.tiny_lfu) return func(std::as_const(*way.tiny_lfu));
+  return func(way.cache);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+decltype(auto) NWayLRU<T, U, Hash, Eq>::WithLockedMap(Way& way,
+                                                      Function&& func) {
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  if (way.tiny_lfu) return func(*way.tiny_lfu);
+  return func(way.cache);
+}
+
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   writer.Write(caches_.size());
 
   for (const Way& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    if (way.clock) {
+      // The size and the items must come from the same snapshot
+      std::vector<std::pair<T, U>> items;
+      way.clock->VisitAll([&items](const T& key, const U& value) {
+        items.emplace_back(key, value);
+      });
+      writer.Write(items.size());
+      for (const auto& [key, value] : items) {
+        writer.Write(key);
+        writer.Write(value);
+      }
+      continue;
+    }
 
-    writer.Write(way.cache.GetSize());
+    WithLockedMap(way, [&writer](const auto& cache) {
+      writer.Write(cache.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
-      writer.Write(key);
-      writer.Write(value);
+      cache.VisitAll([&writer](const T& key, const U& value) {
+        writer.Write(key);
+        writer.Write(value);
+      });
     });
   }
 }
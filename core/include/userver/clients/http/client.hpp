@@ -25,6 +25,7 @@ USERVER_NAMESPACE_BEGIN
 namespace curl {
 class easy;
 class multi;
+class share;
 class ConnectRateLimiter;
 }  // namespace curl
 
@@ -49,6 +50,14 @@ struct ClientSettings final {
   std::string thread_name_prefix;
   size_t io_threads = 8;
   bool defer_events = false;
+
+  /// Share the DNS cache and the TLS sessions between the IO threads
+  bool share_tls_sessions = false;
+  /// Limit of connections to a single host for all the IO threads, 0 for no
+  /// limit
+  size_t max_host_connections = 0;
+  /// Allow multiplexing of HTTP/2 requests over a single connection
+  bool multiplexing = true;
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -80,6 +89,9 @@ class Client final {
   // For internal use only.
   void SetMultiplexingEnabled(bool enabled);
 
+  // Sets the limit of connections to a single host, the limit is divided
+  // between the IO threads and rounded up, so every IO thread may open at
+  // least one connection. The limit is exact for a single IO thread.
   // For internal use only.
   void SetMaxHostConnections(size_t max_host_connections);
 
@@ -167,6 +179,7 @@ class Client final {
   rcu::Variable<std::vector<std::string>> allowed_urls_extra_;
 
   std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
+  std::shared_ptr<curl::share> share_;
 
   clients::dns::Resolver* resolver_{nullptr};
 };
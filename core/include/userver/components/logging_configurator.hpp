@@ -26,6 +26,7 @@ namespace components {
 /// ---- | ----------- | -------------
 /// limited-logging-enable | set to true to make LOG_LIMITED drop repeated logs | -
 /// limited-logging-interval | utils::StringToDuration suitable duration string to group repeated logs into one message | -
+/// span-sampling-rate | ratio in range [0, 1] of the traces whose spans are logged, see tracing::Tracer::SetSpanSamplingRate | 1
 ///
 /// ## Config example:
 ///
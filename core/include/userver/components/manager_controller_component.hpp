@@ -34,6 +34,9 @@ class Manager;
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | -
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | -
+/// event_thread_pool.io_uring | use io_uring for socket and file I/O, falls back to the default backend if the kernel does not support it | false
+/// event_thread_pool.numa_aware | spread the threads over the NUMA nodes and bind each of them to its node; task processors with `numa-node` use the threads of their node | false
+/// event_thread_pool.timer_slack | coalesce the task timers of each thread into a timer wheel with ticks of this duration, a timer may fire up to one tick late; 0 keeps a precise ev timer per task | 0ms
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -45,6 +48,9 @@ class Manager;
 /// thread_name | set OS thread name to this value | -
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest pririty. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
+/// task-processor-queue | Task queue mode for the task processor. `global-task-queue` uses a single queue shared by all the workers; `work-stealing-task-queue` gives each worker a local queue and makes idle workers steal tasks from the busy ones | global-task-queue
+/// numa-node | NUMA node to bind the workers, their memory and the coroutine stacks to; ignored if the machine has no such node | - (not bound)
+/// cpu-set | CPUs to run the workers on in the Linux cpulist format, e.g. `0-7,16-23`; overrides the CPUs of the `numa-node` | - (all CPUs)
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -75,6 +81,8 @@ class ManagerControllerComponent final : public impl::ComponentBase {
 
   const components::Manager& components_manager_;
   utils::statistics::Entry statistics_holder_;
+  utils::statistics::Entry logging_statistics_holder_;
+  utils::statistics::Entry tail_sampling_statistics_holder_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
 };
 
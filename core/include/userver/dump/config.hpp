@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -24,6 +25,15 @@ extern const std::string_view kDump;
 extern const std::string_view kMaxDumpAge;
 extern const std::string_view kMinDumpInterval;
 
+/// Compression of dump chunks, see dump::ChunkedWriter
+enum class Compression {
+  kNone,
+  kZlib,
+};
+
+Compression Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Compression>);
+
 struct ConfigPatch final {
   std::optional<bool> dumps_enabled;
   std::optional<std::chrono::milliseconds> min_dump_interval;
@@ -45,6 +55,10 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool use_mmap;
+  std::optional<Compression> compression;
+  std::size_t chunk_size;
+  std::size_t chunk_concurrency;
 
   bool static_dumps_enabled;
   std::chrono::milliseconds static_min_dump_interval;
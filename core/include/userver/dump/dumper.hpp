@@ -84,6 +84,10 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mmap` | `boolean` | Whether to map the dump file into memory instead of reading it, see dump::MmapFileReader; not compatible with `encrypted` | `false`
+/// `compression` | optional `string` | `none` or `zlib`; if set, the dump is split into chunks that are compressed and checksummed in parallel, see dump::ChunkedWriter | null
+/// `chunk-size` | `integer` | Size of a dump chunk in bytes before compression | `4194304`
+/// `chunk-concurrency` | `integer` | How many dump chunks are compressed or decompressed in parallel on `fs-task-processor` | `4`
 /// `first-update-mode` | `string` | specifies whether required or best-effort first update will be used | skip
 /// `first-update-type` | `string` | specifies whether incremental and/or full first update will be used | full
 ///
@@ -0,0 +1,189 @@
+#pragma once
+
+/// @file userver/dump/flat_map.hpp
+/// @brief @copybrief dump::FlatMap
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/meta.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+// The non-template part of FlatMap. Layout of the buffer, all the numbers are
+// 64-bit in the native byte order:
+//   count, key offsets [count + 1], value offsets [count + 1],
+//   keys, values
+class FlatMapData final {
+ public:
+  FlatMapData();
+
+  // @throws Error if `bytes` are not a valid flat map
+  explicit FlatMapData(SharedBytes bytes);
+
+  // `items` are (key, serialized value)
+  // @throws std::invalid_argument on duplicate keys
+  static FlatMapData Build(
+      std::vector<std::pair<std::string, std::string>>&& items);
+
+  std::size_t GetSize() const noexcept { return size_; }
+  std::string_view GetKey(std::size_t index) const;
+  std::string_view GetValue(std::size_t index) const;
+  std::optional<std::size_t> Find(std::string_view key) const;
+
+  std::string_view GetBytes() const noexcept { return bytes_.data; }
+
+ private:
+  void CheckOffsets(std::size_t first_word, std::string_view name) const;
+  std::uint64_t GetWord(std::size_t index) const noexcept;
+
+  SharedBytes bytes_;
+  std::size_t size_{0};
+  std::size_t keys_size_{0};
+  std::size_t values_size_{0};
+};
+
+void WriteFlatMapData(Writer& writer, const FlatMapData& data);
+
+FlatMapData ReadFlatMapData(Reader& reader);
+
+class StringWriter final : public Writer {
+ public:
+  void Finish() override {}
+
+  std::string Extract() && { return std::move(data_); }
+
+ private:
+  void WriteRaw(std::string_view data) override { data_.append(data); }
+
+  std::string data_;
+};
+
+class StringReader final : public Reader {
+ public:
+  explicit StringReader(std::string_view data) noexcept : data_(data) {}
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::string_view data_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_containers
+///
+/// @brief Immutable map from strings to `T` with a flat layout that is used
+/// right from a dump, without parsing.
+///
+/// The keys are kept sorted in a single buffer, the values are kept serialized
+/// with `Write(dump::Writer&, const T&)` and are read on each lookup.
+///
+/// Reading a FlatMap from a dump does not parse the keys and the values, only
+/// the offset table is validated. With `dump.mmap` enabled the map is a view
+/// of the memory-mapped dump file, otherwise it is a single copy of the
+/// data. A cache may serve its requests from a FlatMap right after the start
+/// and build a faster structure with VisitAll() in the background.
+template <typename T>
+class FlatMap final {
+ public:
+  FlatMap() = default;
+
+  /// @brief Builds the map from a range of key/value pairs
+  /// @throws std::invalid_argument on duplicate keys
+  template <typename Range,
+            typename = std::enable_if_t<meta::kIsRange<Range>>>
+  explicit FlatMap(const Range& items);
+
+  std::size_t size() const noexcept { return data_.GetSize(); }
+  bool empty() const noexcept { return size() == 0; }
+
+  /// @brief Reads the value of the key, O(log(size())) key comparisons
+  /// @returns std::nullopt if there is no such key
+  std::optional<T> Find(std::string_view key) const;
+
+  bool Contains(std::string_view key) const {
+    return data_.Find(key).has_value();
+  }
+
+  /// Calls `func(std::string_view key, T&& value)` for all the elements in the
+  /// order of the keys
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) noexcept {
+    return lhs.data_.GetBytes() == rhs.data_.GetBytes();
+  }
+
+  friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend void Write(Writer& writer, const FlatMap& map) {
+    impl::WriteFlatMapData(writer, map.data_);
+  }
+
+  friend FlatMap Read(Reader& reader, To<FlatMap>) {
+    return FlatMap{impl::ReadFlatMapData(reader)};
+  }
+
+ private:
+  explicit FlatMap(impl::FlatMapData&& data) : data_(std::move(data)) {}
+
+  static T ReadValue(std::string_view bytes);
+
+  impl::FlatMapData data_;
+};
+
+template <typename T>
+template <typename Range, typename>
+FlatMap<T>::FlatMap(const Range& items) {
+  std::vector<std::pair<std::string, std::string>> serialized;
+  for (const auto& [key, value] : items) {
+    impl::StringWriter writer;
+    writer.Write(value);
+    serialized.emplace_back(std::string{key}, std::move(writer).Extract());
+  }
+  data_ = impl::FlatMapData::Build(std::move(serialized));
+}
+
+template <typename T>
+std::optional<T> FlatMap<T>::Find(std::string_view key) const {
+  const auto index = data_.Find(key);
+  if (!index) return std::nullopt;
+  return ReadValue(data_.GetValue(*index));
+}
+
+template <typename T>
+template <typename Function>
+void FlatMap<T>::VisitAll(Function&& func) const {
+  for (std::size_t i = 0; i < data_.GetSize(); ++i) {
+    func(data_.GetKey(i), ReadValue(data_.GetValue(i)));
+  }
+}
+
+template <typename T>
+T FlatMap<T>::ReadValue(std::string_view bytes) {
+  impl::StringReader reader{bytes};
+  T value = reader.Read<T>();
+  reader.Finish();
+  return value;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -44,6 +45,13 @@ class Writer {
   friend void WriteStringViewUnsafe(Writer& writer, std::string_view value);
 };
 
+/// Binary data of a dump together with the storage that keeps it alive, see
+/// dump::ReadSharedUnsafe
+struct SharedBytes final {
+  std::string_view data;
+  std::shared_ptr<const void> owner;
+};
+
 /// A general interface for binary data input
 class Reader {
  public:
@@ -68,7 +76,14 @@ class Reader {
   /// @throws `Error` on read operation failure
   virtual std::string_view ReadRaw(std::size_t max_size) = 0;
 
+  /// @brief Reads exactly `size` bytes that stay valid while the returned
+  /// `owner` is alive, e.g. a view of a memory-mapped dump file
+  /// @note The default implementation copies the data
+  /// @throws `Error` on read operation failure or on end-of-file
+  virtual SharedBytes ReadShared(std::size_t size);
+
   friend std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t size);
+  friend SharedBytes ReadSharedUnsafe(Reader& reader, std::size_t size);
 };
 
 namespace impl {
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <userver/dump/config.hpp>
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+struct Chunk final {
+  std::uint64_t raw_size{0};
+  Compression compression{Compression::kNone};
+  std::uint32_t checksum{0};
+  std::string payload;
+};
+
+}  // namespace impl
+
+/// @brief Splits the data into chunks that are compressed and checksummed in
+/// parallel, then written to the underlying Writer.
+///
+/// Chunks are processed by up to `concurrency` tasks on the current
+/// TaskProcessor, the data is serialized by the caller in the meantime.
+class ChunkedWriter final : public Writer {
+ public:
+  /// The largest chunk that a ChunkedReader accepts
+  static constexpr std::size_t kMaxChunkSize = std::size_t{1} << 30;
+
+  ChunkedWriter(std::unique_ptr<Writer> base, Compression compression,
+                std::size_t chunk_size, std::size_t concurrency);
+
+  ~ChunkedWriter() override;
+
+  void Finish() override;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  void FlushBuffer();
+  void WriteChunk(const impl::Chunk& chunk);
+
+  const std::unique_ptr<Writer> base_;
+  const Compression compression_;
+  const std::size_t chunk_size_;
+  const std::size_t concurrency_;
+  std::string buffer_;
+  std::deque<engine::TaskWithResult<impl::Chunk>> pending_;
+};
+
+/// @brief Reads the data written by ChunkedWriter, up to `concurrency` chunks
+/// ahead are decompressed and verified in parallel on the current
+/// TaskProcessor.
+class ChunkedReader final : public Reader {
+ public:
+  ChunkedReader(std::unique_ptr<Reader> base, std::size_t concurrency);
+
+  ~ChunkedReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  void FillPending();
+  bool NextChunk();
+
+  const std::unique_ptr<Reader> base_;
+  const std::size_t concurrency_;
+  bool base_finished_{false};
+  std::deque<engine::TaskWithResult<std::string>> pending_;
+  std::string current_;
+  std::size_t position_{0};
+  std::string joined_;
+};
+
+/// Wraps the readers and writers of another factory into ChunkedReader and
+/// ChunkedWriter
+class ChunkedOperationsFactory final : public OperationsFactory {
+ public:
+  ChunkedOperationsFactory(std::unique_ptr<OperationsFactory> base,
+                           Compression compression, std::size_t chunk_size,
+                           std::size_t concurrency);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const std::unique_ptr<OperationsFactory> base_;
+  const Compression compression_;
+  const std::size_t chunk_size_;
+  const std::size_t concurrency_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -27,6 +27,12 @@ std::string_view ReadStringViewUnsafe(Reader& reader, std::size_t size);
 /// @warning The `string_view` will be invalidated on the next `Read` operation
 std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size);
 
+/// @brief Reads a non-size-prefixed `std::string_view` that outlives the
+/// next `Read` operations and the `reader` itself
+/// @note The caller must somehow know the string size in advance
+/// @note Memory-mapped readers (see dump::MmapFileReader) do not copy the data
+SharedBytes ReadSharedUnsafe(Reader& reader, std::size_t size);
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
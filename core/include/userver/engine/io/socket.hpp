@@ -5,6 +5,7 @@
 
 #include <sys/socket.h>
 
+#include <cstdint>
 #include <initializer_list>
 
 #include <userver/engine/deadline.hpp>
@@ -103,6 +104,13 @@ class USERVER_NODISCARD Socket final : public RwBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends exactly len bytes of the file starting from offset to the
+  /// socket without copying the data to the user space (see `man sendfile`).
+  /// @note Can return less than len if socket is closed by peer.
+  /// @throws IoException if the file is shorter than offset + len
+  [[nodiscard]] size_t SendFile(int file_fd, std::uint64_t offset, size_t len,
+                                Deadline deadline);
+
   /// @brief Accepts a connection from a listening socket.
   /// @see engine::io::Listen
   [[nodiscard]] Socket Accept(Deadline);
@@ -44,7 +44,9 @@ FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden});
 
 /// @brief Reads file contents asynchronously
-/// @param async_tp TaskProcessor for synchronous waiting
+/// @param async_tp TaskProcessor for synchronous waiting, not used if the
+/// `io_uring` option of the event thread pool is enabled: the file is read via
+/// io_uring of the current task processor without blocking it
 /// @param path file to open
 /// @returns file contents
 /// @throws std::runtime_error if read fails for any reason (e.g. no such file,
@@ -29,7 +29,9 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path);
 /// @brief Rewrite file contents asynchronously
 /// It doesn't provide strict atomic guarantees. If you need them, use
 /// `fs::RewriteFileContentsAtomically`.
-/// @param async_tp TaskProcessor for synchronous waiting
+/// @param async_tp TaskProcessor for synchronous waiting, not used if the
+/// `io_uring` option of the event thread pool is enabled: the file is written
+/// via io_uring of the current task processor without blocking it
 /// @param path file to rewrite
 /// @param contents new file contents
 /// @throws std::runtime_error if failed to overwrite
@@ -9,9 +9,11 @@
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
+#include <userver/formats/json/value.hpp>
 #include <userver/os_signals/component.hpp>
 
 #include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 #include "logger.hpp"
 
@@ -37,10 +39,11 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, either `tskv`, `ltsv` or `binary` | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
-/// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
-/// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// message_queue_size | deprecated and ignored, see `thread_buffer_size` | 65536
+/// thread_buffer_size | the size in bytes of the buffer of formatted messages of each thread that writes to the logger, must be a power of 2 | 262144
+/// overflow_behavior | message handling policy while the buffer is full: `discard` drops messages, `block` waits until message gets into the buffer | discard
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 ///
 /// ### Logs output
@@ -51,6 +54,17 @@ namespace components {
 /// - Use `%file_name%` to write your logs in file. Use USR1 signal or `OnLogRotate` handler to reopen files after log rotation;
 /// - Use `unix:%socket_name%` to write your logs to unix socket. Socket must be created before the service starts and closed by listener afert service is shuted down.
 ///
+/// ### Binary format
+/// The `binary` format writes length-prefixed records with typed fields and
+/// does not escape or stringify the values. Use the `log-converter` tool to
+/// convert such logs into TSKV.
+///
+/// ### Asynchronous logging
+/// Messages of the file and socket loggers are formatted in the calling thread
+/// into a per-thread buffer. A separate thread of each logger writes the
+/// buffered messages in large batches. The numbers of queued and dropped
+/// messages of each logger are reported in the `logger` statistics.
+///
 /// ### testsuite-capture options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
@@ -92,6 +106,10 @@ class Logging final : public impl::ComponentBase {
   void OnLogRotate();
   void TryReopenFiles();
 
+  /// Returns the numbers of queued and dropped records of each logger
+  formats::json::Value ExtendStatistics(
+      const utils::statistics::StatisticsRequest& /*request*/);
+
   class TestsuiteCaptureSink;
 
   static yaml_config::Schema GetStaticConfigSchema();
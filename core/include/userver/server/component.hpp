@@ -67,7 +67,12 @@ namespace components {
 /// handler-defaults.parse_args_from_body | optional field to parse request according to x-www-form-urlencoded rules and make parameters accessible as query parameters | false
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value | 100
+/// connection.max_pipelined_requests | max count of requests of a single connection that are parsed ahead and processed concurrently, responses are sent in the order of requests, 0 means unlimited | 0
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.http_version | HTTP protocol of the connections: '1.1' or '2' for HTTP/2 over cleartext with prior knowledge (h2c) | '1.1'
+/// connection.http2_session.max_concurrent_streams | max count of concurrently open HTTP/2 streams of a single connection, also limited by connection.max_pipelined_requests | 100
+/// connection.http2_session.initial_window_size | initial HTTP/2 flow control window size of a stream in bytes | 65535
+/// connection.http2_session.max_frame_size | max size of a received HTTP/2 frame payload in bytes | 16384
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 
 // clang-format on
@@ -7,6 +7,7 @@
 #include <userver/server/handlers/auth/handler_auth_config.hpp>
 #include <userver/server/handlers/fallback_handlers.hpp>
 #include <userver/server/request/request_config.hpp>
+#include <userver/tracing/tail_sampling.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -39,6 +40,7 @@ struct HandlerConfig {
   bool throttling_enabled{true};
   bool response_body_stream{false};
   std::optional<bool> set_response_server_hostname;
+  std::optional<tracing::TailSamplingConfig> log_tail_sampling;
 };
 
 HandlerConfig ParseHandlerConfigsWithDefaults(
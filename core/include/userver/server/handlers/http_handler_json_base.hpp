@@ -4,6 +4,7 @@
 /// @brief @copybrief server::handlers::HttpHandlerJsonBase
 
 #include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_response_body_json_writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,6 +37,21 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
       const formats::json::Value& request_json,
       request::RequestContext& context) const = 0;
 
+  void HandleStreamRequest(
+      const http::HttpRequest& request, request::RequestContext& context,
+      http::ResponseBodyStream& response_body_stream) const override;
+
+  /// @brief Handles the request if the `response-body-stream` option is set,
+  /// the JSON response is written in parts with the `writer`.
+  ///
+  /// The status code is 200 unless changed before the first part of the body
+  /// is sent, see http::ResponseBodyJsonWriter.
+  virtual void HandleStreamRequestJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      request::RequestContext& context,
+      http::ResponseBodyJsonWriter& writer) const;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  protected:
@@ -51,6 +51,10 @@ class HttpHandlerStatic final : public HttpHandlerBase {
                                  request::RequestContext&) const override;
 
  private:
+  std::string GetResponseDataForLogging(
+      const http::HttpRequest& request, request::RequestContext& context,
+      const std::string& response_data) const override;
+
   dynamic_config::Source config_;
   const fs::FsCacheClient& storage_;
 };
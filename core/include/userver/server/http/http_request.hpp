@@ -13,6 +13,7 @@
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/utils/impl/projecting_view.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 #include <userver/utils/str_icase.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -176,6 +177,12 @@ class HttpRequest final {
   /// @return true if the body of the request was compressed
   bool IsBodyCompressed() const;
 
+  /// @brief Memory arena that lives as long as the request, see
+  /// utils::ArenaAllocator.
+  ///
+  /// The arena is not thread-safe, use it only from the handler task.
+  utils::MonotonicArena& GetArena() const;
+
  private:
   HttpRequestImpl& impl_;
 };
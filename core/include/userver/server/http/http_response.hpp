@@ -3,12 +3,18 @@
 /// @file userver/server/http/http_response.hpp
 /// @brief @copybrief server::http::HttpResponse
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/http/content_type.hpp>
 #include <userver/server/http/http_response_cookie.hpp>
 #include <userver/server/request/response_base.hpp>
@@ -19,6 +25,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace fs::blocking {
+class FileDescriptor;
+}  // namespace fs::blocking
+
 namespace server::http {
 
 namespace impl {
@@ -94,9 +104,30 @@ class HttpResponse final : public request::ResponseBase {
   /// empty string if no such cookie exists.
   const Cookie& GetCookie(std::string_view cookie_name) const;
 
+  /// @brief Appends a chunk to the response body, the chunk is sent after the
+  /// data returned by the handler and the previously appended parts.
+  ///
+  /// The chunk is written to the socket without copying, `owner` must keep
+  /// the chunk memory alive, e.g. a file from fs::FsCacheClient.
+  void AppendBodyChunk(std::shared_ptr<const void> owner,
+                       std::string_view chunk);
+
+  /// @brief Appends a range of a file to the response body, the range is
+  /// written to the socket by the kernel without copying to the user space.
+  /// If the body has to be copied (e.g. for HTTP/2), the file is read in
+  /// `fs_task_processor`.
+  void AppendBodyFile(engine::TaskProcessor& fs_task_processor,
+                      std::shared_ptr<const fs::blocking::FileDescriptor> file,
+                      std::uint64_t offset, std::size_t size);
+
+  /// @return Size of the response body: the data returned by the handler and
+  /// all the appended parts.
+  std::size_t GetBodySize() const;
+
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::Socket& socket) override;
+  bool SerializeForBatch(std::vector<engine::io::IoData>& buffers) override;
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -115,18 +146,48 @@ class HttpResponse final : public request::ResponseBase {
   // Can be called only once
   Queue::Producer GetBodyProducer();
 
+  /// @cond
+  // Makes the sender drop the connection instead of finishing the streamed
+  // body, must be called before the body producer is destroyed
+  void AbortBodyStream() noexcept;
+  // Waits for the whole streamed body and stores it as the response data,
+  // throws if the body was aborted
+  void ConsumeBodyStream();
+  // Copies the appended body parts to the response data
+  void FlattenBody();
+  // Drops the appended body parts, e.g. to replace the body with an error
+  void ClearBodyParts();
+  /// @endcond
+
  private:
+  struct BodyPart {
+    std::shared_ptr<const void> owner;
+    // Memory chunk or a range of the file if file_fd is not -1
+    std::string_view chunk;
+    int file_fd{-1};
+    std::uint64_t file_offset{0};
+    std::size_t file_size{0};
+    engine::TaskProcessor* fs_task_processor{nullptr};
+  };
+
+  std::string SerializeHeaders();
+  bool FinishNotstreamedHeaders(std::string& header) const;
   void SetBodyStreamed(engine::io::Socket& socket, std::string& header);
   void SetBodyNotstreamed(engine::io::Socket& socket, std::string& header);
+  std::size_t SendBodyParts(engine::io::Socket& socket, std::string& header);
 
   const HttpRequestImpl& request_;
   HttpStatus status_ = HttpStatus::kOk;
   HeadersMap headers_;
   CookiesMap cookies_;
+  std::string batch_header_;
+  std::vector<BodyPart> body_parts_;
+  std::size_t body_parts_size_{0};
 
   engine::SingleConsumerEvent headers_end_;
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  std::atomic<bool> is_body_stream_aborted_{false};
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
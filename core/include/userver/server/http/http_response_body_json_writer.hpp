@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file userver/server/http/http_response_body_json_writer.hpp
+/// @brief @copybrief server::http::ResponseBodyJsonWriter
+
+#include <cstddef>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+// clang-format off
+
+/// @brief Writes a JSON response body of a streaming handler in parts while
+/// the JSON is being built.
+///
+/// The JSON is written into formats::json::StringBuilder and is passed to the
+/// server::http::ResponseBodyStream as a chunk each time it grows over the
+/// `flush_threshold`. Only a few chunks may wait to be sent to the client, the
+/// writes wait for a slow client, so the memory usage does not depend on the
+/// size of the body. Use with the `response-body-stream` option of the handler
+/// for big responses, e.g. exports.
+///
+/// The status line and the headers are sent with the first part of the JSON,
+/// until then the handler may still change them or throw an exception to
+/// respond with an error. The rest of the JSON is sent by the destructor.
+/// An exception after the first part aborts the response, the client does not
+/// get a truncated body as a complete one.
+///
+/// ## Example usage:
+///
+/// @snippet server/http/http_response_body_json_writer_test.cpp  Sample server::http::ResponseBodyJsonWriter usage
+
+// clang-format on
+
+class ResponseBodyJsonWriter final {
+ public:
+  static constexpr std::size_t kDefaultFlushThreshold = 64 * 1024;
+
+  /// Sets the JSON Content-Type, the headers are sent by the first Flush()
+  explicit ResponseBodyJsonWriter(
+      ResponseBodyStream& body_stream,
+      std::size_t flush_threshold = kDefaultFlushThreshold);
+
+  ResponseBodyJsonWriter(const ResponseBodyJsonWriter&) = delete;
+  ResponseBodyJsonWriter& operator=(const ResponseBodyJsonWriter&) = delete;
+
+  ~ResponseBodyJsonWriter();
+
+  /// Builder for the keys, objects and arrays of the body. Call
+  /// FlushIfNeeded() from time to time if writing into it directly.
+  formats::json::StringBuilder& GetStringBuilder() noexcept { return builder_; }
+
+  /// @brief Writes the `value` using WriteToStream and sends the JSON if
+  /// needed.
+  /// @throws std::runtime_error if the response would not be sent, e.g. the
+  /// connection is closed.
+  template <typename T>
+  void Write(const T& value) {
+    WriteToStream(value, builder_);
+    FlushIfNeeded();
+  }
+
+  /// @brief Sends the JSON if it has grown over the flush threshold.
+  /// @throws std::runtime_error if the response would not be sent.
+  void FlushIfNeeded() {
+    if (builder_.GetSize() >= flush_threshold_) Flush();
+  }
+
+  /// @brief Sends the JSON written so far.
+  /// @throws std::runtime_error if the response would not be sent.
+  void Flush();
+
+  /// @returns The number of the JSON bytes passed to the ResponseBodyStream
+  std::size_t GetFlushedSize() const noexcept { return flushed_size_; }
+
+ private:
+  ResponseBodyStream& body_stream_;
+  const std::size_t flush_threshold_;
+  const int uncaught_exceptions_;
+  std::size_t flushed_size_{0};
+  formats::json::StringBuilder builder_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
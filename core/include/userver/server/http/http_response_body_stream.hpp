@@ -13,30 +13,51 @@ class HttpHandlerBase;
 
 namespace server::http {
 
+class ResponseBodyStream;
+
+/// @cond
+namespace impl {
+// For internal use only
+ResponseBodyStream MakeResponseBodyStream(HttpResponse& http_response);
+}  // namespace impl
+/// @endcond
+
 class ResponseBodyStream final {
  public:
   ResponseBodyStream(ResponseBodyStream&&) = default;
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
+  // Waits while too many chunks are not sent yet. The chunk is dropped if the
+  // response would not be sent, see IsClosed().
   void PushBodyChunk(std::string&& chunk);
 
+  // Returns true if the response would not be sent anymore, e.g. the
+  // connection is closed
+  bool IsClosed() const { return is_closed_; }
+
   void SetHeader(const std::string&, const std::string&);
 
+  // Sends the status line and the headers, the following
+  // PushBodyChunk() calls send the body while the handler is running.
   void SetEndOfHeaders();
 
+  bool IsEndOfHeaders() const { return headers_ended_; }
+
   void SetStatusCode(int status_code);
 
   void SetStatusCode(HttpStatus status);
 
  private:
   friend class server::handlers::HttpHandlerBase;
+  friend ResponseBodyStream impl::MakeResponseBodyStream(HttpResponse&);
 
   ResponseBodyStream(
       server::http::HttpResponse::Queue::Producer&& queue_producer,
       server::http::HttpResponse& http_response);
 
   bool headers_ended_{false};
+  bool is_closed_{false};
   HttpResponse::Queue::Producer queue_producer_;
   server::http::HttpResponse& http_response_;
 };
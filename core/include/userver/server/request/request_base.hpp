@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,6 +10,7 @@
 // TODO: use fwd declarations
 #include <userver/logging/logger.hpp>
 #include <userver/server/request/response_base.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -45,6 +48,13 @@ class RequestBase {
 
   virtual void AccountResponseTime() = 0;
 
+  /// @brief Memory arena for the request scoped data, all the memory is
+  /// released at once with the request.
+  ///
+  /// The arena is not thread-safe and must be used only from the task that
+  /// currently processes the request.
+  utils::MonotonicArena& GetArena() const noexcept { return arena_; }
+
  protected:
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   std::chrono::steady_clock::time_point start_time_;
@@ -58,6 +68,15 @@ class RequestBase {
   std::chrono::steady_clock::time_point start_send_response_time_;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   std::chrono::steady_clock::time_point finish_send_response_time_;
+
+ private:
+  // Enough for the args and the context data of a typical request, so that
+  // they are allocated together with the request itself
+  static constexpr std::size_t kArenaInitialSize = 1024;
+
+  alignas(std::max_align_t)
+      std::array<std::byte, kArenaInitialSize> arena_buffer_;
+  mutable utils::MonotonicArena arena_;
 };
 
 }  // namespace server::request
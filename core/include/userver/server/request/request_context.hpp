@@ -8,6 +8,7 @@
 #include <userver/compiler/select.hpp>
 #include <userver/utils/any_movable.hpp>
 #include <userver/utils/fast_pimpl.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,6 +21,11 @@ namespace server::request {
 class RequestContext final {
  public:
   RequestContext();
+
+  /// @brief Context that allocates the bookkeeping of the named data from
+  /// `arena`, the arena must outlive the context.
+  explicit RequestContext(utils::MonotonicArena& arena);
+
   RequestContext(RequestContext&&) = delete;
   RequestContext(const RequestContext&) = delete;
 
@@ -102,10 +108,10 @@ class RequestContext final {
   class Impl;
 
   static constexpr std::size_t kPimplSize = compiler::SelectSize()  //
-                                                .ForLibCpp32(24)
-                                                .ForLibCpp64(48)
-                                                .ForLibStdCpp64(64)
-                                                .ForLibStdCpp32(32);
+                                                .ForLibCpp32(32)
+                                                .ForLibCpp64(64)
+                                                .ForLibStdCpp64(72)
+                                                .ForLibStdCpp32(36);
 
   utils::AnyMovable& SetUserAnyData(utils::AnyMovable&& data);
   utils::AnyMovable& GetUserAnyData();
@@ -7,11 +7,13 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 class Socket;
+struct IoData;
 }  // namespace engine::io
 
 namespace server::request {
@@ -72,6 +74,14 @@ class ResponseBase {
 
   virtual void SendResponse(engine::io::Socket& socket) = 0;
 
+  // Serializes a fully constructed response to be sent together with other
+  // responses. Appends the data to `buffers`, the data stays valid until the
+  // response is destroyed. Returns false if the response should be sent by
+  // SendResponse().
+  virtual bool SerializeForBatch(std::vector<engine::io::IoData>& buffers);
+  void SetSentInBatch(size_t bytes_sent,
+                      std::chrono::steady_clock::time_point sent_time);
+
   virtual void SetStatusServiceUnavailable() = 0;
   virtual void SetStatusOk() = 0;
   virtual void SetStatusNotFound() = 0;
@@ -81,6 +91,9 @@ class ResponseBase {
   void SetSent(size_t bytes_sent);
   void SetSentTime(std::chrono::steady_clock::time_point sent_time);
 
+  // Accounts the data that is sent in addition to GetData()
+  void AccountExtraData(size_t size);
+
   class Guard final {
    public:
     Guard(ResponseDataAccounter& accounter,
@@ -101,6 +114,7 @@ class ResponseBase {
   ResponseDataAccounter& accounter_;
   std::optional<Guard> guard_;
   std::string data_;
+  size_t extra_data_size_ = 0;
   std::chrono::steady_clock::time_point create_time_;
   std::chrono::steady_clock::time_point ready_time_;
   std::chrono::steady_clock::time_point sent_time_;
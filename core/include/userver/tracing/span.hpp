@@ -16,6 +16,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace tracing {
 
+struct TailSamplingConfig;
+
+namespace impl {
+class TailSamplingBuffer;
+}  // namespace impl
+
 /// @brief Measures the execution time of the current code block, links it with
 /// the parent tracing::Spans and stores that info in the log.
 ///
@@ -149,6 +155,13 @@ class Span final {
   /// it is set and greater than the main log level of the Span.
   std::optional<logging::Level> GetLocalLogLevel() const;
 
+  /// @brief Buffers the log records of this Span and of its children that are
+  /// created after the call and writes them only if the Span fails or is slow,
+  /// see tracing::TailSamplingConfig.
+  ///
+  /// Does nothing if the Span already buffers the records for its parent.
+  void EnableTailSampling(const TailSamplingConfig& config);
+
   /// Set link. Can be called only once.
   void SetLink(std::string link);
 
@@ -181,6 +194,8 @@ class Span final {
   void AddTags(const logging::LogExtra&, utils::InternalTag);
 
   impl::TimeStorage& GetTimeStorage();
+
+  impl::TailSamplingBuffer* GetTailSamplingBuffer(utils::InternalTag) const;
   /// @endcond
 
  private:
@@ -0,0 +1,49 @@
+#pragma once
+
+/// @file userver/tracing/tail_sampling.hpp
+/// @brief @copybrief tracing::TailSamplingConfig
+
+#include <chrono>
+#include <cstddef>
+
+#include <userver/logging/level.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+/// @brief Settings of the tail-based log retention for a tracing::Span
+///
+/// Log records of the span and of its children are kept in a bounded
+/// in-memory buffer and are written out only if the span:
+/// - is finished with a non-empty tracing::kErrorFlag tag;
+/// - or lasted at least `latency_threshold`;
+/// - or a record with `flush_level` or higher was logged.
+///
+/// `sampling_rate` of the spans are not buffered at all and are logged as
+/// usual. The records of the span themselves are always written.
+///
+/// See tracing::Span::EnableTailSampling
+struct TailSamplingConfig {
+  /// Max bytes of the buffered records, the oldest records are evicted on
+  /// overflow
+  std::size_t buffer_size = 64 * 1024;
+
+  /// Spans that lasted at least that long are flushed
+  std::chrono::milliseconds latency_threshold{1000};
+
+  /// Ratio in range [0, 1] of the spans that are logged without buffering
+  double sampling_rate = 0.0;
+
+  /// Records with this level and above flush the buffer and disable the
+  /// buffering for the rest of the span
+  logging::Level flush_level = logging::Level::kWarning;
+};
+
+TailSamplingConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<TailSamplingConfig>);
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -18,6 +18,15 @@ class Tracer : public std::enable_shared_from_this<Tracer> {
   static void SetNoLogSpans(NoLogSpans&& spans);
   static bool IsNoLogSpan(const std::string& name);
 
+  /// @brief Sets the ratio in range [0, 1] of the traces whose spans are
+  /// logged, 1 by default.
+  ///
+  /// The decision is made once for the root span and is inherited by all its
+  /// children. Spans of the other traces are not logged and do not store the
+  /// data that is only used in the span records.
+  static void SetSpanSamplingRate(double rate);
+  static double GetSpanSamplingRate();
+
   static void SetTracer(TracerPtr tracer);
 
   static TracerPtr GetTracer();
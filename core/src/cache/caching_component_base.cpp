@@ -89,6 +89,24 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mmap:
+                type: boolean
+                description: Whether to map the dump file into memory instead of reading it
+                defaultDescription: false
+            compression:
+                type: string
+                description: If set, the dump is split into chunks that are compressed and checksummed in parallel
+                enum:
+                  - none
+                  - zlib
+            chunk-size:
+                type: integer
+                description: Size of a dump chunk in bytes before compression
+                defaultDescription: 4194304
+            chunk-concurrency:
+                type: integer
+                description: How many dump chunks are processed in parallel
+                defaultDescription: 4
             first-update-mode:
                 type: string
                 description: specifies whether required or best-effort first update will be used
@@ -0,0 +1,68 @@
+#include <userver/cache/expirable_lru_cache.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Cache = cache::ExpirableLruCache<std::uint64_t, std::uint64_t>;
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1024;
+constexpr std::uint64_t kHotKeys = 8;
+constexpr auto kLoadDuration = std::chrono::milliseconds{1};
+
+}  // namespace
+
+// Concurrent misses of a few hot keys with a slow loader, as after
+// an invalidation of the cache. range(0) is the number of concurrent tasks.
+void expirable_lru_cache_slow_load_misses(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    Cache cache(kWays, kWaySize);
+    std::atomic<std::uint64_t> loads{0};
+    const Cache::UpdateValueFunc slow_load = [&loads](std::uint64_t key) {
+      ++loads;
+      engine::SleepFor(kLoadDuration);
+      return key;
+    };
+
+    std::uint64_t requests = 0;
+    for (auto _ : state) {
+      cache.Invalidate();
+
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(state.range(0));
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&cache, &slow_load, i] {
+          const auto key = static_cast<std::uint64_t>(i) % kHotKeys;
+          benchmark::DoNotOptimize(cache.Get(key, slow_load));
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      requests += state.range(0);
+    }
+
+    state.SetItemsProcessed(requests);
+    state.counters["loads_per_request"] =
+        static_cast<double>(loads.load()) / requests;
+    state.counters["coalesced_loads"] =
+        cache.GetStatistics().total.coalesced_loads.load();
+  });
+}
+BENCHMARK(expirable_lru_cache_slow_load_misses)
+    ->RangeMultiplier(4)
+    ->Range(8, 512)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
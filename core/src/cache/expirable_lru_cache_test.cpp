@@ -1,10 +1,15 @@
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/mock_now.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -330,6 +335,98 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
   EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST(ExpirableLruCache, StaleWhileRevalidate) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(3));
+  cache.SetBackgroundUpdate(cache::BackgroundUpdateMode::kEnabled);
+  cache.SetStaleWhileRevalidate(std::chrono::seconds(2));
+
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+
+  // expired less than stale-while-revalidate ago
+  utils::datetime::MockSleep(std::chrono::seconds(4));
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2)));
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+
+  // expired more than stale-while-revalidate ago
+  utils::datetime::MockSleep(std::chrono::seconds(6));
+  counter->Flush();
+  EXPECT_EQ(3, cache.Get(key, UpdateValue(counter, 3)));
+  EXPECT_EQ(Counter::One(), *counter);
+}
+
+UTEST(ExpirableLruCache, CoalescedLoads) {
+  constexpr std::size_t kTasks = 10;
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+  const auto slow_update = [counter](const SimpleCacheKey&) {
+    ++(*counter);
+    engine::SleepFor(std::chrono::milliseconds(50));
+    return 1;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get(key, slow_update); }));
+  }
+  for (auto& task : tasks) EXPECT_EQ(1, task.Get());
+
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(kTasks - 1, cache.GetStatistics().total.coalesced_loads);
+}
+
+UTEST(ExpirableLruCache, CoalescedLoadsException) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+  const auto failing_update = [](const SimpleCacheKey&) -> SimpleCacheValue {
+    engine::SleepFor(std::chrono::milliseconds(50));
+    throw std::runtime_error("update failed");
+  };
+
+  auto first = engine::AsyncNoSpan([&] { cache.Get(key, failing_update); });
+  auto second = engine::AsyncNoSpan([&] { cache.Get(key, UpdateNever()); });
+  UEXPECT_THROW(first.Get(), std::runtime_error);
+  UEXPECT_THROW(second.Get(), std::runtime_error);
+
+  // the failed load is not cached
+  EXPECT_EQ(2, cache.Get(key, [](const SimpleCacheKey&) { return 2; }));
+}
+
+UTEST(ExpirableLruCache, CoalescedLoadsLeaderCancelled) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+  engine::SingleConsumerEvent load_started;
+  const auto hanging_update = [&](const SimpleCacheKey&) -> SimpleCacheValue {
+    load_started.Send();
+    engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+    throw std::runtime_error("update interrupted");
+  };
+
+  auto first = engine::AsyncNoSpan([&] { cache.Get(key, hanging_update); });
+  ASSERT_TRUE(load_started.WaitForEventFor(utest::kMaxTestWaitTime));
+
+  auto second = engine::AsyncNoSpan([&] {
+    return cache.Get(key, [](const SimpleCacheKey&) { return 2; });
+  });
+  while (cache.GetStatistics().total.coalesced_loads == 0) engine::Yield();
+
+  // The waiting task loads the key itself instead of failing
+  first.SyncCancel();
+  EXPECT_EQ(2, second.Get());
+}
+
 UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
   using Key = std::string;
@@ -19,14 +19,18 @@ constexpr const char* kStatisticsNameHits = "hits";
 constexpr const char* kStatisticsNameMisses = "misses";
 constexpr const char* kStatisticsNameStale = "stale";
 constexpr const char* kStatisticsNameBackground = "background-updates";
+constexpr const char* kStatisticsNameCoalescedLoads = "coalesced-loads";
 constexpr const char* kStatisticsNameHitRatio = "hit_ratio";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
+constexpr const char* kStatisticsNameAdmissionRejections =
+    "admission-rejections";
 
 }  // namespace
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size) {
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::size_t admission_rejections) {
   formats::json::ValueBuilder builder;
   utils::statistics::SolomonLabelValue(builder, "cache_name");
 
@@ -35,6 +39,8 @@ formats::json::Value GetCacheStatisticsAsJson(
   builder[kStatisticsNameMisses] = stats.total.misses.load();
   builder[kStatisticsNameStale] = stats.total.stale.load();
   builder[kStatisticsNameBackground] = stats.total.background_updates.load();
+  builder[kStatisticsNameCoalescedLoads] = stats.total.coalesced_loads.load();
+  builder[kStatisticsNameAdmissionRejections] = admission_rejections;
 
   auto s1min = stats.recent.GetStatsForPeriod();
   double s1min_hits = s1min.hits.load();
@@ -91,10 +97,26 @@ properties:
         type: string
         description: TTL for cache entries (0 is unlimited)
         defaultDescription: 0
+    background-update:
+        type: boolean
+        description: update the entries that are past half of their lifetime in background
+        defaultDescription: false
+    stale-while-revalidate:
+        type: string
+        description: how long after the lifetime an entry is still returned while it is updated in background (0 is never); requires background-update
+        defaultDescription: 0
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    eviction-policy:
+        type: string
+        description: lru, clock (cache hits do not take locks) or tiny-lfu (frequently used keys survive scans)
+        defaultDescription: lru
+        enum:
+          - lru
+          - clock
+          - tiny-lfu
 )");
 }
 
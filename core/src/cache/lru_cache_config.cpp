@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
@@ -18,17 +20,35 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kStaleWhileRevalidate = "stale-while-revalidate";
+constexpr std::string_view kStaleWhileRevalidateMs =
+    "stale-while-revalidate-ms";
+constexpr std::string_view kEvictionPolicy = "eviction-policy";
 
 }  // namespace
 
 using dump::impl::ParseMs;
 
+EvictionPolicy Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<EvictionPolicy>) {
+  const auto as_string = value.As<std::string>();
+
+  if (as_string == "lru") return EvictionPolicy::kLru;
+  if (as_string == "clock") return EvictionPolicy::kClock;
+  if (as_string == "tiny-lfu") return EvictionPolicy::kTinyLfu;
+
+  throw yaml_config::ParseException(fmt::format(
+      "Invalid eviction policy '{}' at '{}'", as_string, value.GetPath()));
+}
+
 LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
     : size(config[kSize].As<std::size_t>()),
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      stale_while_revalidate(
+          config[kStaleWhileRevalidate].As<std::chrono::milliseconds>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -40,7 +60,9 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      stale_while_revalidate(ParseMs(value[kStaleWhileRevalidateMs],
+                                     std::chrono::milliseconds::zero())) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -58,7 +80,9 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      eviction_policy(
+          config[kEvictionPolicy].As<EvictionPolicy>(EvictionPolicy::kLru)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
 
@@ -13,13 +13,15 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
-      background_updates(other.background_updates.load()) {}
+      background_updates(other.background_updates.load()),
+      coalesced_loads(other.coalesced_loads.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
   hits = 0;
   misses = 0;
   stale = 0;
   background_updates = 0;
+  coalesced_loads = 0;
 }
 
 ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
@@ -28,6 +30,7 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
   misses += other.misses.load();
   stale += other.stale.load();
   background_updates += other.background_updates.load();
+  coalesced_loads += other.coalesced_loads.load();
   return *this;
 }
 
@@ -49,6 +52,12 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
   LOG_TRACE() << "stale cache";
 }
 
+void CacheLoadCoalesced(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.coalesced_loads;
+  ++stats.recent.GetCurrentCounter().coalesced_loads;
+  LOG_TRACE() << "cache load coalesced";
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
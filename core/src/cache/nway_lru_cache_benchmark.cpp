@@ -0,0 +1,115 @@
+#include <userver/cache/nway_lru_cache.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Cache = cache::NWayLRU<std::uint64_t, std::uint64_t>;
+
+constexpr std::size_t kWays = 16;
+constexpr std::uint64_t kCacheSize = 100'000;
+constexpr std::size_t kGetsPerTask = 10'000;
+
+// range(0): eviction policy; range(1): number of threads
+void PolicyAndThreads(benchmark::internal::Benchmark* benchmark) {
+  for (const auto policy :
+       {cache::EvictionPolicy::kLru, cache::EvictionPolicy::kClock,
+        cache::EvictionPolicy::kTinyLfu}) {
+    for (const auto threads : {1, 2, 4, 8}) {
+      benchmark->Args({static_cast<int>(policy), threads});
+    }
+  }
+}
+
+Cache MakeCache(const benchmark::State& state) {
+  return Cache(kWays, kCacheSize / kWays, {}, {},
+               static_cast<cache::EvictionPolicy>(state.range(0)));
+}
+
+// Zipf-distributed keys, the most popular keys are spread over the ways
+class ZipfKeys final {
+ public:
+  ZipfKeys(std::uint64_t keys, double skew) {
+    std::vector<double> weights(keys);
+    for (std::uint64_t i = 0; i < keys; ++i) {
+      weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), skew);
+    }
+    distribution_ = {weights.begin(), weights.end()};
+  }
+
+  template <typename Rng>
+  std::uint64_t operator()(Rng& rng) {
+    return distribution_(rng) * 0x9E3779B97F4A7C15ULL;
+  }
+
+ private:
+  std::discrete_distribution<std::uint64_t> distribution_;
+};
+
+}  // namespace
+
+// Throughput of cache hits from several threads
+void nway_lru_get_hit(benchmark::State& state) {
+  const auto threads = state.range(1);
+  engine::RunStandalone(threads, [&] {
+    auto cache = MakeCache(state);
+    for (std::uint64_t i = 0; i < kCacheSize; ++i) cache.Put(i, i);
+
+    for (auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      for (std::int64_t t = 0; t < threads; ++t) {
+        tasks.push_back(engine::AsyncNoSpan([&cache, t] {
+          for (std::size_t i = 0; i < kGetsPerTask; ++i) {
+            benchmark::DoNotOptimize(cache.Get((i * 7919 + t) % kCacheSize));
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+    }
+    state.SetItemsProcessed(state.iterations() * threads * kGetsPerTask);
+  });
+}
+BENCHMARK(nway_lru_get_hit)->Apply(PolicyAndThreads)->UseRealTime();
+
+// Hit ratio on a Zipf-distributed workload, the keys that miss are put
+// into the cache. range(1) is the number of keys per cache entry.
+void nway_lru_hit_ratio(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    auto cache = MakeCache(state);
+    ZipfKeys keys{kCacheSize * state.range(1), 0.9};
+    std::minstd_rand rng{42};
+
+    std::uint64_t hits = 0;
+    std::uint64_t total = 0;
+    for (auto _ : state) {
+      const auto key = keys(rng);
+      if (cache.Get(key)) {
+        ++hits;
+      } else {
+        cache.Put(key, key);
+      }
+      ++total;
+    }
+    state.counters["hit_ratio"] = static_cast<double>(hits) / total;
+    state.counters["admission_rejections"] = cache.GetAdmissionRejections();
+  });
+}
+BENCHMARK(nway_lru_hit_ratio)
+    ->ArgsProduct({{static_cast<int>(cache::EvictionPolicy::kLru),
+                    static_cast<int>(cache::EvictionPolicy::kClock),
+                    static_cast<int>(cache::EvictionPolicy::kTinyLfu)},
+                   {2, 10}})
+    ->Iterations(5'000'000);
+
+USERVER_NAMESPACE_END
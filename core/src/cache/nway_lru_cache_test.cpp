@@ -2,6 +2,13 @@
 
 #include <userver/cache/nway_lru_cache.hpp>
 
+#include <atomic>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 using Cache = cache::NWayLRU<int, int>;
@@ -54,4 +61,144 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+namespace {
+
+Cache MakeClockCache(size_t ways, size_t way_size) {
+  return Cache(ways, way_size, {}, {}, cache::EvictionPolicy::kClock);
+}
+
+}  // namespace
+
+UTEST(NWayLRUClock, Set) {
+  auto cache = MakeClockCache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(1, 10);
+  EXPECT_EQ(2, cache.GetSize());
+  EXPECT_EQ(10, cache.Get(1));
+  EXPECT_EQ(2, cache.GetOr(2, -1));
+  EXPECT_EQ(-1, cache.GetOr(3, -1));
+}
+
+UTEST(NWayLRUClock, SecondChance) {
+  auto cache = MakeClockCache(1, 3);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+  EXPECT_EQ(1, cache.Get(1));
+
+  // 1 has been accessed, 2 is the first one without the access bit
+  cache.Put(4, 4);
+  EXPECT_EQ(3, cache.GetSize());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+  EXPECT_EQ(4, cache.Get(4));
+}
+
+UTEST(NWayLRUClock, NewEntryIsNotEvictedFirst) {
+  auto cache = MakeClockCache(1, 3);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // 4 takes the slot of 1, the next eviction must continue past it
+  cache.Put(4, 4);
+  cache.Put(5, 5);
+  EXPECT_EQ(3, cache.GetSize());
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(3, cache.Get(3));
+  EXPECT_EQ(4, cache.Get(4));
+  EXPECT_EQ(5, cache.Get(5));
+}
+
+UTEST(NWayLRUClock, GetExpired) {
+  auto cache = MakeClockCache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_EQ(2, cache.Get(2, [](int) { return true; }));
+
+  cache.InvalidateByKey(2);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(3, 3);
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayLRUClock, UpdateWaySize) {
+  auto cache = MakeClockCache(1, 10);
+  for (int i = 0; i < 10; ++i) cache.Put(i, i);
+  EXPECT_EQ(5, cache.Get(5));
+
+  cache.UpdateWaySize(3);
+  EXPECT_EQ(3, cache.GetSize());
+  EXPECT_EQ(5, cache.Get(5));
+
+  for (int i = 10; i < 20; ++i) cache.Put(i, i);
+  EXPECT_EQ(3, cache.GetSize());
+
+  int visited = 0;
+  cache.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(3, visited);
+}
+
+UTEST_MT(NWayLRUClock, Concurrent, 4) {
+  constexpr int kKeys = 100;
+  auto cache = MakeClockCache(2, kKeys / 4);
+  std::atomic<bool> stop{false};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int t = 0; t < 3; ++t) {
+    tasks.push_back(engine::AsyncNoSpan([&, t] {
+      for (int i = t; !stop; ++i) {
+        const auto key = i % kKeys;
+        if (i % 3 == 0) {
+          cache.Put(key, key);
+        } else if (auto value = cache.Get(key)) {
+          EXPECT_EQ(key, *value);
+        }
+      }
+    }));
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i % kKeys, i % kKeys);
+    engine::Yield();
+  }
+  stop = true;
+  for (auto& task : tasks) task.Get();
+  EXPECT_LE(cache.GetSize(), kKeys / 2);
+}
+
+UTEST(NWayLRUTinyLfu, ScanResistance) {
+  Cache cache(1, 10, {}, {}, cache::EvictionPolicy::kTinyLfu);
+  for (int i = 0; i < 5; ++i) {
+    for (int access = 0; access < 3; ++access) {
+      if (!cache.Get(i)) cache.Put(i, i);
+    }
+  }
+  for (int i = 0; i < 100; ++i) {
+    if (!cache.Get(100 + i)) cache.Put(100 + i, 100 + i);
+    if (i % 2 == 0 && !cache.Get(i / 2 % 5)) cache.Put(i / 2 % 5, i / 2 % 5);
+  }
+
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(i, cache.GetOr(i, -1));
+  EXPECT_EQ(10, cache.GetSize());
+  EXPECT_GT(cache.GetAdmissionRejections(), 0);
+
+  cache.UpdateWaySize(3);
+  EXPECT_EQ(3, cache.GetSize());
+  cache.InvalidateByKey(0);
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
 USERVER_NAMESPACE_END
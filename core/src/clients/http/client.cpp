@@ -20,6 +20,7 @@
 #include <crypto/openssl.hpp>
 #include <curl-ev/multi.hpp>
 #include <curl-ev/ratelimit.hpp>
+#include <curl-ev/share.hpp>
 #include <engine/ev/thread_pool.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -45,6 +46,12 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
       value["thread-name-prefix"].As<std::string>(settings.thread_name_prefix);
   settings.io_threads = value["threads"].As<size_t>(settings.io_threads);
   settings.defer_events = value["defer-events"].As<bool>(settings.defer_events);
+  settings.share_tls_sessions =
+      value["share-tls-sessions"].As<bool>(settings.share_tls_sessions);
+  settings.max_host_connections = value["max-host-connections"].As<size_t>(
+      settings.max_host_connections);
+  settings.multiplexing =
+      value["multiplexing"].As<bool>(settings.multiplexing);
 
   return settings;
 }
@@ -74,13 +81,26 @@ Client::Client(ClientSettings settings,
   // libcurl synchronously reads some of /etc/* files.
   // As we want httpclient to be non-blocking, we have to shift curl's init code
   // to a fs task processor.
-  engine::AsyncNoSpan(fs_task_processor_, [this, io_threads] {
+  engine::AsyncNoSpan(fs_task_processor_, [this, io_threads, &settings] {
     for (auto* thread_control_ptr : thread_pool_->NextThreads(io_threads)) {
       multis_.push_back(std::make_unique<curl::multi>(*thread_control_ptr,
                                                       connect_rate_limiter_));
     }
+
+    if (settings.share_tls_sessions) {
+      // The connection cache is not shared, curl does not support using a
+      // connection from several threads.
+      share_ = std::make_shared<curl::share>();
+      share_->set_share_dns(true);
+      share_->set_share_ssl_session(true);
+    }
   }).Get();
 
+  SetMultiplexingEnabled(settings.multiplexing);
+  if (settings.max_host_connections) {
+    SetMaxHostConnections(settings.max_host_connections);
+  }
+
   easy_reinit_task_.Start(
       "http_easy_reinit",
       utils::PeriodicTask::Settings(kEasyReinitPeriod,
@@ -121,6 +141,7 @@ std::shared_ptr<Request> Client::CreateRequest() {
   if (easy) {
     auto idx = FindMultiIndex(easy->GetMulti());
     auto wrapper = std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
+    if (share_) wrapper->Easy().set_share(share_);
     request = std::make_shared<Request>(std::move(wrapper),
                                         statistics_[idx].CreateRequestStats(),
                                         destination_statistics_, resolver_);
@@ -133,6 +154,7 @@ std::shared_ptr<Request> Client::CreateRequest() {
                   // GetBound() calls blocking Curl_resolver_init()
                   auto wrapper = std::make_shared<impl::EasyWrapper>(
                       easy_.Get()->GetBoundBlocking(*multi), *this);
+                  if (share_) wrapper->Easy().set_share(share_);
                   return std::make_shared<Request>(
                       std::move(wrapper), statistics_[i].CreateRequestStats(),
                       destination_statistics_, resolver_);
@@ -170,8 +192,11 @@ void Client::SetMultiplexingEnabled(bool enabled) {
 }
 
 void Client::SetMaxHostConnections(size_t max_host_connections) {
+  // Rounding up to allow at least one connection for each multi
+  const auto per_multi =
+      (max_host_connections + multis_.size() - 1) / multis_.size();
   for (auto& multi : multis_) {
-    multi->SetMaxHostConnections(ClampToLong(max_host_connections));
+    multi->SetMaxHostConnections(ClampToLong(per_multi));
   }
 }
 
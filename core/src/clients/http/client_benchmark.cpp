@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/internal/net/net_listener.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kConcurrentRequests = 16;
+constexpr std::chrono::seconds kTimeout{10};
+
+constexpr std::string_view kResponse =
+    "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nOK";
+
+// Replies to the requests without a body, keeps the connection alive
+void ServeConnection(engine::io::Socket socket) {
+  std::array<char, 4096> buf{};
+  std::string request;
+  while (const auto size = socket.RecvSome(buf.data(), buf.size(), {})) {
+    request.append(buf.data(), size);
+
+    std::size_t pos = 0;
+    while ((pos = request.find("\r\n\r\n")) != std::string::npos) {
+      request.erase(0, pos + 4);
+      socket.SendAll(kResponse.data(), kResponse.size(), {});
+    }
+  }
+}
+
+// Each accepted connection is a TLS handshake for an HTTPS upstream
+void http_client_requests(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    internal::net::TcpListener listener{internal::net::IpVersion::kV4};
+    const auto url = fmt::format("http://127.0.0.1:{}/", listener.port);
+
+    std::atomic<std::size_t> connections{0};
+    auto accept_task = engine::AsyncNoSpan([&listener, &connections] {
+      std::vector<engine::TaskWithResult<void>> handlers;
+      for (;;) {
+        auto socket = listener.socket.Accept({});
+        ++connections;
+        handlers.push_back(
+            engine::AsyncNoSpan(&ServeConnection, std::move(socket)));
+      }
+    });
+
+    clients::http::ClientSettings settings;
+    settings.io_threads = state.range(0);
+    settings.max_host_connections = state.range(1);
+    clients::http::Client client{settings,
+                                 engine::current_task::GetTaskProcessor()};
+
+    std::vector<clients::http::ResponseFuture> futures;
+    futures.reserve(kConcurrentRequests);
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < kConcurrentRequests; ++i) {
+        futures.push_back(client.CreateRequest()
+                              ->get(url)
+                              ->timeout(kTimeout)
+                              ->async_perform());
+      }
+      for (auto& future : futures) {
+        benchmark::DoNotOptimize(future.Get());
+      }
+      futures.clear();
+    }
+
+    const auto requests = state.iterations() * kConcurrentRequests;
+    state.SetItemsProcessed(requests);
+    state.counters["connections"] = benchmark::Counter(
+        static_cast<double>(connections), benchmark::Counter::kIsRate);
+    state.counters["connections_per_request"] =
+        static_cast<double>(connections) / static_cast<double>(requests);
+
+    accept_task.SyncCancel();
+  });
+}
+
+}  // namespace
+
+// Args: IO threads, max connections to the host (0 for no limit)
+BENCHMARK(http_client_requests)
+    ->Args({1, 0})
+    ->Args({8, 0})
+    ->Args({8, 8})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -129,6 +129,18 @@ properties:
         type: boolean
         description: whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care
         defaultDescription: false
+    share-tls-sessions:
+        type: boolean
+        description: share DNS cache and TLS sessions between the IO threads, so that a new connection to a known host resumes the TLS session instead of making a full handshake
+        defaultDescription: false
+    max-host-connections:
+        type: integer
+        description: approximate max number of connections to a single host, 0 for no limit; the limit is split between the IO threads and rounded up, so it is never less than the number of IO threads
+        defaultDescription: 0
+    multiplexing:
+        type: boolean
+        description: allow sending concurrent HTTP/2 requests to a host over a single connection
+        defaultDescription: true
     fs-task-processor:
         type: string
         description: task processor to run blocking HTTP related calls, like DNS resolving or hosts reading
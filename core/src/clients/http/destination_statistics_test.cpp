@@ -105,4 +105,35 @@ UTEST(DestinationStatistics, Multiple) {
   }
 }
 
+UTEST(DestinationStatistics, ConnectionReuse) {
+  const utest::SimpleServer http_server{[](const HttpRequest& request) {
+    LOG_INFO() << "HTTP Server receive: " << request;
+    return HttpResponse{"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+                        HttpResponse::kWriteAndContinue};
+  }};
+  auto client = utest::CreateHttpClient();
+
+  const auto url = http_server.GetBaseUrl();
+  for (int i = 0; i < 3; ++i) {
+    auto response = client->CreateRequest()
+                        ->get(url)
+                        ->retry(1)
+                        ->timeout(utest::kMaxTestWaitTime)
+                        ->perform();
+    EXPECT_EQ(response->status_code(), 200);
+  }
+
+  const auto& dest_stats = client->GetDestinationStatistics();
+  size_t size = 0;
+  for (const auto& [stat_url, stat_ptr] : dest_stats) {
+    ASSERT_EQ(1, ++size);
+    ASSERT_NE(nullptr, stat_ptr);
+
+    auto stats = clients::http::InstanceStatistics(*stat_ptr);
+    EXPECT_EQ(1, stats.multi.socket_open);
+    EXPECT_EQ(2, stats.multi.socket_reuse);
+  }
+  EXPECT_EQ(1, size);
+}
+
 USERVER_NAMESPACE_END
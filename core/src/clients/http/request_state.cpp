@@ -364,8 +364,10 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
 
   holder->AccountResponse(err);
   const auto sockets = easy.get_num_connects();
-  holder->WithRequestStats(
-      [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  if (sockets != 0 || !err) {
+    holder->WithRequestStats(
+        [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  }
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   span.AddTag(tracing::kMaxAttempts, holder->retry_.retries);
@@ -58,7 +58,11 @@ void RequestStats::StoreTimeToStart(
 }
 
 void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
-  stats_.socket_open_ += sockets;
+  if (sockets == 0) {
+    ++stats_.socket_reuse_;
+  } else {
+    stats_.socket_open_ += sockets;
+  }
 }
 
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
@@ -166,6 +170,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   }
 
   writer["sockets"]["open"] = stats.multi.socket_open;
+  writer["sockets"]["reused"] = stats.multi.socket_reuse;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -190,6 +195,7 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
   for (size_t i = 0; i < error_count.size(); i++)
     error_count[i] = other.error_count_[i].load();
   multi.socket_open = other.socket_open_;
+  multi.socket_reuse = other.socket_reuse_;
 }
 
 uint64_t InstanceStatistics::GetNotOkErrorCount() const {
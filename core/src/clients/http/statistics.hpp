@@ -28,6 +28,8 @@ class RequestStats final {
 
   void StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept;
 
+  // Accounts the connections opened by the request, zero means that the
+  // request has reused a connection from the pool
   void AccountOpenSockets(size_t sockets) noexcept;
 
   void AccountTimeoutUpdatedByDeadline() noexcept;
@@ -44,10 +46,12 @@ struct MultiStats {
   uint64_t socket_open{0};
   uint64_t socket_close{0};
   uint64_t socket_ratelimit{0};
+  uint64_t socket_reuse{0};
   double current_load{0};
 
   MultiStats& operator+=(const MultiStats& other) {
     socket_open += other.socket_open;
+    socket_reuse += other.socket_reuse;
     socket_close += other.socket_close;
     socket_ratelimit += other.socket_ratelimit;
     current_load += other.current_load;
@@ -99,6 +103,7 @@ class Statistics {
       {0, 0, 0, 0, 0, 0, 0}};
   std::atomic_llong retries_{0};
   std::atomic_llong socket_open_{0};
+  std::atomic_llong socket_reuse_{0};
 
   std::atomic<std::uint64_t> timeout_updated_by_deadline_{0};
   std::atomic<std::uint64_t> cancelled_by_deadline_{0};
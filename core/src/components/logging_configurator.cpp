@@ -1,5 +1,8 @@
 #include <userver/components/logging_configurator.hpp>
 
+#include <stdexcept>
+#include <string>
+
 #include <tracing/no_log_spans.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
@@ -32,6 +35,14 @@ LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
   logging::impl::SetLogLimitedInterval(
       config["limited-logging-interval"].As<std::chrono::milliseconds>());
 
+  const auto span_sampling_rate = config["span-sampling-rate"].As<double>(1.0);
+  if (span_sampling_rate < 0.0 || span_sampling_rate > 1.0) {
+    throw std::runtime_error(
+        "span-sampling-rate should be in range [0, 1], current value is " +
+        std::to_string(span_sampling_rate));
+  }
+  tracing::Tracer::SetSpanSamplingRate(span_sampling_rate);
+
   config_subscription_ =
       context.FindComponent<components::DynamicConfig>()
           .GetSource()
@@ -60,6 +71,10 @@ properties:
     limited-logging-interval:
         type: string
         description: utils::StringToDuration suitable duration string to group repeated logs into one message
+    span-sampling-rate:
+        type: number
+        description: ratio in range [0, 1] of the traces whose spans are logged, the decision is made for the root span and is inherited by its children
+        defaultDescription: 1
 )");
 }
 
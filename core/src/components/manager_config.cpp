@@ -107,6 +107,31 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            io_uring:
+                type: boolean
+                description: >
+                    Whether to use io_uring for socket and file I/O. Falls back
+                    to the default ev-loop backend if the kernel does not
+                    support it. fs::ReadFileContents and
+                    fs::RewriteFileContents then do not use their fs task
+                    processor
+                defaultDescription: false
+            numa_aware:
+                type: boolean
+                description: >
+                    Whether to spread the threads over the NUMA nodes and bind
+                    each of them to the CPUs and the memory of its node. Task
+                    processors with `numa-node` use the threads of their node
+                defaultDescription: false
+            timer_slack:
+                type: string
+                description: >
+                    Coalesce the task timers (sleeps, deadlines) of each thread
+                    into a timer wheel with ticks of this duration. A timer may
+                    fire up to one tick late. 0 keeps a precise ev timer per
+                    task. Besides the usual duration suffixes, accepts `us`
+                    for microseconds, e.g. `500us`
+                defaultDescription: 0ms
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -142,6 +167,32 @@ properties:
                       - normal
                       - low-priority
                       - idle
+                task-processor-queue:
+                    type: string
+                    description: |
+                        Task queue mode for the task processor.
+                        `global-task-queue` uses a single queue shared by
+                        all the workers.
+                        `work-stealing-task-queue` gives each worker a local
+                        queue and makes idle workers steal tasks from the
+                        busy ones.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node to run the task processor on. The workers are
+                        bound to the CPUs and the memory of the node, the
+                        coroutine stacks are allocated on the node. Ignored
+                        with a warning if the machine has no such node.
+                cpu-set:
+                    type: string
+                    description: |
+                        CPUs to run the workers on in the Linux cpulist
+                        format, e.g. `0-7,16-23`. Overrides the CPUs of the
+                        `numa-node`.
                 task-trace:
                     type: object
                     description: .
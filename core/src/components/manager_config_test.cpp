@@ -23,6 +23,7 @@ components_manager:
     threads: $event_threads
     threads#fallback: 2
     defer_events: false
+    timer_slack: 500us
   task_processors:
     bg-task-processor:
       thread_name: bg-worker
@@ -35,6 +36,7 @@ components_manager:
     main-task-processor:
       thread_name: main-worker
       worker_threads: $main_worker_threads
+      task-processor-queue: work-stealing-task-queue
     monitor-task-processor:
       thread_name: mon-worker
       worker_threads: $monitor_worker_threads
@@ -212,6 +214,28 @@ TEST(ManagerConfig, Basic) {
       [](const auto& conf) { return conf.Name() == "logging-configurator"; }));
 }
 
+TEST(ManagerConfig, EventThreadPool) {
+  const auto mc = MakeManagerConfig();
+
+  EXPECT_EQ(mc.event_thread_pool.threads, 3);
+  EXPECT_EQ(mc.event_thread_pool.timer_slack, std::chrono::microseconds{500});
+}
+
+TEST(ManagerConfig, TaskProcessorQueue) {
+  const auto mc = MakeManagerConfig();
+
+  for (const auto& tp_config : mc.task_processors) {
+    if (tp_config.name == "main-task-processor") {
+      EXPECT_EQ(tp_config.task_processor_queue,
+                engine::TaskQueueType::kWorkStealingTaskQueue);
+    } else {
+      EXPECT_EQ(tp_config.task_processor_queue,
+                engine::TaskQueueType::kGlobalTaskQueue)
+          << tp_config.name;
+    }
+  }
+}
+
 TEST(ManagerConfig, HandlerConfig) {
   const auto mc = MakeManagerConfig();
 
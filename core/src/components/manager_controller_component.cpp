@@ -4,6 +4,7 @@
 #include <components/manager_controller_component_config.hpp>
 #include <engine/task/task_processor.hpp>
 #include <engine/task/task_processor_pools.hpp>
+#include <tracing/tail_sampling_buffer.hpp>
 #include <userver/components/manager.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
@@ -48,6 +49,7 @@ formats::json::ValueBuilder GetTaskProcessorStats(
   json_context_switch["slow"] = counter.GetTaskSwitchSlow();
   json_context_switch["fast"] = counter.GetTaskSwitchFast();
   json_context_switch["spurious_wakeups"] = counter.GetSpuriousWakeups();
+  json_context_switch["numa_node_migrations"] = counter.GetNumaNodeMigrations();
 
   json_context_switch["overloaded"] = counter.GetTasksOverloadSensor();
   json_context_switch["no_overloaded"] = counter.GetTasksNoOverloadSensor();
@@ -79,6 +81,15 @@ ManagerControllerComponent::ManagerControllerComponent(
       [this](const auto& request) { return ExtendStatistics(request); });
 
   auto& logger_component = context.FindComponent<components::Logging>();
+  logging_statistics_holder_ = storage.RegisterExtender(
+      "logger", [&logger_component](const auto& request) {
+        return logger_component.ExtendStatistics(request);
+      });
+  tail_sampling_statistics_holder_ = storage.RegisterExtender(
+      "log-tail-sampling", [](const auto& /*request*/) {
+        return tracing::impl::GetTailSamplingStatistics();
+      });
+
   for (const auto& [name, task_processor] :
        components_manager_.GetTaskProcessorsMap()) {
     const auto& logger_name = task_processor->GetTaskTraceLoggerName();
@@ -90,6 +101,8 @@ ManagerControllerComponent::ManagerControllerComponent(
 }
 
 ManagerControllerComponent::~ManagerControllerComponent() {
+  tail_sampling_statistics_holder_.Unregister();
+  logging_statistics_holder_.Unregister();
   statistics_holder_.Unregister();
   config_subscription_.Unsubscribe();
 }
@@ -129,7 +142,7 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
   // coroutines
   {
     auto coro_stats =
-        components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+        components_manager_.GetTaskProcessorPools()->GetCoroPoolStats();
     formats::json::ValueBuilder json_coro_pool(formats::json::Type::kObject);
 
     formats::json::ValueBuilder json_coro_stats(formats::json::Type::kObject);
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 
@@ -47,7 +48,8 @@ class share final : public std::enable_shared_from_this<share> {
                      void* userptr);
 
   native::CURLSH* handle_;
-  std::mutex mutex_;
+  // Separate locks for the shared DNS cache, TLS sessions, etc.
+  std::array<std::mutex, native::CURL_LOCK_DATA_LAST> mutexes_;
 };
 }  // namespace curl
 
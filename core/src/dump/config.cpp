@@ -4,6 +4,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/dump/operations_chunked.hpp>
 #include <userver/dynamic_config/value.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,9 +19,15 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kMmap = "mmap";
+constexpr std::string_view kCompression = "compression";
+constexpr std::string_view kChunkSize = "chunk-size";
+constexpr std::string_view kChunkConcurrency = "chunk-concurrency";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
+constexpr std::size_t kDefaultChunkSize = 4 * 1024 * 1024;
+constexpr std::size_t kDefaultChunkConcurrency = 4;
 
 }  // namespace
 
@@ -40,6 +47,17 @@ std::chrono::milliseconds ParseMs(
 
 }  // namespace impl
 
+Compression Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Compression>) {
+  const auto as_string = value.As<std::string>();
+
+  if (as_string == "none") return Compression::kNone;
+  if (as_string == "zlib") return Compression::kZlib;
+
+  throw yaml_config::ParseException(fmt::format(
+      "Invalid dump compression '{}' at '{}'", as_string, value.GetPath()));
+}
+
 constexpr std::string_view kDump = "dump";
 constexpr std::string_view kMaxDumpAge = "max-age";
 constexpr std::string_view kMinDumpInterval = "min-interval";
@@ -67,6 +85,11 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      use_mmap(config[kMmap].As<bool>(false)),
+      compression(config[kCompression].As<std::optional<Compression>>()),
+      chunk_size(config[kChunkSize].As<std::size_t>(kDefaultChunkSize)),
+      chunk_concurrency(config[kChunkConcurrency].As<std::size_t>(
+          kDefaultChunkConcurrency)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -78,6 +101,19 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
     throw std::logic_error(
         fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
   }
+  if (chunk_size == 0 || chunk_size > ChunkedWriter::kMaxChunkSize) {
+    throw std::logic_error(fmt::format("{}: {} must be in [1, {}]", this->name,
+                                       kChunkSize,
+                                       ChunkedWriter::kMaxChunkSize));
+  }
+  if (chunk_concurrency == 0) {
+    throw std::logic_error(
+        fmt::format("{}: {} must not be 0", this->name, kChunkConcurrency));
+  }
+  if (use_mmap && dump_is_encrypted) {
+    throw std::logic_error(fmt::format("{}: {} is not supported for {} dumps",
+                                       this->name, kMmap, kEncrypted));
+  }
 }
 
 DynamicConfig::DynamicConfig(const Config& config, ConfigPatch&& patch)
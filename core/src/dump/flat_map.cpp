@@ -0,0 +1,192 @@
+#include <userver/dump/flat_map.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+constexpr std::size_t kWordSize = sizeof(std::uint64_t);
+
+// count, key offsets, value offsets
+constexpr std::size_t GetHeaderWords(std::size_t count) noexcept {
+  return 2 * count + 3;
+}
+
+void AppendWord(std::string& buffer, std::uint64_t word) {
+  char bytes[kWordSize];
+  std::memcpy(bytes, &word, kWordSize);
+  buffer.append(bytes, kWordSize);
+}
+
+}  // namespace
+
+FlatMapData::FlatMapData() : FlatMapData(Build({})) {}
+
+FlatMapData::FlatMapData(SharedBytes bytes) : bytes_(std::move(bytes)) {
+  const auto total_size = bytes_.data.size();
+  if (total_size < kWordSize * GetHeaderWords(0)) {
+    throw Error(fmt::format("Flat map is too small: size={}", total_size));
+  }
+
+  size_ = GetWord(0);
+  if (size_ > (total_size / kWordSize - GetHeaderWords(0)) / 2) {
+    throw Error(fmt::format("Flat map header does not fit: count={}, size={}",
+                            size_, total_size));
+  }
+
+  const auto data_size = total_size - kWordSize * GetHeaderWords(size_);
+  keys_size_ = GetWord(1 + size_);
+  values_size_ = GetWord(2 + 2 * size_);
+  if (keys_size_ > data_size || values_size_ != data_size - keys_size_) {
+    throw Error(fmt::format(
+        "Flat map data size mismatch: keys={}, values={}, expected-total={}",
+        keys_size_, values_size_, data_size));
+  }
+
+  // The lookups trust the offsets, so a broken dump fails to load instead
+  CheckOffsets(1, "key");
+  CheckOffsets(2 + size_, "value");
+}
+
+FlatMapData FlatMapData::Build(
+    std::vector<std::pair<std::string, std::string>>&& items) {
+  std::sort(items.begin(), items.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+  const auto duplicate = std::adjacent_find(
+      items.begin(), items.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; });
+  if (duplicate != items.end()) {
+    throw std::invalid_argument(
+        fmt::format("Duplicate flat map key '{}'", duplicate->first));
+  }
+
+  std::size_t keys_size = 0;
+  std::size_t values_size = 0;
+  for (const auto& [key, value] : items) {
+    keys_size += key.size();
+    values_size += value.size();
+  }
+
+  auto buffer = std::make_shared<std::string>();
+  buffer->reserve(kWordSize * GetHeaderWords(items.size()) + keys_size +
+                  values_size);
+
+  AppendWord(*buffer, items.size());
+  std::uint64_t offset = 0;
+  AppendWord(*buffer, offset);
+  for (const auto& item : items) {
+    AppendWord(*buffer, offset += item.first.size());
+  }
+  offset = 0;
+  AppendWord(*buffer, offset);
+  for (const auto& item : items) {
+    AppendWord(*buffer, offset += item.second.size());
+  }
+  for (const auto& item : items) buffer->append(item.first);
+  for (const auto& item : items) buffer->append(item.second);
+
+  const std::string_view data = *buffer;
+  return FlatMapData{SharedBytes{data, std::move(buffer)}};
+}
+
+std::string_view FlatMapData::GetKey(std::size_t index) const {
+  UASSERT(index < size_);
+  const auto begin = GetWord(1 + index);
+  const auto end = GetWord(2 + index);
+  UASSERT(begin <= end && end <= keys_size_);
+  return bytes_.data.substr(kWordSize * GetHeaderWords(size_) + begin,
+                            end - begin);
+}
+
+std::string_view FlatMapData::GetValue(std::size_t index) const {
+  UASSERT(index < size_);
+  const auto begin = GetWord(2 + size_ + index);
+  const auto end = GetWord(3 + size_ + index);
+  UASSERT(begin <= end && end <= values_size_);
+  return bytes_.data.substr(
+      kWordSize * GetHeaderWords(size_) + keys_size_ + begin, end - begin);
+}
+
+std::optional<std::size_t> FlatMapData::Find(std::string_view key) const {
+  std::size_t first = 0;
+  std::size_t count = size_;
+  while (count > 0) {
+    const auto step = count / 2;
+    if (GetKey(first + step) < key) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  if (first == size_ || GetKey(first) != key) return std::nullopt;
+  return first;
+}
+
+void FlatMapData::CheckOffsets(std::size_t first_word,
+                               std::string_view name) const {
+  // The last offset is the total size that is checked already
+  std::uint64_t previous = GetWord(first_word);
+  if (previous != 0) {
+    throw Error(fmt::format("Flat map {} offsets do not start from 0: {}",
+                            name, previous));
+  }
+  for (std::size_t i = 1; i <= size_; ++i) {
+    const auto offset = GetWord(first_word + i);
+    if (offset < previous) {
+      throw Error(fmt::format(
+          "Flat map {} offsets are not sorted: offset[{}]={} < offset[{}]={}",
+          name, i, offset, i - 1, previous));
+    }
+    previous = offset;
+  }
+}
+
+std::uint64_t FlatMapData::GetWord(std::size_t index) const noexcept {
+  UASSERT(kWordSize * (index + 1) <= bytes_.data.size());
+  // The data may be unaligned, e.g. in a memory-mapped dump
+  std::uint64_t word = 0;
+  std::memcpy(&word, bytes_.data.data() + kWordSize * index, kWordSize);
+  return word;
+}
+
+void WriteFlatMapData(Writer& writer, const FlatMapData& data) {
+  writer.Write(data.GetBytes().size());
+  WriteStringViewUnsafe(writer, data.GetBytes());
+}
+
+FlatMapData ReadFlatMapData(Reader& reader) {
+  const auto size = reader.Read<std::size_t>();
+  return FlatMapData{ReadSharedUnsafe(reader, size)};
+}
+
+void StringReader::Finish() {
+  if (!data_.empty()) {
+    throw Error(fmt::format("Unexpected extra data at the end of a value: {}",
+                            data_.size()));
+  }
+}
+
+std::string_view StringReader::ReadRaw(std::size_t max_size) {
+  const auto result = data_.substr(0, max_size);
+  data_.remove_prefix(result.size());
+  return result;
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,101 @@
+#include <userver/dump/flat_map.hpp>
+
+#include <string>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = std::unordered_map<std::string, std::string>;
+
+Map MakeMap(std::size_t size) {
+  Map map;
+  map.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    map.emplace("key-" + std::to_string(i), std::string(64, 'a' + i % 26));
+  }
+  return map;
+}
+
+template <typename T>
+void WriteDump(const std::string& path, const T& value) {
+  tracing::Span span{"dump"};
+  auto scope_time = span.CreateScopeTime("write");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Write(value);
+  writer.Finish();
+}
+
+}  // namespace
+
+// The time from opening a dump to serving the first request. The dump file
+// stays in the page cache, so it is the parsing cost that is measured.
+void dump_load_unordered_map(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    WriteDump(path, MakeMap(state.range(0)));
+
+    for (auto _ : state) {
+      dump::FileReader reader(path);
+      const auto map = reader.Read<Map>();
+      reader.Finish();
+      benchmark::DoNotOptimize(map.find("key-42"));
+    }
+  });
+}
+BENCHMARK(dump_load_unordered_map)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+void dump_load_flat_map(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    WriteDump(path, dump::FlatMap<std::string>{MakeMap(state.range(0))});
+
+    for (auto _ : state) {
+      dump::FileReader reader(path);
+      const auto map = reader.Read<dump::FlatMap<std::string>>();
+      reader.Finish();
+      benchmark::DoNotOptimize(map.Find("key-42"));
+    }
+  });
+}
+BENCHMARK(dump_load_flat_map)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+void dump_load_flat_map_mmap(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    WriteDump(path, dump::FlatMap<std::string>{MakeMap(state.range(0))});
+
+    for (auto _ : state) {
+      dump::MmapFileReader reader(path);
+      const auto map = reader.Read<dump::FlatMap<std::string>>();
+      reader.Finish();
+      benchmark::DoNotOptimize(map.Find("key-42"));
+    }
+  });
+}
+BENCHMARK(dump_load_flat_map_mmap)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,97 @@
+#include <userver/dump/flat_map.hpp>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Values = std::vector<int>;
+
+std::map<std::string, Values> ToStdMap(const dump::FlatMap<Values>& map) {
+  std::map<std::string, Values> result;
+  map.VisitAll([&](std::string_view key, Values&& value) {
+    EXPECT_TRUE(result.emplace(key, std::move(value)).second);
+  });
+  return result;
+}
+
+}  // namespace
+
+TEST(DumpFlatMap, Empty) {
+  const dump::FlatMap<Values> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.Find(""), std::nullopt);
+  dump::TestWriteReadCycle(map);
+}
+
+TEST(DumpFlatMap, Find) {
+  const std::unordered_map<std::string, Values> original{
+      {"b", {1, 2}}, {"a", {}}, {"", {3}}, {"aa", {4, 5, 6}}};
+  const dump::FlatMap<Values> map{original};
+
+  EXPECT_EQ(map.size(), original.size());
+  for (const auto& [key, value] : original) {
+    EXPECT_EQ(map.Find(key), value) << key;
+    EXPECT_TRUE(map.Contains(key));
+  }
+  EXPECT_EQ(map.Find("ab"), std::nullopt);
+  EXPECT_EQ(map.Find("c"), std::nullopt);
+  EXPECT_FALSE(map.Contains("0"));
+
+  const auto sorted = ToStdMap(map);
+  EXPECT_EQ(sorted, (std::map<std::string, Values>{original.begin(),
+                                                    original.end()}));
+}
+
+TEST(DumpFlatMap, WriteRead) {
+  std::map<std::string, Values> original;
+  for (int i = 0; i < 1000; ++i) original[std::to_string(i)] = {i, -i};
+
+  const dump::FlatMap<Values> map{original};
+  dump::TestWriteReadCycle(map);
+
+  const auto after_cycle =
+      dump::FromBinary<dump::FlatMap<Values>>(dump::ToBinary(map));
+  EXPECT_EQ(ToStdMap(after_cycle), original);
+}
+
+TEST(DumpFlatMap, DuplicateKeys) {
+  const std::vector<std::pair<std::string, int>> items{{"a", 1}, {"a", 2}};
+  EXPECT_THROW(dump::FlatMap<int>{items}, std::invalid_argument);
+}
+
+TEST(DumpFlatMap, Corrupted) {
+  const dump::FlatMap<int> map{std::map<std::string, int>{{"a", 1}}};
+  auto binary = dump::ToBinary(map);
+  binary.pop_back();
+  // Keep the size prefix in sync with the truncated data
+  binary[0] = static_cast<char>(binary[0] - 1);
+  EXPECT_THROW(dump::FromBinary<dump::FlatMap<int>>(binary), dump::Error);
+}
+
+TEST(DumpFlatMap, CorruptedOffsets) {
+  const dump::FlatMap<int> map{std::map<std::string, int>{{"a", 1}, {"b", 2}}};
+  auto binary = dump::ToBinary(map);
+
+  // Key offsets of 2 keys of size 1 as 64-bit little-endian words
+  const std::string key_offsets{"\0\0\0\0\0\0\0\0"
+                                "\1\0\0\0\0\0\0\0"
+                                "\2\0\0\0\0\0\0\0",
+                                24};
+  const auto pos = binary.find(key_offsets);
+  ASSERT_NE(pos, std::string::npos);
+  // The key "b" would start after its end
+  binary[pos + 8] = '\5';
+  EXPECT_THROW(dump::FromBinary<dump::FlatMap<int>>(binary), dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,268 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+constexpr std::string_view kMagic = "userver-chunked-dump-v1";
+
+// Compressing the fastest way, dumps are written often and are read once
+constexpr int kZlibLevel = 1;
+
+std::uint32_t Checksum(std::string_view data) {
+  auto checksum = crc32(0, nullptr, 0);
+  while (!data.empty()) {
+    const auto size =
+        std::min<std::size_t>(data.size(), std::numeric_limits<uInt>::max());
+    checksum = crc32(checksum, reinterpret_cast<const Bytef*>(data.data()),
+                     static_cast<uInt>(size));
+    data.remove_prefix(size);
+  }
+  return static_cast<std::uint32_t>(checksum);
+}
+
+impl::Chunk Encode(std::string&& data, Compression compression) {
+  impl::Chunk chunk;
+  chunk.raw_size = data.size();
+  chunk.compression = compression;
+  chunk.checksum = Checksum(data);
+
+  switch (compression) {
+    case Compression::kNone:
+      chunk.payload = std::move(data);
+      break;
+    case Compression::kZlib: {
+      auto compressed_size = compressBound(data.size());
+      chunk.payload.resize(compressed_size);
+      const auto ret = compress2(
+          reinterpret_cast<Bytef*>(chunk.payload.data()), &compressed_size,
+          reinterpret_cast<const Bytef*>(data.data()), data.size(),
+          kZlibLevel);
+      if (ret != Z_OK) {
+        throw Error(fmt::format("Failed to compress a dump chunk: {}", ret));
+      }
+      chunk.payload.resize(compressed_size);
+      break;
+    }
+  }
+
+  return chunk;
+}
+
+std::string Decode(impl::Chunk&& chunk) {
+  std::string data;
+
+  switch (chunk.compression) {
+    case Compression::kNone:
+      data = std::move(chunk.payload);
+      break;
+    case Compression::kZlib: {
+      data.resize(chunk.raw_size);
+      auto size = static_cast<uLongf>(data.size());
+      const auto ret = uncompress(
+          reinterpret_cast<Bytef*>(data.data()), &size,
+          reinterpret_cast<const Bytef*>(chunk.payload.data()),
+          chunk.payload.size());
+      if (ret != Z_OK) {
+        throw Error(fmt::format("Failed to decompress a dump chunk: {}", ret));
+      }
+      data.resize(size);
+      break;
+    }
+  }
+
+  if (data.size() != chunk.raw_size) {
+    throw Error(fmt::format("Dump chunk size mismatch: expected={}, actual={}",
+                            chunk.raw_size, data.size()));
+  }
+  if (Checksum(data) != chunk.checksum) {
+    throw Error("Dump chunk checksum mismatch");
+  }
+  return data;
+}
+
+}  // namespace
+
+ChunkedWriter::ChunkedWriter(std::unique_ptr<Writer> base,
+                             Compression compression, std::size_t chunk_size,
+                             std::size_t concurrency)
+    : base_(std::move(base)),
+      compression_(compression),
+      chunk_size_(chunk_size),
+      concurrency_(concurrency) {
+  UASSERT(base_);
+  UINVARIANT(chunk_size_ > 0 && chunk_size_ <= kMaxChunkSize,
+             "Invalid dump chunk size");
+  UINVARIANT(concurrency_ > 0, "Invalid dump chunk concurrency");
+  WriteStringViewUnsafe(*base_, kMagic);
+}
+
+ChunkedWriter::~ChunkedWriter() = default;
+
+void ChunkedWriter::WriteRaw(std::string_view data) {
+  while (!data.empty()) {
+    if (buffer_.empty()) buffer_.reserve(chunk_size_);
+    const auto size = std::min(data.size(), chunk_size_ - buffer_.size());
+    buffer_.append(data.substr(0, size));
+    data.remove_prefix(size);
+    if (buffer_.size() == chunk_size_) FlushBuffer();
+  }
+}
+
+void ChunkedWriter::Finish() {
+  if (!buffer_.empty()) FlushBuffer();
+  while (!pending_.empty()) {
+    WriteChunk(pending_.front().Get());
+    pending_.pop_front();
+  }
+  // An empty chunk marks the end of data
+  base_->Write(std::uint64_t{0});
+  base_->Finish();
+}
+
+void ChunkedWriter::FlushBuffer() {
+  if (pending_.size() >= concurrency_) {
+    WriteChunk(pending_.front().Get());
+    pending_.pop_front();
+  }
+  pending_.push_back(engine::AsyncNoSpan(
+      [data = std::move(buffer_), compression = compression_]() mutable {
+        return Encode(std::move(data), compression);
+      }));
+  buffer_.clear();
+}
+
+void ChunkedWriter::WriteChunk(const impl::Chunk& chunk) {
+  UASSERT(chunk.raw_size > 0);
+  base_->Write(chunk.raw_size);
+  base_->Write(chunk.compression);
+  base_->Write(chunk.checksum);
+  base_->Write(chunk.payload.size());
+  WriteStringViewUnsafe(*base_, chunk.payload);
+}
+
+ChunkedReader::ChunkedReader(std::unique_ptr<Reader> base,
+                             std::size_t concurrency)
+    : base_(std::move(base)), concurrency_(concurrency) {
+  UASSERT(base_);
+  UINVARIANT(concurrency_ > 0, "Invalid dump chunk concurrency");
+  if (ReadUnsafeAtMost(*base_, kMagic.size()) != kMagic) {
+    throw Error("Not a chunked dump");
+  }
+}
+
+ChunkedReader::~ChunkedReader() = default;
+
+std::string_view ChunkedReader::ReadRaw(std::size_t max_size) {
+  if (current_.size() - position_ >= max_size) {
+    const auto result = std::string_view{current_}.substr(position_, max_size);
+    position_ += max_size;
+    return result;
+  }
+
+  // The data spans several chunks
+  joined_.clear();
+  while (joined_.size() < max_size) {
+    const auto part = std::string_view{current_}.substr(
+        position_, max_size - joined_.size());
+    joined_.append(part);
+    position_ += part.size();
+    if (joined_.size() < max_size && !NextChunk()) break;
+  }
+  return joined_;
+}
+
+void ChunkedReader::Finish() {
+  if (position_ != current_.size() || NextChunk()) {
+    throw Error("Unexpected extra data at the end of a chunked dump");
+  }
+  base_->Finish();
+}
+
+void ChunkedReader::FillPending() {
+  while (!base_finished_ && pending_.size() < concurrency_) {
+    impl::Chunk chunk;
+    chunk.raw_size = base_->Read<std::uint64_t>();
+    if (chunk.raw_size == 0) {
+      base_finished_ = true;
+      break;
+    }
+    if (chunk.raw_size > ChunkedWriter::kMaxChunkSize) {
+      throw Error(
+          fmt::format("Dump chunk is too large: size={}", chunk.raw_size));
+    }
+
+    chunk.compression = base_->Read<Compression>();
+    if (chunk.compression != Compression::kNone &&
+        chunk.compression != Compression::kZlib) {
+      throw Error(fmt::format("Unknown dump chunk compression: {}",
+                              static_cast<int>(chunk.compression)));
+    }
+    chunk.checksum = base_->Read<std::uint32_t>();
+
+    const auto payload_size = base_->Read<std::size_t>();
+    if (payload_size > compressBound(chunk.raw_size)) {
+      throw Error(fmt::format("Dump chunk payload is too large: size={}",
+                              payload_size));
+    }
+    chunk.payload = ReadStringViewUnsafe(*base_, payload_size);
+
+    pending_.push_back(
+        engine::AsyncNoSpan([chunk = std::move(chunk)]() mutable {
+          return Decode(std::move(chunk));
+        }));
+  }
+}
+
+bool ChunkedReader::NextChunk() {
+  UASSERT(position_ == current_.size());
+  FillPending();
+  if (pending_.empty()) return false;
+
+  current_ = pending_.front().Get();
+  pending_.pop_front();
+  position_ = 0;
+  FillPending();
+  return true;
+}
+
+ChunkedOperationsFactory::ChunkedOperationsFactory(
+    std::unique_ptr<OperationsFactory> base, Compression compression,
+    std::size_t chunk_size, std::size_t concurrency)
+    : base_(std::move(base)),
+      compression_(compression),
+      chunk_size_(chunk_size),
+      concurrency_(concurrency) {
+  UASSERT(base_);
+}
+
+std::unique_ptr<Reader> ChunkedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<ChunkedReader>(
+      base_->CreateReader(std::move(full_path)), concurrency_);
+}
+
+std::unique_ptr<Writer> ChunkedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<ChunkedWriter>(
+      base_->CreateWriter(std::move(full_path), scope), compression_,
+      chunk_size_, concurrency_);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
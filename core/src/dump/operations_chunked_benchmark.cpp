@@ -0,0 +1,113 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kChunkSize = 4 * 1024 * 1024;
+
+using Data = std::vector<std::string>;
+
+// About 256 MiB of moderately compressible data
+Data MakeData() {
+  Data data;
+  for (std::size_t i = 0; i < 1024 * 1024; ++i) {
+    data.push_back(std::to_string(i * 7919) + std::string(240, 'a' + i % 26));
+  }
+  return data;
+}
+
+std::size_t GetSize(const Data& data) {
+  std::size_t size = 0;
+  for (const auto& item : data) size += item.size();
+  return size;
+}
+
+// range(0): compression, -1 for a plain dump; range(1): concurrency
+std::unique_ptr<dump::Writer> MakeWriter(const benchmark::State& state,
+                                         const std::string& path,
+                                         tracing::ScopeTime& scope) {
+  auto writer = std::make_unique<dump::FileWriter>(
+      path, boost::filesystem::perms::owner_read, scope);
+  if (state.range(0) < 0) return writer;
+  return std::make_unique<dump::ChunkedWriter>(
+      std::move(writer), static_cast<dump::Compression>(state.range(0)),
+      kChunkSize, state.range(1));
+}
+
+std::unique_ptr<dump::Reader> MakeReader(const benchmark::State& state,
+                                         const std::string& path) {
+  auto reader = std::make_unique<dump::FileReader>(path);
+  if (state.range(0) < 0) return reader;
+  return std::make_unique<dump::ChunkedReader>(std::move(reader),
+                                               state.range(1));
+}
+
+void ChunkedArgs(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({-1, 1});
+  for (const auto compression :
+       {dump::Compression::kNone, dump::Compression::kZlib}) {
+    for (const auto concurrency : {1, 2, 4, 8}) {
+      benchmark->Args({static_cast<int>(compression), concurrency});
+    }
+  }
+  benchmark->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+void dump_chunked_write(benchmark::State& state) {
+  engine::RunStandalone(state.range(1) + 1, [&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    const auto data = MakeData();
+    tracing::Span span{"dump"};
+
+    for (auto _ : state) {
+      auto scope_time = span.CreateScopeTime("write");
+      const auto writer = MakeWriter(state, path, scope_time);
+      writer->Write(data);
+      writer->Finish();
+    }
+    state.SetBytesProcessed(state.iterations() * GetSize(data));
+  });
+}
+BENCHMARK(dump_chunked_write)->Apply(ChunkedArgs);
+
+void dump_chunked_read(benchmark::State& state) {
+  engine::RunStandalone(state.range(1) + 1, [&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    const auto data_size = GetSize(MakeData());
+    {
+      tracing::Span span{"dump"};
+      auto scope_time = span.CreateScopeTime("write");
+      const auto writer = MakeWriter(state, path, scope_time);
+      writer->Write(MakeData());
+      writer->Finish();
+    }
+
+    for (auto _ : state) {
+      const auto reader = MakeReader(state, path);
+      benchmark::DoNotOptimize(reader->Read<Data>());
+      reader->Finish();
+    }
+    state.SetBytesProcessed(state.iterations() * data_size);
+  });
+}
+BENCHMARK(dump_chunked_read)->Apply(ChunkedArgs);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,101 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_mock.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Data = std::vector<std::string>;
+
+Data MakeData() {
+  Data data;
+  for (int i = 0; i < 1000; ++i) {
+    data.push_back(std::string(i % 50, 'a' + i % 26));
+  }
+  return data;
+}
+
+std::string WriteChunked(const Data& data, dump::Compression compression,
+                         std::size_t chunk_size, std::size_t concurrency) {
+  auto base = std::make_unique<dump::MockWriter>();
+  auto& base_ref = *base;
+  dump::ChunkedWriter writer(std::move(base), compression, chunk_size,
+                             concurrency);
+  writer.Write(data);
+  writer.Finish();
+  return std::move(base_ref).Extract();
+}
+
+Data ReadChunked(std::string binary, std::size_t concurrency) {
+  dump::ChunkedReader reader(
+      std::make_unique<dump::MockReader>(std::move(binary)), concurrency);
+  auto data = reader.Read<Data>();
+  reader.Finish();
+  return data;
+}
+
+}  // namespace
+
+UTEST_MT(DumpOperationsChunked, WriteRead, 4) {
+  const auto data = MakeData();
+  for (const auto compression :
+       {dump::Compression::kNone, dump::Compression::kZlib}) {
+    for (const std::size_t chunk_size : {1, 7, 1000, 1000000}) {
+      for (const std::size_t concurrency : {1, 3}) {
+        const auto binary =
+            WriteChunked(data, compression, chunk_size, concurrency);
+        EXPECT_EQ(ReadChunked(binary, concurrency), data)
+            << static_cast<int>(compression) << ' ' << chunk_size << ' '
+            << concurrency;
+      }
+    }
+  }
+}
+
+UTEST(DumpOperationsChunked, Compresses) {
+  const Data data(100, std::string(1000, 'a'));
+  const auto plain = WriteChunked(data, dump::Compression::kNone, 4096, 2);
+  const auto compressed = WriteChunked(data, dump::Compression::kZlib, 4096, 2);
+  EXPECT_LT(compressed.size() * 10, plain.size());
+}
+
+UTEST(DumpOperationsChunked, Empty) {
+  auto base = std::make_unique<dump::MockWriter>();
+  auto& base_ref = *base;
+  dump::ChunkedWriter writer(std::move(base), dump::Compression::kZlib, 16, 2);
+  writer.Finish();
+
+  dump::ChunkedReader reader(
+      std::make_unique<dump::MockReader>(std::move(base_ref).Extract()), 2);
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+UTEST(DumpOperationsChunked, Corrupted) {
+  const auto data = MakeData();
+  auto binary = WriteChunked(data, dump::Compression::kZlib, 1000, 2);
+  binary[binary.size() / 2] ^= 1;
+  UEXPECT_THROW(ReadChunked(binary, 2), dump::Error);
+}
+
+UTEST(DumpOperationsChunked, NotChunked) {
+  dump::MockWriter writer;
+  writer.Write(MakeData());
+  writer.Finish();
+  UEXPECT_THROW(ReadChunked(std::move(writer).Extract(), 2), dump::Error);
+}
+
+UTEST(DumpOperationsChunked, Underread) {
+  const auto binary = WriteChunked(MakeData(), dump::Compression::kNone, 7, 2);
+  dump::ChunkedReader reader(std::make_unique<dump::MockReader>(binary), 2);
+  EXPECT_EQ(reader.Read<std::size_t>(), MakeData().size());
+  UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+USERVER_NAMESPACE_END
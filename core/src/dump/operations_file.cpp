@@ -1,12 +1,18 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <sys/mman.h>
+
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -115,11 +121,66 @@ void FileReader::Finish() {
   }
 }
 
-FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
-    : perms_(perms) {}
+MmapFileReader::MmapFileReader(std::string path) : path_(std::move(path)) {
+  try {
+    const auto file = fs::blocking::FileDescriptor::Open(
+        path_, fs::blocking::OpenFlag::kRead);
+    const auto size = file.GetSize();
+    if (size == 0) return;  // mmap does not accept empty ranges
+
+    void* address = utils::CheckSyscallNotEquals(
+        ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.GetNative(), 0),
+        MAP_FAILED, "mapping the dump file");
+    mapping_ = std::shared_ptr<const void>(
+        address, [size](const void* address) {
+          ::munmap(const_cast<void*>(address), size);
+        });
+    data_ = std::string_view(static_cast<const char*>(address), size);
+
+    // Start loading the pages in the background, best effort
+    ::madvise(address, size, MADV_WILLNEED);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to map the dump file for reading \"{}\". Reason: {}", path_,
+        ex.what()));
+  }
+}
+
+std::string_view MmapFileReader::ReadRaw(std::size_t max_size) {
+  const auto result = data_.substr(position_, max_size);
+  position_ += result.size();
+  return result;
+}
+
+SharedBytes MmapFileReader::ReadShared(std::size_t size) {
+  const auto result = ReadRaw(size);
+  if (result.size() != size) {
+    throw Error(
+        fmt::format("Unexpected end-of-file while trying to read from the dump "
+                    "file \"{}\": requested-size={}",
+                    path_, size));
+  }
+  return {result, mapping_};
+}
+
+void MmapFileReader::Finish() {
+  if (position_ != data_.size()) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "file-size={}, position={}, unread-size={}",
+                    path_, data_.size(), position_, data_.size() - position_));
+  }
+  // The mapping stays alive while the views returned by ReadShared are used
+  mapping_.reset();
+}
+
+FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms,
+                                             bool use_mmap)
+    : perms_(perms), use_mmap_(use_mmap) {}
 
 std::unique_ptr<Reader> FileOperationsFactory::CreateReader(
     std::string full_path) {
+  if (use_mmap_) return std::make_unique<MmapFileReader>(std::move(full_path));
   return std::make_unique<FileReader>(std::move(full_path));
 }
 
@@ -2,6 +2,7 @@
 
 #include <boost/regex.hpp>
 
+#include <userver/dump/common.hpp>
 #include <userver/dump/unsafe.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
@@ -113,4 +114,44 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST(DumpOperationsFile, MmapWriteRead) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Write(std::string{"abc"});
+  WriteStringViewUnsafe(writer, "defgh");
+  writer.Finish();
+
+  dump::SharedBytes shared;
+  {
+    dump::MmapFileReader reader(path);
+    EXPECT_EQ(reader.Read<std::string>(), "abc");
+    shared = ReadSharedUnsafe(reader, 5);
+    reader.Finish();
+  }
+  // The mapping outlives the reader
+  EXPECT_EQ(shared.data, "defgh");
+}
+
+TEST(DumpOperationsFile, MmapEmptyDump) {
+  const auto file = fs::blocking::TempFile::Create();
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadUnsafeAtMost(reader, 10), "");
+  EXPECT_THROW(ReadSharedUnsafe(reader, 1), dump::Error);
+  reader.Finish();
+}
+
+TEST(DumpOperationsFile, MmapUnderread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 9), std::string(9, 'a'));
+  EXPECT_THROW(reader.Finish(), dump::Error);
+}
+
 USERVER_NAMESPACE_END
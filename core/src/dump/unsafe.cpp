@@ -1,5 +1,9 @@
 #include <userver/dump/unsafe.hpp>
 
+#include <memory>
+#include <string>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/dump/common.hpp>
@@ -37,6 +41,19 @@ std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size) {
   return result;
 }
 
+SharedBytes ReadSharedUnsafe(Reader& reader, std::size_t size) {
+  auto result = reader.ReadShared(size);
+  UASSERT(result.data.size() == size);
+  return result;
+}
+
+SharedBytes Reader::ReadShared(std::size_t size) {
+  auto copy = std::make_shared<const std::string>(
+      ReadStringViewUnsafe(*this, size));
+  const std::string_view data = *copy;
+  return {data, std::move(copy)};
+}
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
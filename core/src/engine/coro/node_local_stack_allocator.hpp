@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <uboost_coro/coroutine2/protected_fixedsize_stack.hpp>
+
+#include <utils/numa.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// @brief Stack allocator that places the coroutine stacks on a NUMA node.
+///
+/// The memory policy is set right after mmap, before the first touch, so the
+/// stack pages come from the node no matter which thread creates or runs the
+/// coroutine. Without a node it is a plain protected_fixedsize_stack.
+class NodeLocalStackAllocator final {
+ public:
+  NodeLocalStackAllocator(std::size_t stack_size,
+                          std::optional<std::size_t> numa_node) noexcept
+      : allocator_(stack_size), numa_node_(numa_node) {}
+
+  boost::context::stack_context allocate() {
+    auto stack = allocator_.allocate();
+    if (numa_node_) {
+      // Best effort, the stack is usable even if it lands on another node
+      utils::numa::BindMemoryToNode(static_cast<char*>(stack.sp) - stack.size,
+                                    stack.size, *numa_node_);
+    }
+    return stack;
+  }
+
+  void deallocate(boost::context::stack_context& stack) noexcept {
+    allocator_.deallocate(stack);
+  }
+
+ private:
+  boost::coroutines2::protected_fixedsize_stack allocator_;
+  std::optional<std::size_t> numa_node_;
+};
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -3,15 +3,16 @@
 #include <algorithm>  // for std::max
 #include <atomic>
 #include <cerrno>
+#include <optional>
 #include <utility>
 
 #include <moodycamel/concurrentqueue.h>
 #include <uboost_coro/coroutine2/coroutine.hpp>
-#include <uboost_coro/coroutine2/protected_fixedsize_stack.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include "node_local_stack_allocator.hpp"
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
 
@@ -27,7 +28,9 @@ class Pool final {
   using TaskPipe = typename boost::coroutines2::coroutine<Task*>::pull_type;
   using Executor = void (*)(TaskPipe&);
 
-  Pool(PoolConfig config, Executor executor);
+  /// @param numa_node if set, coroutine stacks are allocated on this node
+  Pool(PoolConfig config, Executor executor,
+       std::optional<std::size_t> numa_node = {});
   ~Pool();
 
   CoroutinePtr GetCoroutine();
@@ -40,12 +43,12 @@ class Pool final {
   void OnCoroutineDestruction() noexcept;
 
   template <typename Token>
-  Token& GetToken();
+  Token* GetToken();
 
   const PoolConfig config_;
   const Executor executor_;
 
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
+  NodeLocalStackAllocator stack_allocator_;
   moodycamel::ConcurrentQueue<Coroutine> coroutines_;
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
@@ -81,10 +84,11 @@ class Pool<Task>::CoroutinePtr final {
 };
 
 template <typename Task>
-Pool<Task>::Pool(PoolConfig config, Executor executor)
+Pool<Task>::Pool(PoolConfig config, Executor executor,
+                 std::optional<std::size_t> numa_node)
     : config_(std::move(config)),
       executor_(executor),
-      stack_allocator_(config.stack_size),
+      stack_allocator_(config_.stack_size, numa_node),
       coroutines_(config_.max_size),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
@@ -111,8 +115,9 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 
   std::optional<Coroutine> coroutine;
   CoroutineMover mover{coroutine};
-  auto& token = GetToken<moodycamel::ConsumerToken>();
-  if (coroutines_.try_dequeue(token, mover)) {
+  auto* token = GetToken<moodycamel::ConsumerToken>();
+  if (token ? coroutines_.try_dequeue(*token, mover)
+            : coroutines_.try_dequeue(mover)) {
     --idle_coroutines_num_;
   } else {
     coroutine.emplace(CreateCoroutine());
@@ -123,8 +128,10 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
   if (idle_coroutines_num_.load() >= config_.max_size) return;
-  auto& token = GetToken<moodycamel::ProducerToken>();
-  const bool ok = coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+  auto* token = GetToken<moodycamel::ProducerToken>();
+  const bool ok =
+      token ? coroutines_.enqueue(*token, std::move(coroutine_ptr.Get()))
+            : coroutines_.enqueue(std::move(coroutine_ptr.Get()));
   if (ok) ++idle_coroutines_num_;
 }
 
@@ -177,9 +184,13 @@ std::size_t Pool<Task>::GetStackSize() const {
 
 template <typename Task>
 template <typename Token>
-Token& Pool<Task>::GetToken() {
+Token* Pool<Task>::GetToken() {
+  // A token is bound to a single queue. A thread keeps the token of the first
+  // pool it used, other pools (e.g. the NUMA node-local ones) are accessed
+  // through the slower tokenless path.
+  thread_local const Pool* token_pool = this;
   thread_local Token token(coroutines_);
-  return token;
+  return token_pool == this ? &token : nullptr;
 }
 
 }  // namespace engine::coro
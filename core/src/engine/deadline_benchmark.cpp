@@ -1,8 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include <chrono>
+#include <vector>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -47,6 +53,35 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+// range(0) tasks wait with a deadline that is never reached and get woken up
+// by an event, range(1) is the timer slack in microseconds, 0 disables the
+// timer wheel
+void deadline_unreached_concurrent_wait(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.max_coro_pool_size = state.range(0);
+  config.coro_stack_size = 32 * 1024;
+  config.ev_timer_slack = std::chrono::microseconds{state.range(1)};
+
+  engine::RunStandalone(4, config, [&] {
+    std::vector<engine::SingleConsumerEvent> events(state.range(0));
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0));
+
+    for (auto _ : state) {
+      for (auto& event : events) {
+        tasks.push_back(engine::AsyncNoSpan([&event] {
+          [[maybe_unused]] const bool ok =
+              event.WaitForEventFor(std::chrono::seconds{10});
+        }));
+      }
+      engine::Yield();
+      for (auto& event : events) event.Send();
+      for (auto& task : tasks) task.Wait();
+      tasks.clear();
+    }
+  });
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +91,10 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK(deadline_unreached_concurrent_wait)
+    ->Args({100'000, 0})
+    ->Args({100'000, 1000})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
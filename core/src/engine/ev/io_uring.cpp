@@ -0,0 +1,515 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <build_config.hpp>
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+struct IoUring::Request final {
+  std::uint8_t opcode{0};
+  int fd{-1};
+  std::uint64_t addr{0};
+  std::uint64_t addr2{0};
+  std::uint32_t len{0};
+  std::uint64_t offset{0};
+  std::uint32_t op_flags{0};
+};
+
+class IoUring::Operation final {
+ public:
+  void Complete(std::int32_t result) noexcept {
+    result_ = result;
+    event_.Send();
+  }
+
+  [[nodiscard]] bool WaitUntil(Deadline deadline) {
+    return event_.WaitForEventUntil(deadline);
+  }
+
+  void WaitNonCancellable() {
+    TaskCancellationBlocker blocker;
+    while (!event_.WaitForEvent()) {
+    }
+  }
+
+  std::int32_t GetResult() const noexcept { return result_; }
+
+ private:
+  std::int32_t result_{0};
+  SingleConsumerEvent event_;
+};
+
+#ifdef HAVE_LINUX_IO_URING_H
+
+namespace {
+
+constexpr unsigned kSubmissionQueueEntries = 1024;
+// Operations wait for readiness inside the kernel, so there could be much more
+// in-flight operations than the submission queue size.
+constexpr unsigned kCompletionQueueEntries = 16 * kSubmissionQueueEntries;
+
+// Cancellation requests are not waited for, their completions are ignored.
+constexpr std::uint64_t kIgnoredUserData = 0;
+
+int IoUringSetup(unsigned entries, io_uring_params* params) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+#ifndef IORING_SQ_CQ_OVERFLOW
+// Linux 5.8+, older kernels never set it
+constexpr unsigned IORING_SQ_CQ_OVERFLOW = 1U << 1;
+#endif
+
+int IoUringEnter(int fd, unsigned to_submit) noexcept {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_enter, fd, to_submit, 0, 0, nullptr, 0));
+}
+
+// Moves the completions that did not fit into the completion queue from the
+// kernel backlog (IORING_FEAT_NODROP) back into the queue
+int IoUringFlushOverflow(int fd) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, 0, 0,
+                                    IORING_ENTER_GETEVENTS, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, const void* arg,
+                    unsigned nr_args) noexcept {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// The lengths are 32-bit in the io_uring entries, the longer buffers are
+// transferred partially as with a short read or write
+std::uint32_t ClampLength(std::size_t len) noexcept {
+  return static_cast<std::uint32_t>(
+      std::min<std::size_t>(len, std::numeric_limits<std::uint32_t>::max()));
+}
+
+template <typename T>
+T* Offset(void* base, std::uint32_t offset) noexcept {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+}  // namespace
+
+struct IoUring::Ring final {
+  Ring() = default;
+  Ring(const Ring&) = delete;
+  Ring& operator=(const Ring&) = delete;
+
+  ~Ring() {
+    if (sqes != MAP_FAILED) ::munmap(sqes, sqes_size);
+    if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) ::munmap(cq_ptr, cq_size);
+    if (sq_ptr != MAP_FAILED) ::munmap(sq_ptr, sq_size);
+    if (event_fd != -1) ::close(event_fd);
+    if (ring_fd != -1) ::close(ring_fd);
+  }
+
+  int ring_fd{-1};
+  int event_fd{-1};
+
+  void* sq_ptr{MAP_FAILED};
+  std::size_t sq_size{0};
+  void* cq_ptr{MAP_FAILED};
+  std::size_t cq_size{0};
+  io_uring_sqe* sqes{static_cast<io_uring_sqe*>(MAP_FAILED)};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_head{nullptr};
+  unsigned* sq_tail{nullptr};
+  unsigned* sq_flags{nullptr};
+  unsigned* sq_mask{nullptr};
+  unsigned sq_entries{0};
+  unsigned* sq_array{nullptr};
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  unsigned* cq_mask{nullptr};
+  io_uring_cqe* cqes{nullptr};
+};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(struct ev_loop* loop) {
+  auto ring = std::make_unique<Ring>();
+
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kCompletionQueueEntries;
+  ring->ring_fd = IoUringSetup(kSubmissionQueueEntries, &params);
+  if (ring->ring_fd == -1) {
+    LOG_WARNING() << "io_uring is not available: "
+                  << std::strerror(errno) << ", falling back to epoll";
+    return nullptr;
+  }
+
+  const auto kRequiredFeatures = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP |
+                                 IORING_FEAT_FAST_POLL;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    LOG_WARNING() << "io_uring lacks the required features (kernel 5.7+ is "
+                     "needed), falling back to epoll";
+    return nullptr;
+  }
+
+  ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->cq_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  // IORING_FEAT_SINGLE_MMAP: both rings are mapped with a single mmap
+  ring->sq_size = ring->cq_size = std::max(ring->sq_size, ring->cq_size);
+
+  ring->sq_ptr = ::mmap(nullptr, ring->sq_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                        IORING_OFF_SQ_RING);
+  if (ring->sq_ptr == MAP_FAILED) {
+    LOG_WARNING() << "Failed to map io_uring rings: " << std::strerror(errno);
+    return nullptr;
+  }
+  ring->cq_ptr = ring->sq_ptr;
+
+  ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  ring->sqes = static_cast<io_uring_sqe*>(
+      ::mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQES));
+  if (ring->sqes == MAP_FAILED) {
+    LOG_WARNING() << "Failed to map io_uring entries: "
+                  << std::strerror(errno);
+    return nullptr;
+  }
+
+  ring->sq_head = Offset<unsigned>(ring->sq_ptr, params.sq_off.head);
+  ring->sq_tail = Offset<unsigned>(ring->sq_ptr, params.sq_off.tail);
+  ring->sq_flags = Offset<unsigned>(ring->sq_ptr, params.sq_off.flags);
+  ring->sq_entries = params.sq_entries;
+  ring->sq_mask = Offset<unsigned>(ring->sq_ptr, params.sq_off.ring_mask);
+  ring->sq_array = Offset<unsigned>(ring->sq_ptr, params.sq_off.array);
+  ring->cq_head = Offset<unsigned>(ring->cq_ptr, params.cq_off.head);
+  ring->cq_tail = Offset<unsigned>(ring->cq_ptr, params.cq_off.tail);
+  ring->cq_mask = Offset<unsigned>(ring->cq_ptr, params.cq_off.ring_mask);
+  ring->cqes = Offset<io_uring_cqe>(ring->cq_ptr, params.cq_off.cqes);
+
+  ring->event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (ring->event_fd == -1 ||
+      IoUringRegister(ring->ring_fd, IORING_REGISTER_EVENTFD, &ring->event_fd,
+                      1) == -1) {
+    LOG_WARNING() << "Failed to register io_uring eventfd: "
+                  << std::strerror(errno);
+    return nullptr;
+  }
+
+  return std::unique_ptr<IoUring>(new IoUring(std::move(ring), loop));
+}
+
+IoUring::IoUring(std::unique_ptr<Ring> ring, struct ev_loop* loop)
+    : ring_(std::move(ring)), loop_(loop), enter_(&IoUringEnter) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_io_init(&completion_watcher_, CompletionWatcherCb, ring_->event_fd,
+             EV_READ);
+  completion_watcher_.data = this;
+  ev_io_start(loop_, &completion_watcher_);
+}
+
+void IoUring::Stop() { ev_io_stop(loop_, &completion_watcher_); }
+
+void IoUring::SetEnterFunctionForTests(EnterFunction enter) noexcept {
+  enter_ = enter;
+}
+
+void IoUring::Submit(const Request& request, std::uint64_t user_data) noexcept {
+  TaskCancellationBlocker blocker;
+  while (!TryPushEntry(request, user_data)) {
+    // The queue is full of the entries left by failed io_uring_enter() calls
+    if (SubmitPending() != 0) engine::Yield();
+  }
+
+  // The kernel owns the entry from the moment it is pushed, so do not return
+  // until it is submitted: the caller waits for the completion of the entry
+  // and destroys the operation right after that.
+  while (const auto error = SubmitPending()) {
+    LOG_LIMITED_WARNING() << "io_uring_enter failed: " << std::strerror(error)
+                          << ", retrying";
+    engine::Yield();
+  }
+}
+
+bool IoUring::TryPushEntry(const Request& request,
+                           std::uint64_t user_data) noexcept {
+  std::lock_guard lock(submit_mutex_);
+  const auto tail = *ring_->sq_tail;
+  const auto head = __atomic_load_n(ring_->sq_head, __ATOMIC_ACQUIRE);
+  if (tail - head >= ring_->sq_entries) return false;
+
+  const auto index = tail & *ring_->sq_mask;
+  auto& sqe = ring_->sqes[index];
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = request.opcode;
+  sqe.fd = request.fd;
+  sqe.addr = request.addr;
+  sqe.len = request.len;
+  // `off` and `addr2` share the same storage
+  if (request.addr2) {
+    sqe.addr2 = request.addr2;
+  } else {
+    sqe.off = request.offset;
+  }
+  sqe.rw_flags = static_cast<__kernel_rwf_t>(request.op_flags);
+  sqe.user_data = user_data;
+
+  ring_->sq_array[index] = index;
+  __atomic_store_n(ring_->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+int IoUring::SubmitPending() noexcept {
+  const auto enter = enter_.load();
+  while (true) {
+    const auto tail = __atomic_load_n(ring_->sq_tail, __ATOMIC_ACQUIRE);
+    const auto head = __atomic_load_n(ring_->sq_head, __ATOMIC_ACQUIRE);
+    if (tail == head) return 0;
+
+    const auto submitted = enter(ring_->ring_fd, tail - head);
+    if (submitted == 0) return EAGAIN;
+    // EAGAIN, EBUSY: the kernel is out of resources or the completion queue
+    // is to be reaped by the ev thread, the caller should retry later.
+    if (submitted == -1 && errno != EINTR) return errno;
+  }
+}
+
+std::int64_t IoUring::Perform(const Request& request, Deadline deadline) {
+  Operation op;
+  Submit(request, reinterpret_cast<std::uintptr_t>(&op));
+
+  if (!op.WaitUntil(deadline)) {
+    Request cancel;
+    cancel.opcode = IORING_OP_ASYNC_CANCEL;
+    cancel.addr = reinterpret_cast<std::uintptr_t>(&op);
+    Submit(cancel, kIgnoredUserData);
+
+    // The kernel may still write into the operation buffers
+    op.WaitNonCancellable();
+
+    const auto result = op.GetResult();
+    if (result == -ECANCELED || result == -EINTR) return -EAGAIN;
+    return result;
+  }
+
+  return op.GetResult();
+}
+
+void IoUring::ReapCompletions() noexcept {
+  std::uint64_t counter = 0;
+  [[maybe_unused]] const auto res =
+      ::read(ring_->event_fd, &counter, sizeof(counter));
+
+  auto head = *ring_->cq_head;
+  const auto mask = *ring_->cq_mask;
+  while (true) {
+    const auto tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      // The completions that overflowed the queue are not signalled again
+      if (!(__atomic_load_n(ring_->sq_flags, __ATOMIC_ACQUIRE) &
+            IORING_SQ_CQ_OVERFLOW)) {
+        break;
+      }
+      if (IoUringFlushOverflow(ring_->ring_fd) == -1 && errno != EINTR) {
+        // Retried on the next completion or submission
+        LOG_LIMITED_WARNING() << "Failed to flush io_uring completions: "
+                              << std::strerror(errno);
+        break;
+      }
+      continue;
+    }
+
+    for (; head != tail; ++head) {
+      const auto& cqe = ring_->cqes[head & mask];
+      if (cqe.user_data == kIgnoredUserData) continue;
+
+      // NOLINTNEXTLINE(performance-no-int-to-ptr)
+      reinterpret_cast<Operation*>(cqe.user_data)->Complete(cqe.res);
+    }
+    __atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+  }
+}
+
+std::int64_t IoUring::Recv(int fd, void* buf, std::size_t len,
+                           Deadline deadline) {
+  Request request;
+  request.opcode = IORING_OP_RECV;
+  request.fd = fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(buf);
+  request.len = ClampLength(len);
+  return Perform(request, deadline);
+}
+
+std::int64_t IoUring::Send(int fd, const void* buf, std::size_t len,
+                           Deadline deadline) {
+  Request request;
+  request.opcode = IORING_OP_SEND;
+  request.fd = fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(buf);
+  request.len = ClampLength(len);
+  request.op_flags = MSG_NOSIGNAL;
+  return Perform(request, deadline);
+}
+
+std::int64_t IoUring::Writev(int fd, const struct iovec* list,
+                             std::size_t list_size, Deadline deadline) {
+  Request request;
+  request.opcode = IORING_OP_WRITEV;
+  request.fd = fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(list);
+  request.len = ClampLength(list_size);
+  // Sockets have no position, -1 means "use the current file position"
+  request.offset = static_cast<std::uint64_t>(-1);
+  return Perform(request, deadline);
+}
+
+std::int64_t IoUring::Accept(int fd, struct sockaddr* addr, socklen_t* len,
+                             int flags, Deadline deadline) {
+  Request request;
+  request.opcode = IORING_OP_ACCEPT;
+  request.fd = fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(addr);
+  request.addr2 = reinterpret_cast<std::uintptr_t>(len);
+  request.op_flags = static_cast<std::uint32_t>(flags);
+  return Perform(request, deadline);
+}
+
+std::int64_t IoUring::OpenAt(int dir_fd, const char* path, int flags,
+                             mode_t mode) {
+  Request request;
+  request.opcode = IORING_OP_OPENAT;
+  request.fd = dir_fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(path);
+  request.len = mode;
+  request.op_flags = static_cast<std::uint32_t>(flags);
+  return Perform(request, Deadline{});
+}
+
+std::int64_t IoUring::Read(int fd, void* buf, std::size_t len,
+                           std::uint64_t offset) {
+  Request request;
+  request.opcode = IORING_OP_READ;
+  request.fd = fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(buf);
+  request.len = ClampLength(len);
+  request.offset = offset;
+  return Perform(request, Deadline{});
+}
+
+std::int64_t IoUring::Write(int fd, const void* buf, std::size_t len,
+                            std::uint64_t offset) {
+  Request request;
+  request.opcode = IORING_OP_WRITE;
+  request.fd = fd;
+  request.addr = reinterpret_cast<std::uintptr_t>(buf);
+  request.len = ClampLength(len);
+  request.offset = offset;
+  return Perform(request, Deadline{});
+}
+
+std::int64_t IoUring::FSync(int fd) {
+  Request request;
+  request.opcode = IORING_OP_FSYNC;
+  request.fd = fd;
+  return Perform(request, Deadline{});
+}
+
+std::int64_t IoUring::Close(int fd) {
+  Request request;
+  request.opcode = IORING_OP_CLOSE;
+  request.fd = fd;
+  return Perform(request, Deadline{});
+}
+
+#else  // HAVE_LINUX_IO_URING_H
+
+struct IoUring::Ring final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(struct ev_loop*) {
+  LOG_WARNING() << "io_uring is not supported on this platform, falling back "
+                   "to the default event loop backend";
+  return nullptr;
+}
+
+IoUring::IoUring(std::unique_ptr<Ring> ring, struct ev_loop* loop)
+    : ring_(std::move(ring)), loop_(loop) {}
+
+void IoUring::Stop() {}
+
+void IoUring::SetEnterFunctionForTests(EnterFunction) noexcept {}
+
+void IoUring::Submit(const Request&, std::uint64_t) noexcept {}
+
+bool IoUring::TryPushEntry(const Request&, std::uint64_t) noexcept {
+  return false;
+}
+
+int IoUring::SubmitPending() noexcept { return ENOSYS; }
+
+std::int64_t IoUring::Perform(const Request&, Deadline) { return -ENOSYS; }
+
+void IoUring::ReapCompletions() noexcept {}
+
+std::int64_t IoUring::Recv(int, void*, std::size_t, Deadline) {
+  return -ENOSYS;
+}
+
+std::int64_t IoUring::Send(int, const void*, std::size_t, Deadline) {
+  return -ENOSYS;
+}
+
+std::int64_t IoUring::Writev(int, const struct iovec*, std::size_t,
+                             Deadline) {
+  return -ENOSYS;
+}
+
+std::int64_t IoUring::Accept(int, struct sockaddr*, socklen_t*, int,
+                             Deadline) {
+  return -ENOSYS;
+}
+
+std::int64_t IoUring::OpenAt(int, const char*, int, mode_t) { return -ENOSYS; }
+
+std::int64_t IoUring::Read(int, void*, std::size_t, std::uint64_t) {
+  return -ENOSYS;
+}
+
+std::int64_t IoUring::Write(int, const void*, std::size_t, std::uint64_t) {
+  return -ENOSYS;
+}
+
+std::int64_t IoUring::FSync(int) { return -ENOSYS; }
+
+std::int64_t IoUring::Close(int) { return -ENOSYS; }
+
+#endif  // HAVE_LINUX_IO_URING_H
+
+IoUring::~IoUring() = default;
+
+void IoUring::CompletionWatcherCb(struct ev_loop*, ev_io* watcher,
+                                  int) noexcept {
+  static_cast<IoUring*>(watcher->data)->ReapCompletions();
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
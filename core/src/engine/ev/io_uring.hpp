@@ -0,0 +1,97 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <ev.h>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Completion based I/O via a Linux io_uring instance bound to an
+/// ev-loop.
+///
+/// Operations are submitted directly from the calling coroutine thread. The
+/// kernel signals completions through an eventfd watched by the ev-loop, the
+/// ev thread reaps the completion queue and wakes up the waiting tasks.
+///
+/// All the operations must be called from a coroutine and block it until the
+/// operation completes. On deadline or task cancellation the operation is
+/// cancelled in kernel and `-EAGAIN` is returned if no data was transferred,
+/// so the callers may handle it in the same way as a non-blocking syscall
+/// result.
+///
+/// All the operations return a non-negative result or a negated errno value.
+class IoUring final {
+ public:
+  /// Returns nullptr if io_uring is not supported by the platform or the kernel
+  /// lacks the required features.
+  static std::unique_ptr<IoUring> TryCreate(struct ev_loop* loop);
+
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  std::int64_t Recv(int fd, void* buf, std::size_t len, Deadline deadline);
+  std::int64_t Send(int fd, const void* buf, std::size_t len,
+                    Deadline deadline);
+  std::int64_t Writev(int fd, const struct iovec* list, std::size_t list_size,
+                      Deadline deadline);
+  std::int64_t Accept(int fd, struct sockaddr* addr, socklen_t* len,
+                      int flags, Deadline deadline);
+
+  std::int64_t OpenAt(int dir_fd, const char* path, int flags, mode_t mode);
+  std::int64_t Read(int fd, void* buf, std::size_t len, std::uint64_t offset);
+  std::int64_t Write(int fd, const void* buf, std::size_t len,
+                     std::uint64_t offset);
+  std::int64_t FSync(int fd);
+  std::int64_t Close(int fd);
+
+  /// Stops the completion watcher, must be called from the ev thread before
+  /// the ev-loop is destroyed.
+  void Stop();
+
+  /// @cond
+  // For tests only: replaces the io_uring_enter() syscall, returns -1 and sets
+  // errno on failure.
+  using EnterFunction = int (*)(int ring_fd, unsigned to_submit) noexcept;
+  void SetEnterFunctionForTests(EnterFunction enter) noexcept;
+  /// @endcond
+
+ private:
+  struct Ring;
+  struct Request;
+  class Operation;
+
+  IoUring(std::unique_ptr<Ring> ring, struct ev_loop* loop);
+
+  std::int64_t Perform(const Request& request, Deadline deadline);
+
+  void Submit(const Request& request, std::uint64_t user_data) noexcept;
+  bool TryPushEntry(const Request& request, std::uint64_t user_data) noexcept;
+  // Returns 0 if all the pushed entries are submitted, errno otherwise
+  int SubmitPending() noexcept;
+
+  static void CompletionWatcherCb(struct ev_loop*, ev_io*, int) noexcept;
+  void ReapCompletions() noexcept;
+
+  std::unique_ptr<Ring> ring_;
+  struct ev_loop* loop_;
+  ev_io completion_watcher_{};
+  std::mutex submit_mutex_;
+  std::atomic<EnterFunction> enter_{nullptr};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
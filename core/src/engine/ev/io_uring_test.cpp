@@ -0,0 +1,121 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <build_config.hpp>
+
+#ifdef HAVE_LINUX_IO_URING_H
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <engine/ev/thread_control.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::atomic<int> enter_failures_left{0};
+
+int Enter(int ring_fd, unsigned to_submit) noexcept {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, 0, nullptr, 0));
+}
+
+int FailingEnter(int ring_fd, unsigned to_submit) noexcept {
+  if (enter_failures_left.fetch_sub(1) > 0) {
+    errno = EAGAIN;
+    return -1;
+  }
+  return Enter(ring_fd, to_submit);
+}
+
+class TempFd final {
+ public:
+  TempFd() {
+    std::string path = "/tmp/userver-io-uring-test-XXXXXX";
+    fd_ = ::mkstemp(path.data());
+    if (fd_ != -1) ::unlink(path.c_str());
+  }
+
+  ~TempFd() {
+    if (fd_ != -1) ::close(fd_);
+  }
+
+  int Get() const { return fd_; }
+
+ private:
+  int fd_{-1};
+};
+
+template <typename Func>
+void RunWithIoUring(Func func) {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = true;
+
+  engine::RunStandalone(4, config, [&func] {
+    auto* io_uring = engine::current_task::GetEventThread().GetIoUring();
+    if (!io_uring) {
+      GTEST_SKIP() << "io_uring is not supported by the kernel";
+    }
+
+    io_uring->SetEnterFunctionForTests(&FailingEnter);
+    func(*io_uring);
+    io_uring->SetEnterFunctionForTests(&Enter);
+  });
+}
+
+}  // namespace
+
+TEST(IoUring, EnterFailuresAreRetried) {
+  RunWithIoUring([](engine::ev::IoUring& io_uring) {
+    const TempFd file;
+    ASSERT_NE(file.Get(), -1);
+
+    enter_failures_left = 10;
+    EXPECT_EQ(io_uring.Write(file.Get(), "hello", 5, 0), 5);
+
+    enter_failures_left = 10;
+    std::array<char, 5> buf{};
+    EXPECT_EQ(io_uring.Read(file.Get(), buf.data(), buf.size(), 0), 5);
+    EXPECT_EQ(std::string_view(buf.data(), buf.size()), "hello");
+  });
+}
+
+TEST(IoUring, SubmissionQueueOverflow) {
+  RunWithIoUring([](engine::ev::IoUring& io_uring) {
+    const TempFd file;
+    ASSERT_NE(file.Get(), -1);
+
+    // More operations than the submission queue fits, all of them are pushed
+    // while io_uring_enter() fails
+    constexpr std::size_t kOperations = 3000;
+    enter_failures_left = kOperations;
+
+    std::vector<engine::TaskWithResult<std::int64_t>> tasks;
+    tasks.reserve(kOperations);
+    for (std::size_t i = 0; i < kOperations; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&io_uring, &file, i] {
+        return io_uring.Write(file.Get(), "x", 1, i);
+      }));
+    }
+    for (auto& task : tasks) {
+      EXPECT_EQ(task.Get(), 1);
+    }
+  });
+}
+
+USERVER_NAMESPACE_END
+
+#endif  // HAVE_LINUX_IO_URING_H
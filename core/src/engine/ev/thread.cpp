@@ -1,5 +1,6 @@
 #include "thread.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <stdexcept>
 
@@ -61,20 +62,27 @@ constexpr std::size_t kCpuStatsThrottle{16};
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode, bool use_io_uring,
+               std::chrono::microseconds timer_slack)
+    : Thread(thread_name, false, register_event_mode, use_io_uring,
+             timer_slack) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode, bool use_io_uring,
+               std::chrono::microseconds timer_slack)
+    : Thread(thread_name, true, register_event_mode, use_io_uring,
+             timer_slack) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode, bool use_io_uring,
+               std::chrono::microseconds timer_slack)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
+      use_io_uring_(use_io_uring),
       func_queue_(kInitFuncQueueCapacity),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
+      timer_slack_(timer_slack),
       name_{thread_name},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
       is_running_(false) {
@@ -141,6 +149,28 @@ std::uint8_t Thread::GetCurrentLoadPercent() const {
 
 const std::string& Thread::GetName() const { return name_; }
 
+bool Thread::ScheduleTimer(TimerWheel::Node& node, Deadline deadline) noexcept {
+  UASSERT(IsInEvThread());
+  UASSERT(timer_wheel_);
+  UASSERT(deadline.IsReachable());
+
+  const auto now = Deadline::Clock::now();
+  if (timer_wheel_->GetSize() == 0) {
+    // Keep the wheel close to the current time to place the new timer on the
+    // lowest possible level. No callbacks are called for an empty wheel.
+    timer_wheel_->Advance(GetTimerWheelTick(now, /*round_up=*/false));
+  }
+
+  const auto tick =
+      GetTimerWheelTick(now + deadline.TimeLeft(), /*round_up=*/true);
+  if (!timer_wheel_->Schedule(node, tick)) return false;
+
+  if (!timer_wheel_armed_tick_ || tick < *timer_wheel_armed_tick_) {
+    ArmTimerWheel(tick);
+  }
+  return true;
+}
+
 void Thread::Start() {
   loop_ = use_ev_default_loop_ ? ev_default_loop(EVFLAG_AUTO)
                                : ev_loop_new(EVFLAG_AUTO);
@@ -186,6 +216,15 @@ void Thread::Start() {
     ev_child_start(loop_, &watch_child_);
   }
 
+  if (use_io_uring_) io_uring_ = IoUring::TryCreate(loop_);
+
+  if (timer_slack_.count() > 0) {
+    timer_wheel_ = std::make_unique<TimerWheel>(
+        GetTimerWheelTick(Deadline::Clock::now(), /*round_up=*/false));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    ev_init(&timer_wheel_driver_, TimerWheelWatcher);
+  }
+
   is_running_ = true;
   thread_ = std::thread([this] {
     utils::SetCurrentThreadName(name_);
@@ -201,6 +240,7 @@ void Thread::StopEventLoop() {
     utils::impl::AbortWithStacktrace("Some work was enqueued on a dead Thread");
   }
 
+  io_uring_.reset();
   if (!use_ev_default_loop_) ev_loop_destroy(loop_);
   loop_ = nullptr;
 }
@@ -222,6 +262,8 @@ void Thread::RunEvLoop() {
     ev_timer_stop(loop_, &stats_timer_);
   }
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
+  if (timer_wheel_) ev_timer_stop(loop_, &timer_wheel_driver_);
+  if (io_uring_) io_uring_->Stop();
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -263,6 +305,52 @@ void Thread::BreakLoopWatcherImpl() {
   ev_break(loop_, EVBREAK_ALL);
 }
 
+void Thread::TimerWheelWatcher(struct ev_loop* loop, ev_timer*,
+                               int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  ev_thread->TimerWheelWatcherImpl();
+}
+
+void Thread::TimerWheelWatcherImpl() noexcept {
+  // The callbacks may schedule new timers and re-arm the driver
+  timer_wheel_armed_tick_.reset();
+  timer_wheel_->Advance(
+      GetTimerWheelTick(Deadline::Clock::now(), /*round_up=*/false));
+
+  const auto next_tick = timer_wheel_->GetNextTick();
+  if (next_tick &&
+      (!timer_wheel_armed_tick_ || *next_tick < *timer_wheel_armed_tick_)) {
+    ArmTimerWheel(*next_tick);
+  }
+}
+
+void Thread::ArmTimerWheel(TimerWheel::Tick tick) noexcept {
+  using LibEvDuration = std::chrono::duration<double>;
+  const auto time_left =
+      Deadline::TimePoint{tick * timer_slack_} - Deadline::Clock::now();
+
+  timer_wheel_armed_tick_ = tick;
+  ev_timer_stop(loop_, &timer_wheel_driver_);
+  ev_timer_set(
+      &timer_wheel_driver_,
+      std::max(std::chrono::duration_cast<LibEvDuration>(time_left).count(),
+               0.0),
+      0.0);
+  ev_now_update(loop_);
+  ev_timer_start(loop_, &timer_wheel_driver_);
+}
+
+TimerWheel::Tick Thread::GetTimerWheelTick(Deadline::TimePoint time_point,
+                                           bool round_up) const noexcept {
+  const auto since_epoch = time_point.time_since_epoch();
+  auto tick = static_cast<TimerWheel::Tick>(since_epoch / timer_slack_);
+  if (round_up && since_epoch % timer_slack_ != Deadline::Duration::zero()) {
+    ++tick;
+  }
+  return tick;
+}
+
 void Thread::ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept {
   try {
     ChildWatcherImpl(w);
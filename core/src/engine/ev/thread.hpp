@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -13,6 +15,8 @@
 #include <userver/engine/deadline.hpp>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,14 +39,22 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  // Zero `timer_slack` disables the timer wheel
+  Thread(const std::string& thread_name, RegisterEventMode,
+         bool use_io_uring = false,
+         std::chrono::microseconds timer_slack = {});
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         bool use_io_uring = false,
+         std::chrono::microseconds timer_slack = {});
   ~Thread();
 
   struct ev_loop* GetEvLoop() const {
     return loop_;
   }
 
+  // nullptr if io_uring was not requested or is not supported
+  IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
   // Callbacks passed to RunInEvLoopAsync() are serialized.
   // All successfully registered callbacks are guaranteed to execute.
   void RunInEvLoopAsync(OnAsyncPayload* func, AsyncPayloadPtr&& data);
@@ -55,12 +67,20 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  bool HasTimerWheel() const noexcept { return timer_wheel_ != nullptr; }
+
+  // Schedules the `node` to fire not earlier than `deadline` and not later
+  // than the timer slack after it. Returns false if the deadline has passed.
+  // Must be called in the ev thread.
+  bool ScheduleTimer(TimerWheel::Node& node, Deadline deadline) noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode, bool use_io_uring,
+         std::chrono::microseconds timer_slack);
 
   void RegisterInEvLoop(OnAsyncPayload* func, AsyncPayloadPtr&& data);
 
@@ -74,6 +94,11 @@ class Thread final {
   void UpdateLoopWatcherImpl();
   static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   void BreakLoopWatcherImpl();
+  static void TimerWheelWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
+  void TimerWheelWatcherImpl() noexcept;
+  void ArmTimerWheel(TimerWheel::Tick tick) noexcept;
+  TimerWheel::Tick GetTimerWheelTick(Deadline::TimePoint time_point,
+                                     bool round_up) const noexcept;
   static void ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept;
   static void ChildWatcherImpl(ev_child* w);
 
@@ -84,6 +109,7 @@ class Thread final {
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
+  bool use_io_uring_;
 
   struct QueueData {
     OnAsyncPayload* func;
@@ -102,6 +128,13 @@ class Thread final {
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
+  std::unique_ptr<IoUring> io_uring_;
+
+  // A single libev timer drives all the timers of the wheel
+  const std::chrono::microseconds timer_slack_;
+  std::unique_ptr<TimerWheel> timer_wheel_;
+  ev_timer timer_wheel_driver_{};
+  std::optional<TimerWheel::Tick> timer_wheel_armed_tick_;
 
   const std::string name_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
@@ -60,6 +60,17 @@ void ThreadControl::Stop(ev_io& w) noexcept {
   ev_io_stop(GetEvLoop(), &w);
 }
 
+bool ThreadControl::HasTimerWheel() const noexcept {
+  return thread_.HasTimerWheel();
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+bool ThreadControl::ScheduleTimer(TimerWheel::Node& node,
+                                  Deadline deadline) noexcept {
+  UASSERT(IsInEvThread());
+  return thread_.ScheduleTimer(node, deadline);
+}
+
 void ThreadControl::RunInEvLoopAsync(OnAsyncPayload* func,
                                      AsyncPayloadPtr&& data) {
   thread_.RunInEvLoopAsync(func, std::move(data));
@@ -75,6 +86,10 @@ bool ThreadControl::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUring* ThreadControl::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
 std::uint8_t ThreadControl::GetCurrentLoadPercent() const {
   return thread_.GetCurrentLoadPercent();
 }
@@ -8,6 +8,7 @@
 #include <ev.h>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/single_use_event.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 
@@ -98,6 +99,7 @@ class CallerOwnedPayloadBlocking final : public AsyncPayloadBase {
 }  // namespace impl
 
 class Thread;
+class IoUring;
 
 class ThreadControl final {
  public:
@@ -116,6 +118,14 @@ class ThreadControl final {
   void Start(ev_io& w) noexcept;
   void Stop(ev_io& w) noexcept;
 
+  /// true if the thread coalesces timers in a TimerWheel
+  bool HasTimerWheel() const noexcept;
+
+  /// Schedules the `node` in the TimerWheel of the thread, returns false if
+  /// the `deadline` has passed. Cancel with TimerWheel::Node::Cancel() in the
+  /// ev thread.
+  bool ScheduleTimer(TimerWheel::Node& node, Deadline deadline) noexcept;
+
   /// Fast non allocating function to execute a `func(*data)` in EvLoop
   void RunInEvLoopAsync(OnAsyncPayload* func, AsyncPayloadPtr&& data);
 
@@ -147,6 +157,9 @@ class ThreadControl final {
 
   bool IsInEvThread() const noexcept;
 
+  /// nullptr if io_uring backend is disabled or not supported
+  IoUring* GetIoUring() const noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
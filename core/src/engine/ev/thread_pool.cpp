@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 
 #include <userver/utils/assert.hpp>
+#include <utils/numa.hpp>
 
 #include "thread.hpp"
 #include "thread_control.hpp"
@@ -35,13 +36,29 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
     const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
     return (use_ev_default_loop && index == 0)
                ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                        register_timer_event_mode)
-               : Thread(thread_name, register_timer_event_mode);
+                        register_timer_event_mode, config.use_io_uring,
+                        config.timer_slack)
+               : Thread(thread_name, register_timer_event_mode,
+                        config.use_io_uring, config.timer_slack);
   });
 
   thread_controls_ = utils::GenerateFixedArray(
       threads_.size(),
       [&](std::size_t index) { return ThreadControl(threads_[index]); });
+
+  const auto nodes_count = utils::numa::GetNodesCount();
+  if (config.numa_aware && nodes_count > 1) {
+    // Spread the threads over the nodes, so that each node has its own ev
+    // threads and the timers and sockets of the node-local task processors
+    // are served without cross-node traffic
+    node_thread_controls_.resize(nodes_count);
+    for (std::size_t i = 0; i < thread_controls_.size(); ++i) {
+      const auto node = i % nodes_count;
+      thread_controls_[i].RunInEvLoopBlocking(
+          [node] { utils::numa::BindCurrentThreadToNode(node); });
+      node_thread_controls_[node].push_back(&thread_controls_[i]);
+    }
+  }
 }
 
 ThreadPool::~ThreadPool() = default;
@@ -54,6 +71,16 @@ ThreadControl& ThreadPool::NextThread() {
   return thread_controls_[next_thread_idx_++ % thread_controls_.size()];
 }
 
+ThreadControl& ThreadPool::NextThread(std::size_t numa_node) {
+  if (numa_node >= node_thread_controls_.size() ||
+      node_thread_controls_[numa_node].empty()) {
+    return NextThread();
+  }
+  const auto& node_threads = node_thread_controls_[numa_node];
+  // just ignore counter_ overflow
+  return *node_threads[next_thread_idx_++ % node_threads.size()];
+}
+
 std::vector<ThreadControl*> ThreadPool::NextThreads(std::size_t count) {
   std::vector<ThreadControl*> res;
   if (!count) return res;
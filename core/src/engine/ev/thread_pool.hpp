@@ -27,6 +27,10 @@ class ThreadPool final {
 
   ThreadControl& NextThread();
 
+  /// Next thread running on the `numa_node` if the pool is NUMA aware, any
+  /// thread otherwise
+  ThreadControl& NextThread(std::size_t numa_node);
+
   std::vector<ThreadControl*> NextThreads(std::size_t count);
 
   ThreadControl& GetEvDefaultLoopThread();
@@ -37,6 +41,7 @@ class ThreadPool final {
   bool use_ev_default_loop_;
   utils::FixedArray<Thread> threads_;
   utils::FixedArray<ThreadControl> thread_controls_;
+  std::vector<std::vector<ThreadControl*>> node_thread_controls_;
   std::atomic<std::size_t> next_thread_idx_{0};
 };
 
@@ -1,15 +1,59 @@
 #include "thread_pool_config.hpp"
 
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include <userver/utils/string_to_duration.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+namespace {
+
+constexpr std::string_view kMicrosecondsSuffix = "us";
+
+// A duration string that also accepts microseconds, the slack is usually
+// below a millisecond
+std::chrono::microseconds ParseTimerSlack(
+    const yaml_config::YamlConfig& value) {
+  if (value.IsMissing()) return std::chrono::microseconds{0};
+
+  const auto as_string = value.As<std::string>();
+  const std::string_view view{as_string};
+  try {
+    if (view.size() <= kMicrosecondsSuffix.size() ||
+        view.substr(view.size() - kMicrosecondsSuffix.size()) !=
+            kMicrosecondsSuffix) {
+      return utils::StringToDuration(as_string);
+    }
+
+    std::size_t parsed_size = 0;
+    const auto count = std::stoll(as_string, &parsed_size, 10);
+    if (count < 0 || parsed_size + kMicrosecondsSuffix.size() != view.size()) {
+      throw std::invalid_argument("'" + as_string +
+                                  "' is not a valid duration");
+    }
+    return std::chrono::microseconds{count};
+  } catch (const std::exception& ex) {
+    throw yaml_config::ParseException(
+        fmt::format("While parsing '{}': {}", value.GetPath(), ex.what()));
+  }
+}
+
+}  // namespace
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
   config.threads = value["threads"].As<size_t>(config.threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.use_io_uring = value["io_uring"].As<bool>(config.use_io_uring);
+  config.numa_aware = value["numa_aware"].As<bool>(config.numa_aware);
+  config.timer_slack = ParseTimerSlack(value["timer_slack"]);
   return config;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include <userver/formats/yaml.hpp>
@@ -14,6 +15,11 @@ struct ThreadPoolConfig {
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  bool use_io_uring = false;
+  bool numa_aware = false;
+  // timers are coalesced in a timing wheel with this precision, 0 disables
+  // the wheel
+  std::chrono::microseconds timer_slack{0};
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
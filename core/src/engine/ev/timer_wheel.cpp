@@ -0,0 +1,175 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+namespace {
+
+constexpr TimerWheel::Tick kSlotMask = TimerWheel::kSlots - 1;
+
+constexpr std::size_t Shift(std::size_t level) noexcept {
+  return TimerWheel::kSlotBits * level;
+}
+
+// Farthest timer representable by the wheel, farther timers are kept in the
+// last slot and reinserted on cascade
+constexpr TimerWheel::Tick kMaxDelta =
+    (TimerWheel::Tick{1} << Shift(TimerWheel::kLevels)) - 1;
+
+}  // namespace
+
+void TimerWheel::Node::Cancel() noexcept {
+  if (!hook_.is_linked()) return;
+  hook_.unlink();
+  UASSERT(wheel_ && wheel_->size_ > 0);
+  --wheel_->size_;
+}
+
+TimerWheel::TimerWheel(Tick current_tick) noexcept
+    : current_tick_(current_tick) {}
+
+TimerWheel::~TimerWheel() {
+  for (auto& level : levels_) {
+    for (auto& slot : level) slot.clear();
+  }
+}
+
+bool TimerWheel::Schedule(Node& node, Tick expiry) noexcept {
+  node.Cancel();
+  if (expiry <= current_tick_) return false;
+
+  node.wheel_ = this;
+  node.expiry_ = expiry;
+  Insert(node);
+  ++size_;
+  return true;
+}
+
+void TimerWheel::Advance(Tick now) noexcept {
+  while (current_tick_ < now) {
+    // Skip the ticks without timers and cascades
+    const auto next = GetNextTick();
+    if (!next || *next > now) {
+      current_tick_ = now;
+      return;
+    }
+
+    current_tick_ = *next;
+    const auto index = current_tick_ & kSlotMask;
+    if (index == 0) Cascade(1);
+    Fire(index);
+  }
+}
+
+std::optional<TimerWheel::Tick> TimerWheel::GetNextTick() const noexcept {
+  if (size_ == 0) return std::nullopt;
+
+  std::optional<Tick> next;
+  if (const auto offset =
+          FindOccupied(0, (current_tick_ + 1) & kSlotMask, kSlots - 1)) {
+    next = current_tick_ + 1 + *offset;
+  }
+
+  // Timers of the upper levels are moved down when the lower level completes
+  // a rotation, the slot of the current rotation comes the last
+  for (std::size_t level = 1; level < kLevels; ++level) {
+    const auto rotation = current_tick_ >> Shift(level);
+    const auto offset =
+        FindOccupied(level, (rotation + 1) & kSlotMask, kSlots);
+    if (!offset) continue;
+
+    const auto cascade_tick = (rotation + 1 + *offset) << Shift(level);
+    if (!next || cascade_tick < *next) next = cascade_tick;
+  }
+
+  UASSERT(next);
+  return next;
+}
+
+std::optional<std::size_t> TimerWheel::FindOccupied(
+    std::size_t level, std::size_t first, std::size_t count) const noexcept {
+  std::size_t offset = 0;
+  while (offset < count) {
+    const auto index = (first + offset) & kSlotMask;
+    const auto bits = occupied_[level][index / 64] >> (index % 64);
+    if (bits == 0) {
+      offset += 64 - index % 64;
+      continue;
+    }
+
+    offset += __builtin_ctzll(bits);
+    if (offset >= count) break;
+
+    const auto occupied_index = (first + offset) & kSlotMask;
+    if (!levels_[level][occupied_index].empty()) return offset;
+    // The timers of the slot were cancelled
+    ClearOccupied(level, occupied_index);
+    ++offset;
+  }
+  return std::nullopt;
+}
+
+void TimerWheel::SetOccupied(std::size_t level, std::size_t index) noexcept {
+  occupied_[level][index / 64] |= std::uint64_t{1} << (index % 64);
+}
+
+void TimerWheel::ClearOccupied(std::size_t level,
+                               std::size_t index) const noexcept {
+  occupied_[level][index / 64] &= ~(std::uint64_t{1} << (index % 64));
+}
+
+void TimerWheel::Insert(Node& node) noexcept {
+  UASSERT(node.expiry_ >= current_tick_);
+  const auto delta = node.expiry_ - current_tick_;
+
+  for (std::size_t level = 0; level < kLevels - 1; ++level) {
+    if (delta < (Tick{1} << Shift(level + 1))) {
+      const auto index = (node.expiry_ >> Shift(level)) & kSlotMask;
+      levels_[level][index].push_back(node);
+      SetOccupied(level, index);
+      return;
+    }
+  }
+
+  const auto expiry =
+      delta > kMaxDelta ? current_tick_ + kMaxDelta : node.expiry_;
+  const auto index = (expiry >> Shift(kLevels - 1)) & kSlotMask;
+  levels_[kLevels - 1][index].push_back(node);
+  SetOccupied(kLevels - 1, index);
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  UASSERT(level > 0 && level < kLevels);
+  const auto index = (current_tick_ >> Shift(level)) & kSlotMask;
+  if (index == 0 && level + 1 < kLevels) Cascade(level + 1);
+
+  List timers;
+  timers.swap(levels_[level][index]);
+  ClearOccupied(level, index);
+  while (!timers.empty()) {
+    auto& node = timers.front();
+    timers.pop_front();
+    Insert(node);
+  }
+}
+
+void TimerWheel::Fire(std::size_t index) noexcept {
+  auto& slot = levels_[0][index];
+  ClearOccupied(0, index);
+  while (!slot.empty()) {
+    auto& node = slot.front();
+    slot.pop_front();
+    --size_;
+    UASSERT(node.expiry_ <= current_tick_);
+    // The callback may schedule, cancel or destroy any timer, including this
+    // one
+    node.callback_(node);
+  }
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <boost/intrusive/list.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Hierarchical timing wheel.
+///
+/// Coalesces timers into ticks: scheduling and cancellation are O(1), expired
+/// timers are found without a heap. The wheel does not know the time, the
+/// owner advances it and converts the time points into ticks. A tick never
+/// fires early.
+///
+/// Not thread-safe, in ev::Thread it is used from the ev thread only.
+class TimerWheel final {
+ public:
+  using Tick = std::uint64_t;
+
+  class Node final {
+   public:
+    /// Called in TimerWheel::Advance() when the timer expires
+    using Callback = void (*)(Node&) noexcept;
+
+    Node(Callback callback, void* data) noexcept
+        : callback_(callback), data_(data) {}
+
+    Node(const Node&) = delete;
+    Node& operator=(const Node&) = delete;
+
+    ~Node() { Cancel(); }
+
+    bool IsScheduled() const noexcept { return hook_.is_linked(); }
+
+    /// Removes the timer from the wheel in O(1), no-op if not scheduled
+    void Cancel() noexcept;
+
+    void* GetData() const noexcept { return data_; }
+
+   private:
+    friend class TimerWheel;
+
+    boost::intrusive::list_member_hook<
+        boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
+        hook_;
+    TimerWheel* wheel_{nullptr};
+    Tick expiry_{0};
+    const Callback callback_;
+    void* const data_;
+  };
+
+  static constexpr std::size_t kLevels = 4;
+  static constexpr std::size_t kSlotBits = 8;
+  static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+
+  explicit TimerWheel(Tick current_tick) noexcept;
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  ~TimerWheel();
+
+  /// @brief Schedules the `node` to fire at `expiry`, reschedules it if it
+  /// is already scheduled.
+  /// @returns false if `expiry` has already passed, the node is not scheduled
+  /// and the caller should handle the expiration itself.
+  bool Schedule(Node& node, Tick expiry) noexcept;
+
+  /// Fires all the timers that expire not later than `now`
+  void Advance(Tick now) noexcept;
+
+  /// @returns The nearest tick at which Advance() has work to do, e.g. the
+  /// tick of the earliest timer or a cascade of the upper levels.
+  /// std::nullopt if there are no timers.
+  std::optional<Tick> GetNextTick() const noexcept;
+
+  Tick GetCurrentTick() const noexcept { return current_tick_; }
+
+  std::size_t GetSize() const noexcept { return size_; }
+
+ private:
+  using List = boost::intrusive::list<
+      Node,
+      boost::intrusive::member_hook<Node, decltype(Node::hook_), &Node::hook_>,
+      boost::intrusive::constant_time_size<false>>;
+
+  // Bit per slot, set when a timer is inserted into the slot. Node::Cancel()
+  // does not clear it, the bits of the emptied slots are cleared lazily.
+  using Occupancy = std::array<std::uint64_t, kSlots / 64>;
+
+  void Insert(Node& node) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  void Fire(std::size_t index) noexcept;
+
+  /// @returns the offset of the first non-empty slot of the `level` among
+  /// `count` slots starting from `first`, wrapping around
+  std::optional<std::size_t> FindOccupied(std::size_t level, std::size_t first,
+                                          std::size_t count) const noexcept;
+
+  void SetOccupied(std::size_t level, std::size_t index) noexcept;
+  void ClearOccupied(std::size_t level, std::size_t index) const noexcept;
+
+  std::array<std::array<List, kSlots>, kLevels> levels_;
+  mutable std::array<Occupancy, kLevels> occupied_{};
+  Tick current_tick_;
+  std::size_t size_{0};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
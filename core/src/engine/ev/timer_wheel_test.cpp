@@ -0,0 +1,145 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <deque>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Tick = engine::ev::TimerWheel::Tick;
+
+struct Timer {
+  Timer() : node(&OnTimer, this) {}
+
+  static void OnTimer(engine::ev::TimerWheel::Node& node) noexcept {
+    auto& self = *static_cast<Timer*>(node.GetData());
+    self.fired_at.push_back(self.wheel->GetCurrentTick());
+  }
+
+  engine::ev::TimerWheel* wheel{nullptr};
+  std::vector<Tick> fired_at;
+  engine::ev::TimerWheel::Node node;
+};
+
+}  // namespace
+
+TEST(TimerWheel, FiresOnTime) {
+  engine::ev::TimerWheel wheel{100};
+  std::deque<Timer> timers(5);
+  const std::vector<Tick> expiries{101, 356, 1000, 70'000, 20'000'000};
+  for (std::size_t i = 0; i < timers.size(); ++i) {
+    timers[i].wheel = &wheel;
+    EXPECT_TRUE(wheel.Schedule(timers[i].node, expiries[i]));
+  }
+  EXPECT_EQ(wheel.GetSize(), timers.size());
+  EXPECT_EQ(wheel.GetNextTick(), Tick{101});
+
+  // Stepping by the next tick never skips a timer
+  while (auto next = wheel.GetNextTick()) {
+    EXPECT_GT(*next, wheel.GetCurrentTick());
+    wheel.Advance(*next);
+  }
+
+  for (std::size_t i = 0; i < timers.size(); ++i) {
+    EXPECT_EQ(timers[i].fired_at, std::vector<Tick>{expiries[i]}) << i;
+  }
+  EXPECT_EQ(wheel.GetSize(), 0u);
+}
+
+TEST(TimerWheel, PastExpiry) {
+  engine::ev::TimerWheel wheel{100};
+  Timer timer;
+  EXPECT_FALSE(wheel.Schedule(timer.node, 100));
+  EXPECT_FALSE(wheel.Schedule(timer.node, 50));
+  EXPECT_FALSE(timer.node.IsScheduled());
+  EXPECT_EQ(wheel.GetNextTick(), std::nullopt);
+}
+
+TEST(TimerWheel, CancelAndReschedule) {
+  engine::ev::TimerWheel wheel{0};
+  Timer timer;
+  timer.wheel = &wheel;
+
+  ASSERT_TRUE(wheel.Schedule(timer.node, 10));
+  timer.node.Cancel();
+  EXPECT_FALSE(timer.node.IsScheduled());
+  EXPECT_EQ(wheel.GetSize(), 0u);
+
+  ASSERT_TRUE(wheel.Schedule(timer.node, 1000));
+  ASSERT_TRUE(wheel.Schedule(timer.node, 20));
+  EXPECT_EQ(wheel.GetSize(), 1u);
+  wheel.Advance(5000);
+  EXPECT_EQ(timer.fired_at, std::vector<Tick>{20});
+
+  {
+    Timer destroyed;
+    ASSERT_TRUE(wheel.Schedule(destroyed.node, 6000));
+  }
+  EXPECT_EQ(wheel.GetSize(), 0u);
+}
+
+TEST(TimerWheel, JumpsWhenEmpty) {
+  engine::ev::TimerWheel wheel{0};
+  wheel.Advance(1'000'000'000'000);
+  EXPECT_EQ(wheel.GetCurrentTick(), Tick{1'000'000'000'000});
+}
+
+TEST(TimerWheel, FarTimers) {
+  engine::ev::TimerWheel wheel{7};
+  Timer timer;
+  timer.wheel = &wheel;
+  const Tick expiry = (Tick{1} << 33) + 12345;
+  ASSERT_TRUE(wheel.Schedule(timer.node, expiry));
+
+  while (auto next = wheel.GetNextTick()) wheel.Advance(*next);
+  EXPECT_EQ(timer.fired_at, std::vector<Tick>{expiry});
+}
+
+TEST(TimerWheel, Randomized) {
+  std::minstd_rand rng{42};
+  engine::ev::TimerWheel wheel{0};
+  std::deque<Timer> timers(1000);
+  std::map<Timer*, Tick> expected;
+
+  for (auto& timer : timers) timer.wheel = &wheel;
+
+  Tick now = 0;
+  for (int step = 0; step < 20000; ++step) {
+    auto& timer = timers[rng() % timers.size()];
+    switch (rng() % 3) {
+      case 0: {
+        const Tick delta = 1 + rng() % (1 << (rng() % 20));
+        ASSERT_TRUE(wheel.Schedule(timer.node, now + delta));
+        timer.fired_at.clear();
+        expected[&timer] = now + delta;
+        break;
+      }
+      case 1:
+        timer.node.Cancel();
+        expected.erase(&timer);
+        break;
+      case 2:
+        now += rng() % 64;
+        wheel.Advance(now);
+        for (auto it = expected.begin(); it != expected.end();) {
+          if (it->second <= now) {
+            ASSERT_EQ(it->first->fired_at, std::vector<Tick>{it->second});
+            it->first->fired_at.clear();
+            it = expected.erase(it);
+          } else {
+            ASSERT_TRUE(it->first->fired_at.empty());
+            ++it;
+          }
+        }
+        break;
+    }
+    ASSERT_EQ(wheel.GetSize(), expected.size());
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// Hints the CPU that the current thread busy waits
+inline void CpuPause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/// @brief Self-tuning limit of busy waiting before parking a coroutine or a
+/// thread.
+///
+/// Spinning pays off when the critical section is shorter than a context
+/// switch. The limit follows the number of iterations that were actually
+/// needed to acquire the primitive (as in glibc PTHREAD_MUTEX_ADAPTIVE_NP),
+/// and decays when spinning does not help, e.g. when the owner does not run.
+///
+/// The limit is kept low, a longer wait is cheaper to spend parked.
+class AdaptiveSpinLimit final {
+ public:
+  static constexpr std::uint32_t kMaxSpins = 100;
+
+  /// Iterations tried even when the limit decayed to zero, to notice that
+  /// spinning helps again
+  static constexpr std::uint32_t kProbeSpins = 4;
+
+  /// @brief Busy waits until `try_acquire()` returns true or the spin limit is
+  /// exhausted.
+  /// @returns true if acquired, false if the caller should park.
+  template <typename TryAcquire>
+  bool Spin(TryAcquire try_acquire) noexcept {
+    return Spin(try_acquire, [] { return false; });
+  }
+
+  /// @brief Same as Spin(try_acquire), but also gives up as soon as
+  /// `should_stop()` returns true, e.g. when the wait deadline is reached.
+  /// Stopping does not affect the limit.
+  template <typename TryAcquire, typename ShouldStop>
+  bool Spin(TryAcquire try_acquire, ShouldStop should_stop) noexcept;
+
+  std::uint32_t GetLimit() const noexcept {
+    return limit_.load(std::memory_order_relaxed);
+  }
+
+  /// @returns true if other threads may release a primitive while we spin
+  static bool IsSpinningUseful() noexcept {
+    static const bool kMultiCore = std::thread::hardware_concurrency() > 1;
+    return kMultiCore;
+  }
+
+ private:
+  // Races between the concurrent updates are benign, the limit is a hint
+  std::atomic<std::uint32_t> limit_{kProbeSpins};
+};
+
+template <typename TryAcquire, typename ShouldStop>
+bool AdaptiveSpinLimit::Spin(TryAcquire try_acquire,
+                             ShouldStop should_stop) noexcept {
+  const auto limit = limit_.load(std::memory_order_relaxed);
+  const auto max_spins = std::min(kMaxSpins, limit * 2 + kProbeSpins);
+
+  for (std::uint32_t spins = 1; spins <= max_spins; ++spins) {
+    if (should_stop()) return false;
+    CpuPause();
+    if (try_acquire()) {
+      // Move towards the used amount, with some headroom
+      const std::int64_t target = std::min(kMaxSpins, spins * 2);
+      const std::int64_t current = limit;
+      limit_.store(static_cast<std::uint32_t>(current + (target - current) / 8),
+                   std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  // The time was wasted, spin less next time
+  limit_.store(limit - (limit + 7) / 8, std::memory_order_relaxed);
+  return false;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
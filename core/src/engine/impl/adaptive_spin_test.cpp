@@ -0,0 +1,122 @@
+#include <engine/impl/adaptive_spin.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <engine/impl/mutex_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using engine::impl::AdaptiveSpinLimit;
+
+TEST(AdaptiveSpinLimit, ShrinksOnFailures) {
+  AdaptiveSpinLimit spin;
+  std::size_t attempts = 0;
+  EXPECT_FALSE(spin.Spin([&attempts] {
+    ++attempts;
+    return false;
+  }));
+  EXPECT_EQ(attempts, AdaptiveSpinLimit::kProbeSpins * 3);
+  EXPECT_LT(spin.GetLimit(), AdaptiveSpinLimit::kProbeSpins);
+
+  for (int i = 0; i < 100; ++i) {
+    spin.Spin([] { return false; });
+  }
+  EXPECT_EQ(spin.GetLimit(), 0u);
+
+  // Still probes a few iterations
+  attempts = 0;
+  EXPECT_FALSE(spin.Spin([&attempts] {
+    ++attempts;
+    return false;
+  }));
+  EXPECT_EQ(attempts, AdaptiveSpinLimit::kProbeSpins);
+}
+
+TEST(AdaptiveSpinLimit, GrowsWhenSpinningHelps) {
+  AdaptiveSpinLimit spin;
+  // The primitive is released right before the limit is exhausted
+  for (int i = 0; i < 200; ++i) {
+    const auto max_spins =
+        std::min(AdaptiveSpinLimit::kMaxSpins,
+                 spin.GetLimit() * 2 + AdaptiveSpinLimit::kProbeSpins);
+    std::uint32_t attempts = 0;
+    EXPECT_TRUE(spin.Spin([&] { return ++attempts == max_spins; }));
+  }
+  EXPECT_GT(spin.GetLimit(), AdaptiveSpinLimit::kMaxSpins / 2);
+  EXPECT_LE(spin.GetLimit(), AdaptiveSpinLimit::kMaxSpins);
+}
+
+TEST(AdaptiveSpinLimit, StopsOnRequest) {
+  AdaptiveSpinLimit spin;
+  const auto limit = spin.GetLimit();
+  std::size_t attempts = 0;
+  EXPECT_FALSE(spin.Spin(
+      [&attempts] {
+        ++attempts;
+        return false;
+      },
+      [&attempts] { return attempts == 2; }));
+  EXPECT_EQ(attempts, 2u);
+  EXPECT_EQ(spin.GetLimit(), limit);
+}
+
+UTEST(MutexImpl, NoSpinningOnSingleThread) {
+  engine::impl::MutexImpl<engine::impl::WaitList> mutex;
+  mutex.lock();
+  auto task = engine::AsyncNoSpan([&mutex] {
+    mutex.lock();
+    mutex.unlock();
+  });
+  engine::Yield();
+  mutex.unlock();
+  task.Get();
+
+  // Did not spin, so the limit did not decay
+  EXPECT_EQ(mutex.GetSpinLimit(), AdaptiveSpinLimit::kProbeSpins);
+}
+
+UTEST_MT(MutexImpl, ParksAfterSpinning, 2) {
+  engine::impl::MutexImpl<engine::impl::WaitList> mutex;
+  engine::SingleConsumerEvent locked;
+  auto owner = engine::AsyncNoSpan([&] {
+    mutex.lock();
+    locked.Send();
+    engine::SleepFor(std::chrono::milliseconds{50});
+    mutex.unlock();
+  });
+
+  ASSERT_TRUE(locked.WaitForEvent());
+  mutex.lock();
+  mutex.unlock();
+  owner.Get();
+
+  EXPECT_LT(mutex.GetSpinLimit(), AdaptiveSpinLimit::kProbeSpins);
+}
+
+UTEST_MT(MutexImpl, NoSpinningPastDeadline, 2) {
+  engine::impl::MutexImpl<engine::impl::WaitList> mutex;
+  engine::SingleConsumerEvent locked;
+  engine::SingleConsumerEvent checked;
+  auto owner = engine::AsyncNoSpan([&] {
+    mutex.lock();
+    locked.Send();
+    [[maybe_unused]] const bool ok = checked.WaitForEvent();
+    mutex.unlock();
+  });
+
+  ASSERT_TRUE(locked.WaitForEvent());
+  EXPECT_FALSE(mutex.try_lock_until(engine::Deadline::Passed()));
+  checked.Send();
+  owner.Get();
+
+  EXPECT_EQ(mutex.GetSpinLimit(), AdaptiveSpinLimit::kProbeSpins);
+}
+
+USERVER_NAMESPACE_END
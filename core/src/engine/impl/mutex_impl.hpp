@@ -6,9 +6,11 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -33,13 +35,19 @@ class MutexImpl {
 
   bool try_lock_until(Deadline deadline);
 
+  std::uint32_t GetSpinLimit() const noexcept {
+    return spin_limit_.GetLimit();
+  }
+
  private:
   class MutexWaitStrategy;
 
   bool LockFastPath(TaskContext&);
+  bool LockSpinning(TaskContext&, Deadline);
   bool LockSlowPath(TaskContext&, Deadline);
 
   std::atomic<TaskContext*> owner_;
+  AdaptiveSpinLimit spin_limit_;
   Waiters lock_waiters_;
 };
 
@@ -105,8 +113,26 @@ bool MutexImpl<Waiters>::LockFastPath(TaskContext& current) {
                                         std::memory_order_acquire);
 }
 
+template <class Waiters>
+bool MutexImpl<Waiters>::LockSpinning(TaskContext& current,
+                                      Deadline deadline) {
+  // The owner may release the mutex only if it runs on another thread
+  if (!AdaptiveSpinLimit::IsSpinningUseful() ||
+      current.GetTaskProcessor().GetWorkerCount() < 2) {
+    return false;
+  }
+
+  return spin_limit_.Spin(
+      [this, &current] {
+        return !owner_.load(std::memory_order_relaxed) && LockFastPath(current);
+      },
+      [&deadline] { return deadline.IsReached(); });
+}
+
 template <class Waiters>
 bool MutexImpl<Waiters>::LockSlowPath(TaskContext& current, Deadline deadline) {
+  if (LockSpinning(current, deadline)) return true;
+
   TaskContext* expected = nullptr;
 
   const engine::TaskCancellationBlocker block_cancels;
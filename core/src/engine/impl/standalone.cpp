@@ -6,6 +6,8 @@
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_processor_pools.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <userver/tracing/span.hpp>
 
@@ -25,6 +27,8 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
   ev_config.thread_name = pools_config.ev_thread_name;
   ev_config.ev_default_loop_disabled = pools_config.ev_default_loop_disabled;
   ev_config.defer_events = pools_config.defer_events;
+  ev_config.use_io_uring = pools_config.use_io_uring;
+  ev_config.timer_slack = pools_config.ev_timer_slack;
 
   return std::make_shared<TaskProcessorPools>(std::move(coro_config),
                                               std::move(ev_config));
@@ -32,10 +36,11 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 TaskProcessorHolder TaskProcessorHolder::Make(
     std::size_t threads_num, std::string thread_name,
-    std::shared_ptr<TaskProcessorPools> pools) {
+    std::shared_ptr<TaskProcessorPools> pools, TaskQueueType task_queue_type) {
   TaskProcessorConfig config;
   config.worker_threads = threads_num;
   config.thread_name = std::move(thread_name);
+  config.task_processor_queue = task_queue_type;
 
   return TaskProcessorHolder(
       std::make_unique<TaskProcessor>(std::move(config), std::move(pools)));
@@ -57,6 +62,27 @@ void RunOnTaskProcessorSync(TaskProcessor& tp, std::function<void()> user_cb) {
   task.Get();
 }
 
+void RunStandalone(std::size_t worker_threads,
+                   const TaskProcessorPoolsConfig& config,
+                   TaskQueueType task_queue_type,
+                   std::function<void()> payload) {
+  UINVARIANT(!engine::current_task::GetTaskProcessorOptional(),
+             "RunStandalone must not be used alongside a running engine");
+  UINVARIANT(worker_threads != 0, "Unable to run anything using 0 threads");
+
+  auto task_processor_holder = TaskProcessorHolder::Make(
+      worker_threads, "coro-runner", MakeTaskProcessorPools(config),
+      task_queue_type);
+
+  RunOnTaskProcessorSync(*task_processor_holder, std::move(payload));
+}
+
+void RunStandalone(std::size_t worker_threads, TaskQueueType task_queue_type,
+                   std::function<void()> payload) {
+  RunStandalone(worker_threads, TaskProcessorPoolsConfig{}, task_queue_type,
+                std::move(payload));
+}
+
 }  // namespace engine::impl
 
 USERVER_NAMESPACE_END
@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include <engine/task/task_processor_config.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/not_null.hpp>
@@ -29,9 +30,10 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 class TaskProcessorHolder final {
  public:
-  static TaskProcessorHolder Make(std::size_t threads_num,
-                                  std::string thread_name,
-                                  std::shared_ptr<TaskProcessorPools> pools);
+  static TaskProcessorHolder Make(
+      std::size_t threads_num, std::string thread_name,
+      std::shared_ptr<TaskProcessorPools> pools,
+      TaskQueueType task_queue_type = TaskQueueType::kGlobalTaskQueue);
 
   explicit TaskProcessorHolder(std::unique_ptr<TaskProcessor>&&);
 
@@ -48,6 +50,16 @@ class TaskProcessorHolder final {
 
 void RunOnTaskProcessorSync(TaskProcessor& tp, std::function<void()> user_cb);
 
+/// Same as engine::RunStandalone, but allows choosing the task queue type
+void RunStandalone(std::size_t worker_threads,
+                   const TaskProcessorPoolsConfig& config,
+                   TaskQueueType task_queue_type,
+                   std::function<void()> payload);
+
+/// @overload
+void RunStandalone(std::size_t worker_threads, TaskQueueType task_queue_type,
+                   std::function<void()> payload);
+
 }  // namespace engine::impl
 
 USERVER_NAMESPACE_END
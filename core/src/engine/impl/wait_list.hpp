@@ -7,6 +7,8 @@
 
 #include <userver/utils/fast_pimpl.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
@@ -18,14 +20,26 @@ class WaitList final {
  public:
   class Lock final {
    public:
-    explicit Lock(WaitList& list) noexcept : impl_(list.mutex_) {}
+    explicit Lock(WaitList& list) noexcept
+        : list_(list), impl_(list.mutex_, std::defer_lock) {
+      lock();
+    }
 
     explicit operator bool() noexcept { return !!impl_; }
 
-    void lock() { impl_.lock(); }
+    // Critical sections are short, spinning is cheaper than a futex wait
+    void lock() {
+      if (impl_.try_lock()) return;
+      if (AdaptiveSpinLimit::IsSpinningUseful() &&
+          list_.spin_limit_.Spin([this] { return impl_.try_lock(); })) {
+        return;
+      }
+      impl_.lock();
+    }
     void unlock() { impl_.unlock(); }
 
    private:
+    WaitList& list_;
     std::unique_lock<std::mutex> impl_;
   };
 
@@ -72,8 +86,15 @@ class WaitList final {
   /// @returns 0 if there are definitely no waiters currently, non-0 otherwise
   std::size_t GetCountOfSleepies() const noexcept { return sleepies_.load(); }
 
+  /// @brief Get the current self-tuned limit of spinning on the internal lock
+  std::uint32_t GetSpinLimit() const noexcept {
+    return spin_limit_.GetLimit();
+  }
+
  private:
-  std::atomic<std::size_t> sleepies_{0};
+  // Both fit into the size of the former std::size_t counter
+  std::atomic<std::uint32_t> sleepies_{0};
+  AdaptiveSpinLimit spin_limit_;
   std::mutex mutex_;
 
   struct List;
@@ -183,6 +183,37 @@ void wait_list_add_remove_contention_unbalanced(benchmark::State& state) {
   });
 }
 
+// Threads contend for the WaitList lock with critical sections much shorter
+// than a futex wait
+void wait_list_lock_contention_short_section(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::atomic<bool> run{true};
+    WaitList wl;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < state.range(0) - 1; i++)
+      tasks.push_back(engine::AsyncNoSpan([&]() {
+        while (run) {
+          WaitList::Lock guard{wl};
+          benchmark::DoNotOptimize(wl.IsEmpty(guard));
+        }
+      }));
+
+    for (auto _ : state) {
+      WaitList::Lock guard{wl};
+      benchmark::DoNotOptimize(wl.IsEmpty(guard));
+    }
+
+    run = false;
+    for (auto& task : tasks) task.Get();
+    state.counters["spin-limit"] = wl.GetSpinLimit();
+  });
+}
+BENCHMARK(wait_list_lock_contention_short_section)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+
 // This benchmark has been restricted to using only 1 thread, because a single
 // iteration of it (the multithreaded version) could easily take about 10
 // minutes on a modern CPU.
@@ -136,9 +136,13 @@ Direction::SingleUserGuard::~SingleUserGuard() {
 #endif  // #ifndef NDEBUG
 
 Direction::Direction(Kind kind)
+    : Direction(kind, current_task::GetEventThread()) {}
+
+Direction::Direction(Kind kind, ev::ThreadControl& thread_control)
     : kind_(kind),
       state_(State::kInvalid),
-      watcher_(current_task::GetEventThread(), this) {
+      watcher_(thread_control, this),
+      io_uring_(thread_control.GetIoUring()) {
   watcher_.Init(&IoWatcherCb);
 }
 
@@ -78,6 +78,9 @@ class Direction final {
 
   int Fd() const { return fd_; }
 
+  /// io_uring of the bound ev thread, nullptr if the backend is disabled
+  ev::IoUring* GetIoUring() const noexcept { return io_uring_; }
+
   [[nodiscard]] bool Wait(Deadline);
 
   // (IoFunc*)(int, void*, size_t), e.g. read
@@ -95,6 +98,7 @@ class Direction final {
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
+  Direction(Kind kind, ev::ThreadControl& thread_control);
 
   engine::impl::TaskContext::WakeupSource DoWait(Deadline);
 
@@ -117,6 +121,7 @@ class Direction final {
   std::atomic<State> state_;
   engine::impl::FastPimplWaitListLight waiters_;
   ev::Watcher<ev_io> watcher_;
+  ev::IoUring* io_uring_;
 };
 
 class FdControl final {
@@ -4,7 +4,12 @@
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <string>
 #include <vector>
@@ -15,6 +20,7 @@
 #include <userver/utils/assert.hpp>
 
 #include <build_config.hpp>
+#include <engine/ev/io_uring.hpp>
 #include <engine/io/fd_control.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -106,6 +112,103 @@ class SendToWrapper {
   const Sockaddr& dest_addr_;
 };
 
+// io_uring operations return a negated errno, IoFunc must set errno
+[[nodiscard]] ssize_t ToSyscallResult(std::int64_t result) {
+  if (result < 0) {
+    errno = static_cast<int>(-result);
+    return -1;
+  }
+  return static_cast<ssize_t>(result);
+}
+
+// io_uring IoFunc wrappers wait for completion up to the deadline. On
+// cancellation or deadline they report EAGAIN, so Direction handles them
+// in the same way as a non-blocking syscall that would block.
+
+class IoUringRecvWrapper {
+ public:
+  IoUringRecvWrapper(ev::IoUring& io_uring, Deadline deadline)
+      : io_uring_(io_uring), deadline_(deadline) {}
+
+  [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ToSyscallResult(io_uring_.Recv(fd, buf, len, deadline_));
+  }
+
+ private:
+  ev::IoUring& io_uring_;
+  const Deadline deadline_;
+};
+
+class IoUringSendWrapper {
+ public:
+  IoUringSendWrapper(ev::IoUring& io_uring, Deadline deadline)
+      : io_uring_(io_uring), deadline_(deadline) {}
+
+  [[nodiscard]] ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ToSyscallResult(io_uring_.Send(fd, buf, len, deadline_));
+  }
+
+ private:
+  ev::IoUring& io_uring_;
+  const Deadline deadline_;
+};
+
+class IoUringWritevWrapper {
+ public:
+  IoUringWritevWrapper(ev::IoUring& io_uring, Deadline deadline)
+      : io_uring_(io_uring), deadline_(deadline) {}
+
+  [[nodiscard]] ssize_t operator()(int fd, const struct iovec* list,
+                                   std::size_t list_size) const {
+    return ToSyscallResult(io_uring_.Writev(fd, list, list_size, deadline_));
+  }
+
+ private:
+  ev::IoUring& io_uring_;
+  const Deadline deadline_;
+};
+
+template <typename... Context>
+size_t RecvImpl(impl::Direction& dir, impl::Direction::SingleUserGuard& guard,
+                void* buf, size_t len, impl::TransferMode mode,
+                Deadline deadline, const Context&... context) {
+  if (auto* io_uring = dir.GetIoUring()) {
+    return dir.PerformIo(guard, IoUringRecvWrapper{*io_uring, deadline}, buf,
+                         len, mode, deadline, context...);
+  }
+  return dir.PerformIo(guard, &RecvWrapper, buf, len, mode, deadline,
+                       context...);
+}
+
+template <typename... Context>
+size_t SendVImpl(impl::Direction& dir, impl::Direction::SingleUserGuard& guard,
+                 struct iovec* list, std::size_t list_size, Deadline deadline,
+                 const Context&... context) {
+  if (auto* io_uring = dir.GetIoUring()) {
+    return dir.PerformIoV(guard, IoUringWritevWrapper{*io_uring, deadline},
+                          list, list_size, impl::TransferMode::kWhole,
+                          deadline, context...);
+  }
+  return dir.PerformIoV(guard, &writev, list, list_size,
+                        impl::TransferMode::kWhole, deadline, context...);
+}
+
+int AcceptImpl(impl::Direction& dir, Sockaddr& addr, socklen_t& len,
+               Deadline deadline) {
+  if (auto* io_uring = dir.GetIoUring()) {
+    return static_cast<int>(ToSyscallResult(
+        io_uring->Accept(dir.Fd(), addr.Data(), &len,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC, deadline)));
+  }
+
+// MAC_COMPAT: no accept4
+#ifdef HAVE_ACCEPT4
+  return ::accept4(dir.Fd(), addr.Data(), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+  return ::accept(dir.Fd(), addr.Data(), &len);
+#endif
+}
+
 void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
   UASSERT(data);
   UASSERT(count > 0);
@@ -220,8 +323,8 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len, impl::TransferMode::kOnce,
-                       deadline, "RecvSome from ", peername_);
+  return RecvImpl(dir, guard, buf, len, impl::TransferMode::kOnce, deadline,
+                  "RecvSome from ", peername_);
 }
 
 size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
@@ -230,9 +333,8 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len,
-                       impl::TransferMode::kWhole, deadline, "RecvAll from ",
-                       peername_);
+  return RecvImpl(dir, guard, buf, len, impl::TransferMode::kWhole, deadline,
+                  "RecvAll from ", peername_);
 }
 
 size_t Socket::SendAll(std::initializer_list<IoData> list, Deadline deadline) {
@@ -253,16 +355,14 @@ size_t Socket::SendAll(const IoData* list, std::size_t list_size,
     /// stack
     std::array<struct iovec, kMaxStackSizeVector> data{};
     FillIoSendData(list, data.data(), list_size);
-    return dir.PerformIoV(guard, &writev, data.data(), list_size,
-                          impl::TransferMode::kWhole, deadline, "SendAll to ",
-                          peername_);
+    return SendVImpl(dir, guard, data.data(), list_size, deadline,
+                     "SendAll to ", peername_);
   } else {
     /// heap
     std::vector<struct iovec> data(list_size);
     FillIoSendData(list, data.data(), list_size);
-    return dir.PerformIoV(guard, &writev, data.data(), list_size,
-                          impl::TransferMode::kWhole, deadline, "SendAll to ",
-                          peername_);
+    return SendVImpl(dir, guard, data.data(), list_size, deadline,
+                     "SendAll to ", peername_);
   }
 }
 
@@ -272,12 +372,77 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Write();
   impl::Direction::SingleUserGuard guard(dir);
+  if (auto* io_uring = dir.GetIoUring()) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return dir.PerformIo(guard, IoUringSendWrapper{*io_uring, deadline},
+                         const_cast<void*>(buf), len,
+                         impl::TransferMode::kWhole, deadline, "SendAll to ",
+                         peername_);
+  }
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   return dir.PerformIo(guard, &SendWrapper, const_cast<void*>(buf), len,
                        impl::TransferMode::kWhole, deadline, "SendAll to ",
                        peername_);
 }
 
+size_t Socket::SendFile(int file_fd, std::uint64_t offset, size_t len,
+                        Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendFile to closed socket");
+  }
+  auto& dir = fd_control_->Write();
+  impl::Direction::SingleUserGuard guard(dir);
+
+  // io_uring has no sendfile operation, the syscall is used with both backends
+  size_t sent_bytes = 0;
+  while (sent_bytes < len) {
+#ifdef __linux__
+    auto file_offset = static_cast<off_t>(offset + sent_bytes);
+    const auto chunk_size =
+        ::sendfile(dir.Fd(), file_fd, &file_offset, len - sent_bytes);
+#else
+    // MAC_COMPAT: sendfile has a different signature, read and send instead
+    std::array<char, 64 * 1024> buf{};
+    auto chunk_size =
+        ::pread(file_fd, buf.data(), std::min(buf.size(), len - sent_bytes),
+                static_cast<off_t>(offset + sent_bytes));
+    if (chunk_size > 0) {
+      chunk_size = static_cast<ssize_t>(
+          dir.PerformIo(guard, &SendWrapper, buf.data(), chunk_size,
+                        impl::TransferMode::kWhole, deadline, "SendFile to ",
+                        peername_));
+    }
+#endif
+
+    if (chunk_size > 0) {
+      sent_bytes += chunk_size;
+      continue;
+    }
+    if (chunk_size == 0) {
+      // The announced length can not be sent anymore
+      throw IoException() << "File ended before " << len
+                          << " bytes were sent by SendFile to " << peername_
+                          << ", sent " << sent_bytes << " bytes";
+    }
+    if (errno == EINTR) continue;
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      if (sent_bytes != 0) break;
+      throw IoSystemError(errno, "Socket::SendFile")
+          << "Error while SendFile to " << peername_ << ", fd=" << Fd();
+    }
+    if (!dir.Wait(deadline)) {
+      if (current_task::ShouldCancel()) {
+        throw IoCancelled(sent_bytes) << "SendFile to " << peername_;
+      }
+      throw IoTimeout(sent_bytes) << "SendFile to " << peername_;
+    }
+    if (!dir.IsValid()) {
+      throw IoException() << "Fd closed during SendFile to " << peername_;
+    }
+  }
+  return sent_bytes;
+}
+
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len,
                                             Deadline deadline) {
   if (!IsValid()) {
@@ -324,14 +489,7 @@ Socket Socket::Accept(Deadline deadline) {
   for (;;) {
     Sockaddr buf;
     auto len = buf.Capacity();
-
-// MAC_COMPAT: no accept4
-#ifdef HAVE_ACCEPT4
-    int fd =
-        ::accept4(dir.Fd(), buf.Data(), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
-#else
-    int fd = ::accept(dir.Fd(), buf.Data(), &len);
-#endif
+    const int fd = AcceptImpl(dir, buf, len, deadline);
 
     UASSERT(len <= buf.Capacity());
     if (fd != -1) {
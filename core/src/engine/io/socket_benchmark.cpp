@@ -1,8 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
@@ -138,4 +140,61 @@ BENCHMARK(socket_send_all_v);
 // TODO(TAXICOMMON-5510) flaky, sometimes throws engine::io::IoTimeout
 // BENCHMARK(socket_send_all_range)->RangeMultiplier(10)->Range(10, 10000);
 
+// Echo round trip, state.range(0) is the message size, state.range(1) enables
+// the io_uring backend (falls back to the default one if not supported)
+void socket_echo(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = state.range(1) != 0;
+
+  engine::RunStandalone(2, config, [&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+    auto task_echo = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          std::array<char, 64 * 1024> buf = {};
+          while (true) {
+            const auto size =
+                server.RecvSome(buf.data(), buf.size(), test_deadline);
+            if (size == 0) break;
+            server.SendAll(buf.data(), size, test_deadline);
+          }
+        },
+        std::move(server));
+
+    const std::string message(state.range(0), 'a');
+    std::string response(message.size(), '\0');
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    latencies.reserve(state.max_iterations);
+
+    for (auto _ : state) {
+      const auto start = std::chrono::steady_clock::now();
+      client.SendAll(message.data(), message.size(), test_deadline);
+      client.RecvAll(response.data(), response.size(), test_deadline);
+      latencies.push_back(std::chrono::steady_clock::now() - start);
+    }
+    client.Close();
+    task_echo.Get();
+
+    if (!latencies.empty()) {
+      const auto p99_index = latencies.size() * 99 / 100;
+      std::nth_element(latencies.begin(), latencies.begin() + p99_index,
+                       latencies.end());
+      state.counters["p99_us"] =
+          std::chrono::duration<double, std::micro>(latencies[p99_index])
+              .count();
+    }
+    state.SetBytesProcessed(state.iterations() * message.size() * 2);
+  });
+}
+BENCHMARK(socket_echo)
+    ->ArgNames({"size", "io_uring"})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Args({4096, 0})
+    ->Args({4096, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
 USERVER_NAMESPACE_END
@@ -15,6 +15,7 @@
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/internal/net/net_listener.hpp>
@@ -440,4 +441,45 @@ UTEST(Socket, WriteALot) {
   }
 }
 
+// Falls back to the default backend if io_uring is not supported by the kernel
+TEST(Socket, IoUringBackend) {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = true;
+
+  engine::RunStandalone(2, config, [] {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    TcpListener listener;
+
+    UEXPECT_THROW([[maybe_unused]] auto socket = listener.socket.Accept(
+                      Deadline::FromDuration(std::chrono::milliseconds(10))),
+                  io::IoTimeout);
+
+    auto echo_task = engine::AsyncNoSpan([&] {
+      auto server = listener.socket.Accept(test_deadline);
+      std::array<char, 16> buf{};
+      const auto size = server.RecvSome(buf.data(), buf.size(), test_deadline);
+      ASSERT_EQ(size, 5);
+      EXPECT_EQ(server.SendAll({{buf.data(), 2}, {buf.data() + 2, 3}},
+                               test_deadline),
+                5);
+
+      UEXPECT_THROW(server.RecvSome(buf.data(), buf.size(),
+                                    Deadline::FromDuration(
+                                        std::chrono::milliseconds(10))),
+                    io::IoTimeout);
+    });
+
+    io::Socket client{listener.addr.Domain(), TcpListener::type};
+    client.Connect(listener.addr, test_deadline);
+    EXPECT_EQ(client.SendAll("hello", 5, test_deadline), 5);
+
+    std::array<char, 5> response{};
+    EXPECT_EQ(client.RecvAll(response.data(), response.size(), test_deadline),
+              5);
+    EXPECT_EQ(std::string_view(response.data(), response.size()), "hello");
+
+    echo_task.Get();
+  });
+}
+
 USERVER_NAMESPACE_END
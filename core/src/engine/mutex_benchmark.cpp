@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <userver/engine/async.hpp>
@@ -12,6 +13,8 @@
 #include <userver/engine/single_waiting_task_mutex.hpp>
 #include <userver/utils/rand.hpp>
 
+#include <engine/impl/mutex_impl.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -76,6 +79,14 @@ struct PoolForImpl<engine::SingleWaitingTaskMutex> {
   using Pool = AsyncCoroPool;
 };
 
+// engine::Mutex internals, to report the spin limit
+using MutexImpl = engine::impl::MutexImpl<engine::impl::WaitList>;
+
+template <>
+struct PoolForImpl<MutexImpl> {
+  using Pool = AsyncCoroPool;
+};
+
 template <typename T>
 using PoolFor = typename PoolForImpl<T>::Pool;
 
@@ -215,6 +226,52 @@ void generic_contention_with_payload(benchmark::State& state) {
       total_lock_unlock_count / state.range(0), benchmark::Counter::kIsRate);
 }
 
+// Critical section is much shorter than a context switch
+template <typename Mutex>
+void generic_contention_short_section(benchmark::State& state) {
+  alignas(kInterferenceSize) std::atomic<bool> run{true};
+  alignas(kInterferenceSize) std::atomic<std::uint64_t> lock_unlock_count{0};
+  alignas(kInterferenceSize) Mutex m;
+  alignas(kInterferenceSize) std::uint64_t protected_counter = 0;
+
+  PoolFor<Mutex> pool(state.range(0) - 1, [&]() {
+    std::uint64_t local_lock_unlock_count = 0;
+
+    while (run) {
+      m.lock();
+      benchmark::DoNotOptimize(++protected_counter);
+      m.unlock();
+      ++local_lock_unlock_count;
+    }
+
+    lock_unlock_count += local_lock_unlock_count;
+  });
+
+  std::uint64_t local_lock_unlock_count = 0;
+
+  for (auto _ : state) {
+    m.lock();
+    benchmark::DoNotOptimize(++protected_counter);
+    m.unlock();
+    ++local_lock_unlock_count;
+  }
+
+  lock_unlock_count += local_lock_unlock_count;
+
+  run = false;
+  pool.Wait();
+  const auto total_lock_unlock_count =
+      static_cast<double>(lock_unlock_count.load());
+  state.counters["locks"] =
+      benchmark::Counter(total_lock_unlock_count, benchmark::Counter::kIsRate);
+  state.counters["locks-per-thread"] = benchmark::Counter(
+      total_lock_unlock_count / state.range(0), benchmark::Counter::kIsRate);
+
+  if constexpr (std::is_same_v<Mutex, MutexImpl>) {
+    state.counters["spin-limit"] = m.GetSpinLimit();
+  }
+}
+
 //////// Benchmarks
 
 // Note: We intentionally do not run std::* benchmarks from RunStandalone to
@@ -279,6 +336,22 @@ void single_waiting_task_mutex_contention_with_payload(
   });
 }
 
+void mutex_coro_contention_short_section(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    generic_contention_short_section<engine::Mutex>(state);
+  });
+}
+
+void mutex_impl_contention_short_section(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    generic_contention_short_section<MutexImpl>(state);
+  });
+}
+
+void mutex_std_contention_short_section(benchmark::State& state) {
+  generic_contention_short_section<std::mutex>(state);
+}
+
 }  // namespace
 
 BENCHMARK(mutex_coro_lock);
@@ -297,4 +370,14 @@ BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention_with_payload)->Range(1, 2);
 
+BENCHMARK(mutex_coro_contention_short_section)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK(mutex_impl_contention_short_section)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK(mutex_std_contention_short_section)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
 USERVER_NAMESPACE_END
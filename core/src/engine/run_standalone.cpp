@@ -1,8 +1,6 @@
 #include <userver/engine/run_standalone.hpp>
 
 #include <engine/impl/standalone.hpp>
-#include <userver/engine/task/task.hpp>
-#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,16 +17,8 @@ void RunStandalone(std::size_t worker_threads, std::function<void()> payload) {
 void RunStandalone(std::size_t worker_threads,
                    const TaskProcessorPoolsConfig& config,
                    std::function<void()> payload) {
-  UINVARIANT(!engine::current_task::GetTaskProcessorOptional(),
-             "RunStandalone must not be used alongside a running engine");
-  UINVARIANT(worker_threads != 0, "Unable to run anything using 0 threads");
-
-  auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
-      worker_threads, "coro-runner",
-      engine::impl::MakeTaskProcessorPools(config));
-
-  engine::impl::RunOnTaskProcessorSync(*task_processor_holder,
-                                       std::move(payload));
+  impl::RunStandalone(worker_threads, config, TaskQueueType::kGlobalTaskQueue,
+                      std::move(payload));
 }
 
 }  // namespace engine
@@ -1,9 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
 
 using namespace std::chrono_literals;
 
@@ -23,6 +26,37 @@ BENCHMARK(sleep_benchmark_us)
     ->Range(1, 1024 * 128)
     ->Unit(benchmark::kMicrosecond);
 
+// range(0) tasks sleep concurrently, range(1) is the timer slack in
+// microseconds, 0 disables the timer wheel
+void concurrent_sleep_benchmark(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.max_coro_pool_size = state.range(0);
+  config.coro_stack_size = 32 * 1024;
+  config.ev_timer_slack = std::chrono::microseconds{state.range(1)};
+
+  engine::RunStandalone(4, config, [&] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0));
+
+    for (auto _ : state) {
+      for (std::int64_t i = 0; i < state.range(0); ++i) {
+        // Spread the wakeups over 1-5ms
+        const std::chrono::microseconds duration{1000 + i % 4000};
+        tasks.push_back(engine::AsyncNoSpan([duration] {
+          engine::InterruptibleSleepFor(duration);
+        }));
+      }
+      for (auto& task : tasks) task.Wait();
+      tasks.clear();
+    }
+  });
+}
+BENCHMARK(concurrent_sleep_benchmark)
+    ->Args({100'000, 0})
+    ->Args({100'000, 1000})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 void run_in_ev_loop_benchmark(benchmark::State& state) {
   engine::RunStandalone([&] {
     auto& ev_thread = engine::current_task::GetEventThread();
@@ -3,6 +3,7 @@
 #include <array>
 #include <thread>
 
+#include <engine/impl/standalone.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -35,6 +36,26 @@ void async_comparisons_coro(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro)->RangeMultiplier(2)->Range(1, 32);
 
+template <engine::TaskQueueType kQueueType>
+void async_comparisons_coro_queue_type(benchmark::State& state) {
+  engine::impl::RunStandalone(state.range(0), kQueueType, [&] {
+    std::uint64_t constructed_joined_count = 0;
+    for (auto _ : state) {
+      engine::AsyncNoSpan([] {}).Wait();
+      ++constructed_joined_count;
+    }
+    benchmark::DoNotOptimize(constructed_joined_count);
+  });
+}
+BENCHMARK_TEMPLATE(async_comparisons_coro_queue_type,
+                   engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(async_comparisons_coro_queue_type,
+                   engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
 void wrap_call_single(benchmark::State& state) {
   engine::RunStandalone([&] {
     for (auto _ : state) {
@@ -37,6 +37,7 @@ class ContextTimer::Impl final : public ev::AsyncPayloadBase {
   void StopTimerInEvThread() noexcept;
 
   static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnWheelTimer(ev::TimerWheel::Node& node) noexcept;
   void DoOnTimer();
 
   struct Params {
@@ -48,6 +49,8 @@ class ContextTimer::Impl final : public ev::AsyncPayloadBase {
   std::optional<ev::ThreadControl> thread_control_;
   Params params_;
   ev_timer timer_{};
+  // used instead of `timer_` if the ev thread has a timer wheel
+  ev::TimerWheel::Node wheel_node_{&OnWheelTimer, this};
 
   using ParamsPipe = ev::DataPipeToEv<Params>;
   ParamsPipe params_pipe_to_ev_;
@@ -62,6 +65,7 @@ ContextTimer::Impl::Impl() : ev::AsyncPayloadBase(&Release) {
 ContextTimer::Impl::~Impl() {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
   UASSERT(!ev_is_active(&timer_));
+  UASSERT(!wheel_node_.IsScheduled());
 }
 
 bool ContextTimer::Impl::WasStarted() const noexcept {
@@ -151,11 +155,19 @@ void ContextTimer::Impl::ArmTimerInEvThread() {
     return;
   }
 
+  if (thread_control_->HasTimerWheel()) {
+    if (!thread_control_->ScheduleTimer(wheel_node_, params_.deadline)) {
+      DoOnTimer();
+    }
+    return;
+  }
+
   timer_.repeat = time_left;
   thread_control_->Again(timer_);
 }
 
 void ContextTimer::Impl::StopTimerInEvThread() noexcept {
+  wheel_node_.Cancel();
   thread_control_->Stop(timer_);
 }
 
@@ -165,6 +177,12 @@ void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
   ev_timer->DoOnTimer();
 }
 
+void ContextTimer::Impl::OnWheelTimer(ev::TimerWheel::Node& node) noexcept {
+  auto* ev_timer = static_cast<Impl*>(node.GetData());
+  UASSERT(ev_timer != nullptr);
+  ev_timer->DoOnTimer();
+}
+
 void ContextTimer::Impl::DoOnTimer() {
   try {
     // do not keep the function object around for much longer
@@ -182,7 +182,7 @@ TaskProcessor* GetTaskProcessorOptional() noexcept {
 }
 
 ev::ThreadControl& GetEventThread() {
-  return GetTaskProcessor().EventThreadPool().NextThread();
+  return GetTaskProcessor().NextEventThread();
 }
 
 void AccountSpuriousWakeup() {
@@ -1,7 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
 #include <thread>
 
+#include <engine/impl/standalone.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
@@ -43,6 +45,57 @@ void engine_task_yield_multiple_threads(benchmark::State& state) {
 }
 BENCHMARK(engine_task_yield_multiple_threads)->RangeMultiplier(2)->Range(1, 32);
 
+template <engine::TaskQueueType kQueueType>
+void engine_task_yield_queue_type(benchmark::State& state) {
+  engine::impl::RunStandalone(state.range(0), kQueueType, [&] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < state.range(0) - 1; i++)
+      tasks.push_back(engine::AsyncNoSpan([]() {
+        while (!engine::current_task::ShouldCancel()) engine::Yield();
+      }));
+
+    for (auto _ : state) engine::Yield();
+  });
+}
+BENCHMARK_TEMPLATE(engine_task_yield_queue_type,
+                   engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(engine_task_yield_queue_type,
+                   engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+// Every worker constantly spawns short tasks, all of them go through Schedule()
+template <engine::TaskQueueType kQueueType>
+void engine_task_spawn_queue_type(benchmark::State& state) {
+  engine::impl::RunStandalone(state.range(0), kQueueType, [&] {
+    std::atomic<std::uint64_t> spawned{0};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < state.range(0) - 1; i++)
+      tasks.push_back(engine::AsyncNoSpan([&spawned]() {
+        while (!engine::current_task::ShouldCancel()) {
+          engine::AsyncNoSpan([] {}).Wait();
+          spawned.fetch_add(1, std::memory_order_relaxed);
+        }
+      }));
+
+    for (auto _ : state) engine::AsyncNoSpan([] {}).Wait();
+
+    for (auto& task : tasks) task.SyncCancel();
+    state.counters["background_spawns"] =
+        benchmark::Counter(spawned.load(), benchmark::Counter::kIsRate);
+  });
+}
+BENCHMARK_TEMPLATE(engine_task_spawn_queue_type,
+                   engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(engine_task_spawn_queue_type,
+                   engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
 void thread_yield(benchmark::State& state) {
   for (auto _ : state) std::this_thread::yield();
 }
@@ -355,7 +355,7 @@ void TaskContext::ArmTimer(Deadline deadline, Func&& func) {
     deadline_timer_.Restart(std::forward<Func>(func), deadline);
   } else {
     deadline_timer_.Start(boost::intrusive_ptr{this},
-                          task_processor_.EventThreadPool().NextThread(),
+                          task_processor_.NextEventThread(),
                           std::forward<Func>(func), deadline);
   }
 }
@@ -2,7 +2,9 @@
 
 #include <atomic>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <ev.h>
@@ -170,6 +172,14 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
     task_queue_wait_timepoint_ = tp;
   }
 
+  // remembers the NUMA node the task is about to run on,
+  // returns true if the previous step ran on another node
+  bool UpdateNumaNode(std::size_t node) noexcept {
+    const auto previous =
+        std::exchange(numa_node_, static_cast<std::uint16_t>(node));
+    return previous != kNoNumaNode && previous != numa_node_;
+  }
+
   void SetCancelDeadline(Deadline deadline);
 
   bool HasLocalStorage() const noexcept;
@@ -185,6 +195,7 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   class LocalStorageGuard;
 
   static constexpr uint64_t kMagic = 0x6b73615453755459ULL;  // "YTuSTask"
+  static constexpr auto kNoNumaNode = std::numeric_limits<std::uint16_t>::max();
 
   template <typename Func>
   void ArmTimer(Deadline deadline, Func&& func);
@@ -211,6 +222,7 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   const bool is_critical_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
+  std::uint16_t numa_node_{kNoNumaNode};
   EhGlobals eh_globals_;
   TaskPayload payload_;
 
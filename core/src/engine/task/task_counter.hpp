@@ -88,6 +88,8 @@ class TaskCounter final {
 
   size_t GetSpuriousWakeups() const { return spurious_wakeups_; }
 
+  size_t GetNumaNodeMigrations() const { return numa_node_migrations_; }
+
   void AccountTaskCancel() noexcept { tasks_cancelled_++; }
 
   void AccountTaskCancelOverload() noexcept { tasks_cancelled_overload_++; }
@@ -104,6 +106,8 @@ class TaskCounter final {
 
   void AccountSpuriousWakeup() { spurious_wakeups_++; }
 
+  void AccountNumaNodeMigration() { numa_node_migrations_++; }
+
   void AccountTaskExecution(std::chrono::microseconds us) {
     task_processor_profiler_timings_.Add(us.count(), 1);
   }
@@ -120,6 +124,7 @@ class TaskCounter final {
   std::atomic<size_t> tasks_switch_fast_{0};
   std::atomic<size_t> tasks_switch_slow_{0};
   std::atomic<size_t> spurious_wakeups_{0};
+  std::atomic<size_t> numa_node_migrations_{0};
   std::atomic<size_t> tasks_cancelled_overload_{0};
   std::atomic<size_t> tasks_overload_{0};
 
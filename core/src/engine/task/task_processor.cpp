@@ -1,6 +1,7 @@
 #include "task_processor.hpp"
 
 #include <sys/types.h>
+#include <algorithm>
 #include <csignal>
 
 #include <fmt/format.h>
@@ -10,8 +11,10 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <utils/impl/static_registration.hpp>
+#include <utils/numa.hpp>
 #include <utils/threads.hpp>
 
+#include <engine/ev/thread_pool.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
 
@@ -51,6 +54,38 @@ void EmitMagicNanosleep() {
   nanosleep(&ts, nullptr);
 }
 
+std::optional<std::size_t> GetNumaNode(const TaskProcessorConfig& config) {
+  if (!config.numa_node) return {};
+
+  const auto nodes_count = utils::numa::GetNodesCount();
+  if (*config.numa_node >= nodes_count) {
+    // The same config is often used on the machines with different topology
+    LOG_WARNING() << "NUMA node " << *config.numa_node
+                  << " is not available, the machine has " << nodes_count
+                  << " node(s); ignoring numa-node of task processor "
+                  << config.name;
+    return {};
+  }
+
+  const auto& node_cpus = utils::numa::GetNodeCpus(*config.numa_node);
+  const auto allowed_cpus = utils::numa::GetAllowedCpus();
+  const auto has_allowed_cpu =
+      allowed_cpus.empty() || node_cpus.empty() ||
+      std::any_of(node_cpus.begin(), node_cpus.end(), [&](std::size_t cpu) {
+        return std::binary_search(allowed_cpus.begin(), allowed_cpus.end(),
+                                  cpu);
+      });
+  if (!has_allowed_cpu) {
+    // e.g. a container restricted to the CPUs of another node
+    LOG_WARNING() << "NUMA node " << *config.numa_node
+                  << " has no CPUs allowed for the process; ignoring "
+                     "numa-node of task processor "
+                  << config.name;
+    return {};
+  }
+  return config.numa_node;
+}
+
 void TaskProcessorThreadStartedHook() {
   utils::impl::AssertStaticRegistrationFinished();
   (void)utils::DefaultRandom();
@@ -65,6 +100,8 @@ void TaskProcessorThreadStartedHook() {
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : config_(std::move(config)),
+      numa_node_(GetNumaNode(config_)),
+      track_numa_migrations_(utils::numa::GetNodesCount() > 1),
       task_profiler_threshold_{std::chrono::microseconds(0)},
       profiler_force_stacktrace_{false},
       pools_(std::move(pools)),
@@ -75,9 +112,18 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       task_trace_logger_{nullptr} {
   utils::impl::FinishStaticRegistration();
   try {
+    // The worker threads can not report errors, an invalid cpu-set would
+    // terminate the process there
+    utils::numa::ValidateCpus(config_.cpu_set);
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
-               << " thread_name=" << config_.thread_name;
+               << " thread_name=" << config_.thread_name << " numa_node="
+               << (numa_node_ ? std::to_string(*numa_node_) : "none");
+    if (config_.task_processor_queue ==
+        TaskQueueType::kWorkStealingTaskQueue) {
+      work_stealing_queue_ =
+          std::make_unique<WorkStealingTaskQueue>(config_.worker_threads);
+    }
     workers_.reserve(config_.worker_threads);
     for (size_t i = 0; i < config_.worker_threads; ++i) {
       workers_.emplace_back([this, i] {
@@ -92,6 +138,18 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
             break;
         }
 
+        try {
+          if (numa_node_) utils::numa::BindCurrentThreadToNode(*numa_node_);
+          if (!config_.cpu_set.empty()) {
+            utils::numa::SetCurrentThreadAffinity(config_.cpu_set);
+          }
+        } catch (const std::exception& ex) {
+          // e.g. the affinity is forbidden by seccomp, the thread still works
+          LOG_ERROR() << "Failed to set the affinity of a worker of task "
+                         "processor "
+                      << config_.name << ": " << ex;
+        }
+
         utils::SetCurrentThreadName(
             fmt::format("{}_{}", config_.thread_name, i));
         ProcessTasks();
@@ -111,7 +169,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion(std::chrono::milliseconds(10));
 
-  task_queue_.enqueue(nullptr);
+  PushTask(nullptr);
 
   for (auto& w : workers_) {
     w.join();
@@ -146,10 +204,15 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
   // but oh well
   intrusive_ptr_add_ref(context);
 
-  task_queue_.enqueue(context);
+  PushTask(context);
   // NOTE: task may be executed at this point
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  if (work_stealing_queue_) return work_stealing_queue_->GetSizeApproximate();
+  return task_queue_.size_approx();
+}
+
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_.Add(context);
 }
@@ -158,8 +221,13 @@ ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
 
+ev::ThreadControl& TaskProcessor::NextEventThread() {
+  auto& pool = pools_->EventThreadPool();
+  return numa_node_ ? pool.NextThread(*numa_node_) : pool.NextThread();
+}
+
 impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
-  return {pools_->GetCoroPool().GetCoroutine(), *this};
+  return {pools_->GetCoroPool(numa_node_).GetCoroutine(), *this};
 }
 
 void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
@@ -227,20 +295,32 @@ logging::LoggerPtr TaskProcessor::GetTaskTraceLogger() const {
   return task_trace_logger_;
 }
 
+void TaskProcessor::PushTask(impl::TaskContext* context) {
+  if (work_stealing_queue_) {
+    work_stealing_queue_->Push(context);
+  } else {
+    task_queue_.enqueue(context);
+  }
+}
+
 impl::TaskContext* TaskProcessor::DequeueTask() {
   impl::TaskContext* buf = nullptr;
 
-  /* Current thread handles only a single TaskProcessor, so it's safe to store
-   * a token for the task processor in a thread-local variable.
-   */
-  thread_local moodycamel::ConsumerToken token(task_queue_);
+  if (work_stealing_queue_) {
+    buf = work_stealing_queue_->PopBlocking();
+  } else {
+    /* Current thread handles only a single TaskProcessor, so it's safe to
+     * store a token for the task processor in a thread-local variable.
+     */
+    thread_local moodycamel::ConsumerToken token(task_queue_);
 
-  task_queue_.wait_dequeue(token, buf);
+    task_queue_.wait_dequeue(token, buf);
+  }
   GetTaskCounter().AccountTaskSwitchSlow();
 
   if (!buf) {
     // return "stop" token back
-    task_queue_.enqueue(nullptr);
+    PushTask(nullptr);
   }
 
   return buf;
@@ -262,6 +342,7 @@ void TaskProcessor::ProcessTasks() noexcept {
     if (!context) break;
 
     CheckWaitTime(*context);
+    if (track_numa_migrations_) AccountNumaNode(*context);
 
     bool has_failed = false;
     try {
@@ -277,6 +358,14 @@ void TaskProcessor::ProcessTasks() noexcept {
   }
 }
 
+void TaskProcessor::AccountNumaNode(impl::TaskContext& context) {
+  // The stack and the data of the task are most likely on the node of the
+  // previous step, running on another node makes all of them remote
+  if (context.UpdateNumaNode(utils::numa::GetCurrentNode())) {
+    GetTaskCounter().AccountNumaNodeMigration();
+  }
+}
+
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
   const auto max_wait_time = max_task_queue_wait_time_.load();
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <unordered_set>
 #include <vector>
@@ -15,6 +16,7 @@
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -27,6 +29,7 @@ class TaskProcessorPools;
 }  // namespace impl
 
 namespace ev {
+class ThreadControl;
 class ThreadPool;
 }  // namespace ev
 
@@ -45,6 +48,10 @@ class TaskProcessor final {
 
   ev::ThreadPool& EventThreadPool();
 
+  // ev thread for the timers and sockets of the tasks, node-local if the task
+  // processor is bound to a NUMA node
+  ev::ThreadControl& NextEventThread();
+
   std::shared_ptr<impl::TaskProcessorPools> GetTaskProcessorPools() {
     return pools_;
   }
@@ -55,7 +62,7 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.size_approx(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
@@ -76,15 +83,21 @@ class TaskProcessor final {
  private:
   void Cleanup() noexcept;
 
+  void PushTask(impl::TaskContext* context);
+
   impl::TaskContext* DequeueTask();
 
   void ProcessTasks() noexcept;
 
   void CheckWaitTime(impl::TaskContext& context);
 
+  void AccountNumaNode(impl::TaskContext& context);
+
   void HandleOverload(impl::TaskContext& context);
 
   const TaskProcessorConfig config_;
+  const std::optional<std::size_t> numa_node_;
+  const bool track_numa_migrations_;
   std::atomic<std::chrono::microseconds> task_profiler_threshold_;
   std::atomic<bool> profiler_force_stacktrace_{false};
 
@@ -94,6 +107,7 @@ class TaskProcessor final {
   impl::DetachedTasksSyncBlock detached_contexts_;
 
   moodycamel::BlockingConcurrentQueue<impl::TaskContext*> task_queue_;
+  std::unique_ptr<WorkStealingTaskQueue> work_stealing_queue_;
 
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{};
@@ -8,6 +8,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
+#include <utils/numa.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -27,6 +28,18 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
   UINVARIANT(false, "Unknown OS scheduling value: " + str);
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  const auto str = value.As<std::string>();
+  if (str == "global-task-queue") {
+    return TaskQueueType::kGlobalTaskQueue;
+  } else if (str == "work-stealing-task-queue") {
+    return TaskQueueType::kWorkStealingTaskQueue;
+  }
+
+  UINVARIANT(false, "Unknown task processor queue type: " + str);
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
@@ -36,6 +49,12 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_name = value["thread_name"].As<std::string>();
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(OsScheduling::kNormal);
+  config.task_processor_queue =
+      value["task-processor-queue"].As<TaskQueueType>(
+          TaskQueueType::kGlobalTaskQueue);
+  config.numa_node = value["numa-node"].As<std::optional<std::size_t>>();
+  const auto cpu_set = value["cpu-set"].As<std::optional<std::string>>();
+  if (cpu_set) config.cpu_set = utils::numa::ParseCpuList(*cpu_set);
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
@@ -1,6 +1,9 @@
 #include <engine/task/task_processor_pools.hpp>
 
+#include <algorithm>
+
 #include <engine/task/task_context.hpp>
+#include <utils/numa.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,9 +11,36 @@ namespace engine::impl {
 
 TaskProcessorPools::TaskProcessorPools(coro::PoolConfig coro_pool_config,
                                        ev::ThreadPoolConfig ev_pool_config)
-    : coro_pool_(std::move(coro_pool_config), &TaskContext::CoroFunc),
+    : coro_pool_(coro_pool_config, &TaskContext::CoroFunc),
       event_thread_pool_(std::move(ev_pool_config),
-                         ev::ThreadPool::kUseDefaultEvLoop) {}
+                         ev::ThreadPool::kUseDefaultEvLoop) {
+  const auto nodes_count = utils::numa::GetNodesCount();
+  if (nodes_count > 1) {
+    coro_pool_config.initial_size = 0;
+    // Not to keep nodes_count times more idle stacks than configured
+    coro_pool_config.max_size =
+        std::max<std::size_t>(coro_pool_config.max_size / nodes_count, 1);
+    node_coro_pools_.reserve(nodes_count);
+    for (std::size_t node = 0; node < nodes_count; ++node) {
+      node_coro_pools_.push_back(std::make_unique<CoroPool>(
+          coro_pool_config, &TaskContext::CoroFunc, node));
+    }
+  }
+}
+
+TaskProcessorPools::CoroPool& TaskProcessorPools::GetCoroPool(
+    std::optional<std::size_t> numa_node) {
+  if (numa_node && *numa_node < node_coro_pools_.size()) {
+    return *node_coro_pools_[*numa_node];
+  }
+  return coro_pool_;
+}
+
+coro::PoolStats TaskProcessorPools::GetCoroPoolStats() const {
+  auto stats = coro_pool_.GetStats();
+  for (const auto& pool : node_coro_pools_) stats += pool->GetStats();
+  return stats;
+}
 
 }  // namespace engine::impl
 
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include <engine/coro/pool.hpp>
 #include <engine/ev/thread_pool.hpp>
 
@@ -17,10 +22,21 @@ class TaskProcessorPools final {
                      ev::ThreadPoolConfig ev_pool_config);
 
   CoroPool& GetCoroPool() { return coro_pool_; }
+
+  /// Pool with the stacks on the `numa_node`, the common pool if there is no
+  /// node or the machine has a single NUMA node
+  CoroPool& GetCoroPool(std::optional<std::size_t> numa_node);
+
+  /// Statistics of the common and the node-local coroutine pools
+  coro::PoolStats GetCoroPoolStats() const;
+
   ev::ThreadPool& EventThreadPool() { return event_thread_pool_; }
 
  private:
   CoroPool coro_pool_;
+  // Node-local pools start empty, the common pool holds the preallocated
+  // coroutines. The max_size of idle coroutines is split between the nodes.
+  std::vector<std::unique_ptr<CoroPool>> node_coro_pools_;
   ev::ThreadPool event_thread_pool_;
 };
 
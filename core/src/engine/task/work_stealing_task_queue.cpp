@@ -0,0 +1,165 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <thread>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+namespace {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+// Consecutive pops from the LIFO slot are limited, otherwise a pair of tasks
+// waking up each other could starve the rest of the local queue.
+constexpr std::size_t kMaxLifoStreak = 16;
+
+// The injection queue is polled before the local one every N pops, otherwise
+// tasks from foreign threads could starve under a steady local load.
+constexpr std::size_t kGlobalQueuePollInterval = 61;
+
+// Number of failed full scans before giving up the CPU. A consumer spins only
+// while a task it has a token for is not yet visible in the queues.
+constexpr std::size_t kScansBeforeYield = 16;
+
+struct ConsumerBinding final {
+  const WorkStealingTaskQueue* queue{nullptr};
+  std::size_t index{0};
+};
+
+thread_local ConsumerBinding current_binding;
+
+}  // namespace
+
+struct alignas(kCacheLineSize) WorkStealingTaskQueue::Consumer final {
+  Consumer() : producer_token(local_queue) {}
+
+  std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+  moodycamel::ConcurrentQueue<impl::TaskContext*> local_queue;
+  moodycamel::ProducerToken producer_token;
+
+  // Accessed only by the owning thread
+  std::size_t index{0};
+  std::size_t lifo_streak{0};
+  std::size_t pops_count{0};
+};
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(std::size_t consumers_count)
+    : consumers_count_(consumers_count),
+      consumers_(std::make_unique<Consumer[]>(consumers_count)) {
+  UINVARIANT(consumers_count_ != 0, "Work stealing queue needs consumers");
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    consumers_[i].index = i;
+  }
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::Push(impl::TaskContext* context) {
+  auto* consumer = GetCurrentConsumer();
+  if (!consumer || !context) {
+    global_queue_.enqueue(context);
+  } else if (current_task::GetCurrentTaskContextUnchecked()) {
+    // Woken up by a running task, is likely to share the data with it
+    auto* displaced =
+        consumer->lifo_slot.exchange(context, std::memory_order_acq_rel);
+    if (displaced) {
+      consumer->local_queue.enqueue(consumer->producer_token, displaced);
+    }
+  } else {
+    // Rescheduled by TaskProcessor itself, e.g. after a Yield()
+    consumer->local_queue.enqueue(consumer->producer_token, context);
+  }
+
+  queued_tasks_.signal();
+}
+
+impl::TaskContext* WorkStealingTaskQueue::PopBlocking() {
+  auto* consumer = GetCurrentConsumer();
+  if (!consumer) consumer = &BindCurrentThread();
+
+  while (!queued_tasks_.wait()) {
+  }
+
+  // The acquired token guarantees that there is a task for us somewhere
+  std::size_t failed_scans = 0;
+  while (true) {
+    impl::TaskContext* context = nullptr;
+    if (TryPop(*consumer, context)) return context;
+
+    if (++failed_scans == kScansBeforeYield) {
+      failed_scans = 0;
+      std::this_thread::yield();
+    }
+  }
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  return queued_tasks_.availableApprox();
+}
+
+WorkStealingTaskQueue::Consumer* WorkStealingTaskQueue::GetCurrentConsumer()
+    const noexcept {
+  if (current_binding.queue != this) return nullptr;
+  return &consumers_[current_binding.index];
+}
+
+WorkStealingTaskQueue::Consumer& WorkStealingTaskQueue::BindCurrentThread() {
+  const auto index = bound_consumers_.fetch_add(1, std::memory_order_relaxed);
+  UINVARIANT(index < consumers_count_,
+             "More threads consume from a work stealing queue than expected");
+  current_binding = ConsumerBinding{this, index};
+  return consumers_[index];
+}
+
+bool WorkStealingTaskQueue::TryPop(Consumer& consumer,
+                                   impl::TaskContext*& context) {
+  if (++consumer.pops_count == kGlobalQueuePollInterval) {
+    consumer.pops_count = 0;
+    if (global_queue_.try_dequeue(context)) return true;
+  }
+
+  if (consumer.lifo_streak < kMaxLifoStreak) {
+    context = consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) {
+      ++consumer.lifo_streak;
+      return true;
+    }
+  }
+  consumer.lifo_streak = 0;
+
+  if (consumer.local_queue.try_dequeue_from_producer(consumer.producer_token,
+                                                     context)) {
+    return true;
+  }
+
+  if (global_queue_.try_dequeue(context)) return true;
+
+  if (TrySteal(consumer, context)) return true;
+
+  // LIFO slot might have been skipped because of the streak limit
+  context = consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+  return context != nullptr;
+}
+
+bool WorkStealingTaskQueue::TrySteal(Consumer& consumer,
+                                     impl::TaskContext*& context) {
+  const auto start = utils::RandRange(consumers_count_);
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    auto& victim = consumers_[(start + i) % consumers_count_];
+    if (&victim == &consumer) continue;
+
+    if (victim.local_queue.try_dequeue(context)) return true;
+
+    context = victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) return true;
+  }
+  return false;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// @brief Task queue with a local queue per consumer (worker thread) and
+/// randomized work stealing between them.
+///
+/// Each consumer owns a LIFO slot and a FIFO queue:
+/// * a task woken up by a task running on the consumer goes to the LIFO slot,
+///   so it is likely to be executed next while its data is still in the cache;
+///   the displaced task goes to the FIFO queue of the consumer;
+/// * a task that is rescheduled outside of a coroutine (e.g. Yield()) goes to
+///   the FIFO queue of the consumer;
+/// * tasks scheduled from foreign threads go to a shared injection queue.
+///
+/// An idle consumer takes tasks from its own queues first, then from the
+/// injection queue, then steals from the other consumers.
+///
+/// Every pushed task is accounted in a semaphore and every consumer acquires
+/// the semaphore before looking for a task, so a consumer that passed the
+/// semaphore is guaranteed to eventually find a task in one of the queues.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(std::size_t consumers_count);
+  ~WorkStealingTaskQueue();
+
+  WorkStealingTaskQueue(const WorkStealingTaskQueue&) = delete;
+  WorkStealingTaskQueue& operator=(const WorkStealingTaskQueue&) = delete;
+
+  /// Pushes a task, `nullptr` is allowed and is returned to a consumer as is.
+  void Push(impl::TaskContext* context);
+
+  /// Blocks until a task is available. Must be called only from the consumer
+  /// threads, each thread is bound to a consumer on its first call.
+  impl::TaskContext* PopBlocking();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  struct Consumer;
+
+  Consumer* GetCurrentConsumer() const noexcept;
+  Consumer& BindCurrentThread();
+
+  bool TryPop(Consumer& consumer, impl::TaskContext*& context);
+  bool TrySteal(Consumer& consumer, impl::TaskContext*& context);
+
+  const std::size_t consumers_count_;
+  std::unique_ptr<Consumer[]> consumers_;
+  std::atomic<std::size_t> bound_consumers_{0};
+
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  moodycamel::LightweightSemaphore queued_tasks_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kWorkStealing = engine::TaskQueueType::kWorkStealingTaskQueue;
+
+}  // namespace
+
+TEST(WorkStealingTaskQueue, ManyTasks) {
+  engine::impl::RunStandalone(4, kWorkStealing, [] {
+    constexpr std::size_t kTasksCount = 1000;
+    std::atomic<std::size_t> executed{0};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasksCount);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&executed] {
+        engine::Yield();
+        ++executed;
+      }));
+    }
+
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(executed.load(), kTasksCount);
+  });
+}
+
+TEST(WorkStealingTaskQueue, YieldingTasksDoNotStarve) {
+  engine::impl::RunStandalone(1, kWorkStealing, [] {
+    engine::SingleConsumerEvent event;
+    auto spinner = engine::AsyncNoSpan([] {
+      while (!engine::current_task::ShouldCancel()) engine::Yield();
+    });
+    auto waker = engine::AsyncNoSpan([&event] { event.Send(); });
+
+    EXPECT_TRUE(event.WaitForEventFor(utest::kMaxTestWaitTime));
+    spinner.SyncCancel();
+  });
+}
+
+TEST(WorkStealingTaskQueue, MutexPingPong) {
+  engine::impl::RunStandalone(4, kWorkStealing, [] {
+    constexpr std::size_t kIterations = 10000;
+    engine::Mutex mutex;
+    std::size_t counter = 0;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t i = 0; i < 8; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        for (std::size_t j = 0; j < kIterations; ++j) {
+          std::lock_guard lock(mutex);
+          ++counter;
+        }
+      }));
+    }
+
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(counter, 8 * kIterations);
+  });
+}
+
+TEST(WorkStealingTaskQueue, TasksFromForeignThread) {
+  engine::impl::RunStandalone(2, kWorkStealing, [] {
+    auto task = engine::AsyncNoSpan([] {
+      engine::SleepFor(std::chrono::milliseconds{1});
+      return 42;
+    });
+    EXPECT_EQ(task.Get(), 42);
+  });
+}
+
+USERVER_NAMESPACE_END
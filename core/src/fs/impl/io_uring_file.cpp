@@ -0,0 +1,115 @@
+#include <fs/impl/io_uring_file.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_control.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+namespace {
+
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+
+std::int64_t CheckResult(std::int64_t result, std::string_view operation,
+                         const std::string& path) {
+  if (result >= 0) return result;
+
+  // Cancelled operations are reported as EAGAIN
+  engine::current_task::CancellationPoint();
+  throw std::system_error(static_cast<int>(-result), std::generic_category(),
+                          fmt::format("Error while {} '{}'", operation, path));
+}
+
+class FileCloser final {
+ public:
+  FileCloser(engine::ev::IoUring& io_uring, int fd) noexcept
+      : io_uring_(io_uring), fd_(fd) {}
+
+  FileCloser(const FileCloser&) = delete;
+  FileCloser& operator=(const FileCloser&) = delete;
+
+  ~FileCloser() {
+    if (fd_ != -1) {
+      engine::TaskCancellationBlocker blocker;
+      [[maybe_unused]] const auto res = io_uring_.Close(fd_);
+    }
+  }
+
+  void Close(const std::string& path) {
+    const auto fd = std::exchange(fd_, -1);
+    CheckResult(io_uring_.Close(fd), "closing", path);
+  }
+
+ private:
+  engine::ev::IoUring& io_uring_;
+  int fd_;
+};
+
+}  // namespace
+
+engine::ev::IoUring* GetCurrentIoUring() {
+  return engine::current_task::GetEventThread().GetIoUring();
+}
+
+std::string ReadFileContents(engine::ev::IoUring& io_uring,
+                             const std::string& path) {
+  const auto fd = static_cast<int>(
+      CheckResult(io_uring.OpenAt(AT_FDCWD, path.c_str(),
+                                  O_RDONLY | O_CLOEXEC, 0),
+                  "opening", path));
+  FileCloser closer{io_uring, fd};
+
+  std::string result;
+  std::uint64_t offset = 0;
+  while (true) {
+    result.resize(offset + kReadChunkSize);
+    const auto bytes_read = CheckResult(
+        io_uring.Read(fd, result.data() + offset, kReadChunkSize, offset),
+        "reading", path);
+    if (bytes_read == 0) break;
+    offset += bytes_read;
+  }
+  result.resize(offset);
+
+  closer.Close(path);
+  return result;
+}
+
+void RewriteFileContents(engine::ev::IoUring& io_uring,
+                         const std::string& path, std::string_view contents) {
+  const auto fd = static_cast<int>(CheckResult(
+      io_uring.OpenAt(AT_FDCWD, path.c_str(),
+                      O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                      S_IRUSR | S_IWUSR),
+      "opening", path));
+  FileCloser closer{io_uring, fd};
+
+  std::uint64_t offset = 0;
+  while (offset < contents.size()) {
+    const auto bytes_written = CheckResult(
+        io_uring.Write(fd, contents.data() + offset, contents.size() - offset,
+                       offset),
+        "writing", path);
+    UINVARIANT(bytes_written != 0, "Zero bytes written to " + path);
+    offset += bytes_written;
+  }
+
+  CheckResult(io_uring.FSync(fd), "syncing", path);
+  closer.Close(path);
+}
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+class IoUring;
+}  // namespace engine::ev
+
+namespace fs::impl {
+
+/// io_uring of an ev thread of the current task processor, nullptr if the
+/// io_uring backend is disabled or not supported
+engine::ev::IoUring* GetCurrentIoUring();
+
+/// Same as fs::blocking::ReadFileContents, but does not block the thread
+std::string ReadFileContents(engine::ev::IoUring& io_uring,
+                             const std::string& path);
+
+/// Same as fs::blocking::RewriteFileContents, but does not block the thread
+void RewriteFileContents(engine::ev::IoUring& io_uring,
+                         const std::string& path, std::string_view contents);
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
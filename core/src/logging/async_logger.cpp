@@ -0,0 +1,324 @@
+#include <logging/async_logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <spdlog/pattern_formatter.h>
+
+#include <logging/spdlog_helpers.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/thread_name.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// The writer wakes up at least this often if nobody wakes it up earlier
+constexpr std::chrono::milliseconds kIdlePeriod{10};
+
+// The records are written to the output sink in batches of about this size
+constexpr std::size_t kMaxBatchSize = 1 << 20;
+
+std::atomic<std::uint64_t> next_logger_id{0};
+
+template <typename T>
+void IncrementBySingleWriter(std::atomic<T>& counter) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+}  // namespace
+
+RecordRing::RecordRing(std::size_t capacity)
+    : data_(std::make_unique<char[]>(capacity)), mask_(capacity - 1) {
+  UINVARIANT(capacity > 0 && (capacity & mask_) == 0,
+             "RecordRing capacity must be a power of 2");
+}
+
+bool RecordRing::TryPush(std::string_view record) noexcept {
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  const auto head = head_.load(std::memory_order_acquire);
+  if (GetCapacity() - (tail - head) < record.size()) return false;
+
+  const auto offset = tail & mask_;
+  const auto first = std::min(record.size(), GetCapacity() - offset);
+  std::memcpy(data_.get() + offset, record.data(), first);
+  std::memcpy(data_.get(), record.data() + first, record.size() - first);
+
+  tail_.store(tail + record.size(), std::memory_order_release);
+  return true;
+}
+
+std::size_t RecordRing::PopAll(spdlog::memory_buf_t& out) {
+  const auto head = head_.load(std::memory_order_relaxed);
+  const auto tail = tail_.load(std::memory_order_acquire);
+  const auto size = tail - head;
+  if (size == 0) return 0;
+
+  const auto offset = head & mask_;
+  const auto first = std::min(size, GetCapacity() - offset);
+  out.append(data_.get() + offset, data_.get() + offset + first);
+  out.append(data_.get(), data_.get() + (size - first));
+
+  head_.store(tail, std::memory_order_release);
+  return size;
+}
+
+std::size_t RecordRing::GetSize() const noexcept {
+  // head is loaded first, so that it never exceeds tail
+  const auto head = head_.load(std::memory_order_acquire);
+  return tail_.load(std::memory_order_acquire) - head;
+}
+
+struct AsyncLogger::Ring final {
+  explicit Ring(std::size_t capacity) : records(capacity) {}
+
+  RecordRing records;
+  // Whether a thread produces into the ring
+  std::atomic<bool> attached{true};
+  std::atomic<bool> logger_alive{true};
+
+  // Written only by the attached thread
+  std::atomic<std::uint64_t> queued{0};
+  std::atomic<std::uint64_t> dropped{0};
+};
+
+struct AsyncLogger::ThreadProducer final {
+  std::uint64_t logger_id;
+  std::shared_ptr<Ring> ring;
+  // spdlog::pattern_formatter caches the time, so each thread needs its own
+  std::unique_ptr<spdlog::formatter> formatter;
+  std::uint64_t formatter_version;
+  spdlog::memory_buf_t buffer;
+};
+
+AsyncLogger::AsyncLogger(std::string name, spdlog::sink_ptr output,
+                         const LoggerConfig& config)
+    : spdlog::logger(std::move(name)),
+      id_(next_logger_id++),
+      output_(std::move(output)),
+      formatter_(MakeSpdlogFormatter(config.format, config.pattern)),
+      thread_buffer_size_(config.thread_buffer_size),
+      overflow_behavior_(config.queue_overflow_behavior) {
+  // The batches are formatted already
+  output_->set_formatter(std::make_unique<spdlog::pattern_formatter>(
+      "%v", spdlog::pattern_time_type::local, ""));
+
+  writer_ = std::thread([this, thread_name = "log/" + this->name()] {
+    utils::SetCurrentThreadName(thread_name);
+    WriterLoop();
+  });
+}
+
+AsyncLogger::~AsyncLogger() {
+  {
+    std::lock_guard lock(writer_mutex_);
+    stop_ = true;
+  }
+  writer_cv_.notify_one();
+  writer_.join();
+
+  std::lock_guard lock(rings_mutex_);
+  for (const auto& ring : rings_) {
+    ring->logger_alive.store(false, std::memory_order_release);
+  }
+}
+
+AsyncLogger::Statistics AsyncLogger::GetStatistics() const {
+  Statistics result;
+  std::lock_guard lock(rings_mutex_);
+  for (const auto& ring : rings_) {
+    result.queued += ring->queued.load(std::memory_order_relaxed);
+    result.dropped += ring->dropped.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+void AsyncLogger::sink_it_(const spdlog::details::log_msg& msg) {
+  for (const auto& sink : sinks_) {
+    if (sink->should_log(msg.level)) sink->log(msg);
+  }
+
+  auto& producer = GetThreadProducer();
+  const auto formatter_version =
+      formatter_version_.load(std::memory_order_acquire);
+  if (producer.formatter_version != formatter_version) {
+    std::lock_guard lock(formatter_mutex_);
+    producer.formatter = formatter_->clone();
+    producer.formatter_version =
+        formatter_version_.load(std::memory_order_relaxed);
+  }
+
+  producer.buffer.clear();
+  producer.formatter->format(msg, producer.buffer);
+  Push(*producer.ring, {producer.buffer.data(), producer.buffer.size()});
+
+  if (should_flush_(msg)) flush_();
+}
+
+void AsyncLogger::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+  UASSERT(formatter);
+  {
+    std::lock_guard lock(formatter_mutex_);
+    formatter_ = formatter->clone();
+    formatter_version_.fetch_add(1, std::memory_order_release);
+  }
+  spdlog::logger::set_formatter(std::move(formatter));
+}
+
+void AsyncLogger::set_pattern(std::string pattern,
+                              spdlog::pattern_time_type time_type) {
+  set_formatter(std::make_unique<spdlog::pattern_formatter>(std::move(pattern),
+                                                            time_type));
+}
+
+void AsyncLogger::flush_() {
+  spdlog::logger::flush_();
+
+  flush_requested_ = true;
+  Wakeup();
+}
+
+AsyncLogger::ThreadProducer& AsyncLogger::GetThreadProducer() {
+  struct ThreadProducers final {
+    ~ThreadProducers() {
+      for (const auto& producer : items) {
+        producer.ring->attached.store(false, std::memory_order_release);
+      }
+    }
+
+    std::vector<ThreadProducer> items;
+  };
+  thread_local ThreadProducers producers;
+
+  for (auto& producer : producers.items) {
+    if (producer.logger_id == id_) return producer;
+  }
+
+  auto& items = producers.items;
+  items.erase(std::remove_if(items.begin(), items.end(),
+                             [](const ThreadProducer& producer) {
+                               return !producer.ring->logger_alive.load(
+                                   std::memory_order_acquire);
+                             }),
+              items.end());
+
+  std::shared_ptr<Ring> ring;
+  {
+    std::lock_guard lock(rings_mutex_);
+    for (const auto& candidate : rings_) {
+      bool expected = false;
+      if (candidate->attached.compare_exchange_strong(
+              expected, true, std::memory_order_acq_rel)) {
+        ring = candidate;
+        break;
+      }
+    }
+    if (!ring) {
+      ring = std::make_shared<Ring>(thread_buffer_size_);
+      rings_.push_back(ring);
+    }
+  }
+
+  std::lock_guard lock(formatter_mutex_);
+  return items.emplace_back(ThreadProducer{
+      id_, std::move(ring), formatter_->clone(),
+      formatter_version_.load(std::memory_order_relaxed), {}});
+}
+
+void AsyncLogger::Push(Ring& ring, std::string_view record) {
+  auto& records = ring.records;
+  if (record.size() > records.GetCapacity()) {
+    IncrementBySingleWriter(ring.dropped);
+    return;
+  }
+
+  while (!records.TryPush(record)) {
+    if (overflow_behavior_ == LoggerConfig::QueueOveflowBehavior::kDiscard) {
+      IncrementBySingleWriter(ring.dropped);
+      return;
+    }
+    Wakeup();
+    std::this_thread::yield();
+  }
+  IncrementBySingleWriter(ring.queued);
+
+  if (records.GetSize() > records.GetCapacity() / 2) Wakeup();
+}
+
+void AsyncLogger::Wakeup() {
+  if (wakeup_requested_.exchange(true)) return;
+
+  // Makes sure that the writer either sees the request or is waiting already
+  { std::lock_guard lock(writer_mutex_); }
+  writer_cv_.notify_one();
+}
+
+void AsyncLogger::WriterLoop() {
+  spdlog::memory_buf_t batch;
+  std::vector<std::shared_ptr<Ring>> rings;
+
+  while (true) {
+    const bool stop = stop_.load();
+    const bool flush = flush_requested_.exchange(false);
+
+    {
+      std::lock_guard lock(rings_mutex_);
+      rings.assign(rings_.begin(), rings_.end());
+    }
+
+    bool written = false;
+    for (const auto& ring : rings) {
+      if (ring->records.PopAll(batch) != 0) written = true;
+      if (batch.size() >= kMaxBatchSize) WriteBatch(batch);
+    }
+    WriteBatch(batch);
+
+    if (flush || stop) {
+      try {
+        output_->flush();
+      } catch (const std::exception& e) {
+        err_handler_(e.what());
+      }
+    }
+    if (stop) break;
+
+    if (!written) {
+      std::unique_lock lock(writer_mutex_);
+      writer_cv_.wait_for(lock, kIdlePeriod, [this] {
+        return wakeup_requested_.load() || stop_.load();
+      });
+    }
+    wakeup_requested_ = false;
+  }
+}
+
+void AsyncLogger::WriteBatch(spdlog::memory_buf_t& batch) {
+  if (batch.size() == 0) return;
+
+  const spdlog::details::log_msg msg{
+      name(), spdlog::level::critical,
+      spdlog::string_view_t{batch.data(), batch.size()}};
+  try {
+    output_->log(msg);
+  } catch (const std::exception& e) {
+    err_handler_(e.what());
+  }
+  batch.clear();
+}
+
+void SetFormatter(spdlog::logger& logger,
+                  std::unique_ptr<spdlog::formatter> formatter) {
+  if (auto* async_logger = dynamic_cast<AsyncLogger*>(&logger)) {
+    async_logger->set_formatter(std::move(formatter));
+  } else {
+    logger.set_formatter(std::move(formatter));
+  }
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/formatter.h>
+#include <spdlog/logger.h>
+
+#include "config.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// Lock-free single producer single consumer ring of formatted records.
+/// A record is either pushed as a whole or not pushed at all.
+class RecordRing final {
+ public:
+  /// @param capacity size in bytes, must be a power of 2
+  explicit RecordRing(std::size_t capacity);
+
+  /// Producer side
+  bool TryPush(std::string_view record) noexcept;
+
+  /// Consumer side, appends all the pushed records to `out`
+  /// @returns the number of appended bytes
+  std::size_t PopAll(spdlog::memory_buf_t& out);
+
+  std::size_t GetCapacity() const noexcept { return mask_ + 1; }
+
+  /// Approximate number of bytes in the ring
+  std::size_t GetSize() const noexcept;
+
+ private:
+  const std::unique_ptr<char[]> data_;
+  const std::size_t mask_;
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+/// spdlog::logger that formats the records in the calling thread into
+/// a per-thread RecordRing. A single writer thread collects the records of all
+/// the threads and writes them to the output sink in large batches.
+///
+/// The output sink gets the batches as the payload of a log_msg and must not
+/// add anything to them. Sinks added via sinks() get each message
+/// synchronously, as with a plain spdlog::logger.
+///
+/// Records of different threads may get to the output in a different order
+/// than they were logged in, e.g. when a coroutine migrates between threads.
+class AsyncLogger final : public spdlog::logger {
+ public:
+  struct Statistics {
+    /// Records that got into the buffers
+    std::uint64_t queued{0};
+    /// Records that were discarded because the buffer was full
+    std::uint64_t dropped{0};
+  };
+
+  AsyncLogger(std::string name, spdlog::sink_ptr output,
+              const LoggerConfig& config);
+  ~AsyncLogger() override;
+
+  const spdlog::sink_ptr& GetOutputSink() const noexcept { return output_; }
+
+  /// Replaces the formatter of the records and of the extra sinks. Hides the
+  /// non-virtual spdlog::logger one, use impl::SetFormatter via a base
+  /// reference.
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter);
+
+  void set_pattern(std::string pattern, spdlog::pattern_time_type time_type =
+                                            spdlog::pattern_time_type::local);
+
+  Statistics GetStatistics() const;
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+  void flush_() override;
+
+ private:
+  struct Ring;
+  struct ThreadProducer;
+
+  ThreadProducer& GetThreadProducer();
+  void Push(Ring& ring, std::string_view record);
+  void Wakeup();
+  void WriterLoop();
+  void WriteBatch(spdlog::memory_buf_t& batch);
+
+  const std::uint64_t id_;
+  const spdlog::sink_ptr output_;
+  // The threads re-clone the formatter when the version changes
+  mutable std::mutex formatter_mutex_;
+  std::unique_ptr<spdlog::formatter> formatter_;
+  std::atomic<std::uint64_t> formatter_version_{0};
+  const std::size_t thread_buffer_size_;
+  const LoggerConfig::QueueOveflowBehavior overflow_behavior_;
+
+  mutable std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  std::mutex writer_mutex_;
+  std::condition_variable writer_cv_;
+  std::atomic<bool> wakeup_requested_{false};
+  std::atomic<bool> flush_requested_{false};
+  std::atomic<bool> stop_{false};
+  std::thread writer_;
+};
+
+/// Calls AsyncLogger::set_formatter if `logger` is an AsyncLogger and
+/// spdlog::logger::set_formatter otherwise.
+void SetFormatter(spdlog::logger& logger,
+                  std::unique_ptr<spdlog::formatter> formatter);
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
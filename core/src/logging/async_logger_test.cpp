@@ -0,0 +1,196 @@
+#include <logging/async_logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string PopAll(logging::impl::RecordRing& ring) {
+  spdlog::memory_buf_t buffer;
+  ring.PopAll(buffer);
+  return {buffer.data(), buffer.size()};
+}
+
+logging::LoggerConfig MakeConfig(std::size_t thread_buffer_size) {
+  logging::LoggerConfig config;
+  config.pattern = "%v";
+  config.thread_buffer_size = thread_buffer_size;
+  return config;
+}
+
+}  // namespace
+
+TEST(RecordRing, PushPop) {
+  logging::impl::RecordRing ring(16);
+  EXPECT_EQ(ring.GetCapacity(), 16);
+  EXPECT_EQ(PopAll(ring), "");
+
+  EXPECT_TRUE(ring.TryPush("abc\n"));
+  EXPECT_TRUE(ring.TryPush("de\n"));
+  EXPECT_EQ(ring.GetSize(), 7);
+  EXPECT_EQ(PopAll(ring), "abc\nde\n");
+  EXPECT_EQ(ring.GetSize(), 0);
+}
+
+TEST(RecordRing, Full) {
+  logging::impl::RecordRing ring(8);
+  EXPECT_TRUE(ring.TryPush("12345"));
+  EXPECT_FALSE(ring.TryPush("6789"));
+  EXPECT_TRUE(ring.TryPush("678"));
+  EXPECT_FALSE(ring.TryPush("9"));
+  EXPECT_EQ(PopAll(ring), "12345678");
+}
+
+TEST(RecordRing, Wraparound) {
+  logging::impl::RecordRing ring(8);
+  EXPECT_TRUE(ring.TryPush("12345"));
+  EXPECT_EQ(PopAll(ring), "12345");
+
+  EXPECT_TRUE(ring.TryPush("abcdef"));
+  EXPECT_EQ(PopAll(ring), "abcdef");
+  EXPECT_TRUE(ring.TryPush("ghijklmn"));
+  EXPECT_EQ(PopAll(ring), "ghijklmn");
+}
+
+TEST(AsyncLogger, WritesFromManyThreads) {
+  constexpr std::size_t kThreads = 8;
+  constexpr std::size_t kMessagesPerThread = 1000;
+
+  std::ostringstream stream;
+  {
+    auto config = MakeConfig(1 << 16);
+    config.queue_overflow_behavior =
+        logging::LoggerConfig::QueueOveflowBehavior::kBlock;
+    logging::impl::AsyncLogger logger(
+        "test", std::make_shared<spdlog::sinks::ostream_sink_st>(stream),
+        config);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&logger, i] {
+        for (std::size_t j = 0; j < kMessagesPerThread; ++j) {
+          logger.info("{}-{}", i, j);
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const auto stats = logger.GetStatistics();
+    EXPECT_EQ(stats.queued, kThreads * kMessagesPerThread);
+    EXPECT_EQ(stats.dropped, 0);
+  }
+
+  const auto output = stream.str();
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    for (std::size_t j = 0; j < kMessagesPerThread; ++j) {
+      expected.push_back(std::to_string(i) + '-' + std::to_string(j));
+    }
+  }
+
+  std::vector<std::string> lines;
+  std::istringstream input(output);
+  for (std::string line; std::getline(input, line);) lines.push_back(line);
+  std::sort(lines.begin(), lines.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(lines, expected);
+}
+
+TEST(AsyncLogger, Flush) {
+  class FlushCountingSink final : public spdlog::sinks::sink {
+   public:
+    void log(const spdlog::details::log_msg&) override {}
+    void flush() override { ++flushes; }
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    std::atomic<std::size_t> flushes{0};
+  };
+
+  auto sink = std::make_shared<FlushCountingSink>();
+  logging::impl::AsyncLogger logger("test", sink, MakeConfig(1 << 10));
+
+  logger.info("message");
+  logger.flush();
+  // The writer thread flushes the output sink asynchronously
+  while (sink->flushes == 0) std::this_thread::yield();
+}
+
+TEST(AsyncLogger, Discard) {
+  std::ostringstream stream;
+  {
+    logging::impl::AsyncLogger logger(
+        "test", std::make_shared<spdlog::sinks::ostream_sink_mt>(stream),
+        MakeConfig(16));
+
+    logger.info("{}", std::string(32, '*'));
+    auto stats = logger.GetStatistics();
+    EXPECT_EQ(stats.queued, 0);
+    EXPECT_EQ(stats.dropped, 1);
+
+    logger.info("short");
+    stats = logger.GetStatistics();
+    EXPECT_EQ(stats.queued, 1);
+    EXPECT_EQ(stats.dropped, 1);
+  }
+  EXPECT_EQ(stream.str(), "short\n");
+}
+
+TEST(AsyncLogger, ExtraSinks) {
+  std::ostringstream output;
+  std::ostringstream extra;
+  {
+    logging::impl::AsyncLogger logger(
+        "test", std::make_shared<spdlog::sinks::ostream_sink_mt>(output),
+        MakeConfig(1 << 10));
+    auto extra_sink = std::make_shared<spdlog::sinks::ostream_sink_st>(extra);
+    extra_sink->set_pattern("extra %v");
+    logger.sinks().push_back(extra_sink);
+
+    logger.info("message");
+    EXPECT_EQ(extra.str(), "extra message\n");
+  }
+  EXPECT_EQ(output.str(), "message\n");
+}
+
+TEST(AsyncLogger, SetFormatter) {
+  std::ostringstream stream;
+  {
+    logging::impl::AsyncLogger logger(
+        "test", std::make_shared<spdlog::sinks::ostream_sink_mt>(stream),
+        MakeConfig(1 << 10));
+
+    logger.info("first");
+    logger.set_pattern("new %v");
+    logger.info("second");
+
+    // Threads that start logging after the change get the new formatter too
+    std::thread([&logger] { logger.info("third"); }).join();
+
+    logging::impl::SetFormatter(
+        static_cast<spdlog::logger&>(logger),
+        std::make_unique<spdlog::pattern_formatter>(
+            "newer %v", spdlog::pattern_time_type::local));
+    logger.info("fourth");
+  }
+  // Records of different threads may be reordered
+  std::vector<std::string> lines;
+  std::istringstream input(stream.str());
+  for (std::string line; std::getline(input, line);) lines.push_back(line);
+  std::sort(lines.begin(), lines.end());
+  EXPECT_EQ(lines, (std::vector<std::string>{"first", "new second",
+                                             "new third", "newer fourth"}));
+}
+
+USERVER_NAMESPACE_END
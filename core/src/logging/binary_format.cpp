@@ -0,0 +1,217 @@
+#include <logging/binary_format.hpp>
+
+#include <array>
+#include <ctime>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <logging/spdlog.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+namespace {
+
+// Ids of the keys are their indices, never reorder or remove the keys
+constexpr std::array<std::string_view, 14> kWellKnownKeys{
+    "",  // kInlineKey
+    "module",
+    "task_id",
+    "thread_id",
+    "text",
+    "trace_id",
+    "span_id",
+    "parent_id",
+    "link",
+    "stopwatch_name",
+    "total_time",
+    "span_ref_type",
+    "stopwatch_units",
+    "start_timestamp",
+};
+
+constexpr std::size_t kRecordSizeSize = sizeof(std::uint32_t);
+
+class RecordReader final {
+ public:
+  explicit RecordReader(std::string_view data) : data_(data) {}
+
+  bool IsEmpty() const noexcept { return data_.empty(); }
+
+  template <typename T>
+  T GetInteger() {
+    const auto bytes = GetBytes(sizeof(T));
+    std::make_unsigned_t<T> bits = 0;
+    for (std::size_t i = sizeof(T); i > 0; --i) {
+      bits = static_cast<decltype(bits)>(bits << 8);
+      bits |= static_cast<unsigned char>(bytes[i - 1]);
+    }
+    return static_cast<T>(bits);
+  }
+
+  std::string_view GetBytes(std::size_t size) {
+    if (size > data_.size()) {
+      throw std::runtime_error("Malformed binary log record: unexpected end");
+    }
+    const auto result = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return result;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+struct PutCharString final {
+  void operator()(std::string& to, char ch) const { to.push_back(ch); }
+};
+
+void AppendTimestamp(std::string& out, std::int64_t timestamp_us) {
+  constexpr std::int64_t kMicrosecondsInSecond = 1'000'000;
+  auto seconds = timestamp_us / kMicrosecondsInSecond;
+  auto microseconds = timestamp_us % kMicrosecondsInSecond;
+  if (microseconds < 0) {
+    --seconds;
+    microseconds += kMicrosecondsInSecond;
+  }
+
+  const auto time = static_cast<std::time_t>(seconds);
+  std::tm tm{};
+  localtime_r(&time, &tm);
+
+  std::array<char, 32> buffer{};
+  const auto size =
+      std::strftime(buffer.data(), buffer.size(), "%Y-%m-%dT%H:%M:%S", &tm);
+  out.append(buffer.data(), size);
+  fmt::format_to(std::back_inserter(out), FMT_COMPILE(".{:06}"), microseconds);
+}
+
+void AppendValue(std::string& out, RecordReader& reader) {
+  const auto type = static_cast<ValueType>(reader.GetInteger<std::uint8_t>());
+  switch (type) {
+    case ValueType::kString: {
+      const auto value = reader.GetBytes(reader.GetInteger<std::uint32_t>());
+      utils::encoding::EncodeTskv(out, value.begin(), value.end(),
+                                  utils::encoding::EncodeTskvMode::kValue,
+                                  PutCharString{});
+      return;
+    }
+    case ValueType::kInt64:
+      fmt::format_to(std::back_inserter(out), FMT_COMPILE("{}"),
+                     reader.GetInteger<std::int64_t>());
+      return;
+    case ValueType::kUInt64:
+      fmt::format_to(std::back_inserter(out), FMT_COMPILE("{}"),
+                     reader.GetInteger<std::uint64_t>());
+      return;
+    case ValueType::kDouble: {
+      const auto bits = reader.GetInteger<std::uint64_t>();
+      double value{};
+      std::memcpy(&value, &bits, sizeof(value));
+      fmt::format_to(std::back_inserter(out), FMT_COMPILE("{}"), value);
+      return;
+    }
+    case ValueType::kHex:
+      fmt::format_to(std::back_inserter(out), FMT_COMPILE("{:X}"),
+                     reader.GetInteger<std::uint64_t>());
+      return;
+  }
+
+  throw std::runtime_error(
+      fmt::format("Malformed binary log record: unknown value type {}",
+                  static_cast<int>(type)));
+}
+
+void AppendRecordAsTskv(std::string& out, std::string_view record) {
+  RecordReader reader{record};
+
+  const auto version = reader.GetInteger<std::uint8_t>();
+  if (version != kVersion) {
+    throw std::runtime_error(fmt::format(
+        "Unsupported binary log record version {}", static_cast<int>(version)));
+  }
+
+  out += "tskv\ttimestamp=";
+  AppendTimestamp(out, reader.GetInteger<std::int64_t>());
+
+  const auto level = reader.GetInteger<std::uint8_t>();
+  if (level >= spdlog::level::n_levels) {
+    throw std::runtime_error(
+        fmt::format("Malformed binary log record: unknown level {}",
+                    static_cast<int>(level)));
+  }
+  out += "\tlevel=";
+  const auto level_name = spdlog::level::to_string_view(
+      static_cast<spdlog::level::level_enum>(level));
+  out.append(level_name.data(), level_name.size());
+
+  while (!reader.IsEmpty()) {
+    out += utils::encoding::kTskvPairsSeparator;
+
+    const auto key_id = reader.GetInteger<std::uint8_t>();
+    const auto key = key_id == kInlineKey
+                         ? reader.GetBytes(reader.GetInteger<std::uint8_t>())
+                         : GetKeyById(key_id);
+    utils::encoding::EncodeTskv(
+        out, key.begin(), key.end(),
+        utils::encoding::EncodeTskvMode::kKeyReplacePeriod, PutCharString{});
+    out += utils::encoding::kTskvKeyValueSeparator;
+
+    AppendValue(out, reader);
+  }
+  out += '\n';
+}
+
+}  // namespace
+
+std::uint8_t FindKeyId(std::string_view key) noexcept {
+  for (std::size_t i = 1; i < kWellKnownKeys.size(); ++i) {
+    if (kWellKnownKeys[i] == key) return static_cast<std::uint8_t>(i);
+  }
+  return kInlineKey;
+}
+
+std::string_view GetKeyById(std::uint8_t id) {
+  if (id == kInlineKey || id >= kWellKnownKeys.size()) {
+    throw std::runtime_error(
+        fmt::format("Malformed binary log record: unknown key id {}",
+                    static_cast<int>(id)));
+  }
+  return kWellKnownKeys[id];
+}
+
+void ConvertToTskv(std::istream& in, std::ostream& out) {
+  std::string record;
+  std::string line;
+
+  while (true) {
+    char size_bytes[kRecordSizeSize];
+    in.read(size_bytes, kRecordSizeSize);
+    if (in.gcount() == 0) break;
+    if (static_cast<std::size_t>(in.gcount()) != kRecordSizeSize) {
+      throw std::runtime_error("Truncated binary log record size");
+    }
+
+    RecordReader size_reader{{size_bytes, kRecordSizeSize}};
+    record.resize(size_reader.GetInteger<std::uint32_t>());
+    in.read(record.data(), record.size());
+    if (static_cast<std::size_t>(in.gcount()) != record.size()) {
+      throw std::runtime_error("Truncated binary log record");
+    }
+
+    line.clear();
+    AppendRecordAsTskv(line, record);
+    out << line;
+  }
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string_view>
+#include <type_traits>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief Binary log records for logging::Format::kBinary
+///
+/// Each record is:
+/// - u32 size of the rest of the record;
+/// - u8 version of the format, kVersion;
+/// - i64 timestamp in microseconds since the Unix epoch;
+/// - u8 logging::Level;
+/// - fields up to the end of the record.
+///
+/// A field is a key followed by a typed value. The key is either an u8 id of
+/// a well-known key or kInlineKey followed by u8 size and the key itself.
+/// The value is an u8 ValueType followed by u32 size and the bytes for
+/// kString or by 8 bytes for the other types. All the integers are
+/// little-endian, the strings are stored without any escaping.
+namespace logging::impl::binary {
+
+inline constexpr std::uint8_t kVersion = 1;
+inline constexpr std::uint8_t kInlineKey = 0;
+
+enum class ValueType : std::uint8_t {
+  kString = 1,
+  kInt64 = 2,
+  kUInt64 = 3,
+  kDouble = 4,
+  kHex = 5,  ///< kUInt64 that is displayed in hex
+};
+
+/// @returns the id of a well-known key or kInlineKey
+std::uint8_t FindKeyId(std::string_view key) noexcept;
+
+/// @throws std::runtime_error if `id` is not an id of a well-known key
+std::string_view GetKeyById(std::uint8_t id);
+
+/// @brief Reads the binary records from `in` and writes them to `out` as
+/// TSKV lines, the timestamps are written in the local time zone
+/// @throws std::runtime_error if the input is malformed
+void ConvertToTskv(std::istream& in, std::ostream& out);
+
+template <typename Buffer, typename T>
+void PutInteger(Buffer& buffer, T value) {
+  static_assert(std::is_integral_v<T>);
+
+  auto bits = static_cast<std::make_unsigned_t<T>>(value);
+  char bytes[sizeof(T)];
+  for (auto& byte : bytes) {
+    byte = static_cast<char>(bits & 0xFF);
+    bits = static_cast<decltype(bits)>(bits >> 8);
+  }
+  buffer.append(bytes, bytes + sizeof(T));
+}
+
+template <typename Buffer>
+void PutKey(Buffer& buffer, std::string_view key) {
+  const auto id = FindKeyId(key);
+  PutInteger(buffer, id);
+  if (id != kInlineKey) return;
+
+  key = key.substr(0, UINT8_MAX);
+  PutInteger(buffer, static_cast<std::uint8_t>(key.size()));
+  buffer.append(key.data(), key.data() + key.size());
+}
+
+/// Writes the key and the type of a string value whose bytes are appended
+/// later
+/// @returns offset of the size of the string to pass to FinishString
+template <typename Buffer>
+std::size_t BeginString(Buffer& buffer, std::string_view key) {
+  PutKey(buffer, key);
+  PutInteger(buffer, static_cast<std::uint8_t>(ValueType::kString));
+
+  const auto size_offset = buffer.size();
+  PutInteger(buffer, std::uint32_t{0});
+  return size_offset;
+}
+
+template <typename Buffer>
+void FinishString(Buffer& buffer, std::size_t size_offset) {
+  const auto string_begin = size_offset + sizeof(std::uint32_t);
+  const auto size = static_cast<std::uint32_t>(buffer.size() - string_begin);
+  for (std::size_t i = 0; i < sizeof(size); ++i) {
+    buffer.data()[size_offset + i] = static_cast<char>((size >> 8 * i) & 0xFF);
+  }
+}
+
+template <typename Buffer>
+void PutString(Buffer& buffer, std::string_view key, std::string_view value) {
+  PutKey(buffer, key);
+  PutInteger(buffer, static_cast<std::uint8_t>(ValueType::kString));
+  PutInteger(buffer, static_cast<std::uint32_t>(value.size()));
+  buffer.append(value.data(), value.data() + value.size());
+}
+
+template <typename Buffer>
+void PutNumber(Buffer& buffer, std::string_view key, ValueType type,
+               std::uint64_t bits) {
+  PutKey(buffer, key);
+  PutInteger(buffer, static_cast<std::uint8_t>(type));
+  PutInteger(buffer, bits);
+}
+
+template <typename Buffer>
+void PutDouble(Buffer& buffer, std::string_view key, double value) {
+  static_assert(sizeof(double) == sizeof(std::uint64_t));
+  std::uint64_t bits{};
+  std::memcpy(&bits, &value, sizeof(bits));
+  PutNumber(buffer, key, ValueType::kDouble, bits);
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
@@ -12,9 +12,9 @@
 
 #include <fmt/format.h>
 
-#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include <logging/async_logger.hpp>
 #include <logging/logger_with_info.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <logging/spdlog_helpers.hpp>
@@ -22,12 +22,13 @@
 #include <userver/components/component.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
-#include <userver/utils/thread_name.hpp>
+#include <userver/utils/statistics/metadata.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include "config.hpp"
@@ -65,19 +66,27 @@ std::optional<TestsuiteCaptureConfig> GetTestsuiteCaptureConfig(
   return config.As<TestsuiteCaptureConfig>();
 }
 
-void ReopenAll(std::vector<spdlog::sink_ptr>& sinks) {
-  for (const auto& s : sinks) {
-    auto reop = std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s);
-    if (!reop) {
-      continue;
-    }
+void Reopen(const spdlog::sink_ptr& sink) {
+  auto reop = std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(sink);
+  if (!reop) {
+    return;
+  }
 
-    try {
-      bool should_truncate = false;
-      reop->Reopen(should_truncate);
-    } catch (const std::exception& e) {
-      LOG_ERROR() << "Exception on log reopen: " << e;
-    }
+  try {
+    bool should_truncate = false;
+    reop->Reopen(should_truncate);
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Exception on log reopen: " << e;
+  }
+}
+
+void ReopenAll(spdlog::logger& logger) {
+  for (const auto& s : logger.sinks()) {
+    Reopen(s);
+  }
+
+  if (auto* async_logger = dynamic_cast<logging::impl::AsyncLogger*>(&logger)) {
+    Reopen(async_logger->GetOutputSink());
   }
 }
 
@@ -117,25 +126,24 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
     return logging::MakeStdoutLogger(logger_name, logger_config.format,
                                      logger_config.level);
 
-  auto overflow_policy = spdlog::async_overflow_policy::overrun_oldest;
-  if (logger_config.queue_overflow_behavior ==
-      logging::LoggerConfig::QueueOveflowBehavior::kBlock) {
-    overflow_policy = spdlog::async_overflow_policy::block;
-  }
-
   CreateLogDirectory(logger_name, logger_config.file_path);
   spdlog::sink_ptr sink = GetSinkFromFilename(logger_config.file_path);
 
-  auto tp = std::make_shared<spdlog::details::thread_pool>(
-      logger_config.message_queue_size, logger_config.thread_pool_size,
-      [thread_name = "log/" + logger_name] {
-        utils::SetCurrentThreadName(thread_name);
-      });
-
   return std::make_shared<logging::impl::LoggerWithInfo>(
-      logger_config.format, tp,
-      utils::MakeSharedRef<spdlog::async_logger>(logger_name, std::move(sink),
-                                                 tp, overflow_policy));
+      logger_config.format, utils::MakeSharedRef<logging::impl::AsyncLogger>(
+                                logger_name, std::move(sink), logger_config));
+}
+
+void AddStatistics(formats::json::ValueBuilder& builder,
+                   const std::string& logger_name,
+                   const logging::LoggerPtr& logger) {
+  const auto* async_logger =
+      dynamic_cast<const logging::impl::AsyncLogger*>(&*logger->ptr);
+  if (!async_logger) return;
+
+  const auto stats = async_logger->GetStatistics();
+  builder[logger_name]["queued"] = stats.queued;
+  builder[logger_name]["dropped"] = stats.dropped;
 }
 
 }  // namespace
@@ -215,7 +223,9 @@ Logging::Logging(const ComponentConfig& config, const ComponentContext& context)
 
     logger->ptr->set_level(
         static_cast<spdlog::level::level_enum>(logger_config.level));
-    logger->ptr->set_pattern(logger_config.pattern);
+    logging::impl::SetFormatter(
+        *logger->ptr, logging::MakeSpdlogFormatter(logger_config.format,
+                                                   logger_config.pattern));
     logger->ptr->flush_on(
         static_cast<spdlog::level::level_enum>(logger_config.flush_level));
 
@@ -292,11 +302,11 @@ void Logging::TryReopenFiles() {
   // this must be a copy as the default logger may change
   auto default_logger = logging::DefaultLogger();
   tasks.push_back(engine::CriticalAsyncNoSpan(
-      *fs_task_processor_, ReopenAll, std::ref(default_logger->ptr->sinks())));
+      *fs_task_processor_, ReopenAll, std::ref(*default_logger->ptr)));
 
   for (const auto& item : loggers_) {
     tasks.push_back(engine::CriticalAsyncNoSpan(
-        *fs_task_processor_, ReopenAll, std::ref(item.second->ptr->sinks())));
+        *fs_task_processor_, ReopenAll, std::ref(*item.second->ptr)));
   }
 
   std::string result_messages;
@@ -323,6 +333,17 @@ void Logging::FlushLogs() {
   }
 }
 
+formats::json::Value Logging::ExtendStatistics(
+    const utils::statistics::StatisticsRequest& /*request*/) {
+  formats::json::ValueBuilder builder(formats::json::Type::kObject);
+  AddStatistics(builder, "default", logging::DefaultLogger());
+  for (const auto& [name, logger] : loggers_) {
+    AddStatistics(builder, name, logger);
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(builder, "logger");
+  return builder.ExtractValue();
+}
+
 yaml_config::Schema Logging::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<impl::ComponentBase>(R"(
 type: object
@@ -356,17 +377,22 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
                     defaultDescription: warning
                 message_queue_size:
                     type: integer
-                    description: the size of internal message queue, must be a power of 2
+                    description: deprecated and ignored, see thread_buffer_size
+                    defaultDescription: 65536
+                thread_buffer_size:
+                    type: integer
+                    description: the size in bytes of the buffer of formatted messages of each thread that writes to the logger, must be a power of 2; the buffer is allocated on the first message of the thread, longer messages are dropped
                     defaultDescription: 65536
                 overflow_behavior:
                     type: string
-                    description: "message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue"
+                    description: "message handling policy while the buffer is full: `discard` drops messages, `block` waits until message gets into the buffer"
                     defaultDescription: discard
                     enum:
                       - discard
@@ -55,6 +55,13 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_pool_size = value["thread_pool_size"].As<size_t>(
       LoggerConfig::kDefaultThreadPoolSize);
 
+  config.thread_buffer_size = value["thread_buffer_size"].As<size_t>(
+      LoggerConfig::kDefaultThreadBufferSize);
+  if (config.thread_buffer_size == 0 ||
+      (config.thread_buffer_size & (config.thread_buffer_size - 1))) {
+    throw std::runtime_error("log thread buffer size must be a power of 2");
+  }
+
   return config;
 }
 
@@ -15,6 +15,7 @@ namespace logging {
 struct LoggerConfig {
   static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
   static constexpr size_t kDefaultThreadPoolSize = 1;
+  static constexpr size_t kDefaultThreadBufferSize = 1 << 16;
 
   enum class QueueOveflowBehavior { kDiscard, kBlock };
 
@@ -24,11 +25,14 @@ struct LoggerConfig {
   std::string pattern;  // deprecated
   Level flush_level = Level::kWarning;
 
-  // must be a power of 2
+  // deprecated, must be a power of 2
   size_t message_queue_size = kDefaultMessageQueueSize;
   QueueOveflowBehavior queue_overflow_behavior = QueueOveflowBehavior::kDiscard;
 
-  size_t thread_pool_size = kDefaultThreadPoolSize;
+  size_t thread_pool_size = kDefaultThreadPoolSize;  // deprecated
+
+  // per-thread buffer of formatted records in bytes, must be a power of 2
+  size_t thread_buffer_size = kDefaultThreadBufferSize;
 };
 
 LoggerConfig Parse(const yaml_config::YamlConfig& value,
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <logging/binary_format.hpp>
+#include <logging/logger_with_info.hpp>
+#include <logging/logging_test.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/logging/logger.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string ToTskv(const std::string& binary) {
+  std::istringstream in(binary);
+  std::ostringstream out;
+  logging::impl::binary::ConvertToTskv(in, out);
+  return out.str();
+}
+
+std::string MakeRecord(std::string_view fields) {
+  namespace binary = logging::impl::binary;
+
+  fmt::memory_buffer buffer;
+  binary::PutInteger(buffer, static_cast<std::uint32_t>(1 + 8 + 1 +
+                                                        fields.size()));
+  binary::PutInteger(buffer, binary::kVersion);
+  binary::PutInteger(buffer, std::int64_t{1'500'000});
+  binary::PutInteger(buffer, static_cast<std::uint8_t>(logging::Level::kInfo));
+  buffer.append(fields.data(), fields.data() + fields.size());
+  return {buffer.data(), buffer.size()};
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+  LOG_INFO() << "text\twith tab"
+             << logging::LogExtra{{"int", -42},
+                                  {"unsigned", 42u},
+                                  {"double", 1.5},
+                                  {"dotted.key", "value"}};
+
+  logging::LogFlush();
+  const auto binary = GetStreamString();
+  EXPECT_EQ(binary.find("text="), std::string::npos);
+
+  const auto tskv = ToTskv(binary);
+  EXPECT_EQ(tskv.rfind("tskv\ttimestamp=", 0), 0) << tskv;
+  EXPECT_NE(tskv.find("\tlevel=INFO\tmodule="), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\ttask_id="), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tthread_id="), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\ttext=text\\twith tab\t"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tint=-42"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tunsigned=42"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tdouble=1.5"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tdotted_key=value\n"), std::string::npos) << tskv;
+}
+
+TEST_F(LoggingBinaryTest, ManyRecords) {
+  for (int i = 0; i < 10; ++i) {
+    LOG_INFO() << "message " << i;
+  }
+
+  logging::LogFlush();
+  const auto tskv = ToTskv(GetStreamString());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NE(tskv.find("\ttext=message " + std::to_string(i) + '\n'),
+              std::string::npos)
+        << tskv;
+  }
+}
+
+TEST_F(LoggingBinaryTest, LogRaw) {
+  auto logger = logging::DefaultLogger();
+  logging::impl::LogRaw(*logger, logging::Level::kWarning, "raw\tmessage");
+
+  logging::LogFlush();
+  const auto tskv = ToTskv(GetStreamString());
+  EXPECT_NE(tskv.find("\tlevel=WARNING\ttext=raw\\tmessage\n"),
+            std::string::npos)
+      << tskv;
+}
+
+TEST(LogBinaryFormat, InlineKeys) {
+  namespace binary = logging::impl::binary;
+
+  fmt::memory_buffer fields;
+  binary::PutString(fields, "text", "hello");
+  binary::PutNumber(fields, "custom", binary::ValueType::kHex, 255);
+  binary::PutDouble(fields, "ratio", 0.25);
+
+  const auto tskv = ToTskv(MakeRecord({fields.data(), fields.size()}));
+  EXPECT_NE(tskv.find(".500000\tlevel=INFO\ttext=hello\tcustom=FF\t"
+                      "ratio=0.25\n"),
+            std::string::npos)
+      << tskv;
+}
+
+TEST(LogBinaryFormat, Malformed) {
+  namespace binary = logging::impl::binary;
+
+  EXPECT_EQ(ToTskv({}), "");
+  EXPECT_THROW(ToTskv("\x01\x00"), std::runtime_error);
+
+  const auto record = MakeRecord({});
+  EXPECT_THROW(ToTskv(record.substr(0, record.size() - 1)), std::runtime_error);
+
+  fmt::memory_buffer fields;
+  binary::PutString(fields, "text", "hello");
+  const std::string_view truncated{fields.data(), fields.size() - 1};
+  EXPECT_THROW(ToTskv(MakeRecord(truncated)), std::runtime_error);
+
+  const std::string unknown_key = "\xFF\x01";
+  EXPECT_THROW(ToTskv(MakeRecord(unknown_key)), std::runtime_error);
+}
+
+USERVER_NAMESPACE_END
@@ -28,6 +28,7 @@
 #include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/encoding/tskv.hpp>
 #include <userver/utils/traceful_exception.hpp>
+#include <utils/internal_tag.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -141,6 +142,7 @@ bool LogHelper::IsLimitReached() const noexcept {
 
 void LogHelper::DoLog() noexcept {
   try {
+    if (pimpl_->IsBinary()) pimpl_->FinishBinaryString();
     AppendLogExtra();
     if (pimpl_->IsStreamInitialized()) {
       Stream().flush();
@@ -173,6 +175,13 @@ void LogHelper::AppendLogExtra() {
   const auto& items = pimpl_->GetLogExtra().extra_;
   if (items->empty()) return;
 
+  if (pimpl_->IsBinary()) {
+    for (const auto& item : *items) {
+      pimpl_->PutBinaryValue(item.first, item.second.GetValue());
+    }
+    return;
+  }
+
   for (const auto& item : *items) {
     Put(utils::encoding::kTskvPairsSeparator);
     {
@@ -186,6 +195,11 @@ void LogHelper::AppendLogExtra() {
 }
 
 void LogHelper::LogTextKey() {
+  if (pimpl_->IsBinary()) {
+    pimpl_->BeginBinaryString("text");
+    return;
+  }
+
   Put(utils::encoding::kTskvPairsSeparator);
   Put("text");
   pimpl_->PutKeyValueSeparator();
@@ -193,14 +207,21 @@ void LogHelper::LogTextKey() {
 
 void LogHelper::LogModule(std::string_view path, int line,
                           std::string_view func) {
-  Put("module");
-  pimpl_->PutKeyValueSeparator();
+  if (pimpl_->IsBinary()) {
+    pimpl_->BeginBinaryString("module");
+  } else {
+    Put("module");
+    pimpl_->PutKeyValueSeparator();
+  }
+
   Put(func);
   Put(" ( ");
   Put(path);
   Put(kPathLineSeparator);
   PutSigned(line);
   Put(" ) ");
+
+  if (pimpl_->IsBinary()) pimpl_->FinishBinaryString();
 }
 
 void LogHelper::LogIds() {
@@ -208,6 +229,13 @@ void LogHelper::LogIds() {
   uint64_t task_id = task ? reinterpret_cast<uint64_t>(task) : 0;
   auto* thread_id = reinterpret_cast<void*>(pthread_self());
 
+  if (pimpl_->IsBinary()) {
+    pimpl_->PutBinaryValue("task_id", impl::binary::ValueType::kHex, task_id);
+    pimpl_->PutBinaryValue("thread_id", impl::binary::ValueType::kHex,
+                           reinterpret_cast<uint64_t>(thread_id));
+    return;
+  }
+
   Put(utils::encoding::kTskvPairsSeparator);
   Put("task_id");
   pimpl_->PutKeyValueSeparator();
@@ -221,7 +249,11 @@ void LogHelper::LogIds() {
 
 void LogHelper::LogSpan() {
   auto* span = tracing::Span::CurrentSpanUnchecked();
-  if (span) *this << *span;
+  if (!span) return;
+
+  pimpl_->SetTailSamplingBuffer(
+      span->GetTailSamplingBuffer(utils::InternalTag{}));
+  *this << *span;
 }
 
 LogHelper& LogHelper::operator<<(char value) noexcept {
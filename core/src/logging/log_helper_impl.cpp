@@ -1,9 +1,12 @@
 #include "log_helper_impl.hpp"
 
+#include <cstring>
+#include <type_traits>
+
 #include <logging/spdlog.hpp>
 
 #include <logging/logger_with_info.hpp>
-
+#include <tracing/tail_sampling_buffer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/tskv.hpp>
 
@@ -31,6 +34,7 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   switch (logger.format) {
     case Format::kTskv:
     case Format::kRaw:
+    case Format::kBinary:
       return '=';
     case Format::kLtsv:
       return ':';
@@ -39,6 +43,33 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+bool IsBinaryLogger(const LoggerPtr& logger_ptr) {
+  return logger_ptr && logger_ptr->format == Format::kBinary;
+}
+
+template <typename T>
+std::uint64_t ToBits(T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    std::uint64_t bits{};
+    const auto double_value = static_cast<double>(value);
+    std::memcpy(&bits, &double_value, sizeof(bits));
+    return bits;
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
+template <typename T>
+impl::binary::ValueType GetBinaryType() {
+  if constexpr (std::is_floating_point_v<T>) {
+    return impl::binary::ValueType::kDouble;
+  } else if constexpr (std::is_signed_v<T>) {
+    return impl::binary::ValueType::kInt64;
+  } else {
+    return impl::binary::ValueType::kUInt64;
+  }
+}
+
 }  // namespace
 
 LogHelper::Impl::int_type LogHelper::Impl::BufferStd::overflow(int_type c) {
@@ -56,7 +87,8 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerPtr logger, Level level) noexcept
     : logger_(std::move(logger)),
       level_(level),
-      key_value_separator_(GetSeparatorFromLogger(logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(logger_)),
+      is_binary_(IsBinaryLogger(logger_)) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
@@ -122,9 +154,48 @@ void LogHelper::Impl::LogTheMessage() const {
 
   UASSERT(logger_);
   std::string_view message(msg_.data(), msg_.size());
+  if (tail_sampling_buffer_ &&
+      tail_sampling_buffer_->TryBuffer(logger_, level_, message)) {
+    return;
+  }
   logger_->ptr->log(static_cast<spdlog::level::level_enum>(level_), message);
 }
 
+void LogHelper::Impl::BeginBinaryString(std::string_view key) {
+  UASSERT(is_binary_);
+  UASSERT_MSG(binary_string_offset_ == kNoBinaryString,
+              "Previous binary string was not finished");
+  binary_string_offset_ = impl::binary::BeginString(msg_, key);
+}
+
+void LogHelper::Impl::FinishBinaryString() {
+  UASSERT(is_binary_);
+  if (binary_string_offset_ == kNoBinaryString) return;
+  impl::binary::FinishString(msg_, binary_string_offset_);
+  binary_string_offset_ = kNoBinaryString;
+}
+
+void LogHelper::Impl::PutBinaryValue(std::string_view key,
+                                     impl::binary::ValueType type,
+                                     std::uint64_t bits) {
+  UASSERT(binary_string_offset_ == kNoBinaryString);
+  impl::binary::PutNumber(msg_, key, type, bits);
+}
+
+void LogHelper::Impl::PutBinaryValue(std::string_view key,
+                                     const LogExtra::Value& value) {
+  std::visit(
+      [this, key](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          impl::binary::PutString(msg_, key, value);
+        } else {
+          PutBinaryValue(key, GetBinaryType<T>(), ToBits(value));
+        }
+      },
+      value);
+}
+
 void LogHelper::Impl::MarkTextBegin() {
   UASSERT_MSG(initial_length_ == 0, "MarkTextBegin must only be called once");
   initial_length_ = msg_.size();
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <ostream>
 
 #include <fmt/format.h>
 
+#include <logging/binary_format.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace tracing::impl {
+class TailSamplingBuffer;
+}  // namespace tracing::impl
+
 namespace logging {
 
 class LogHelper::Impl final {
@@ -22,7 +29,10 @@ class LogHelper::Impl final {
 
   explicit Impl(LoggerPtr logger, Level level) noexcept;
 
-  void SetEncoding(Encode encode_mode) noexcept { encode_mode_ = encode_mode; }
+  void SetEncoding(Encode encode_mode) noexcept {
+    // Binary records store the strings as is
+    if (!is_binary_) encode_mode_ = encode_mode;
+  }
   Encode GetEncoding() const noexcept { return encode_mode_; }
 
   auto& Message() noexcept { return msg_; }
@@ -39,6 +49,23 @@ class LogHelper::Impl final {
 
   void PutKeyValueSeparator() { xsputn(&key_value_separator_, 1); }
 
+  bool IsBinary() const noexcept { return is_binary_; }
+
+  /// Starts a binary string field, its value is written by xsputn and
+  /// overflow up to the FinishBinaryString() call
+  void BeginBinaryString(std::string_view key);
+  void FinishBinaryString();
+
+  void PutBinaryValue(std::string_view key, impl::binary::ValueType type,
+                      std::uint64_t bits);
+  void PutBinaryValue(std::string_view key, const LogExtra::Value& value);
+
+  /// Records are offered to the buffer before being logged, the buffer must
+  /// outlive the Impl
+  void SetTailSamplingBuffer(tracing::impl::TailSamplingBuffer* buffer) {
+    tail_sampling_buffer_ = buffer;
+  }
+
   void LogTheMessage() const;
 
   void MarkTextBegin();
@@ -70,15 +97,19 @@ class LogHelper::Impl final {
   LazyInitedStream& GetLazyInitedStream();
 
   static constexpr size_t kOptimalBufferSize = 1500;
+  static constexpr size_t kNoBinaryString = std::numeric_limits<size_t>::max();
 
   LoggerPtr logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
   Encode encode_mode_{Encode::kNone};
   fmt::basic_memory_buffer<char, kOptimalBufferSize> msg_;
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   size_t initial_length_{0};
+  size_t binary_string_offset_{kNoBinaryString};
+  tracing::impl::TailSamplingBuffer* tail_sampling_buffer_{nullptr};
 };
 
 }  // namespace logging
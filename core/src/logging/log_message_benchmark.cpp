@@ -1,9 +1,19 @@
 #include <benchmark/benchmark.h>
 
+#include <logging/async_logger.hpp>
+#include <logging/logger_with_info.hpp>
+#include <logging/spdlog_helpers.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
 #include <userver/logging/logger.hpp>
 
+#include <spdlog/async.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <algorithm>
+#include <chrono>
 #include <ostream>
+#include <vector>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -98,4 +108,96 @@ BENCHMARK_REGISTER_F(LogHelperBenchmark, LogStruct)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+namespace {
+
+logging::LoggerPtr MakeNullSinkLogger(logging::Format format) {
+  auto logger = std::make_shared<logging::impl::LoggerWithInfo>(
+      format, utils::MakeSharedRef<spdlog::logger>(
+                  "null_sink_logger",
+                  std::make_shared<spdlog::sinks::null_sink_st>()));
+  logger->ptr->set_formatter(
+      logging::MakeSpdlogFormatter(format, logging::GetSpdlogPattern(format)));
+  logger->ptr->set_level(spdlog::level::info);
+  return logger;
+}
+
+}  // namespace
+
+// Measures the formatting of a typical message with LogExtra in each format
+void LogExtraFormat(benchmark::State& state) {
+  const auto format = static_cast<logging::Format>(state.range(0));
+  auto old = logging::SetDefaultLogger(MakeNullSinkLogger(format));
+
+  const logging::LogExtra extra{{"http_method", "POST"},
+                                {"uri", "/v1/orders/create?id=42&kind=user"},
+                                {"status", 200},
+                                {"size", 4096u},
+                                {"duration", 12.345},
+                                {"meta_type", "/v1/orders/create"}};
+  for (auto _ : state) {
+    LOG_INFO() << "Request\tfinished" << extra;
+  }
+
+  logging::SetDefaultLogger(std::move(old));
+}
+BENCHMARK(LogExtraFormat)
+    ->Arg(static_cast<int>(logging::Format::kTskv))
+    ->Arg(static_cast<int>(logging::Format::kLtsv))
+    ->Arg(static_cast<int>(logging::Format::kBinary));
+
+namespace {
+
+std::shared_ptr<spdlog::logger> MakeSpdlogAsyncLogger() {
+  static auto thread_pool = std::make_shared<spdlog::details::thread_pool>(
+      logging::LoggerConfig::kDefaultMessageQueueSize, 1);
+  auto logger = std::make_shared<spdlog::async_logger>(
+      "spdlog_async", std::make_shared<spdlog::sinks::null_sink_mt>(),
+      thread_pool, spdlog::async_overflow_policy::overrun_oldest);
+  logger->set_pattern(logging::GetSpdlogPattern(logging::Format::kTskv));
+  return logger;
+}
+
+std::shared_ptr<spdlog::logger> MakeAsyncLogger() {
+  logging::LoggerConfig config;
+  config.pattern = logging::GetSpdlogPattern(logging::Format::kTskv);
+  return std::make_shared<logging::impl::AsyncLogger>(
+      "async", std::make_shared<spdlog::sinks::null_sink_mt>(), config);
+}
+
+// Measures the throughput and the latency of the calling threads
+void LogConcurrently(benchmark::State& state, spdlog::logger& logger) {
+  const std::string msg(state.range(0), '*');
+  std::vector<std::chrono::steady_clock::duration> latencies;
+  latencies.reserve(1 << 16);
+
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    logger.info(msg);
+    latencies.push_back(std::chrono::steady_clock::now() - start);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  if (!latencies.empty()) {
+    auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), p99, latencies.end());
+    state.counters["p99_ns"] = benchmark::Counter(
+        std::chrono::duration<double, std::nano>(*p99).count(),
+        benchmark::Counter::kAvgThreads);
+  }
+}
+
+}  // namespace
+
+void LogSpdlogAsyncLogger(benchmark::State& state) {
+  static const auto logger = MakeSpdlogAsyncLogger();
+  LogConcurrently(state, *logger);
+}
+BENCHMARK(LogSpdlogAsyncLogger)->Arg(64)->ThreadRange(1, 64)->UseRealTime();
+
+void LogAsyncLogger(benchmark::State& state) {
+  static const auto logger = MakeAsyncLogger();
+  LogConcurrently(state, *logger);
+}
+BENCHMARK(LogAsyncLogger)->Arg(64)->ThreadRange(1, 64)->UseRealTime();
+
 USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 // to override spdlog's level names
 #include <logging/spdlog.hpp>
 
+#include <logging/binary_format.hpp>
 #include <logging/logger_with_info.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <logging/spdlog_helpers.hpp>
@@ -26,11 +27,11 @@ namespace {
 LoggerPtr MakeSimpleLogger(const std::string& name, spdlog::sink_ptr sink,
                            spdlog::level::level_enum level, Format format) {
   auto spdlog_logger = utils::MakeSharedRef<spdlog::logger>(name, sink);
-  auto logger = std::make_shared<impl::LoggerWithInfo>(
-      format, std::shared_ptr<spdlog::details::thread_pool>{},
-      std::move(spdlog_logger));
+  auto logger =
+      std::make_shared<impl::LoggerWithInfo>(format, std::move(spdlog_logger));
 
-  logger->ptr->set_pattern(GetSpdlogPattern(format));
+  logger->ptr->set_formatter(
+      MakeSpdlogFormatter(format, GetSpdlogPattern(format)));
   logger->ptr->set_level(level);
   logger->ptr->flush_on(level);
   return logger;
@@ -78,6 +79,13 @@ namespace impl {
 
 void LogRaw(LoggerWithInfo& logger, Level level, std::string_view message) {
   auto spdlog_level = static_cast<spdlog::level::level_enum>(level);
+  if (logger.format == Format::kBinary) {
+    spdlog::memory_buf_t record;
+    binary::PutString(record, "text", message);
+    logger.ptr->log(spdlog_level,
+                    spdlog::string_view_t{record.data(), record.size()});
+    return;
+  }
   logger.ptr->log(spdlog_level, "{}", message);
 }
 
@@ -1,11 +1,49 @@
 #include <logging/spdlog_helpers.hpp>
 
+#include <chrono>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/formatter.h>
+#include <spdlog/pattern_formatter.h>
+
+#include <logging/binary_format.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace logging {
 
+namespace {
+
+// Adds the record header to the fields that were written by LogHelper
+class BinaryFormatter final : public spdlog::formatter {
+ public:
+  void format(const spdlog::details::log_msg& msg,
+              spdlog::memory_buf_t& dest) override {
+    const auto timestamp_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            msg.time.time_since_epoch())
+            .count();
+    const auto size = sizeof(impl::binary::kVersion) + sizeof(std::int64_t) +
+                      sizeof(std::uint8_t) + msg.payload.size();
+
+    impl::binary::PutInteger(dest, static_cast<std::uint32_t>(size));
+    impl::binary::PutInteger(dest, impl::binary::kVersion);
+    impl::binary::PutInteger(dest, static_cast<std::int64_t>(timestamp_us));
+    impl::binary::PutInteger(dest, static_cast<std::uint8_t>(msg.level));
+    dest.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+  }
+
+  std::unique_ptr<spdlog::formatter> clone() const override {
+    return std::make_unique<BinaryFormatter>();
+  }
+};
+
+}  // namespace
+
 const std::string& GetSpdlogPattern(Format format) {
   static const std::string kSpdlogTskvPattern =
       "tskv\ttimestamp=%Y-%m-%dT%H:%M:%S.%f\tlevel=%l\t%v";
@@ -19,12 +57,19 @@ const std::string& GetSpdlogPattern(Format format) {
     case Format::kLtsv:
       return kSpdlogLtsvPattern;
     case Format::kRaw:
+    case Format::kBinary:
       return kSpdlogRawPattern;
   }
 
   UINVARIANT(false, "Invalid logging::Format enum value");
 }
 
+std::unique_ptr<spdlog::formatter> MakeSpdlogFormatter(
+    Format format, const std::string& pattern) {
+  if (format == Format::kBinary) return std::make_unique<BinaryFormatter>();
+  return std::make_unique<spdlog::pattern_formatter>(pattern);
+}
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
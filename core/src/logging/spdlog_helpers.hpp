@@ -1,15 +1,24 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <userver/logging/format.hpp>
 
+namespace spdlog {
+class formatter;
+}  // namespace spdlog
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging {
 
 const std::string& GetSpdlogPattern(Format format);
 
+/// Makes a formatter for `format` that uses `pattern` for text formats
+std::unique_ptr<spdlog::formatter> MakeSpdlogFormatter(
+    Format format, const std::string& pattern);
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
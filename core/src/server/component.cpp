@@ -129,10 +129,42 @@ properties:
                         type: integer
                         description: drop requests from handlers that allow trottling if there's more pending requests than allowed by this value
                         defaultDescription: 100
+                    max_pipelined_requests:
+                        type: integer
+                        description: max count of requests of a single connection that are parsed ahead and processed concurrently, responses are sent in the order of requests; 0 means unlimited
+                        defaultDescription: 0
                     keepalive_timeout:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http_version:
+                        type: string
+                        description: |
+                            HTTP protocol of the connections.
+                            `2` expects HTTP/2 over cleartext with prior
+                            knowledge (h2c), requests of a single connection
+                            are multiplexed as HTTP/2 streams.
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2_session:
+                        type: object
+                        description: HTTP/2 session settings, used only if http_version is '2'
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max count of concurrently open streams of a single connection
+                                defaultDescription: 100
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window size of a stream in bytes
+                                defaultDescription: 65535
+                            max_frame_size:
+                                type: integer
+                                description: max size of a received frame payload in bytes
+                                defaultDescription: 16384
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
@@ -173,10 +205,42 @@ properties:
                         type: integer
                         description: drop requests from handlers that allow trottling if there's more pending requests than allowed by this value
                         defaultDescription: 100
+                    max_pipelined_requests:
+                        type: integer
+                        description: max count of requests of a single connection that are parsed ahead and processed concurrently, responses are sent in the order of requests; 0 means unlimited
+                        defaultDescription: 0
                     keepalive_timeout:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http_version:
+                        type: string
+                        description: |
+                            HTTP protocol of the connections.
+                            `2` expects HTTP/2 over cleartext with prior
+                            knowledge (h2c), requests of a single connection
+                            are multiplexed as HTTP/2 streams.
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2_session:
+                        type: object
+                        description: HTTP/2 session settings, used only if http_version is '2'
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max count of concurrently open streams of a single connection
+                                defaultDescription: 100
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window size of a stream in bytes
+                                defaultDescription: 65535
+                            max_frame_size:
+                                type: integer
+                                description: max size of a received frame payload in bytes
+                                defaultDescription: 16384
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -86,6 +86,9 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
       value["set-response-server-hostname"].As<std::optional<bool>>();
 
   config.response_body_stream = value["response-body-stream"].As<bool>(false);
+  config.log_tail_sampling =
+      value["log-tail-sampling"]
+          .As<std::optional<tracing::TailSamplingConfig>>();
 
   if (config.max_requests_per_second &&
       config.max_requests_per_second.value() <= 0) {
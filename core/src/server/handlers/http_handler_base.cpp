@@ -79,6 +79,7 @@ std::vector<http::HttpMethod> InitAllowedMethods(const HandlerConfig& config) {
 void SetFormattedErrorResponse(http::HttpResponse& http_response,
                                FormattedErrorData&& formatted_error_data) {
   http_response.SetData(std::move(formatted_error_data.external_body));
+  http_response.ClearBodyParts();
   if (formatted_error_data.content_type) {
     http_response.SetContentType(*std::move(formatted_error_data.content_type));
   }
@@ -122,21 +123,29 @@ class RequestProcessor final {
     try {
       auto& span = tracing::Span::CurrentSpan();
       auto& response = http_request_.GetHttpResponse();
-      response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaRequestId,
-                         span.GetLink());
+      // Headers of a streamed response are set before the handler is called,
+      // they may be serialized by the connection concurrently.
+      const bool is_body_streamed = response.IsBodyStreamed();
+      if (!is_body_streamed) {
+        response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaRequestId,
+                           span.GetLink());
+      }
 
       const auto status_code = response.GetStatus();
       span.SetLogLevel(handler_.GetLogLevelForResponseStatus(status_code));
-      if (!span.ShouldLogDefault()) {
-        return;
-      }
 
+      // Set even if the span is not logged, the error tag makes the tail
+      // sampling write out the logs of the request
       int response_code = static_cast<int>(status_code);
       span.AddTag(tracing::kHttpStatusCode, response_code);
       if (response_code >= 500) span.AddTag(tracing::kErrorFlag, true);
 
+      if (!span.ShouldLogDefault()) {
+        return;
+      }
+
       if (log_request_) {
-        if (log_request_headers_) {
+        if (log_request_headers_ && !is_body_streamed) {
           span.AddNonInheritableTag("response_headers",
                                     GetHeadersLogString(response));
         }
@@ -176,6 +185,7 @@ class RequestProcessor final {
       response.SetStatus(http_status);
       if (ex.IsExternalErrorBodyFormatted()) {
         response.SetData(ex.GetExternalErrorBody());
+        response.ClearBodyParts();
       } else {
         SetFormattedErrorResponse(response,
                                   handler_.GetFormattedExternalErrorBody(ex));
@@ -409,6 +419,10 @@ void HttpHandlerBase::HandleRequestStream(
     request::RequestContext& context) const {
   utils::ScopeGuard scope([&response] { response.SetHeadersEnd(); });
 
+  // The headers are sent as soon as the handler ends them
+  SetResponseAcceptEncoding(response);
+  SetResponseServerHostname(response);
+
   auto& http_response = http_request.GetHttpResponse();
   server::http::ResponseBodyStream response_body_stream{
       response.GetBodyProducer(), http_response};
@@ -420,6 +434,14 @@ void HttpHandlerBase::HandleRequestStream(
   try {
     HandleStreamRequest(http_request, context, response_body_stream);
   } catch (const CustomHandlerException& e) {
+    if (response_body_stream.IsEndOfHeaders()) {
+      // The status is already sent, the connection is dropped instead of
+      // finishing the body
+      LOG_ERROR() << "exception in '" << HandlerName()
+                  << "' handler after the response headers were sent: " << e;
+      response.AbortBodyStream();
+      return;
+    }
     response_body_stream.SetStatusCode(http::GetHttpStatus(e.GetCode()));
 
     for (const auto& [name, value] : e.GetExtraHeaders()) {
@@ -437,11 +459,19 @@ void HttpHandlerBase::HandleRequestStream(
     if (engine::current_task::ShouldCancel()) {
       LOG_WARNING() << "request task cancelled, exception in '" << HandlerName()
                     << "' handler in handle_request: " << e;
+      if (response_body_stream.IsEndOfHeaders()) {
+        response.AbortBodyStream();
+        return;
+      }
       response_body_stream.SetStatusCode(
           http::HttpStatus::kClientClosedRequest);
     } else {
       LOG_ERROR() << "exception in '" << HandlerName()
                   << "' handler in handle_request: " << e;
+      if (response_body_stream.IsEndOfHeaders()) {
+        response.AbortBodyStream();
+        return;
+      }
       response_body_stream.SetStatusCode(500);
       SetFormattedErrorResponse(response,
                                 GetFormattedExternalErrorBody({
@@ -459,6 +489,7 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
   auto& http_request_impl = static_cast<http::HttpRequestImpl&>(request);
   http::HttpRequest http_request(http_request_impl);
   auto& response = http_request.GetHttpResponse();
+  bool is_stream_started = false;
 
   try {
     HttpHandlerStatisticsScope stats_scope(*handler_statistics_,
@@ -506,8 +537,15 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
                        span.GetTraceId());
     response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaSpanId,
                        span.GetSpanId());
+    if (response.IsBodyStreamed()) {
+      response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaRequestId,
+                         span.GetLink());
+    }
 
     span.SetLocalLogLevel(log_level_);
+    if (GetConfig().log_tail_sampling) {
+      span.EnableTailSampling(*GetConfig().log_tail_sampling);
+    }
 
     if (!parent_link.empty()) span.SetParentLink(parent_link);
 
@@ -562,8 +600,10 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     }
 
     request_processor.ProcessRequestStep(
-        kHandleRequestStep, [this, &response, &http_request, &context] {
+        kHandleRequestStep,
+        [this, &response, &http_request, &context, &is_stream_started] {
           if (response.IsBodyStreamed()) {
+            is_stream_started = true;
             HandleRequestStream(http_request, response, context);
           } else {
             // !IsBodyStreamed()
@@ -574,8 +614,11 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     LOG_ERROR() << "unable to handle request: " << ex;
   }
 
-  SetResponseAcceptEncoding(response);
-  SetResponseServerHostname(response);
+  if (!is_stream_started) {
+    // Otherwise the headers might be already sent
+    SetResponseAcceptEncoding(response);
+    SetResponseServerHostname(response);
+  }
   response.SetHeadersEnd();
 }
 
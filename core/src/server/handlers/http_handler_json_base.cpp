@@ -1,5 +1,7 @@
 #include <userver/server/handlers/http_handler_json_base.hpp>
 
+#include <stdexcept>
+
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/http/content_type.hpp>
@@ -47,6 +49,25 @@ std::string HttpHandlerJsonBase::HandleRequestThrow(
   return formats::json::ToString(response_json);
 }
 
+void HttpHandlerJsonBase::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext& context,
+    http::ResponseBodyStream& response_body_stream) const {
+  const auto& request_json =
+      context.GetData<const formats::json::Value&>(kRequestDataName);
+
+  response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+  http::ResponseBodyJsonWriter writer{response_body_stream};
+  HandleStreamRequestJsonThrow(request, request_json, context, writer);
+}
+
+void HttpHandlerJsonBase::HandleStreamRequestJsonThrow(
+    const http::HttpRequest&, const formats::json::Value&,
+    request::RequestContext&, http::ResponseBodyJsonWriter&) const {
+  throw std::runtime_error(
+      "stream HandleStreamRequestJsonThrow() is executed, but the handler "
+      "doesn't override HandleStreamRequestJsonThrow().");
+}
+
 const formats::json::Value* HttpHandlerJsonBase::GetRequestJson(
     const request::RequestContext& context) {
   return context.GetDataOptional<const formats::json::Value>(kRequestDataName);
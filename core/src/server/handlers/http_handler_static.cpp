@@ -1,5 +1,7 @@
 #include <userver/server/handlers/http_handler_static.hpp>
 
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
@@ -36,14 +38,25 @@ std::string HttpHandlerStatic::HandleRequestThrow(
   const auto file = storage_.TryGetFile(request.GetRequestPath());
   if (file) {
     const auto config = config_.GetSnapshot();
-    request.GetHttpResponse().SetContentType(
-        config[kContentTypeMap][file->extension]);
-    return file->data;
+    auto& response = request.GetHttpResponse();
+    response.SetContentType(config[kContentTypeMap][file->extension]);
+    // The cached file is kept alive by the response, no need to copy it
+    response.AppendBodyChunk(file, file->data);
+    return {};
   }
   request.GetResponse().SetStatusNotFound();
   return "File not found";
 }
 
+std::string HttpHandlerStatic::GetResponseDataForLogging(
+    const http::HttpRequest& request, request::RequestContext&,
+    const std::string& response_data) const {
+  // The file is sent as a body chunk, no need to copy it to the logs
+  const auto body_size = request.GetHttpResponse().GetBodySize();
+  if (body_size == response_data.size()) return response_data;
+  return fmt::format("<file of {} bytes>", body_size);
+}
+
 }  // namespace server::handlers
 
 USERVER_NAMESPACE_END
@@ -107,6 +107,27 @@ properties:
         type: boolean
         description: TODO
         defaultDescription: false
+    log-tail-sampling:
+        type: object
+        description: buffer the logs of each request and write them only for failed, slow or sampled requests, see tracing::TailSamplingConfig
+        additionalProperties: false
+        properties:
+            buffer-size:
+                type: integer
+                description: max bytes of the buffered log records of a request, the oldest records are evicted on overflow
+                defaultDescription: 65536
+            latency-threshold:
+                type: string
+                description: logs of the requests that lasted at least that long are written
+                defaultDescription: 1s
+            sampling-rate:
+                type: number
+                description: ratio in range [0, 1] of the requests that are logged without buffering
+                defaultDescription: 0
+            flush-level:
+                type: string
+                description: records of this level and above write out the buffered logs of the request
+                defaultDescription: warning
     monitor-handler:
         type: boolean
         description: overrides the in-code `is_monitor` flag that makes the handler run either on 'server.listener' or on 'server.listener-monitor'
@@ -0,0 +1,649 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include <server/http/http_cached_date.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+#include "http_request_impl.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kMethodPseudoHeader = ":method";
+constexpr std::string_view kPathPseudoHeader = ":path";
+constexpr std::string_view kAuthorityPseudoHeader = ":authority";
+constexpr std::string_view kStatusPseudoHeader = ":status";
+constexpr std::string_view kCookieHeader = "cookie";
+
+// Pending frames are accumulated up to this size before writing to the socket
+constexpr std::size_t kMaxOutBufferSize = 64 * 1024;
+
+constexpr std::size_t kFrameHeaderSize = 9;
+
+const auto kDefaultContentTypeString =
+    USERVER_NAMESPACE::http::ContentType{"text/html; charset=utf-8"}
+        .ToString();
+
+using Headers = std::vector<std::pair<std::string, std::string>>;
+
+std::string_view ToStringView(const std::uint8_t* data, size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+std::string ToLowerAscii(std::string_view str) {
+  std::string result{str};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+  return result;
+}
+
+// RFC 7540 8.1.2.2: connection-specific headers must not be sent
+bool IsConnectionSpecificHeader(std::string_view name) {
+  const utils::StrIcaseEqual equal;
+  return equal(name, USERVER_NAMESPACE::http::headers::kConnection) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kTransferEncoding) ||
+         equal(name, "Keep-Alive") || equal(name, "Proxy-Connection") ||
+         equal(name, "Upgrade");
+}
+
+bool IsBodyForbidden(const HttpRequestImpl& request, HttpStatus status) {
+  return request.GetOrigMethod() == HttpMethod::kHead ||
+         status == HttpStatus::kNoContent ||
+         status == HttpStatus::kNotModified ||
+         (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
+}
+
+Headers MakeResponseHeaders(const HttpResponse& response, bool send_body) {
+  const utils::StrIcaseEqual equal;
+  Headers headers;
+  headers.emplace_back(
+      kStatusPseudoHeader,
+      fmt::format("{}", static_cast<int>(response.GetStatus())));
+
+  bool has_date = false;
+  bool has_content_type = false;
+  for (const auto& name : response.GetHeaderNames()) {
+    if (IsConnectionSpecificHeader(name) ||
+        equal(name, USERVER_NAMESPACE::http::headers::kContentLength)) {
+      continue;
+    }
+    has_date |= equal(name, USERVER_NAMESPACE::http::headers::kDate);
+    has_content_type |=
+        equal(name, USERVER_NAMESPACE::http::headers::kContentType);
+    headers.emplace_back(ToLowerAscii(name), response.GetHeader(name));
+  }
+
+  if (!has_date) headers.emplace_back("date", impl::GetCachedDate());
+  if (!has_content_type) {
+    headers.emplace_back("content-type", kDefaultContentTypeString);
+  }
+  for (const auto& name : response.GetCookieNames()) {
+    headers.emplace_back("set-cookie", response.GetCookie(name).ToString());
+  }
+  if (send_body) {
+    headers.emplace_back("content-length",
+                         fmt::format("{}", response.GetData().size()));
+  }
+
+  return headers;
+}
+
+nghttp2_nv MakeNv(const std::pair<std::string, std::string>& header) {
+  nghttp2_nv nv{};
+  // nghttp2 copies the names and values, it does not modify them
+  nv.name = reinterpret_cast<std::uint8_t*>(
+      const_cast<char*>(header.first.data()));
+  nv.namelen = header.first.size();
+  nv.value = reinterpret_cast<std::uint8_t*>(
+      const_cast<char*>(header.second.data()));
+  nv.valuelen = header.second.size();
+  nv.flags = NGHTTP2_NV_FLAG_NONE;
+  return nv;
+}
+
+}  // namespace
+
+struct Http2Session::Stream final {
+  Stream(const HttpRequestConstructor::Config& config,
+         const HandlerInfoIndex& handler_info_index,
+         request::ResponseDataAccounter& data_accounter)
+      : constructor(config, handler_info_index, data_accounter) {}
+
+  HttpRequestConstructor constructor;
+  std::string authority;
+  std::string cookies;
+  bool is_url_parsed{false};
+  // The request is malformed, the constructor reports the error on Finalize()
+  bool is_failed{false};
+  bool is_finalized{false};
+  // The response is submitted, but its last frame is not serialized yet
+  bool is_response_pending{false};
+  // Size of the serialized response frames, with the frame headers
+  std::size_t response_bytes{0};
+
+  // Kept until the stream is closed, the response body is read from it
+  std::shared_ptr<request::RequestBase> request;
+  std::string_view body;
+  std::size_t body_offset{0};
+};
+
+void Http2Session::SessionDeleter::operator()(
+    nghttp2_session* session) const noexcept {
+  nghttp2_session_del(session);
+}
+
+Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           const net::Http2SessionConfig& session_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           OnResponseFinishedCb&& on_response_finished_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter,
+                           engine::io::Socket& socket,
+                           std::chrono::milliseconds send_timeout)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      on_response_finished_cb_(std::move(on_response_finished_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      socket_(socket),
+      send_timeout_(send_timeout) {
+  nghttp2_session* session = nullptr;
+  if (nghttp2_session_server_new(&session, GetCallbacks(), this) != 0) {
+    throw std::runtime_error("Failed to create HTTP/2 session");
+  }
+  session_.reset(session);
+
+  const std::array<nghttp2_settings_entry, 3> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+       session_config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+       session_config.initial_window_size},
+      {NGHTTP2_SETTINGS_MAX_FRAME_SIZE, session_config.max_frame_size},
+  }};
+  const auto rv = nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE,
+                                          settings.data(), settings.size());
+  if (rv != 0) {
+    throw std::runtime_error(
+        fmt::format("Failed to submit HTTP/2 settings: {}",
+                    nghttp2_strerror(rv)));
+  }
+}
+
+Http2Session::~Http2Session() {
+  for (const auto& [stream_id, stream] : streams_) {
+    if (!stream->is_finalized) --stats_.parsing_request_count;
+  }
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  bool is_ok = true;
+  std::vector<std::shared_ptr<request::RequestBase>> new_requests;
+  std::vector<FinishedResponse> finished_responses;
+  {
+    std::unique_lock lock(mutex_);
+    const auto parsed = nghttp2_session_mem_recv(
+        session_.get(), reinterpret_cast<const std::uint8_t*>(data), size);
+    if (parsed < 0) {
+      LOG_WARNING() << "HTTP/2 session error: "
+                    << nghttp2_strerror(static_cast<int>(parsed));
+      is_ok = false;
+    }
+
+    // Settings, pings, window updates, GOAWAY on errors and the response
+    // bodies that were waiting for the flow control window
+    SendPendingFrames(lock);
+
+    // The socket writes might have failed in the responses sender
+    is_ok = is_ok && !is_broken_ &&
+            (nghttp2_session_want_read(session_.get()) ||
+             nghttp2_session_want_write(session_.get()));
+    new_requests.swap(new_requests_);
+    finished_responses.swap(finished_responses_);
+  }
+
+  NotifyFinishedResponses(finished_responses);
+  // Might block on the requests queue, so the session must not be locked
+  for (auto& request : new_requests) on_new_request_cb_(std::move(request));
+  return is_ok;
+}
+
+void Http2Session::WriteResponse(
+    std::shared_ptr<request::RequestBase> request) {
+  auto& http_request = static_cast<HttpRequestImpl&>(*request);
+  auto& response = http_request.GetHttpResponse();
+  if (response.IsBodyStreamed() && response.GetData().empty()) {
+    try {
+      response.ConsumeBodyStream();
+    } catch (const std::exception&) {
+      // The handler failed in the middle of the body, the client must not get
+      // a partial body as a complete response
+      ResetStream(*request);
+      throw;
+    }
+  }
+  // DATA frames are filled by copying anyway
+  response.FlattenBody();
+
+  const bool send_body = !IsBodyForbidden(http_request, response.GetStatus());
+  const std::string_view body =
+      send_body ? std::string_view{response.GetData()} : std::string_view{};
+  const auto headers = MakeResponseHeaders(response, send_body);
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(headers.size());
+  for (const auto& header : headers) nva.push_back(MakeNv(header));
+
+  std::vector<FinishedResponse> finished_responses;
+  {
+    std::unique_lock lock(mutex_);
+    if (SubmitResponse(*request, body, nva)) {
+      try {
+        SendPendingFrames(lock);
+      } catch (const std::exception& ex) {
+        LOG_WARNING() << "Failed to write HTTP/2 frames: " << ex;
+      }
+    } else {
+      finished_responses_.push_back({std::move(request), 0, false});
+    }
+    finished_responses.swap(finished_responses_);
+  }
+
+  NotifyFinishedResponses(finished_responses);
+}
+
+void Http2Session::ResetStream(const request::RequestBase& request) {
+  std::vector<FinishedResponse> finished_responses;
+  {
+    std::unique_lock lock(mutex_);
+    const auto it = request_streams_.find(&request);
+    if (it != request_streams_.end()) {
+      nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, it->second,
+                                NGHTTP2_INTERNAL_ERROR);
+      try {
+        SendPendingFrames(lock);
+      } catch (const std::exception& ex) {
+        LOG_WARNING() << "Failed to write HTTP/2 frames: " << ex;
+      }
+    }
+    finished_responses.swap(finished_responses_);
+  }
+
+  NotifyFinishedResponses(finished_responses);
+}
+
+void Http2Session::FailPendingResponses() {
+  std::vector<FinishedResponse> finished_responses;
+  {
+    std::lock_guard lock(mutex_);
+    FailResponses();
+    finished_responses.swap(finished_responses_);
+  }
+
+  NotifyFinishedResponses(finished_responses);
+}
+
+bool Http2Session::SubmitResponse(const request::RequestBase& request,
+                                  std::string_view body,
+                                  const std::vector<nghttp2_nv>& nva) {
+  const auto it = request_streams_.find(&request);
+  if (it == request_streams_.end()) return false;
+  const auto stream_id = it->second;
+  auto* stream = FindStream(stream_id);
+  UASSERT(stream);
+
+  nghttp2_data_provider data_provider{};
+  data_provider.source.ptr = stream;
+  data_provider.read_callback = &Http2Session::ReadResponseBody;
+  stream->body = body;
+
+  const auto rv = nghttp2_submit_response(
+      session_.get(), stream_id, nva.data(), nva.size(),
+      stream->body.empty() ? nullptr : &data_provider);
+  if (rv != 0) {
+    LOG_WARNING() << "Failed to submit HTTP/2 response: "
+                  << nghttp2_strerror(rv);
+    return false;
+  }
+
+  stream->is_response_pending = true;
+  return true;
+}
+
+nghttp2_session_callbacks* Http2Session::GetCallbacks() {
+  static const std::unique_ptr<nghttp2_session_callbacks,
+                               decltype(&nghttp2_session_callbacks_del)>
+      callbacks{[] {
+                  nghttp2_session_callbacks* callbacks = nullptr;
+                  UINVARIANT(nghttp2_session_callbacks_new(&callbacks) == 0,
+                             "Failed to create HTTP/2 session callbacks");
+
+                  nghttp2_session_callbacks_set_on_begin_headers_callback(
+                      callbacks, &Http2Session::OnBeginHeaders);
+                  nghttp2_session_callbacks_set_on_header_callback(
+                      callbacks, &Http2Session::OnHeader);
+                  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+                      callbacks, &Http2Session::OnDataChunkRecv);
+                  nghttp2_session_callbacks_set_on_frame_recv_callback(
+                      callbacks, &Http2Session::OnFrameRecv);
+                  nghttp2_session_callbacks_set_on_frame_send_callback(
+                      callbacks, &Http2Session::OnFrameSend);
+                  nghttp2_session_callbacks_set_on_stream_close_callback(
+                      callbacks, &Http2Session::OnStreamClose);
+                  return callbacks;
+                }(),
+                &nghttp2_session_callbacks_del};
+  return callbacks.get();
+}
+
+int Http2Session::OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                                 void* user_data) {
+  if (frame->hd.type != NGHTTP2_HEADERS ||
+      frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+
+  auto& self = *static_cast<Http2Session*>(user_data);
+  try {
+    auto stream = std::make_unique<Stream>(self.request_constructor_config_,
+                                           self.handler_info_index_,
+                                           self.data_accounter_);
+    stream->constructor.SetHttpMajor(2);
+    stream->constructor.SetHttpMinor(0);
+    self.streams_.emplace(frame->hd.stream_id, std::move(stream));
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to start HTTP/2 stream: " << ex;
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+  ++self.stats_.parsing_request_count;
+  return 0;
+}
+
+int Http2Session::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                           const std::uint8_t* name, size_t namelen,
+                           const std::uint8_t* value, size_t valuelen,
+                           std::uint8_t, void* user_data) {
+  auto& self = *static_cast<Http2Session*>(user_data);
+  auto* stream = self.FindStream(frame->hd.stream_id);
+  if (!stream || stream->is_failed) return 0;
+
+  const auto name_view = ToStringView(name, namelen);
+  const auto value_view = ToStringView(value, valuelen);
+  LOG_TRACE() << "HTTP/2 header: '" << name_view << "': '" << value_view
+              << '\'';
+
+  // nghttp2 guarantees that the pseudo-headers go before the regular ones
+  try {
+    auto& constructor = stream->constructor;
+    if (name_view == kMethodPseudoHeader) {
+      constructor.SetMethod(HttpMethodFromString(value_view));
+    } else if (name_view == kPathPseudoHeader) {
+      constructor.AppendUrl(value_view.data(), value_view.size());
+    } else if (name_view == kAuthorityPseudoHeader) {
+      stream->authority = value_view;
+    } else if (!name_view.empty() && name_view.front() == ':') {
+      // :scheme is not used
+    } else if (name_view == kCookieHeader) {
+      // RFC 7540 8.1.2.5: cookie may be split into several header fields
+      if (!stream->cookies.empty()) stream->cookies += "; ";
+      stream->cookies += value_view;
+    } else {
+      self.EnsureUrlParsed(*stream);
+      constructor.AppendHeaderField(name_view.data(), name_view.size());
+      constructor.AppendHeaderValue(value_view.data(), value_view.size());
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't process HTTP/2 header: " << ex;
+    stream->is_failed = true;
+  }
+  return 0;
+}
+
+int Http2Session::OnDataChunkRecv(nghttp2_session*, std::uint8_t,
+                                  std::int32_t stream_id,
+                                  const std::uint8_t* data, size_t len,
+                                  void* user_data) {
+  auto& self = *static_cast<Http2Session*>(user_data);
+  auto* stream = self.FindStream(stream_id);
+  if (!stream || stream->is_failed) return 0;
+
+  try {
+    stream->constructor.AppendBody(reinterpret_cast<const char*>(data), len);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append HTTP/2 body: " << ex;
+    stream->is_failed = true;
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+    return 0;
+  }
+  if (!(frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) return 0;
+
+  auto& self = *static_cast<Http2Session*>(user_data);
+  auto* stream = self.FindStream(frame->hd.stream_id);
+  if (!stream || stream->is_finalized) return 0;
+
+  try {
+    self.FinalizeStream(frame->hd.stream_id, *stream);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to finalize HTTP/2 request: " << ex;
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameSend(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+    return 0;
+  }
+
+  auto& self = *static_cast<Http2Session*>(user_data);
+  auto* stream = self.FindStream(frame->hd.stream_id);
+  if (!stream || !stream->is_response_pending) return 0;
+
+  stream->response_bytes += kFrameHeaderSize + frame->hd.length;
+  if (!(frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) return 0;
+
+  // The response is sent once the output buffer is written out
+  stream->is_response_pending = false;
+  self.serialized_responses_.push_back(
+      {stream->request, stream->response_bytes, true});
+  return 0;
+}
+
+int Http2Session::OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                                std::uint32_t, void* user_data) {
+  auto& self = *static_cast<Http2Session*>(user_data);
+  const auto it = self.streams_.find(stream_id);
+  if (it == self.streams_.end()) return 0;
+
+  auto& stream = *it->second;
+  if (!stream.is_finalized) --self.stats_.parsing_request_count;
+  // Reset by the peer before the response was written out
+  if (stream.is_response_pending) {
+    self.finished_responses_.push_back(
+        {stream.request, stream.response_bytes, false});
+  }
+  if (stream.request) self.request_streams_.erase(stream.request.get());
+  self.streams_.erase(it);
+  return 0;
+}
+
+ssize_t Http2Session::ReadResponseBody(nghttp2_session*, std::int32_t,
+                                       std::uint8_t* buf, size_t length,
+                                       std::uint32_t* data_flags,
+                                       nghttp2_data_source* source, void*) {
+  auto& stream = *static_cast<Stream*>(source->ptr);
+  const auto size =
+      std::min(length, stream.body.size() - stream.body_offset);
+  std::memcpy(buf, stream.body.data() + stream.body_offset, size);
+  stream.body_offset += size;
+  if (stream.body_offset == stream.body.size()) {
+    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+  }
+  return static_cast<ssize_t>(size);
+}
+
+Http2Session::Stream* Http2Session::FindStream(
+    std::int32_t stream_id) noexcept {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : it->second.get();
+}
+
+void Http2Session::EnsureUrlParsed(Stream& stream) {
+  if (stream.is_url_parsed) return;
+  stream.is_url_parsed = true;
+
+  auto& constructor = stream.constructor;
+  constructor.ParseUrl();
+  if (!stream.authority.empty()) {
+    constexpr std::string_view kHost = USERVER_NAMESPACE::http::headers::kHost;
+    constructor.AppendHeaderField(kHost.data(), kHost.size());
+    constructor.AppendHeaderValue(stream.authority.data(),
+                                  stream.authority.size());
+  }
+}
+
+void Http2Session::FinalizeStream(std::int32_t stream_id, Stream& stream) {
+  stream.is_finalized = true;
+  --stats_.parsing_request_count;
+
+  auto& constructor = stream.constructor;
+  if (!stream.is_failed) {
+    try {
+      EnsureUrlParsed(stream);
+      if (!stream.cookies.empty()) {
+        constructor.AppendHeaderField(kCookieHeader.data(),
+                                      kCookieHeader.size());
+        constructor.AppendHeaderValue(stream.cookies.data(),
+                                      stream.cookies.size());
+      }
+      constructor.AppendHeaderField("", 0);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't finalize HTTP/2 headers: " << ex;
+    }
+  }
+  constructor.SetIsFinal(false);
+
+  auto request = constructor.Finalize();
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+
+  stream.request = request;
+  request_streams_.emplace(request.get(), stream_id);
+  new_requests_.push_back(std::move(request));
+}
+
+void Http2Session::SendPendingFrames(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  std::vector<FinishedResponse> written_responses;
+  try {
+    if (is_broken_) throw std::runtime_error("HTTP/2 connection is broken");
+    SerializeFrames();
+    // The frames are written out by the task that is sending already
+    if (is_sending_) return;
+
+    is_sending_ = true;
+    while (!out_buffer_.empty()) {
+      std::string buffer;
+      buffer.swap(out_buffer_);
+      written_responses.swap(serialized_responses_);
+
+      // Frames are serialized by the other tasks meanwhile
+      lock.unlock();
+      [[maybe_unused]] const auto sent = socket_.SendAll(
+          buffer.data(), buffer.size(),
+          engine::Deadline::FromDuration(send_timeout_));
+      lock.lock();
+
+      for (auto& response : written_responses) {
+        finished_responses_.push_back(std::move(response));
+      }
+      written_responses.clear();
+      SerializeFrames();
+    }
+    is_sending_ = false;
+  } catch (const std::exception&) {
+    if (!lock.owns_lock()) lock.lock();
+    // Nothing is written out anymore, the connection is closed by the
+    // requests listener
+    is_sending_ = false;
+    is_broken_ = true;
+    for (auto& response : written_responses) {
+      response.is_sent = false;
+      finished_responses_.push_back(std::move(response));
+    }
+    FailResponses();
+    throw;
+  }
+}
+
+void Http2Session::SerializeFrames() {
+  while (out_buffer_.size() < kMaxOutBufferSize) {
+    const std::uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_.get(), &data);
+    if (size < 0) {
+      throw std::runtime_error(
+          fmt::format("Failed to serialize HTTP/2 frames: {}",
+                      nghttp2_strerror(static_cast<int>(size))));
+    }
+    if (size == 0) return;
+    out_buffer_.append(reinterpret_cast<const char*>(data), size);
+  }
+}
+
+void Http2Session::FailResponses() {
+  for (auto& response : serialized_responses_) {
+    response.is_sent = false;
+    finished_responses_.push_back(std::move(response));
+  }
+  serialized_responses_.clear();
+  std::string().swap(out_buffer_);
+
+  for (auto& [stream_id, stream] : streams_) {
+    if (!stream->is_response_pending) continue;
+    stream->is_response_pending = false;
+    finished_responses_.push_back(
+        {stream->request, stream->response_bytes, false});
+  }
+}
+
+void Http2Session::NotifyFinishedResponses(
+    std::vector<FinishedResponse>& responses) {
+  for (auto& response : responses) {
+    on_response_finished_cb_(*response.request, response.bytes,
+                             response.is_sent);
+  }
+  responses.clear();
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// HTTP/2 server session over a single connection (h2c with prior knowledge).
+///
+/// Frames are parsed by nghttp2, every stream is assembled into a separate
+/// HttpRequestImpl and passed to the same callback as the HTTP/1.1 requests,
+/// so streams are processed concurrently by the usual handlers pipeline.
+/// HPACK and flow control are handled by nghttp2.
+///
+/// Parse() is called from the requests listener and WriteResponse() from the
+/// tasks of the streams. The session is guarded by a mutex, the frames are
+/// serialized under it and written to the socket by one task at a time
+/// without holding it.
+///
+/// There are no separate per-stream deadlines: the handler of every stream
+/// has its own deadline, as for the HTTP/1.1 requests. Socket writes time out
+/// after `send_timeout`, then all the pending responses fail and Parse()
+/// reports an error, so that the connection is closed.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+  /// Called once for every response passed to WriteResponse(), with
+  /// `is_sent` set if the last frame of the response was written out.
+  /// `bytes` is the size of the response frames, with the frame headers.
+  using OnResponseFinishedCb = std::function<void(
+      request::RequestBase& request, std::size_t bytes, bool is_sent)>;
+
+  Http2Session(const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               const net::Http2SessionConfig& session_config,
+               OnNewRequestCb&& on_new_request_cb,
+               OnResponseFinishedCb&& on_response_finished_cb,
+               net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter,
+               engine::io::Socket& socket,
+               std::chrono::milliseconds send_timeout);
+  ~Http2Session() override;
+
+  bool Parse(const char* data, size_t size) override;
+
+  /// Submits the response to a request created by this session and writes
+  /// out the frames allowed by the flow control windows. The rest of the body
+  /// is written once the peer updates the window, the response is reported
+  /// as finished after that. On exceptions the response is not submitted,
+  /// the stream is reset if the streamed body was aborted.
+  void WriteResponse(std::shared_ptr<request::RequestBase> request);
+
+  /// Reports the responses that are not written out yet as failed, must be
+  /// called once the connection stops reading from the socket
+  void FailPendingResponses();
+
+ private:
+  struct Stream;
+  struct FinishedResponse {
+    std::shared_ptr<request::RequestBase> request;
+    std::size_t bytes;
+    bool is_sent;
+  };
+  struct SessionDeleter {
+    void operator()(nghttp2_session* session) const noexcept;
+  };
+
+  static nghttp2_session_callbacks* GetCallbacks();
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const std::uint8_t* name, size_t namelen,
+                      const std::uint8_t* value, size_t valuelen,
+                      std::uint8_t flags, void* user_data);
+  static int OnDataChunkRecv(nghttp2_session* session, std::uint8_t flags,
+                             std::int32_t stream_id, const std::uint8_t* data,
+                             size_t len, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnFrameSend(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnStreamClose(nghttp2_session* session, std::int32_t stream_id,
+                           std::uint32_t error_code, void* user_data);
+  static ssize_t ReadResponseBody(nghttp2_session* session,
+                                  std::int32_t stream_id, std::uint8_t* buf,
+                                  size_t length, std::uint32_t* data_flags,
+                                  nghttp2_data_source* source,
+                                  void* user_data);
+
+  Stream* FindStream(std::int32_t stream_id) noexcept;
+  void EnsureUrlParsed(Stream& stream);
+  void FinalizeStream(std::int32_t stream_id, Stream& stream);
+
+  void ResetStream(const request::RequestBase& request);
+  bool SubmitResponse(const request::RequestBase& request,
+                      std::string_view body,
+                      const std::vector<nghttp2_nv>& nva);
+
+  // Writes out the frames unless another task is doing that, the lock is
+  // released for the socket writes. On errors reports the responses that are
+  // not written out yet as failed and rethrows.
+  void SendPendingFrames(std::unique_lock<engine::Mutex>& lock);
+  void SerializeFrames();
+  void FailResponses();
+  void NotifyFinishedResponses(std::vector<FinishedResponse>& responses);
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  OnResponseFinishedCb on_response_finished_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  engine::io::Socket& socket_;
+  const std::chrono::milliseconds send_timeout_;
+
+  engine::Mutex mutex_;
+  std::unique_ptr<nghttp2_session, SessionDeleter> session_;
+  std::unordered_map<std::int32_t, std::unique_ptr<Stream>> streams_;
+  std::unordered_map<const request::RequestBase*, std::int32_t>
+      request_streams_;
+  std::vector<std::shared_ptr<request::RequestBase>> new_requests_;
+  // Frames that are not written to the socket yet
+  std::string out_buffer_;
+  // Responses with the last frame in `out_buffer_`
+  std::vector<FinishedResponse> serialized_responses_;
+  std::vector<FinishedResponse> finished_responses_;
+  // Some task writes the frames without holding the mutex
+  bool is_sending_{false};
+  // A socket write failed, nothing is written out anymore
+  bool is_broken_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
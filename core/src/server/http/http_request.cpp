@@ -151,6 +151,10 @@ void HttpRequest::SetResponseStatus(HttpStatus status) const {
 
 bool HttpRequest::IsBodyCompressed() const { return impl_.IsBodyCompressed(); }
 
+utils::MonotonicArena& HttpRequest::GetArena() const {
+  return impl_.GetArena();
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+
+#include <sys/socket.h>
+
+#include <array>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_parser.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/request/request_context.hpp>
+#include <userver/utils/monotonic_arena.hpp>
+
+namespace {
+
+// The whole request lifecycle runs on a single engine thread
+thread_local std::size_t allocations_count = 0;
+
+}  // namespace
+
+// Counts the heap allocations of the benchmarks thread. The benchmark is built
+// into a separate binary, so that the allocator of the other benchmarks is not
+// affected.
+void* operator new(std::size_t size) {
+  ++allocations_count;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kRequest =
+    "GET /v1/orders/retrieve?order_id=5f9b3a1c2d4e&lang=en&fields=id&"
+    "fields=status&fields=price HTTP/1.1\r\n"
+    "Host: orders.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Connection: keep-alive\r\n"
+    "Cookie: session_id=1f2e3d4c5b6a79880a1b2c3d4e5f6071; theme=dark\r\n"
+    "X-Request-Id: 4bf92f3577b34da6a3ce929d0e0e4736\r\n"
+    "X-YaTraceId: 4bf92f3577b34da6a3ce929d0e0e4736\r\n"
+    "X-YaSpanId: 00f067aa0ba902b7\r\n"
+    "\r\n";
+
+// Typical handler: reads args, stores some data in the context, gathers a
+// small list and writes the response. Without the arena everything is
+// allocated on heap, including the request args.
+void HandleRequest(server::http::HttpRequestImpl& impl, bool use_arena) {
+  const server::http::HttpRequest request{impl};
+
+  utils::MonotonicArena& arena = request.GetArena();
+  std::optional<server::request::RequestContext> context;
+  if (use_arena) {
+    context.emplace(arena);
+  } else {
+    context.emplace();
+  }
+  context->SetData("order_id", request.GetArg("order_id"));
+  context->SetData("lang", request.GetArg("lang"));
+
+  using Allocator = utils::ArenaAllocator<std::string_view>;
+  std::vector<std::string_view, Allocator> fields{
+      use_arena ? Allocator{arena} : Allocator{}};
+  for (const auto& field : request.GetArgVector("fields")) {
+    fields.push_back(field);
+  }
+  benchmark::DoNotOptimize(fields.data());
+
+  auto& response = request.GetHttpResponse();
+  response.SetHeader(std::string{"X-Order-Id"},
+                     context->GetData<std::string>("order_id"));
+  response.SetData(R"({"id":"5f9b3a1c2d4e","status":"delivered"})");
+}
+
+void http_request_lifecycle(benchmark::State& state, bool use_arena) {
+  engine::RunStandalone([&] {
+    std::array<int, 2> fds{};
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) != 0) {
+      state.SkipWithError("socketpair failed");
+      return;
+    }
+    engine::io::Socket writer{fds[0]};
+    engine::io::Socket reader_socket{fds[1]};
+    auto reader = engine::AsyncNoSpan([&reader_socket] {
+      std::array<char, 64 * 1024> buf{};
+      while (reader_socket.RecvSome(buf.data(), buf.size(), {}) != 0) {
+      }
+    });
+
+    const server::http::HandlerInfoIndex handler_info_index;
+    server::request::HttpRequestConfig config;
+    config.testing_mode = true;  // parse args without a registered handler
+    server::net::ParserStats stats;
+    server::request::ResponseDataAccounter data_accounter;
+    std::size_t arena_bytes = 0;
+    server::http::HttpRequestParser parser(
+        handler_info_index, config,
+        [&](std::shared_ptr<server::request::RequestBase>&& request) {
+          auto& impl = dynamic_cast<server::http::HttpRequestImpl&>(*request);
+          HandleRequest(impl, use_arena);
+          impl.GetHttpResponse().SendResponse(writer);
+          arena_bytes += request->GetArena().GetAllocatedBytes();
+        },
+        stats, data_accounter, use_arena);
+
+    const auto allocations_before = allocations_count;
+    for (auto _ : state) {
+      parser.Parse(kRequest.data(), kRequest.size());
+    }
+    const auto allocations = allocations_count - allocations_before;
+
+    writer.Close();
+    reader.Get();
+
+    state.counters["allocations_per_request"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    state.counters["arena_bytes_per_request"] = benchmark::Counter(
+        static_cast<double>(arena_bytes), benchmark::Counter::kAvgIterations);
+  });
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(http_request_lifecycle, heap, false);
+BENCHMARK_CAPTURE(http_request_lifecycle, arena, true);
+
+USERVER_NAMESPACE_END
@@ -48,7 +48,8 @@ HttpRequestConstructor::HttpRequestConstructor(
     request::ResponseDataAccounter& data_accounter)
     : config_(config),
       handler_info_index_(handler_info_index),
-      request_(std::make_shared<HttpRequestImpl>(data_accounter)) {}
+      request_(std::make_shared<HttpRequestImpl>(data_accounter,
+                                                 config.use_request_arena)) {}
 
 void HttpRequestConstructor::SetMethod(HttpMethod method) {
   request_->orig_method_ = method;
@@ -159,6 +160,21 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendHeader(std::string_view field,
+                                          std::string_view value) {
+  UASSERT(!header_field_flag_);
+
+  AccountHeadersSize(field.size() + value.size());
+  AccountRequestSize(field.size() + value.size());
+
+  auto [it, inserted] =
+      request_->headers_.try_emplace(std::string{field}, value);
+  if (!inserted) {
+    it->second += ',';
+    it->second += value;
+  }
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
   request_->request_body_.append(data, size);
@@ -240,8 +256,7 @@ void HttpRequestConstructor::ParseArgs(const http_parser_url& url) {
 }
 
 void HttpRequestConstructor::ParseArgs(const char* data, size_t size) {
-  return USERVER_NAMESPACE::http::parser::ParseArgs(
-      std::string_view(data, size), request_->request_args_);
+  request_->ParseArgs(std::string_view(data, size));
 }
 
 void HttpRequestConstructor::AddHeader() {
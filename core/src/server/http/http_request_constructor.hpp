@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 
 #include <http_parser.h>
 
@@ -33,7 +34,10 @@ class HttpRequestConstructor final : public request::RequestConstructor {
     kParseMultipartFormDataError,
   };
 
-  using Config = server::request::HttpRequestConfig;
+  struct Config : server::request::HttpRequestConfig {
+    // Allocate the request args in the request arena, benchmarks disable it
+    bool use_request_arena = true;
+  };
 
   HttpRequestConstructor(Config config,
                          const HandlerInfoIndex& handler_info_index,
@@ -50,6 +54,8 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void ParseUrl();
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
+  // Adds a complete header, must not be mixed with AppendHeaderField()
+  void AppendHeader(std::string_view field, std::string_view value);
   void AppendBody(const char* data, size_t size);
 
   void SetIsFinal(bool is_final);
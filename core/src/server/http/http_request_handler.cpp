@@ -173,7 +173,7 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
   auto payload = [request = std::move(request), handler] {
     request->SetTaskStartTime();
 
-    request::RequestContext context;
+    request::RequestContext context{request->GetArena()};
     handler->HandleRequest(*request, context);
 
     const auto now = std::chrono::steady_clock::now();
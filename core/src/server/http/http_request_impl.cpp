@@ -64,12 +64,27 @@ std::string EscapeForAccessTskvLog(const std::string& str) {
 const std::string kEmptyString{};
 const std::vector<std::string> kEmptyVector{};
 
+template <typename Allocator>
+Allocator MakeAllocator(utils::MonotonicArena& arena, bool use_arena) {
+  return use_arena ? Allocator{arena} : Allocator{};
+}
+
 }  // namespace
 
 namespace server::http {
 
-HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter)
-    : response_(*this, data_accounter) {}
+HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter,
+                                 bool use_arena)
+    : request_args_(
+          MakeAllocator<ArenaMap<std::vector<std::string>>::allocator_type>(
+              GetArena(), use_arena)),
+      form_data_args_(MakeAllocator<FormDataArgs::allocator_type>(GetArena(),
+                                                                  use_arena)),
+      path_args_(MakeAllocator<decltype(path_args_)::allocator_type>(
+          GetArena(), use_arena)),
+      path_args_by_name_index_(MakeAllocator<ArenaMap<size_t>::allocator_type>(
+          GetArena(), use_arena)),
+      response_(*this, data_accounter) {}
 
 HttpRequestImpl::~HttpRequestImpl() = default;
 
@@ -208,9 +223,7 @@ void HttpRequestImpl::SetRequestBody(std::string body) {
   request_body_ = std::move(body);
 }
 
-void HttpRequestImpl::ParseArgsFromBody() {
-  USERVER_NAMESPACE::http::parser::ParseArgs(request_body_, request_args_);
-}
+void HttpRequestImpl::ParseArgsFromBody() { ParseArgs(request_body_); }
 
 bool HttpRequestImpl::IsBodyCompressed() const {
   auto encoding = GetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding);
@@ -231,6 +244,13 @@ void HttpRequestImpl::SetPathArgs(
   }
 }
 
+void HttpRequestImpl::ParseArgs(std::string_view args) {
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
+      args, [this](std::string&& key, std::string&& value) {
+        request_args_[std::move(key)].push_back(std::move(value));
+      });
+}
+
 void HttpRequestImpl::SetMatchedPathLength(size_t length) {
   path_suffix_ = request_path_.substr(length);
 }
@@ -246,6 +266,7 @@ void HttpRequestImpl::AccountResponseTime() {
 void HttpRequestImpl::MarkAsInternalServerError() const {
   response_.SetStatus(http::HttpStatus::kInternalServerError);
   response_.SetData({});
+  response_.ClearBodyParts();
   response_.ClearHeaders();
 }
 
@@ -13,8 +13,11 @@
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include "multipart_form_data_parser.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -27,7 +30,8 @@ namespace http {
 
 class HttpRequestImpl final : public request::RequestBase {
  public:
-  HttpRequestImpl(request::ResponseDataAccounter& data_accounter);
+  HttpRequestImpl(request::ResponseDataAccounter& data_accounter,
+                  bool use_arena = true);
   ~HttpRequestImpl() override;
 
   const HttpMethod& GetMethod() const { return method_; }
@@ -119,6 +123,13 @@ class HttpRequestImpl final : public request::RequestBase {
   friend class HttpRequestConstructor;
 
  private:
+  template <typename Value>
+  using ArenaMap = std::unordered_map<
+      std::string, Value, utils::StrCaseHash, std::equal_to<std::string>,
+      utils::ArenaAllocator<std::pair<const std::string, Value>>>;
+
+  void ParseArgs(std::string_view args);
+
   // method_ = (orig_method_ == kHead ? kGet : orig_method_)
   HttpMethod method_{HttpMethod::kUnknown};
   HttpMethod orig_method_{HttpMethod::kUnknown};
@@ -128,13 +139,12 @@ class HttpRequestImpl final : public request::RequestBase {
   std::string request_path_;
   std::string request_body_;
   std::string path_suffix_;
-  std::unordered_map<std::string, std::vector<std::string>, utils::StrCaseHash>
-      request_args_;
-  std::unordered_map<std::string, std::vector<FormDataArg>, utils::StrCaseHash>
-      form_data_args_;
-  std::vector<std::string> path_args_;
-  std::unordered_map<std::string, size_t, utils::StrCaseHash>
-      path_args_by_name_index_;
+  // The arena takes the nodes and the buckets, the keys and the vectors of
+  // values are still allocated on heap
+  ArenaMap<std::vector<std::string>> request_args_;
+  FormDataArgs form_data_args_;
+  std::vector<std::string, utils::ArenaAllocator<std::string>> path_args_;
+  ArenaMap<size_t> path_args_by_name_index_;
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
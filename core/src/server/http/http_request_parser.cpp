@@ -1,9 +1,13 @@
 #include "http_request_parser.hpp"
 
+#include <charconv>
+
+#include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,6 +38,18 @@ HttpMethod ConvertHttpMethod(http_method method) {
   }
 }
 
+// Methods that do not need special handling in http_parser
+HttpMethod ConvertSimpleHttpMethod(std::string_view method) {
+  if (method == "GET") return HttpMethod::kGet;
+  if (method == "POST") return HttpMethod::kPost;
+  if (method == "PUT") return HttpMethod::kPut;
+  if (method == "DELETE") return HttpMethod::kDelete;
+  if (method == "PATCH") return HttpMethod::kPatch;
+  if (method == "HEAD") return HttpMethod::kHead;
+  if (method == "OPTIONS") return HttpMethod::kOptions;
+  return HttpMethod::kUnknown;
+}
+
 }  // namespace
 
 const http_parser_settings HttpRequestParser::parser_settings = []() {
@@ -52,9 +68,9 @@ HttpRequestParser::HttpRequestParser(
     const HandlerInfoIndex& handler_info_index,
     const request::HttpRequestConfig& request_config,
     OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
-    request::ResponseDataAccounter& data_accounter)
+    request::ResponseDataAccounter& data_accounter, bool use_request_arena)
     : handler_info_index_(handler_info_index),
-      request_constructor_config_{request_config},
+      request_constructor_config_{request_config, use_request_arena},
       on_new_request_cb_(std::move(on_new_request_cb)),
       stats_(stats),
       data_accounter_(data_accounter) {
@@ -63,6 +79,22 @@ HttpRequestParser::HttpRequestParser(
 }
 
 bool HttpRequestParser::Parse(const char* data, size_t size) {
+  // The fast path may only start a new request, a request received partially
+  // is finished by http_parser
+  while (size != 0 && !request_constructor_) {
+    size_t parsed_size = 0;
+    bool is_final = false;
+    const auto result = TryParseFast(data, size, parsed_size, is_final);
+    if (result == FastParseResult::kFallback) break;
+    if (result == FastParseResult::kError) return false;
+
+    data += parsed_size;
+    size -= parsed_size;
+    // http_parser rejects the data after a request without keep-alive
+    if (is_final) return size == 0;
+  }
+  if (size == 0) return true;
+
   size_t parsed = http_parser_execute(&parser_, &parser_settings, data, size);
   if (parsed != size) {
     LOG_WARNING() << "parsed=" << parsed << " size=" << size
@@ -79,6 +111,82 @@ bool HttpRequestParser::Parse(const char* data, size_t size) {
   return true;
 }
 
+HttpRequestParser::FastParseResult HttpRequestParser::TryParseFast(
+    const char* data, size_t size, size_t& parsed_size, bool& is_final) {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+
+  if (TokenizeRequestHead({data, size}, tokenized_head_) !=
+      TokenizeResult::kOk) {
+    return FastParseResult::kFallback;
+  }
+  const auto method = ConvertSimpleHttpMethod(tokenized_head_.method);
+  if (method == HttpMethod::kUnknown) return FastParseResult::kFallback;
+
+  // Message framing, anything unusual is left to http_parser
+  const utils::StrIcaseEqual equal;
+  std::optional<size_t> content_length;
+  bool has_connection_close = false;
+  bool has_connection_keep_alive = false;
+  for (const auto& [name, value] : tokenized_head_.headers) {
+    if (equal(name, headers::kContentLength)) {
+      size_t length = 0;
+      const auto [ptr, ec] =
+          std::from_chars(value.data(), value.data() + value.size(), length);
+      if (content_length || ec != std::errc{} ||
+          ptr != value.data() + value.size()) {
+        return FastParseResult::kFallback;
+      }
+      content_length = length;
+    } else if (equal(name, headers::kConnection)) {
+      if (equal(value, "close")) {
+        has_connection_close = true;
+      } else if (equal(value, "keep-alive")) {
+        has_connection_keep_alive = true;
+      } else {
+        return FastParseResult::kFallback;
+      }
+    } else if (equal(name, headers::kTransferEncoding) ||
+               equal(name, "Upgrade")) {
+      return FastParseResult::kFallback;
+    }
+  }
+
+  const auto body_size = content_length.value_or(0);
+  if (body_size > size - tokenized_head_.size) {
+    return FastParseResult::kFallback;
+  }
+  parsed_size = tokenized_head_.size + body_size;
+  // Same as http_should_keep_alive() for requests
+  is_final = tokenized_head_.http_minor == 1 ? has_connection_close
+                                             : !has_connection_keep_alive;
+
+  CreateRequestConstructor();
+  url_complete_ = true;
+  try {
+    auto& constructor = *request_constructor_;
+    constructor.SetMethod(method);
+    constructor.SetHttpMajor(1);
+    constructor.SetHttpMinor(tokenized_head_.http_minor);
+    constructor.AppendUrl(tokenized_head_.url.data(),
+                          tokenized_head_.url.size());
+    constructor.ParseUrl();
+    for (const auto& [name, value] : tokenized_head_.headers) {
+      constructor.AppendHeader(name, value);
+    }
+    if (body_size) {
+      constructor.AppendBody(data + tokenized_head_.size, body_size);
+    }
+    constructor.SetIsFinal(is_final);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't parse request: " << ex;
+    FinalizeRequest();
+    return FastParseResult::kError;
+  }
+
+  return FinalizeRequest() ? FastParseResult::kParsed
+                           : FastParseResult::kError;
+}
+
 int HttpRequestParser::OnMessageBegin(http_parser* p) {
   auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
   UASSERT(http_request_parser != nullptr);
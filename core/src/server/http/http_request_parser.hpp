@@ -13,6 +13,7 @@
 #include <userver/server/request/request_config.hpp>
 
 #include "http_request_constructor.hpp"
+#include "http_request_tokenizer.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,7 +27,8 @@ class HttpRequestParser final : public request::RequestParser {
   HttpRequestParser(const HandlerInfoIndex& handler_info_index,
                     const request::HttpRequestConfig& request_config,
                     OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
-                    request::ResponseDataAccounter& data_accounter);
+                    request::ResponseDataAccounter& data_accounter,
+                    bool use_request_arena = true);
 
   HttpRequestParser(HttpRequestParser&&) = delete;
   HttpRequestParser& operator=(HttpRequestParser&&) = delete;
@@ -34,6 +36,13 @@ class HttpRequestParser final : public request::RequestParser {
   bool Parse(const char* data, size_t size) override;
 
  private:
+  enum class FastParseResult { kParsed, kFallback, kError };
+
+  // Parses a complete simple request without http_parser, the rest of the
+  // requests go to http_parser
+  FastParseResult TryParseFast(const char* data, size_t size,
+                               size_t& parsed_size, bool& is_final);
+
   static int OnMessageBegin(http_parser* p);
   static int OnUrl(http_parser* p, const char* data, size_t size);
   static int OnHeaderField(http_parser* p, const char* data, size_t size);
@@ -66,6 +75,8 @@ class HttpRequestParser final : public request::RequestParser {
 
   http_parser parser_{};
   std::optional<HttpRequestConstructor> request_constructor_;
+  // Reused to not allocate on every request
+  TokenizedRequestHead tokenized_head_;
 
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
@@ -0,0 +1,160 @@
+#include <userver/utest/utest.hpp>
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/request/request_context.hpp>
+
+#include <server/http/http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct ParsedRequest {
+  std::string method;
+  std::string url;
+  int http_minor;
+  std::map<std::string, std::string> headers;
+  std::string body;
+  bool is_final;
+  int status;
+
+  bool operator==(const ParsedRequest& other) const {
+    return std::tie(method, url, http_minor, headers, body, is_final,
+                    status) ==
+           std::tie(other.method, other.url, other.http_minor, other.headers,
+                    other.body, other.is_final, other.status);
+  }
+};
+
+// Either a single buffer for the tokenizer fast path or byte by byte for
+// http_parser
+std::vector<ParsedRequest> ParseRequests(std::string_view data,
+                                         bool split_bytes) {
+  std::vector<ParsedRequest> result;
+  auto parser = server::CreateTestParser(
+      [&result](std::shared_ptr<server::request::RequestBase>&& request) {
+        const auto& impl =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        ParsedRequest parsed{impl.GetOrigMethodStr(),
+                             impl.GetUrl(),
+                             impl.GetHttpMinor(),
+                             {},
+                             impl.RequestBody(),
+                             impl.IsFinal(),
+                             static_cast<int>(
+                                 impl.GetHttpResponse().GetStatus())};
+        for (const auto& name : impl.GetHeaderNames()) {
+          parsed.headers.emplace(name, impl.GetHeader(name));
+        }
+        result.push_back(std::move(parsed));
+      });
+
+  if (split_bytes) {
+    for (const char c : data) EXPECT_TRUE(parser.Parse(&c, 1));
+  } else {
+    EXPECT_TRUE(parser.Parse(data.data(), data.size()));
+  }
+  return result;
+}
+
+}  // namespace
+
+UTEST(HttpRequestParser, FastPathMatchesHttpParser) {
+  constexpr std::string_view kRequests =
+      "GET /first?a=b HTTP/1.1\r\n"
+      "Host: localhost\r\n"
+      "X-Dup: 1\r\n"
+      "x-dup: 2\r\n"
+      "Cookie: name=value\r\n"
+      "\r\n"
+      "POST /second HTTP/1.1\r\n"
+      "Content-Length: 4\r\n"
+      "X-Trailing-Space: value \r\n"
+      "\r\n"
+      "body"
+      "HEAD /third HTTP/1.0\r\n"
+      "Connection: keep-alive\r\n"
+      "\r\n"
+      "PUT /last HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "Connection: close\r\n"
+      "\r\n"
+      "3\r\nabc\r\n0\r\n\r\n";
+
+  const auto fast = ParseRequests(kRequests, false);
+  const auto reference = ParseRequests(kRequests, true);
+
+  ASSERT_EQ(fast.size(), std::size_t{4});
+  EXPECT_EQ(fast, reference);
+
+  EXPECT_EQ(fast[0].headers.at("X-Dup"), "1,2");
+  EXPECT_EQ(fast[1].body, "body");
+  EXPECT_EQ(fast[1].headers.at("X-Trailing-Space"), "value ");
+  EXPECT_EQ(fast[2].method, "HEAD");
+  EXPECT_FALSE(fast[2].is_final);
+  EXPECT_EQ(fast[3].body, "abc");
+  EXPECT_TRUE(fast[3].is_final);
+}
+
+UTEST(HttpRequestParser, FastPathHttp10) {
+  constexpr std::string_view kRequest = "GET / HTTP/1.0\r\nHost: a\r\n\r\n";
+
+  const auto fast = ParseRequests(kRequest, false);
+  ASSERT_EQ(fast.size(), std::size_t{1});
+  EXPECT_TRUE(fast[0].is_final);
+  EXPECT_EQ(fast, ParseRequests(kRequest, true));
+}
+
+UTEST(HttpRequestParser, FastPathLimits) {
+  const std::string request =
+      "GET / HTTP/1.1\r\nX-Large: " + std::string(70000, 'x') + "\r\n\r\n";
+
+  std::vector<int> statuses;
+  auto parser = server::CreateTestParser(
+      [&statuses](std::shared_ptr<server::request::RequestBase>&& request) {
+        const auto& impl =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        statuses.push_back(
+            static_cast<int>(impl.GetHttpResponse().GetStatus()));
+      });
+
+  EXPECT_FALSE(parser.Parse(request.data(), request.size()));
+  ASSERT_EQ(statuses.size(), std::size_t{1});
+  EXPECT_EQ(statuses[0], static_cast<int>(server::http::HttpStatus::
+                                              kRequestHeaderFieldsTooLarge));
+}
+
+UTEST(HttpRequestParser, ArgsInArena) {
+  constexpr std::string_view kRequest =
+      "GET /path?a=1&b=2&a=3 HTTP/1.1\r\nHost: a\r\n\r\n";
+
+  std::shared_ptr<server::request::RequestBase> parsed;
+  auto parser = server::CreateTestParser(
+      [&parsed](std::shared_ptr<server::request::RequestBase>&& request) {
+        parsed = std::move(request);
+      });
+  EXPECT_TRUE(parser.Parse(kRequest.data(), kRequest.size()));
+  ASSERT_TRUE(parsed);
+
+  const auto& impl = dynamic_cast<server::http::HttpRequestImpl&>(*parsed);
+  EXPECT_EQ(impl.ArgCount(), std::size_t{2});
+  EXPECT_EQ(impl.GetArgVector("a"), (std::vector<std::string>{"1", "3"}));
+  EXPECT_EQ(impl.GetArg("b"), "2");
+  EXPECT_GT(parsed->GetArena().GetAllocatedBytes(), std::size_t{0});
+  EXPECT_EQ(parsed->GetArena().GetHeapBlocksCount(), std::size_t{0});
+
+  server::request::RequestContext context{parsed->GetArena()};
+  const auto allocated = parsed->GetArena().GetAllocatedBytes();
+  context.SetData("key", std::string{"value"});
+  EXPECT_EQ(context.GetData<std::string>("key"), "value");
+  EXPECT_GT(parsed->GetArena().GetAllocatedBytes(), allocated);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,185 @@
+#include "http_request_tokenizer.hpp"
+
+#include <array>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kHttpVersionPrefix = "HTTP/1.";
+
+// Header values may contain any bytes except control characters, HTAB is
+// allowed. URLs end at the first space or control character.
+enum class StopChars { kValue, kUrl };
+
+constexpr auto kTokenChars = [] {
+  std::array<bool, 256> res{};  // zero initialize
+  for (int c = '0'; c <= '9'; ++c) res[c] = true;
+  for (int c = 'a'; c <= 'z'; ++c) res[c] = true;
+  for (int c = 'A'; c <= 'Z'; ++c) res[c] = true;
+  for (unsigned char c : std::string_view{"!#$%&'*+-.^_`|~"}) res[c] = true;
+  return res;
+}();
+
+template <StopChars kStop>
+constexpr bool IsStopChar(unsigned char c) noexcept {
+  if constexpr (kStop == StopChars::kUrl) {
+    return c <= ' ' || c == 0x7f;
+  } else {
+    return (c < ' ' && c != '\t') || c == 0x7f;
+  }
+}
+
+#if defined(__AVX2__)
+template <StopChars kStop>
+std::uint32_t StopCharsMask(__m256i chars) noexcept {
+  // Unsigned comparison via signed one with flipped sign bits
+  constexpr char kBound = kStop == StopChars::kUrl ? ' ' + 1 : ' ';
+  const auto flipped = _mm256_xor_si256(chars, _mm256_set1_epi8(-128));
+  const auto bound = _mm256_set1_epi8(static_cast<char>(kBound ^ 0x80));
+  auto mask = _mm256_or_si256(_mm256_cmpgt_epi8(bound, flipped),
+                              _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(0x7f)));
+  if constexpr (kStop == StopChars::kValue) {
+    const auto tabs = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\t'));
+    mask = _mm256_andnot_si256(tabs, mask);
+  }
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(mask));
+}
+#endif
+
+#if defined(__SSE2__)
+template <StopChars kStop>
+std::uint32_t StopCharsMask(__m128i chars) noexcept {
+  // Unsigned comparison via signed one with flipped sign bits
+  constexpr char kBound = kStop == StopChars::kUrl ? ' ' + 1 : ' ';
+  const auto flipped = _mm_xor_si128(chars, _mm_set1_epi8(-128));
+  const auto bound = _mm_set1_epi8(static_cast<char>(kBound ^ 0x80));
+  auto mask = _mm_or_si128(_mm_cmplt_epi8(flipped, bound),
+                           _mm_cmpeq_epi8(chars, _mm_set1_epi8(0x7f)));
+  if constexpr (kStop == StopChars::kValue) {
+    mask = _mm_andnot_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')), mask);
+  }
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(mask));
+}
+#endif
+
+template <StopChars kStop>
+const char* FindStopChar(const char* pos, const char* end) noexcept {
+#if defined(__AVX2__)
+  for (; end - pos >= 32; pos += 32) {
+    const auto mask = StopCharsMask<kStop>(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos)));
+    if (mask) return pos + __builtin_ctz(mask);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; end - pos >= 16; pos += 16) {
+    const auto mask = StopCharsMask<kStop>(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)));
+    if (mask) return pos + __builtin_ctz(mask);
+  }
+#endif
+  for (; pos != end; ++pos) {
+    if (IsStopChar<kStop>(static_cast<unsigned char>(*pos))) return pos;
+  }
+  return end;
+}
+
+// Returns nullptr if the buffer is too short to check
+const char* SkipCrlf(const char* pos, const char* end, bool& is_crlf) noexcept {
+  if (end - pos < 2) return nullptr;
+  is_crlf = pos[0] == '\r' && pos[1] == '\n';
+  return pos + 2;
+}
+
+}  // namespace
+
+TokenizeResult TokenizeRequestHead(std::string_view data,
+                                   TokenizedRequestHead& head) {
+  const char* const begin = data.data();
+  const char* const end = begin + data.size();
+  const char* pos = begin;
+  head.headers.clear();
+
+  // Method, only uppercase letters are known to http_parser
+  const char* const method_begin = pos;
+  while (pos != end && *pos >= 'A' && *pos <= 'Z') ++pos;
+  if (pos == end) return TokenizeResult::kIncomplete;
+  if (pos == method_begin || *pos != ' ') return TokenizeResult::kUnsupported;
+  head.method = {method_begin, static_cast<std::size_t>(pos - method_begin)};
+  ++pos;
+
+  const char* const url_begin = pos;
+  pos = FindStopChar<StopChars::kUrl>(pos, end);
+  if (pos == end) return TokenizeResult::kIncomplete;
+  if (pos == url_begin || *pos != ' ') return TokenizeResult::kUnsupported;
+  head.url = {url_begin, static_cast<std::size_t>(pos - url_begin)};
+  ++pos;
+
+  if (static_cast<std::size_t>(end - pos) < kHttpVersionPrefix.size() + 1) {
+    return TokenizeResult::kIncomplete;
+  }
+  if (std::string_view{pos, kHttpVersionPrefix.size()} != kHttpVersionPrefix ||
+      (pos[kHttpVersionPrefix.size()] != '0' &&
+       pos[kHttpVersionPrefix.size()] != '1')) {
+    return TokenizeResult::kUnsupported;
+  }
+  head.http_minor = pos[kHttpVersionPrefix.size()] - '0';
+  pos += kHttpVersionPrefix.size() + 1;
+
+  bool is_crlf = false;
+  pos = SkipCrlf(pos, end, is_crlf);
+  if (!pos) return TokenizeResult::kIncomplete;
+  if (!is_crlf) return TokenizeResult::kUnsupported;
+
+  while (true) {
+    if (pos == end) return TokenizeResult::kIncomplete;
+    if (*pos == '\r') {
+      pos = SkipCrlf(pos, end, is_crlf);
+      if (!pos) return TokenizeResult::kIncomplete;
+      if (!is_crlf) return TokenizeResult::kUnsupported;
+      head.size = pos - begin;
+      return TokenizeResult::kOk;
+    }
+
+    // Header names are short, a table lookup is faster than vector setup
+    const char* const name_begin = pos;
+    while (pos != end && kTokenChars[static_cast<unsigned char>(*pos)]) ++pos;
+    if (pos == end) return TokenizeResult::kIncomplete;
+    if (pos == name_begin || *pos != ':') return TokenizeResult::kUnsupported;
+    const std::string_view name{name_begin,
+                                static_cast<std::size_t>(pos - name_begin)};
+    ++pos;
+
+    // Leading whitespace is dropped, the trailing one is kept as in
+    // http_parser
+    while (pos != end && (*pos == ' ' || *pos == '\t')) ++pos;
+    const char* const value_begin = pos;
+    pos = FindStopChar<StopChars::kValue>(pos, end);
+    if (pos == end) return TokenizeResult::kIncomplete;
+    if (pos == value_begin) return TokenizeResult::kUnsupported;
+    const std::string_view value{value_begin,
+                                 static_cast<std::size_t>(pos - value_begin)};
+
+    pos = SkipCrlf(pos, end, is_crlf);
+    if (!pos) return TokenizeResult::kIncomplete;
+    if (!is_crlf) return TokenizeResult::kUnsupported;
+    // Obsolete line folding continues the value on the next line
+    if (pos != end && (*pos == ' ' || *pos == '\t')) {
+      return TokenizeResult::kUnsupported;
+    }
+
+    head.headers.push_back({name, value});
+  }
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
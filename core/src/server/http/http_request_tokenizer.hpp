@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+struct TokenizedHeader {
+  std::string_view name;
+  std::string_view value;
+};
+
+/// Request line and headers of an HTTP/1.x request, all the views point into
+/// the tokenized buffer.
+struct TokenizedRequestHead {
+  std::string_view method;
+  std::string_view url;
+  unsigned short http_minor{0};
+  std::vector<TokenizedHeader> headers;
+  /// Size of the request line and the headers including the empty line
+  std::size_t size{0};
+};
+
+enum class TokenizeResult {
+  kOk,
+  /// The buffer ends before the empty line after the headers
+  kIncomplete,
+  /// The request uses syntax that must be handled by a complete parser:
+  /// obsolete line folding, bare LF line endings, empty header values, etc.
+  kUnsupported,
+};
+
+/// @brief Splits the request line and headers into views without copying.
+///
+/// Control characters are searched with SSE2/AVX2 instructions where
+/// available and with a lookup table otherwise. The tokenizer is strict: any
+/// unusual syntax is reported as kUnsupported rather than an error, so that
+/// the caller may fall back to http_parser to get the exact same behavior.
+TokenizeResult TokenizeRequestHead(std::string_view data,
+                                   TokenizedRequestHead& head);
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
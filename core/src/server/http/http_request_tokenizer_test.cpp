@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <server/http/http_request_tokenizer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::TokenizedRequestHead;
+using server::http::TokenizeRequestHead;
+using server::http::TokenizeResult;
+
+constexpr std::string_view kRequest =
+    "POST /path/to/handler?arg=value HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent:   curl/7.58.0 with a long value to cross the vector size\r\n"
+    "X-Header: \tvalue with\ttabs and trailing space \r\n"
+    "X-High-Bytes: \x80\xff\r\n"
+    "\r\n"
+    "body";
+
+}  // namespace
+
+TEST(HttpRequestTokenizer, Basic) {
+  TokenizedRequestHead head;
+  ASSERT_EQ(TokenizeRequestHead(kRequest, head), TokenizeResult::kOk);
+
+  EXPECT_EQ(head.method, "POST");
+  EXPECT_EQ(head.url, "/path/to/handler?arg=value");
+  EXPECT_EQ(head.http_minor, 1);
+  EXPECT_EQ(head.size, kRequest.size() - 4);
+
+  ASSERT_EQ(head.headers.size(), std::size_t{4});
+  EXPECT_EQ(head.headers[0].name, "Host");
+  EXPECT_EQ(head.headers[0].value, "localhost:8080");
+  EXPECT_EQ(head.headers[1].name, "User-Agent");
+  EXPECT_EQ(head.headers[1].value,
+            "curl/7.58.0 with a long value to cross the vector size");
+  EXPECT_EQ(head.headers[2].name, "X-Header");
+  EXPECT_EQ(head.headers[2].value, "value with\ttabs and trailing space ");
+  EXPECT_EQ(head.headers[3].value, "\x80\xff");
+}
+
+TEST(HttpRequestTokenizer, Incomplete) {
+  TokenizedRequestHead head;
+  for (std::size_t size = 0; size < kRequest.size() - 4; ++size) {
+    EXPECT_EQ(TokenizeRequestHead(kRequest.substr(0, size), head),
+              TokenizeResult::kIncomplete)
+        << "size=" << size;
+  }
+}
+
+TEST(HttpRequestTokenizer, Unsupported) {
+  TokenizedRequestHead head;
+  for (const std::string_view request : {
+           "get / HTTP/1.1\r\n\r\n",
+           "GET / HTTP/2.0\r\n\r\n",
+           "GET / HTTP/1.1\n\r\n",
+           "GET  / HTTP/1.1\r\n\r\n",
+           "GET / HTTP/1.1\r\nHost\r\n\r\n",
+           "GET / HTTP/1.1\r\nHost :localhost\r\n\r\n",
+           "GET / HTTP/1.1\r\nHost:\r\n\r\n",
+           "GET / HTTP/1.1\r\nHost: local\x01host\r\n\r\n",
+           "GET / HTTP/1.1\r\nHost: localhost\n\r\n",
+           "GET / HTTP/1.1\r\nX-Folded: a\r\n b\r\n\r\n",
+       }) {
+    EXPECT_EQ(TokenizeRequestHead(request, head), TokenizeResult::kUnsupported)
+        << request;
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,18 @@
 #include <userver/server/http/http_response.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <array>
+#include <stdexcept>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
@@ -15,8 +21,10 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 #include <server/http/http_cached_date.hpp>
+#include <utils/check_syscall.hpp>
 
 #include "http_request_impl.hpp"
 
@@ -30,6 +38,15 @@ constexpr std::string_view kKeyValueHeaderSeparator = ": ";
 const auto kDefaultContentTypeString =
     http::ContentType{"text/html; charset=utf-8"}.ToString();
 
+// Keeps the iovec arrays of writev on stack, see engine::io::Socket::SendAll
+constexpr std::size_t kMaxIoDataPerSend = 31;
+// Responses with many chunks are sent separately to not hit IOV_MAX
+constexpr std::size_t kMaxBatchedBodyParts = 8;
+
+// Bounds the memory of a streamed body and makes the handler wait for a slow
+// client
+constexpr std::size_t kMaxQueuedBodyStreamChunks = 16;
+
 constexpr std::string_view kClose = "close";
 constexpr std::string_view kKeepAlive = "keep-alive";
 
@@ -72,6 +89,22 @@ bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
          (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
 }
 
+void ReadFileRange(int fd, std::uint64_t offset, char* buffer,
+                   std::size_t size) {
+  std::size_t read_bytes = 0;
+  while (read_bytes < size) {
+    const auto chunk_size = utils::CheckSyscall(
+        ::pread(fd, buffer + read_bytes, size - read_bytes,
+                static_cast<off_t>(offset + read_bytes)),
+        "reading the response body from file");
+    if (chunk_size == 0) {
+      throw std::runtime_error(
+          "File ended before the response body was read from it");
+    }
+    read_bytes += chunk_size;
+  }
+}
+
 }  // namespace
 
 namespace server::http {
@@ -163,11 +196,73 @@ const Cookie& HttpResponse::GetCookie(std::string_view cookie_name) const {
   return cookies_.at(cookie_name.data());
 }
 
+void HttpResponse::AppendBodyChunk(std::shared_ptr<const void> owner,
+                                   std::string_view chunk) {
+  UASSERT_MSG(!IsBodyStreamed(), "Body parts are not allowed for streams");
+  if (chunk.empty()) return;
+
+  body_parts_.push_back({std::move(owner), chunk});
+  body_parts_size_ += chunk.size();
+  AccountExtraData(chunk.size());
+}
+
+void HttpResponse::AppendBodyFile(
+    engine::TaskProcessor& fs_task_processor,
+    std::shared_ptr<const fs::blocking::FileDescriptor> file,
+    std::uint64_t offset, std::size_t size) {
+  UASSERT_MSG(!IsBodyStreamed(), "Body parts are not allowed for streams");
+  UASSERT(file && file->IsOpen());
+  if (size == 0) return;
+
+  const int fd = file->GetNative();
+  body_parts_.push_back(
+      {std::move(file), {}, fd, offset, size, &fs_task_processor});
+  body_parts_size_ += size;
+  AccountExtraData(size);
+}
+
+std::size_t HttpResponse::GetBodySize() const {
+  return GetData().size() + body_parts_size_;
+}
+
 void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
 void HttpResponse::SendResponse(engine::io::Socket& socket) {
+  auto header = SerializeHeaders();
+
+  if (IsBodyStreamed() && GetData().empty()) {
+    SetBodyStreamed(socket, header);
+  } else {
+    // e.g. a CustomHandlerException
+    SetBodyNotstreamed(socket, header);
+  }
+}
+
+bool HttpResponse::SerializeForBatch(
+    std::vector<engine::io::IoData>& buffers) {
+  if (IsBodyStreamed() && GetData().empty()) return false;
+  if (body_parts_.size() > kMaxBatchedBodyParts) return false;
+  for (const auto& part : body_parts_) {
+    if (part.file_fd != -1) return false;
+  }
+
+  batch_header_ = SerializeHeaders();
+  const bool send_body = FinishNotstreamedHeaders(batch_header_);
+
+  buffers.push_back({batch_header_.data(), batch_header_.size()});
+  if (send_body) {
+    const auto& data = GetData();
+    buffers.push_back({data.data(), data.size()});
+    for (const auto& part : body_parts_) {
+      buffers.push_back({part.chunk.data(), part.chunk.size()});
+    }
+  }
+  return true;
+}
+
+std::string HttpResponse::SerializeHeaders() {
   // According to https://www.chromium.org/spdy/spdy-whitepaper/
   // "typical header sizes of 700-800 bytes is common"
   // Adjusting it to 1KiB to fit jemalloc size class
@@ -209,35 +304,39 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
     header.append(kCrlf);
   }
 
-  if (IsBodyStreamed() && GetData().empty()) {
-    SetBodyStreamed(socket, header);
-  } else {
-    // e.g. a CustomHandlerException
-    SetBodyNotstreamed(socket, header);
-  }
+  return header;
 }
 
-void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
-                                      std::string& header) {
+bool HttpResponse::FinishNotstreamedHeaders(std::string& header) const {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
-  const auto& data = GetData();
+  const auto body_size = GetBodySize();
 
   if (!is_body_forbidden) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentLength,
-                       fmt::format(FMT_COMPILE("{}"), data.size()));
+                       fmt::format(FMT_COMPILE("{}"), body_size));
   }
   header.append(kCrlf);
 
-  if (is_body_forbidden && !data.empty()) {
+  if (is_body_forbidden && body_size != 0) {
     LOG_LIMITED_WARNING()
         << "Non-empty body provided for response with HTTP code "
         << static_cast<int>(status_)
         << " which does not allow one, it will be dropped";
   }
 
+  return !is_head_request && !is_body_forbidden;
+}
+
+void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
+                                      std::string& header) {
+  const bool send_body = FinishNotstreamedHeaders(header);
+  const auto& data = GetData();
+
   ssize_t sent_bytes = 0;
-  if (!is_head_request && !is_body_forbidden) {
+  if (send_body && !body_parts_.empty()) {
+    sent_bytes = SendBodyParts(socket, header);
+  } else if (send_body) {
     sent_bytes = socket.SendAll(
         {{header.data(), header.size()}, {data.data(), data.size()}},
         engine::Deadline{});
@@ -250,11 +349,48 @@ void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
   SetSent(sent_bytes);
 }
 
+std::size_t HttpResponse::SendBodyParts(engine::io::Socket& socket,
+                                        std::string& header) {
+  std::vector<engine::io::IoData> buffers;
+  buffers.reserve(std::min(body_parts_.size() + 2, kMaxIoDataPerSend));
+  std::size_t sent_bytes = 0;
+  const auto flush = [&] {
+    if (buffers.empty()) return;
+    sent_bytes +=
+        socket.SendAll(buffers.data(), buffers.size(), engine::Deadline{});
+    buffers.clear();
+  };
+
+  buffers.push_back({header.data(), header.size()});
+  const auto& data = GetData();
+  if (!data.empty()) buffers.push_back({data.data(), data.size()});
+
+  for (const auto& part : body_parts_) {
+    if (part.file_fd == -1) {
+      buffers.push_back({part.chunk.data(), part.chunk.size()});
+      if (buffers.size() == kMaxIoDataPerSend) flush();
+    } else {
+      flush();
+      sent_bytes += socket.SendFile(part.file_fd, part.file_offset,
+                                    part.file_size, engine::Deadline{});
+    }
+  }
+  flush();
+
+  return sent_bytes;
+}
+
 void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
                                    std::string& header) {
   impl::OutputHeader(
       header, USERVER_NAMESPACE::http::headers::kTransferEncoding, "chunked");
 
+  // Producer waits on the bounded queue, release it on send failures as well
+  const utils::FastScopeGuard release_stream([this]() noexcept {
+    body_stream_producer_.reset();
+    body_stream_.reset();
+  });
+
   // send HTTP headers
   size_t sent_bytes = socket.SendAll(header.data(), header.size(), {});
   std::string().swap(header);  // free memory before time consuming operation
@@ -273,14 +409,16 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
         engine::Deadline{});
   }
 
+  if (is_body_stream_aborted_) {
+    // Without the terminating chunk the client sees a truncated body, the
+    // connection is closed by the caller
+    throw std::runtime_error("Streamed response body was aborted");
+  }
+
   const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
   sent_bytes +=
       socket.SendAll(terminating_chunk.data(), terminating_chunk.size(), {});
 
-  // TODO: exceptions?
-  body_stream_producer_.reset();
-  body_stream_.reset();
-
   SetSentTime(std::chrono::steady_clock::now());
   SetSent(sent_bytes);
 }
@@ -301,13 +439,61 @@ void SetThrottleReason(http::HttpResponse& http_response,
 void HttpResponse::SetStreamBody() {
   UASSERT(!body_stream_);
 
-  const auto body_queue = Queue::Create();
+  const auto body_queue = Queue::Create(kMaxQueuedBodyStreamChunks);
   body_stream_.emplace(body_queue->GetConsumer());
   body_stream_producer_.emplace(body_queue->GetProducer());
 }
 
 bool HttpResponse::IsBodyStreamed() const { return body_stream_.has_value(); }
 
+void HttpResponse::AbortBodyStream() noexcept {
+  is_body_stream_aborted_ = true;
+}
+
+void HttpResponse::ConsumeBodyStream() {
+  UASSERT(IsBodyStreamed());
+
+  std::string body;
+  std::string body_part;
+  while (body_stream_->Pop(body_part)) body.append(body_part);
+
+  body_stream_producer_.reset();
+  body_stream_.reset();
+  if (is_body_stream_aborted_) {
+    throw std::runtime_error("Streamed response body was aborted");
+  }
+  SetData(std::move(body));
+}
+
+void HttpResponse::FlattenBody() {
+  if (body_parts_.empty()) return;
+
+  std::string body;
+  body.reserve(GetBodySize());
+  body.append(GetData());
+  for (const auto& part : body_parts_) {
+    if (part.file_fd == -1) {
+      body.append(part.chunk);
+      continue;
+    }
+
+    const auto begin = body.size();
+    body.resize(begin + part.file_size);
+    UASSERT(part.fs_task_processor);
+    engine::AsyncNoSpan(*part.fs_task_processor, &ReadFileRange, part.file_fd,
+                        part.file_offset, body.data() + begin, part.file_size)
+        .Get();
+  }
+
+  ClearBodyParts();
+  SetData(std::move(body));
+}
+
+void HttpResponse::ClearBodyParts() {
+  body_parts_.clear();
+  body_parts_size_ = 0;
+}
+
 HttpResponse::Queue::Producer HttpResponse::GetBodyProducer() {
   UASSERT(IsBodyStreamed());
   UASSERT_MSG(body_stream_producer_, "GetBodyProducer() is called twice");
@@ -1,10 +1,25 @@
 #include <benchmark/benchmark.h>
 
-#include <fmt/compile.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <sstream>
 
+#include <fmt/compile.h>
+
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/formats/json/inline.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_response_body_json_writer.hpp>
 #include <userver/server/http/http_status.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -65,9 +80,146 @@ void http_headers_serialization_ostreams(benchmark::State& state) {
   }
 }
 
+enum class BodyMode { kCopy, kChunk };
+
+void http_response_send(benchmark::State& state, BodyMode mode) {
+  engine::RunStandalone(2, [&] {
+    std::array<int, 2> fds{};
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) != 0) {
+      state.SkipWithError("socketpair failed");
+      return;
+    }
+    engine::io::Socket writer{fds[0]};
+    engine::io::Socket reader_socket{fds[1]};
+    auto reader = engine::AsyncNoSpan([&reader_socket] {
+      std::array<char, 64 * 1024> buf{};
+      while (reader_socket.RecvSome(buf.data(), buf.size(), {}) != 0) {
+      }
+    });
+
+    // e.g. a file of the fs::FsCacheClient
+    const auto body = std::make_shared<const std::string>(
+        static_cast<std::size_t>(state.range(0)), 'x');
+    server::request::ResponseDataAccounter accounter;
+    std::size_t bytes_copied = 0;
+
+    for (auto _ : state) {
+      server::http::HttpRequestImpl request{accounter};
+      auto& response = request.GetHttpResponse();
+      if (mode == BodyMode::kCopy) {
+        response.SetData(*body);
+        bytes_copied += body->size();
+      } else {
+        response.AppendBodyChunk(body, *body);
+      }
+      response.SendResponse(writer);
+    }
+
+    writer.Close();
+    reader.Get();
+
+    state.SetBytesProcessed(state.iterations() * body->size());
+    state.counters["bytes_copied_per_response"] = benchmark::Counter(
+        static_cast<double>(bytes_copied), benchmark::Counter::kAvgIterations);
+  });
+}
+
+enum class JsonMode { kDom, kStream };
+
+formats::json::Value MakeJsonItem(std::int64_t i) {
+  return formats::json::MakeObject("id", i, "name", "some item name", "price",
+                                   i * 0.5);
+}
+
+// Measures the peak of the response body bytes that are kept in memory: the
+// whole body for kDom (the DOM itself is not counted) and the bytes that are
+// produced by the handler but are not received by the client yet for kStream.
+void http_response_json_array(benchmark::State& state, JsonMode mode) {
+  engine::RunStandalone(2, [&] {
+    std::array<int, 2> fds{};
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) != 0) {
+      state.SkipWithError("socketpair failed");
+      return;
+    }
+    engine::io::Socket writer{fds[0]};
+    engine::io::Socket reader_socket{fds[1]};
+    std::atomic<std::size_t> received{0};
+    auto reader = engine::AsyncNoSpan([&reader_socket, &received] {
+      std::array<char, 64 * 1024> buf{};
+      while (const auto size =
+                 reader_socket.RecvSome(buf.data(), buf.size(), {})) {
+        received += size;
+      }
+    });
+
+    const auto items = state.range(0);
+    server::request::ResponseDataAccounter accounter;
+    std::size_t peak_buffered = 0;
+
+    for (auto _ : state) {
+      server::http::HttpRequestImpl request{accounter};
+      auto& response = request.GetHttpResponse();
+
+      if (mode == JsonMode::kDom) {
+        formats::json::ValueBuilder builder{formats::common::Type::kArray};
+        for (std::int64_t i = 0; i < items; ++i) {
+          builder.PushBack(MakeJsonItem(i));
+        }
+        response.SetData(formats::json::ToString(builder.ExtractValue()));
+        peak_buffered = std::max(peak_buffered, response.GetData().size());
+        response.SendResponse(writer);
+        continue;
+      }
+
+      response.SetStreamBody();
+      auto send_task = engine::AsyncNoSpan([&response, &writer] {
+        response.WaitForHeadersEnd();
+        response.SendResponse(writer);
+      });
+      {
+        auto body_stream =
+            server::http::impl::MakeResponseBodyStream(response);
+        server::http::ResponseBodyJsonWriter json_writer{body_stream};
+        auto& builder = json_writer.GetStringBuilder();
+        const std::size_t received_before = received;
+
+        formats::json::StringBuilder::ArrayGuard guard{builder};
+        for (std::int64_t i = 0; i < items; ++i) {
+          json_writer.Write(MakeJsonItem(i));
+          const auto produced =
+              json_writer.GetFlushedSize() + builder.GetSize();
+          const std::size_t consumed = received - received_before;
+          if (produced > consumed) {
+            peak_buffered = std::max(peak_buffered, produced - consumed);
+          }
+        }
+      }
+      send_task.Get();
+    }
+
+    writer.Close();
+    reader.Get();
+
+    state.counters["peak_buffered_bytes"] =
+        benchmark::Counter(static_cast<double>(peak_buffered));
+  });
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
+BENCHMARK_CAPTURE(http_response_send, copy, BodyMode::kCopy)
+    ->RangeMultiplier(10)
+    ->Range(1024, 10 * 1024 * 1024);
+BENCHMARK_CAPTURE(http_response_send, chunk, BodyMode::kChunk)
+    ->RangeMultiplier(10)
+    ->Range(1024, 10 * 1024 * 1024);
+BENCHMARK_CAPTURE(http_response_json_array, dom, JsonMode::kDom)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+BENCHMARK_CAPTURE(http_response_json_array, stream, JsonMode::kStream)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,51 @@
+#include <userver/server/http/http_response_body_json_writer.hpp>
+
+#include <exception>
+#include <stdexcept>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+ResponseBodyJsonWriter::ResponseBodyJsonWriter(ResponseBodyStream& body_stream,
+                                               std::size_t flush_threshold)
+    : body_stream_(body_stream),
+      flush_threshold_(flush_threshold),
+      uncaught_exceptions_(std::uncaught_exceptions()) {
+  body_stream_.SetHeader(
+      USERVER_NAMESPACE::http::headers::kContentType,
+      USERVER_NAMESPACE::http::content_type::kApplicationJson.ToString());
+}
+
+ResponseBodyJsonWriter::~ResponseBodyJsonWriter() {
+  // Do not send a part of the JSON that was interrupted by an exception
+  if (std::uncaught_exceptions() != uncaught_exceptions_) return;
+
+  try {
+    Flush();
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Failed to send the rest of the JSON response body: "
+                  << e;
+  }
+}
+
+void ResponseBodyJsonWriter::Flush() {
+  if (!builder_.GetSize()) return;
+
+  auto chunk = builder_.ExtractString();
+  flushed_size_ += chunk.size();
+  body_stream_.SetEndOfHeaders();
+  body_stream_.PushBodyChunk(std::move(chunk));
+  if (body_stream_.IsClosed()) {
+    throw std::runtime_error(
+        "Failed to send the JSON response body, the response is not sent");
+  }
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,172 @@
+#include <userver/server/http/http_response_body_json_writer.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/formats/json/inline.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string ReceiveAll(engine::io::Socket& socket, engine::Deadline deadline) {
+  std::string result;
+  std::vector<char> buffer(4096, '\0');
+  while (const auto size =
+             socket.RecvSome(buffer.data(), buffer.size(), deadline)) {
+    result.append(buffer.data(), size);
+  }
+  return result;
+}
+
+std::string DecodeChunkedBody(std::string_view reply) {
+  const auto headers_end = reply.find("\r\n\r\n");
+  EXPECT_NE(headers_end, std::string_view::npos);
+  reply.remove_prefix(headers_end + 2);
+
+  std::string body;
+  for (;;) {
+    EXPECT_EQ(reply.substr(0, 2), "\r\n");
+    reply.remove_prefix(2);
+    const auto size_end = reply.find("\r\n");
+    const auto size =
+        std::stoul(std::string{reply.substr(0, size_end)}, nullptr, 16);
+    reply.remove_prefix(size_end + 2);
+    if (size == 0) break;
+
+    body += reply.substr(0, size);
+    reply.remove_prefix(size);
+  }
+  EXPECT_EQ(reply, "\r\n");
+  return body;
+}
+
+}  // namespace
+
+UTEST(HttpResponseBodyJsonWriter, Sample) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) {
+        response.WaitForHeadersEnd();
+        response.SendResponse(socket);
+      },
+      std::ref(response), std::move(server));
+  auto receive_task = engine::AsyncNoSpan(
+      [&client, test_deadline] { return ReceiveAll(client, test_deadline); });
+
+  constexpr int kItems = 1000;
+  {
+    // Producer of the body, the body ends with its destruction
+    auto body_stream = server::http::impl::MakeResponseBodyStream(response);
+
+    /// [Sample server::http::ResponseBodyJsonWriter usage]
+    // In HandleStreamRequest(), `body_stream` is its argument
+    server::http::ResponseBodyJsonWriter writer{body_stream,
+                                                /*flush_threshold=*/100};
+    formats::json::StringBuilder::ArrayGuard guard{writer.GetStringBuilder()};
+    for (int i = 0; i < kItems; ++i) {
+      writer.Write(formats::json::MakeObject("id", i, "name", "item"));
+    }
+    /// [Sample server::http::ResponseBodyJsonWriter usage]
+  }
+
+  const auto reply = receive_task.Get();
+  send_task.Get();
+
+  EXPECT_NE(reply.find(http::headers::kContentType), std::string::npos);
+  const auto json = formats::json::FromString(DecodeChunkedBody(reply));
+  ASSERT_EQ(json.GetSize(), kItems);
+  EXPECT_EQ(json[kItems - 1]["id"].As<int>(), kItems - 1);
+}
+
+UTEST(HttpResponseBodyJsonWriter, ClientGone) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+  auto body_stream = server::http::impl::MakeResponseBodyStream(response);
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) {
+        response.WaitForHeadersEnd();
+        try {
+          response.SendResponse(socket);
+        } catch (const std::exception&) {
+          // expected
+        }
+      },
+      std::ref(response), std::move(server));
+  client.Close();
+
+  server::http::ResponseBodyJsonWriter writer{body_stream, 1};
+  const std::string item(1024, 'x');
+  EXPECT_THROW(
+      {
+        for (;;) writer.Write(item);
+      },
+      std::runtime_error);
+}
+
+UTEST(HttpResponseBodyJsonWriter, AbortedByException) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) {
+        response.WaitForHeadersEnd();
+        response.SendResponse(socket);
+      },
+      std::ref(response), std::move(server));
+
+  {
+    auto body_stream = server::http::impl::MakeResponseBodyStream(response);
+    try {
+      server::http::ResponseBodyJsonWriter writer{body_stream, 1};
+      formats::json::StringBuilder::ArrayGuard guard{
+          writer.GetStringBuilder()};
+      writer.Write(std::string{"item"});
+      throw std::runtime_error("handler failed");
+    } catch (const std::runtime_error&) {
+      // What HttpHandlerBase does after the headers were sent
+      response.AbortBodyStream();
+    }
+  }
+
+  UEXPECT_THROW(send_task.Get(), std::runtime_error);
+  // The server socket is closed by the finished task
+  const auto reply = ReceiveAll(client, test_deadline);
+  EXPECT_NE(reply.find("item"), std::string::npos);
+  EXPECT_EQ(reply.find("\r\n0\r\n\r\n"), std::string::npos);
+}
+
+USERVER_NAMESPACE_END
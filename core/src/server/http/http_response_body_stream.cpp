@@ -13,7 +13,8 @@ ResponseBodyStream::ResponseBodyStream(
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
-  queue_producer_.Push(std::move(chunk));
+  if (is_closed_) return;
+  is_closed_ = !queue_producer_.Push(std::move(chunk));
 }
 
 void ResponseBodyStream::SetHeader(const std::string& name,
@@ -22,7 +23,12 @@ void ResponseBodyStream::SetHeader(const std::string& name,
   http_response_.SetHeader(name, value);
 }
 
-void ResponseBodyStream::SetEndOfHeaders() { headers_ended_ = true; }
+void ResponseBodyStream::SetEndOfHeaders() {
+  if (headers_ended_) return;
+  headers_ended_ = true;
+  // The connection starts sending the response and popping the chunks
+  http_response_.SetHeadersEnd();
+}
 
 void ResponseBodyStream::SetStatusCode(int status_code) {
   UINVARIANT(
@@ -38,6 +44,14 @@ void ResponseBodyStream::SetStatusCode(HttpStatus status) {
   http_response_.SetStatus(status);
 }
 
+namespace impl {
+
+ResponseBodyStream MakeResponseBodyStream(HttpResponse& http_response) {
+  return ResponseBodyStream{http_response.GetBodyProducer(), http_response};
+}
+
+}  // namespace impl
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
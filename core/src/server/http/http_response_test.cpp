@@ -1,3 +1,4 @@
+#include <stdexcept>
 #include <string_view>
 #include <vector>
 
@@ -5,6 +6,10 @@
 
 #include <server/http/http_request_impl.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
@@ -45,6 +50,76 @@ UTEST(HttpResponse, Smoke) {
             fmt::format("\r\n\r\n{}", kBody));
 }
 
+UTEST(HttpResponse, BodyParts) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  const auto temp_file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(temp_file.GetPath(), "..file data..");
+  const auto file = std::make_shared<fs::blocking::FileDescriptor>(
+      fs::blocking::FileDescriptor::Open(temp_file.GetPath(),
+                                         fs::blocking::OpenFlag::kRead));
+  const auto chunk = std::make_shared<const std::string>(" chunk ");
+
+  response.AppendBodyChunk(chunk, *chunk);
+  response.AppendBodyFile(engine::current_task::GetTaskProcessor(), file, 2,
+                          9);
+  response.AppendBodyChunk(chunk, std::string_view{*chunk}.substr(0, 6));
+  response.SetData("data");
+  constexpr std::string_view kBody = "data chunk file data chunk";
+  EXPECT_EQ(response.GetBodySize(), kBody.size());
+  EXPECT_EQ(accounter.GetCurrentLevel(), kBody.size());
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  std::string_view reply{buffer.data(), reply_size};
+  const auto expected_content_length = fmt::format(
+      "\r\n{}: {}\r\n", http::headers::kContentLength, kBody.size());
+  EXPECT_TRUE(reply.find(expected_content_length) != std::string_view::npos);
+  EXPECT_EQ(reply.substr(reply.size() - 4 - kBody.size()),
+            fmt::format("\r\n\r\n{}", kBody));
+  EXPECT_EQ(response.BytesSent(), reply.size());
+
+  response.FlattenBody();
+  EXPECT_EQ(response.GetData(), kBody);
+  EXPECT_EQ(response.GetBodySize(), kBody.size());
+}
+
+UTEST(HttpResponse, BodyFileTruncated) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  const auto temp_file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(temp_file.GetPath(), "short");
+  const auto file = std::make_shared<fs::blocking::FileDescriptor>(
+      fs::blocking::FileDescriptor::Open(temp_file.GetPath(),
+                                         fs::blocking::OpenFlag::kRead));
+  // The file is shorter than the announced Content-Length
+  response.AppendBodyFile(engine::current_task::GetTaskProcessor(), file, 0,
+                          100);
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  EXPECT_THROW(response.SendResponse(server), engine::io::IoException);
+  EXPECT_THROW(response.FlattenBody(), std::runtime_error);
+}
+
 class HttpResponseBody : public testing::TestWithParam<int> {};
 
 UTEST_P(HttpResponseBody, ForbiddenBody) {
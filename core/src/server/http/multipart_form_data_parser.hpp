@@ -6,14 +6,18 @@
 #include <vector>
 
 #include <userver/server/http/form_data_arg.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 #include <userver/utils/str_icase.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
-using FormDataArgs = std::unordered_map<std::string, std::vector<FormDataArg>,
-                                        utils::StrCaseHash>;
+using FormDataArgs = std::unordered_map<
+    std::string, std::vector<FormDataArg>, utils::StrCaseHash,
+    std::equal_to<std::string>,
+    utils::ArenaAllocator<
+        std::pair<const std::string, std::vector<FormDataArg>>>>;
 
 bool IsMultipartFormDataContentType(std::string_view content_type);
 bool ParseMultipartFormData(const std::string& content_type,
@@ -4,8 +4,10 @@
 #include <array>
 #include <stdexcept>
 #include <system_error>
+#include <optional>
 #include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 
@@ -22,6 +24,22 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
+namespace {
+
+// Limits the amount of memory pinned by responses waiting for a batched send
+constexpr std::size_t kMaxBatchedResponses = 16;
+
+void LogSendError(const engine::io::IoSystemError& ex) {
+  // working with raw values because std::errc compares error_category
+  // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
+  auto log_level =
+      ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
+          ? logging::Level::kWarning
+          : logging::Level::kError;
+  LOG(log_level) << "I/O error while sending data: " << ex;
+}
+
+}  // namespace
 
 std::shared_ptr<Connection> Connection::Create(
     engine::TaskProcessor& task_processor, const ConnectionConfig& config,
@@ -58,6 +76,8 @@ Connection::Connection(
   ++stats_->connections_created;
 }
 
+Connection::~Connection() = default;
+
 void Connection::SetCloseCb(CloseCb close_cb) {
   close_cb_ = std::move(close_cb);
 }
@@ -110,6 +130,10 @@ void Connection::Shutdown() noexcept {
                  "requests) for fd "
               << Fd();
 
+  // The listener is stopped, the responses waiting for the flow control
+  // window are not written out anymore
+  if (http2_session_) http2_session_->FailPendingResponses();
+
   peer_socket_.Close();  // should not throw
 
   --stats_->active_connections;
@@ -142,14 +166,30 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   try {
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
 
-    http::HttpRequestParser request_parser(
-        request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
-        [this, &producer](RequestBasePtr&& request_ptr) {
-          if (!NewRequest(std::move(request_ptr), producer)) {
-            is_accepting_requests_ = false;
-          }
-        },
-        stats_->parser_stats, data_accounter_);
+    auto on_new_request = [this, &producer](RequestBasePtr&& request_ptr) {
+      if (!NewRequest(std::move(request_ptr), producer)) {
+        is_accepting_requests_ = false;
+      }
+    };
+
+    std::optional<http::HttpRequestParser> http1_parser;
+    request::RequestParser* request_parser = nullptr;
+    if (config_.http_version == HttpVersion::k2) {
+      http2_session_ = std::make_unique<http::Http2Session>(
+          request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+          config_.http2_session_config, std::move(on_new_request),
+          [this](request::RequestBase& request, std::size_t bytes,
+                 bool is_sent) {
+            FinishHttp2Response(request, bytes, is_sent);
+          },
+          stats_->parser_stats, data_accounter_, peer_socket_,
+          config_.keepalive_timeout);
+      request_parser = http2_session_.get();
+    } else {
+      request_parser = &http1_parser.emplace(
+          request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+          std::move(on_new_request), stats_->parser_stats, data_accounter_);
+    }
 
     std::vector<char> buf(config_.in_buffer_size);
     std::size_t last_bytes_read = 0;
@@ -190,7 +230,7 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
                   << peer_socket_.Getpeername() << " on fd " << Fd();
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
+      if (!request_parser->Parse(buf.data(), last_bytes_read)) {
         LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
                     << " on fd " << Fd();
 
@@ -237,39 +277,135 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
     is_accepting_requests_ = false;
   }
 
+  if (!WaitForPipelineSlot()) return false;
+  const bool is_pipelined = requests_in_flight_++ != 0;
+  if (is_pipelined) ++stats_->pipelined_request_count;
+
   ++stats_->active_request_count;
-  return producer.Push(
-      {request_ptr, request_handler_.StartRequestTask(request_ptr)});
+  auto request_task = request_handler_.StartRequestTask(request_ptr);
+  if (http2_session_) {
+    // Streams are multiplexed, the response is submitted to the session as
+    // soon as it is ready, regardless of the previous streams. The stream
+    // task releases the pipeline slot itself.
+    request_task = engine::CriticalAsyncNoSpan(
+        task_processor_,
+        [](Connection* self, QueueItem item) {
+          self->ProcessHttp2Stream(item);
+        },
+        this, QueueItem{request_ptr, std::move(request_task), is_pipelined});
+    // The stream task is cancelled if not pushed, and finishes the request
+    return producer.Push({std::move(request_ptr), std::move(request_task)});
+  }
+
+  if (producer.Push(
+          {std::move(request_ptr), std::move(request_task), is_pipelined})) {
+    return true;
+  }
+
+  if (is_pipelined) --stats_->pipelined_request_count;
+  --requests_in_flight_;
+  return false;
+}
+
+bool Connection::WaitForPipelineSlot() {
+  if (config_.max_pipelined_requests == 0) return true;
+
+  // Only the requests listener increments the counter, so the slot can not be
+  // taken by someone else after the check
+  while (requests_in_flight_.load() >= config_.max_pipelined_requests) {
+    if (!request_finished_event_.WaitForEvent()) return false;
+  }
+  return true;
 }
 
 void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
+  if (http2_session_) {
+    WaitForHttp2Streams(consumer);
+    return;
+  }
+
   try {
+    std::vector<QueueItem> items;
+    items.reserve(kMaxBatchedResponses);
+
     QueueItem item;
-    while (consumer.Pop(item)) {
+    bool has_item = consumer.Pop(item);
+    while (has_item) {
       HandleQueueItem(item);
+      const bool is_batchable = IsReadyForBatch(item);
+      items.push_back(std::move(item));
+
+      // Responses to the pipelined requests that are already done are sent
+      // together with the current one
+      has_item = false;
+      while (is_batchable && items.size() < kMaxBatchedResponses &&
+             consumer.PopNoblock(item)) {
+        if (!IsReadyForBatch(item)) {
+          has_item = true;
+          break;
+        }
+        HandleQueueItem(item);
+        items.push_back(std::move(item));
+      }
 
-      // now we must complete processing
-      engine::TaskCancellationBlocker block_cancel;
+      {
+        // now we must complete processing
+        engine::TaskCancellationBlocker block_cancel;
 
-      /* In stream case we don't want a user task to exit
-       * until SendResponse() as the task produces body chunks.
-       */
-      SendResponse(*item.first);
-      item.first.reset();
-      item.second = {};
+        /* In stream case we don't want a user task to exit
+         * until SendResponse() as the task produces body chunks.
+         */
+        SendResponses(items);
+        for (auto& sent_item : items) ReleasePipelineSlot(sent_item);
+        items.clear();
+      }
+
+      if (!has_item) has_item = consumer.Pop(item);
     }
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
 }
 
+void Connection::WaitForHttp2Streams(Queue::Consumer& consumer) noexcept {
+  try {
+    // The stream tasks send the responses themselves, they are only kept
+    // alive until finished
+    std::vector<engine::TaskWithResult<void>> stream_tasks;
+    QueueItem item;
+    while (consumer.Pop(item)) {
+      stream_tasks.erase(
+          std::remove_if(stream_tasks.begin(), stream_tasks.end(),
+                         [](const auto& task) { return task.IsFinished(); }),
+          stream_tasks.end());
+      stream_tasks.push_back(std::move(item.task));
+    }
+
+    for (auto& task : stream_tasks) {
+      if (!engine::current_task::IsCancelRequested()) task.Wait();
+      if (!task.IsFinished()) task.SyncCancel();
+    }
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
+  }
+}
+
+void Connection::ProcessHttp2Stream(QueueItem& item) {
+  HandleQueueItem(item);
+  {
+    engine::TaskCancellationBlocker block_cancel;
+    SendHttp2Response(item.request);
+  }
+  ReleasePipelineSlot(item);
+}
+
 void Connection::HandleQueueItem(QueueItem& item) {
-  auto& request = *item.first;
+  auto& request = *item.request;
 
   if (engine::current_task::IsCancelRequested()) {
     // We could've packed all remaining requests into a vector and cancel them
     // in parallel. But pipelining is almost never used so why bother.
-    auto request_task = std::move(item.second);
+    auto request_task = std::move(item.task);
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
     is_response_chain_valid_ = false;
@@ -281,7 +417,7 @@ void Connection::HandleQueueItem(QueueItem& item) {
     if (response.IsBodyStreamed()) {
       response.WaitForHeadersEnd();
     } else {
-      auto request_task = std::move(item.second);
+      auto request_task = std::move(item.task);
       request_task.Get();
     }
   } catch (const engine::TaskCancelledException&) {
@@ -300,6 +436,68 @@ void Connection::HandleQueueItem(QueueItem& item) {
   }
 }
 
+bool Connection::IsReadyForBatch(const QueueItem& item) const {
+  return !item.task.IsValid() ||
+         (item.task.IsFinished() &&
+          !item.request->GetResponse().IsBodyStreamed());
+}
+
+void Connection::SendResponses(std::vector<QueueItem>& items) {
+  UASSERT(!items.empty());
+  if (items.size() > 1 && is_response_chain_valid_ && peer_socket_ &&
+      SendResponsesBatch(items)) {
+    return;
+  }
+
+  for (auto& item : items) SendResponse(*item.request);
+}
+
+bool Connection::SendResponsesBatch(std::vector<QueueItem>& items) {
+  std::vector<engine::io::IoData> buffers;
+  buffers.reserve(items.size() * 2);
+  std::vector<std::size_t> sizes;
+  sizes.reserve(items.size());
+
+  for (auto& item : items) {
+    auto& request = *item.request;
+    UASSERT(!request.GetResponse().IsSent());
+    request.SetStartSendResponseTime();
+
+    const auto buffers_begin = buffers.size();
+    if (!request.GetResponse().SerializeForBatch(buffers)) return false;
+
+    std::size_t size = 0;
+    for (auto i = buffers_begin; i < buffers.size(); ++i) {
+      size += buffers[i].len;
+    }
+    sizes.push_back(size);
+  }
+
+  bool is_sent = false;
+  try {
+    [[maybe_unused]] const auto sent_bytes =
+        peer_socket_.SendAll(buffers.data(), buffers.size(), {});
+    is_sent = true;
+  } catch (const engine::io::IoSystemError& ex) {
+    LogSendError(ex);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Error while sending data: " << ex;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    auto& request = *items[i].request;
+    if (is_sent) {
+      request.GetResponse().SetSentInBatch(sizes[i], now);
+    } else {
+      request.GetResponse().SetSendFailed(now);
+    }
+    FinishResponse(request);
+  }
+  stats_->responses_batched_count += items.size() - 1;
+  return true;
+}
+
 void Connection::SendResponse(request::RequestBase& request) {
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
@@ -309,20 +507,56 @@ void Connection::SendResponse(request::RequestBase& request) {
       // Might be a stream reading or a fully constructed response
       response.SendResponse(peer_socket_);
     } catch (const engine::io::IoSystemError& ex) {
-      // working with raw values because std::errc compares error_category
-      // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
-      auto log_level =
-          ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
-              ? logging::Level::kWarning
-              : logging::Level::kError;
-      LOG(log_level) << "I/O error while sending data: " << ex;
+      LogSendError(ex);
     } catch (const std::exception& ex) {
       LOG_ERROR() << "Error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
+      // The response might be cut in the middle, the next ones would be
+      // read as its body. The connection is closed for the client to see the
+      // body as truncated, e.g. for an aborted streamed body.
+      is_response_chain_valid_ = false;
+      Stop();
     }
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishResponse(request);
+}
+
+void Connection::SendHttp2Response(
+    std::shared_ptr<request::RequestBase> request) {
+  auto& response = request->GetResponse();
+  UASSERT(!response.IsSent());
+  request->SetStartSendResponseTime();
+
+  if (is_response_chain_valid_ && peer_socket_) {
+    try {
+      // The session calls FinishHttp2Response() once the last frame of the
+      // response is written out
+      http2_session_->WriteResponse(request);
+      return;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+    }
+  }
+
+  response.SetSendFailed(std::chrono::steady_clock::now());
+  FinishResponse(*request);
+}
+
+void Connection::FinishHttp2Response(request::RequestBase& request,
+                                     std::size_t bytes, bool is_sent) {
+  auto& response = request.GetResponse();
+  const auto now = std::chrono::steady_clock::now();
+  if (is_sent) {
+    response.SetSentInBatch(bytes, now);
+  } else {
+    response.SetSendFailed(now);
+  }
+  FinishResponse(request);
+}
+
+void Connection::FinishResponse(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   --stats_->active_request_count;
   ++stats_->requests_processed_count;
@@ -331,6 +565,12 @@ void Connection::SendResponse(request::RequestBase& request) {
                           request_handler_.LoggerAccessTskv(), remote_address_);
 }
 
+void Connection::ReleasePipelineSlot(QueueItem& item) noexcept {
+  if (item.is_pipelined) --stats_->pipelined_request_count;
+  --requests_in_flight_;
+  request_finished_event_.Send();
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
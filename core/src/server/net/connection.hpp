@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
@@ -20,6 +22,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace server::http {
+class Http2Session;
+}  // namespace server::http
+
 namespace server::net {
 
 class Connection final : public std::enable_shared_from_this<Connection> {
@@ -46,6 +52,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
              const http::RequestHandlerBase& request_handler,
              std::shared_ptr<Stats> stats,
              request::ResponseDataAccounter& data_accounter, EmplaceEnabler);
+  ~Connection();
 
   void SetCloseCb(CloseCb close_cb);
 
@@ -56,8 +63,12 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   int Fd() const;
 
  private:
-  using QueueItem = std::pair<std::shared_ptr<request::RequestBase>,
-                              engine::TaskWithResult<void>>;
+  struct QueueItem {
+    std::shared_ptr<request::RequestBase> request;
+    engine::TaskWithResult<void> task;
+    // Whether the request waits for a previous one of this connection
+    bool is_pipelined{false};
+  };
   using Queue = concurrent::SpscQueue<QueueItem>;
 
   void Shutdown() noexcept;
@@ -67,10 +78,21 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   void ListenForRequests(Queue::Producer) noexcept;
   bool NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                   Queue::Producer&);
+  bool WaitForPipelineSlot();
 
   void ProcessResponses(Queue::Consumer&) noexcept;
+  void WaitForHttp2Streams(Queue::Consumer&) noexcept;
+  void ProcessHttp2Stream(QueueItem& item);
   void HandleQueueItem(QueueItem& item);
+  bool IsReadyForBatch(const QueueItem& item) const;
+  void SendResponses(std::vector<QueueItem>& items);
+  bool SendResponsesBatch(std::vector<QueueItem>& items);
   void SendResponse(request::RequestBase& request);
+  void SendHttp2Response(std::shared_ptr<request::RequestBase> request);
+  void FinishHttp2Response(request::RequestBase& request, std::size_t bytes,
+                           bool is_sent);
+  void FinishResponse(request::RequestBase& request);
+  void ReleasePipelineSlot(QueueItem& item) noexcept;
 
   engine::TaskProcessor& task_processor_;
   const ConnectionConfig& config_;
@@ -82,12 +104,18 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   const std::string remote_address_;
 
   std::shared_ptr<Queue> request_tasks_;
+  // Set by the requests listener before the first request is queued
+  std::unique_ptr<http::Http2Session> http2_session_;
+  // Requests that are started but whose responses are not sent yet
+  std::atomic<std::size_t> requests_in_flight_{0};
+  engine::SingleConsumerEvent request_finished_event_;
   engine::SingleConsumerEvent response_sender_launched_event_;
   engine::SingleConsumerEvent response_sender_assigned_event_;
   engine::Task response_sender_task_;
 
   bool is_accepting_requests_{true};
-  bool is_response_chain_valid_{true};
+  // Written by the HTTP/2 stream tasks concurrently
+  std::atomic<bool> is_response_chain_valid_{true};
   CloseCb close_cb_;
 };
 
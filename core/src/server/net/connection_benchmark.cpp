@@ -0,0 +1,191 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <server/handlers/http_handler_base_statistics.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <server/http/request_handler_base.hpp>
+#include <server/net/connection.hpp>
+#include <server/net/create_socket.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kTimeout = std::chrono::seconds{10};
+
+class NoopRequestHandler final : public server::http::RequestHandlerBase {
+ public:
+  engine::TaskWithResult<void> StartRequestTask(
+      std::shared_ptr<server::request::RequestBase> request) const override {
+    auto& http_request = dynamic_cast<server::http::HttpRequestImpl&>(*request);
+    static server::handlers::HttpRequestStatistics statistics;
+    http_request.SetHttpHandlerStatistics(statistics);
+    return engine::AsyncNoSpan([] {});
+  }
+
+  const server::http::HandlerInfoIndex& GetHandlerInfoIndex() const override {
+    return handler_info_index_;
+  }
+
+  const logging::LoggerPtr& LoggerAccess() const noexcept override {
+    return no_logger_;
+  }
+  const logging::LoggerPtr& LoggerAccessTskv() const noexcept override {
+    return no_logger_;
+  }
+
+ private:
+  logging::LoggerPtr no_logger_;
+  server::http::HandlerInfoIndex handler_info_index_;
+};
+
+std::string MakeHttp1Requests(std::size_t count) {
+  std::string result;
+  for (std::size_t i = 0; i < count; ++i) {
+    result += "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  }
+  return result;
+}
+
+void AppendFrameHeader(std::string& out, std::size_t length, std::uint8_t type,
+                       std::uint8_t flags, std::uint32_t stream_id) {
+  out += static_cast<char>((length >> 16) & 0xff);
+  out += static_cast<char>((length >> 8) & 0xff);
+  out += static_cast<char>(length & 0xff);
+  out += static_cast<char>(type);
+  out += static_cast<char>(flags);
+  out += static_cast<char>((stream_id >> 24) & 0x7f);
+  out += static_cast<char>((stream_id >> 16) & 0xff);
+  out += static_cast<char>((stream_id >> 8) & 0xff);
+  out += static_cast<char>(stream_id & 0xff);
+}
+
+constexpr std::uint8_t kFrameData = 0x0;
+constexpr std::uint8_t kFrameHeaders = 0x1;
+constexpr std::uint8_t kFrameSettings = 0x4;
+constexpr std::uint8_t kFlagEndStream = 0x1;
+constexpr std::uint8_t kFlagEndHeaders = 0x4;
+
+std::string MakeHttp2Requests(std::size_t count) {
+  // GET http://localhost/ encoded with the HPACK static table
+  constexpr std::string_view kHeaderBlock =
+      "\x82\x86\x84\x01\x09localhost";
+
+  std::string result = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+  AppendFrameHeader(result, 0, kFrameSettings, 0, 0);
+  for (std::size_t i = 0; i < count; ++i) {
+    AppendFrameHeader(result, kHeaderBlock.size(), kFrameHeaders,
+                      kFlagEndStream | kFlagEndHeaders,
+                      static_cast<std::uint32_t>(i * 2 + 1));
+    result += kHeaderBlock;
+  }
+  return result;
+}
+
+std::size_t CountHttp1Responses(std::string_view data) {
+  constexpr std::string_view kStatusLine = "HTTP/1.1 ";
+  std::size_t count = 0;
+  for (auto pos = data.find(kStatusLine); pos != std::string_view::npos;
+       pos = data.find(kStatusLine, pos + kStatusLine.size())) {
+    ++count;
+  }
+  return count;
+}
+
+std::size_t CountHttp2Responses(std::string_view data) {
+  constexpr std::size_t kFrameHeaderSize = 9;
+  std::size_t count = 0;
+  while (data.size() >= kFrameHeaderSize) {
+    const auto byte = [&data](std::size_t i) {
+      return static_cast<std::size_t>(static_cast<unsigned char>(data[i]));
+    };
+    const auto length = (byte(0) << 16) | (byte(1) << 8) | byte(2);
+    if (data.size() < kFrameHeaderSize + length) break;
+
+    const auto type = byte(3);
+    const auto flags = byte(4);
+    if ((type == kFrameHeaders || type == kFrameData) &&
+        (flags & kFlagEndStream)) {
+      ++count;
+    }
+    data.remove_prefix(kFrameHeaderSize + length);
+  }
+  return count;
+}
+
+}  // namespace
+
+void connection_requests(benchmark::State& state,
+                         server::net::HttpVersion http_version) {
+  engine::RunStandalone([&] {
+    const auto requests_count = static_cast<std::size_t>(state.range(0));
+    const bool is_http2 = http_version == server::net::HttpVersion::k2;
+    const auto requests = is_http2 ? MakeHttp2Requests(requests_count)
+                                   : MakeHttp1Requests(requests_count);
+
+    server::net::ListenerConfig config;
+    config.handler_defaults = server::request::HttpRequestConfig{};
+    config.connection_config.http_version = http_version;
+    auto listen_socket = server::net::CreateSocket(config);
+    const auto addr = listen_socket.Getsockname();
+
+    NoopRequestHandler handler;
+    server::request::ResponseDataAccounter data_accounter;
+    std::array<char, 16 * 1024> buf{};
+    std::size_t connections = 0;
+
+    for (auto _ : state) {
+      const auto deadline = engine::Deadline::FromDuration(kTimeout);
+      engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+      client.Connect(addr, deadline);
+
+      auto connection = server::net::Connection::Create(
+          engine::current_task::GetTaskProcessor(), config.connection_config,
+          config.handler_defaults, listen_socket.Accept(deadline), handler,
+          std::make_shared<server::net::Stats>(), data_accounter);
+      connection->Start();
+      ++connections;
+
+      client.SendAll(requests.data(), requests.size(), deadline);
+
+      std::string responses;
+      std::size_t responses_count = 0;
+      while (responses_count < requests_count) {
+        const auto received = client.RecvSome(buf.data(), buf.size(), deadline);
+        UINVARIANT(received, "Connection closed before all the responses");
+        responses.append(buf.data(), received);
+        responses_count = is_http2 ? CountHttp2Responses(responses)
+                                   : CountHttp1Responses(responses);
+      }
+
+      client.Close();
+      std::weak_ptr<server::net::Connection> weak = connection;
+      connection.reset();
+      while (weak.lock()) engine::Yield();
+    }
+
+    state.SetItemsProcessed(state.iterations() * requests_count);
+    state.counters["connections"] = benchmark::Counter(
+        static_cast<double>(connections), benchmark::Counter::kIsRate);
+  });
+}
+// Requests per second over a single connection with up to 64 requests in
+// flight, the default limits of the pipelined requests and of the concurrent
+// streams. The memory per stream is not measured here: the allocations are
+// not accounted in this binary, compare the RSS of a service under load.
+BENCHMARK_CAPTURE(connection_requests, http1, server::net::HttpVersion::k11)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_CAPTURE(connection_requests, http2, server::net::HttpVersion::k2)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,42 @@
 #include <server/net/connection_config.hpp>
 
+#include <stdexcept>
+#include <string>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>) {
+  const auto str = value.As<std::string>();
+  if (str == "1.1") {
+    return HttpVersion::k11;
+  } else if (str == "2") {
+    return HttpVersion::k2;
+  }
+
+  throw std::runtime_error("Invalid http_version value '" + str + "' in " +
+                           value.GetPath());
+}
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>) {
+  Http2SessionConfig config;
+
+  config.max_concurrent_streams =
+      value["max_concurrent_streams"].As<std::uint32_t>(
+          config.max_concurrent_streams);
+  config.initial_window_size = value["initial_window_size"].As<std::uint32_t>(
+      config.initial_window_size);
+  config.max_frame_size =
+      value["max_frame_size"].As<std::uint32_t>(config.max_frame_size);
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -15,9 +46,16 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.requests_queue_size_threshold =
       value["requests_queue_size_threshold"].As<size_t>(
           config.requests_queue_size_threshold);
+  config.max_pipelined_requests = value["max_pipelined_requests"].As<size_t>(
+      config.max_pipelined_requests);
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.http_version =
+      value["http_version"].As<HttpVersion>(config.http_version);
+  config.http2_session_config =
+      value["http2_session"].As<Http2SessionConfig>(
+          config.http2_session_config);
 
   return config;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,12 +10,33 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+enum class HttpVersion {
+  k11,  ///< HTTP/1.1 with pipelining
+  k2,   ///< HTTP/2 over cleartext TCP (h2c) with prior knowledge
+};
+
+struct Http2SessionConfig {
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t initial_window_size = 65535;
+  std::uint32_t max_frame_size = 16384;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
+  // 0 means unlimited
+  size_t max_pipelined_requests = 0;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  HttpVersion http_version = HttpVersion::k11;
+  Http2SessionConfig http2_session_config;
 };
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>);
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>);
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>);
 
@@ -1,5 +1,9 @@
 #include <server/net/connection.hpp>
 
+#include <array>
+#include <string>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -23,7 +27,7 @@ constexpr auto kAcceptTimeout = utest::kMaxTestWaitTime;
 
 class TestHttprequestHandler : public server::http::RequestHandlerBase {
  public:
-  enum class Behaviors { kNoop, kHang };
+  enum class Behaviors { kNoop, kHang, kSleep, kFirstHangs };
 
   explicit TestHttprequestHandler(Behaviors behavior = Behaviors::kNoop)
       : behavior_(behavior) {}
@@ -45,6 +49,21 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
           ASSERT_TRUE(engine::current_task::IsCancelRequested());
           ++asyncs_finished;
         });
+      case Behaviors::kSleep:
+        return engine::AsyncNoSpan([this]() {
+          const auto running = ++asyncs_running;
+          if (running > max_asyncs_running) max_asyncs_running = running;
+          engine::SleepFor(std::chrono::milliseconds{1});
+          --asyncs_running;
+          ++asyncs_finished;
+        });
+      case Behaviors::kFirstHangs:
+        if (asyncs_started++ == 0) {
+          return engine::AsyncNoSpan([] {
+            engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+          });
+        }
+        return engine::AsyncNoSpan([this]() { ++asyncs_finished; });
     }
 
     UINVARIANT(false, "Unexpected behavior");
@@ -61,8 +80,14 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
     return no_logger_;
   };
 
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable std::atomic<std::size_t> asyncs_started{0};
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   mutable std::atomic<std::size_t> asyncs_finished{0};
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable std::atomic<std::size_t> asyncs_running{0};
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable std::atomic<std::size_t> max_asyncs_running{0};
 
  private:
   const Behaviors behavior_;
@@ -98,6 +123,64 @@ net::ListenerConfig CreateConfig() {
   return config;
 }
 
+std::size_t SendPipelinedRequests(net::ListenerConfig& config,
+                                  TestHttprequestHandler& handler,
+                                  std::size_t requests_count) {
+  auto request_socket = net::CreateSocket(config);
+  const auto addr = request_socket.Getsockname();
+
+  engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+  client.Connect(addr, Deadline::FromDuration(kAcceptTimeout));
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  EXPECT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+  connection_ptr->Start();
+
+  std::string requests;
+  for (std::size_t i = 0; i < requests_count; ++i) {
+    requests += "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  }
+  const auto sent = client.SendAll(requests.data(), requests.size(),
+                                   Deadline::FromDuration(kAcceptTimeout));
+  EXPECT_EQ(sent, requests.size());
+
+  constexpr std::string_view kStatusLine = "HTTP/1.1 404";
+  std::string responses;
+  std::array<char, 4096> buf{};
+  std::size_t responses_count = 0;
+  while (responses_count < requests_count) {
+    const auto received = client.RecvSome(
+        buf.data(), buf.size(), Deadline::FromDuration(kAcceptTimeout));
+    if (!received) break;
+    responses.append(buf.data(), received);
+
+    responses_count = 0;
+    for (auto pos = responses.find(kStatusLine); pos != std::string::npos;
+         pos = responses.find(kStatusLine, pos + kStatusLine.size())) {
+      ++responses_count;
+    }
+  }
+
+  client.Close();
+  std::weak_ptr<net::Connection> weak = connection_ptr;
+  connection_ptr.reset();
+  auto task = engine::AsyncNoSpan([weak]() {
+    while (weak.lock()) engine::Yield();
+  });
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+  EXPECT_EQ(stats->pipelined_request_count, 0);
+  EXPECT_EQ(stats->requests_processed_count, requests_count);
+
+  return responses_count;
+}
+
 }  // namespace
 
 UTEST(ServerNetConnection, EarlyCancel) {
@@ -257,6 +340,7 @@ UTEST(ServerNetConnection, KeepAlive) {
   auto request_socket = net::CreateSocket(config);
 
   auto http_client_ptr = utest::CreateHttpClient();
+  // A single connection, the test client has one IO thread
   http_client_ptr->SetMaxHostConnections(1);
 
   auto request = CreateRequest(*http_client_ptr, request_socket,
@@ -289,6 +373,7 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   auto request_socket = net::CreateSocket(config);
 
   auto http_client_ptr = utest::CreateHttpClient();
+  // A single connection, the test client has one IO thread
   http_client_ptr->SetMaxHostConnections(1);
 
   for (unsigned ii = 0; ii < kMaxAttempts; ++ii) {
@@ -339,4 +424,107 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, Pipelining) {
+  constexpr std::size_t kRequests = 8;
+  net::ListenerConfig config = CreateConfig();
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kSleep};
+
+  EXPECT_EQ(SendPipelinedRequests(config, handler, kRequests), kRequests);
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+  EXPECT_GT(handler.max_asyncs_running, 1);
+}
+
+UTEST(ServerNetConnection, PipeliningLimit) {
+  constexpr std::size_t kRequests = 8;
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.max_pipelined_requests = 1;
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kSleep};
+
+  EXPECT_EQ(SendPipelinedRequests(config, handler, kRequests), kRequests);
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+  EXPECT_EQ(handler.max_asyncs_running, 1);
+}
+
+UTEST(ServerNetConnection, Http2Multiplexing) {
+  constexpr std::size_t kRequests = 8;
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http_version = net::HttpVersion::k2;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  // A single connection, the test client has one IO thread
+  http_client_ptr->SetMaxHostConnections(1);
+
+  std::vector<clients::http::ResponseFuture> requests;
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    requests.push_back(
+        http_client_ptr->CreateRequest()
+            ->get(HttpConnectionUriFromSocket(request_socket))
+            ->http_version(clients::http::HttpVersion::k2PriorKnowledge)
+            ->timeout(utest::kMaxTestWaitTime)
+            ->async_perform());
+  }
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kSleep};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+  connection_ptr->Start();
+
+  for (auto& request : requests) {
+    EXPECT_EQ(request.Get()->status_code(), 404);
+  }
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+  EXPECT_EQ(stats->connections_created, 1);
+  EXPECT_EQ(stats->requests_processed_count, kRequests);
+}
+
+UTEST(ServerNetConnection, Http2NoHeadOfLineBlocking) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http_version = net::HttpVersion::k2;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  // A single connection, the test client has one IO thread
+  http_client_ptr->SetMaxHostConnections(1);
+  const auto create_request = [&] {
+    return http_client_ptr->CreateRequest()
+        ->get(HttpConnectionUriFromSocket(request_socket))
+        ->http_version(clients::http::HttpVersion::k2PriorKnowledge)
+        ->timeout(utest::kMaxTestWaitTime)
+        ->async_perform();
+  };
+
+  auto slow_request = create_request();
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{
+      TestHttprequestHandler::Behaviors::kFirstHangs};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+  connection_ptr->Start();
+  while (handler.asyncs_started == 0) engine::Yield();
+
+  // The response to the later stream is not held back by the first one
+  auto fast_request = create_request();
+  EXPECT_EQ(fast_request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_started, 2);
+  EXPECT_EQ(handler.asyncs_finished, 1);
+
+  slow_request.Cancel();
+  connection_ptr->Stop();
+  std::weak_ptr<net::Connection> weak = connection_ptr;
+  connection_ptr.reset();
+  while (weak.lock()) engine::Yield();
+}
+
 USERVER_NAMESPACE_END
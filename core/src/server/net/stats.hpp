@@ -29,7 +29,9 @@ struct Stats {
         connections_closed(other.connections_closed.load()),
         parser_stats(other.parser_stats),
         active_request_count(other.active_request_count.load()),
-        requests_processed_count(other.requests_processed_count.load()) {}
+        requests_processed_count(other.requests_processed_count.load()),
+        pipelined_request_count(other.pipelined_request_count.load()),
+        responses_batched_count(other.responses_batched_count.load()) {}
 
   Stats() = default;
 
@@ -42,6 +44,10 @@ struct Stats {
   ParserStats parser_stats;
   std::atomic<size_t> active_request_count{0};
   std::atomic<size_t> requests_processed_count{0};
+  // requests that wait for a previous request of the same connection
+  std::atomic<size_t> pipelined_request_count{0};
+  // responses sent in the same syscall with a previous response
+  std::atomic<size_t> responses_batched_count{0};
 };
 
 inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
@@ -52,6 +58,8 @@ inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
   lhs.parser_stats += rhs.parser_stats;
   lhs.active_request_count += rhs.active_request_count;
   lhs.requests_processed_count += rhs.requests_processed_count;
+  lhs.pipelined_request_count += rhs.pipelined_request_count;
+  lhs.responses_batched_count += rhs.responses_batched_count;
   return lhs;
 }
 
@@ -4,7 +4,9 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::request {
 
-RequestBase::RequestBase() : start_time_(std::chrono::steady_clock::now()) {}
+RequestBase::RequestBase()
+    : start_time_(std::chrono::steady_clock::now()),
+      arena_(arena_buffer_.data(), arena_buffer_.size()) {}
 
 RequestBase::~RequestBase() = default;
 
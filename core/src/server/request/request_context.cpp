@@ -10,6 +10,10 @@ namespace server::request {
 
 class RequestContext::Impl final {
  public:
+  Impl() = default;
+  explicit Impl(utils::MonotonicArena& arena)
+      : named_datum_(NamedDatum::allocator_type{arena}) {}
+
   utils::AnyMovable& SetUserAnyData(utils::AnyMovable&& data);
   utils::AnyMovable& GetUserAnyData();
   utils::AnyMovable* GetUserAnyDataOptional();
@@ -21,8 +25,13 @@ class RequestContext::Impl final {
   void EraseAnyData(const std::string& name);
 
  private:
+  using NamedDatum = std::unordered_map<
+      std::string, utils::AnyMovable, std::hash<std::string>,
+      std::equal_to<std::string>,
+      utils::ArenaAllocator<std::pair<const std::string, utils::AnyMovable>>>;
+
   utils::AnyMovable user_data_;
-  std::unordered_map<std::string, utils::AnyMovable> named_datum_;
+  NamedDatum named_datum_;
 };
 
 utils::AnyMovable& RequestContext::Impl::SetUserAnyData(
@@ -80,6 +89,8 @@ void RequestContext::Impl::EraseAnyData(const std::string& name) {
 
 RequestContext::RequestContext() = default;
 
+RequestContext::RequestContext(utils::MonotonicArena& arena) : impl_(arena) {}
+
 RequestContext::~RequestContext() = default;
 
 utils::AnyMovable& RequestContext::SetUserAnyData(utils::AnyMovable&& data) {
@@ -53,7 +53,7 @@ ResponseBase::~ResponseBase() noexcept = default;
 void ResponseBase::SetData(std::string data) {
   create_time_ = std::chrono::steady_clock::now();
   data_ = std::move(data);
-  guard_.emplace(accounter_, create_time_, data_.size());
+  guard_.emplace(accounter_, create_time_, data_.size() + extra_data_size_);
 }
 
 void ResponseBase::SetReady() { SetReady(std::chrono::steady_clock::now()); }
@@ -73,11 +73,26 @@ void ResponseBase::SetSendFailed(
   SetSent(0);
 }
 
+bool ResponseBase::SerializeForBatch(std::vector<engine::io::IoData>&) {
+  return false;
+}
+
+void ResponseBase::SetSentInBatch(
+    size_t bytes_sent, std::chrono::steady_clock::time_point sent_time) {
+  SetSentTime(sent_time);
+  SetSent(bytes_sent);
+}
+
 void ResponseBase::SetSent(size_t bytes_sent) {
   bytes_sent_ = bytes_sent;
   is_sent_ = true;
 }
 
+void ResponseBase::AccountExtraData(size_t size) {
+  extra_data_size_ += size;
+  guard_.emplace(accounter_, create_time_, data_.size() + extra_data_size_);
+}
+
 void ResponseBase::SetSentTime(
     std::chrono::steady_clock::time_point sent_time) {
   sent_time_ = sent_time;
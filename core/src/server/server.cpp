@@ -212,6 +212,10 @@ formats::json::Value Server::GetMonitorData(
         server_stats.requests_processed_count.load();
     json_request_stats["parsing"] =
         server_stats.parser_stats.parsing_request_count.load();
+    json_request_stats["pipelined"] =
+        server_stats.pipelined_request_count.load();
+    json_request_stats["sent-batched"] =
+        server_stats.responses_batched_count.load();
 
     json_data["requests"] = std::move(json_request_stats);
   }
@@ -1,14 +1,23 @@
 #include <tracing/span_impl.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
 #include <random>
+#include <string_view>
 #include <type_traits>
+#include <variant>
+#include <vector>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <tracing/tail_sampling_buffer.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/rand.hpp>
@@ -77,6 +86,44 @@ logging::LogHelper& operator<<(logging::LogHelper& lh,
   return lh;
 }
 
+bool IsErrorValue(const logging::LogExtra::Value& value) {
+  return std::visit(
+      [](const auto& v) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) {
+          return !v.empty();
+        } else {
+          return v != 0;
+        }
+      },
+      value);
+}
+
+// The services of a trace must get the same hash of the trace id, so it is
+// FNV-1a with the murmur3 finalizer to spread the similar ids over the range
+std::uint64_t HashTraceId(std::string_view trace_id) noexcept {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const char c : trace_id) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+bool ShouldSampleTrace(std::string_view trace_id) {
+  const auto rate = tracing::Tracer::GetSpanSamplingRate();
+  if (rate >= 1.0) return true;
+  if (rate <= 0.0) return false;
+  // Every hop of the trace makes the same decision
+  constexpr auto kMaxHash =
+      static_cast<double>(std::numeric_limits<std::uint64_t>::max());
+  return static_cast<double>(HashTraceId(trace_id)) < rate * kMaxHash;
+}
+
 const Span::Impl* GetParentSpanImpl() {
   if (!engine::current_task::GetCurrentTaskContextUnchecked()) return nullptr;
 
@@ -94,23 +141,37 @@ Span::Impl::Impl(std::string name, ReferenceType reference_type,
 Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
                  ReferenceType reference_type, logging::Level log_level)
     : name_(std::move(name)),
-      is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
+      trace_id_(parent ? parent->GetTraceId()
+                       : utils::generators::GenerateUuid()),
+      is_root_(!parent),
+      is_sampled_(parent ? parent->is_sampled_ : ShouldSampleTrace(trace_id_)),
+      is_no_log_span_(!is_sampled_ || tracing::Tracer::IsNoLogSpan(name_)),
+      initial_log_level_(log_level),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
       tracer_(std::move(tracer)),
-      start_system_time_(std::chrono::system_clock::now()),
+      start_system_time_(is_sampled_ ? std::chrono::system_clock::now()
+                                     : std::chrono::system_clock::time_point{}),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
-      span_id_(GenerateSpanId()),
-      parent_id_(GetParentIdForLogging(parent)),
+      // Records of a non-sampled child are attributed to its parent, there
+      // is no span record to link them to
+      span_id_(is_sampled_ || !parent ? GenerateSpanId()
+                                      : parent->GetSpanId()),
+      parent_id_(is_sampled_ || !parent ? GetParentIdForLogging(parent)
+                                        : parent->GetParentId()),
       reference_type_(reference_type) {
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
+    tail_sampling_buffer_ = parent->tail_sampling_buffer_;
   }
 }
 
 Span::Impl::~Impl() {
+  if (is_tail_sampling_root_ && tail_sampling_buffer_) {
+    tail_sampling_buffer_->Finish(
+        HasErrorTag(), std::chrono::steady_clock::now() - start_steady_time_);
+  }
+
   if (!ShouldLog()) {
     return;
   }
@@ -142,6 +203,23 @@ Span::Impl::~Impl() {
       << std::move(result) << std::move(*this);
 }
 
+void Span::Impl::SetTraceId(std::string&& id) {
+  trace_id_ = std::move(id);
+  // The trace id came from another service or was restored, the span is
+  // logged only if the other services of the trace log it
+  if (is_root_) UpdateSampling();
+}
+
+void Span::Impl::UpdateSampling() {
+  const bool is_sampled = ShouldSampleTrace(trace_id_);
+  if (is_sampled == is_sampled_) return;
+
+  is_sampled_ = is_sampled;
+  is_no_log_span_ = !is_sampled_ || tracing::Tracer::IsNoLogSpan(name_);
+  log_level_ = is_no_log_span_ ? logging::Level::kNone : initial_log_level_;
+  if (is_sampled_) start_system_time_ = std::chrono::system_clock::now();
+}
+
 void Span::Impl::LogTo(logging::LogHelper& log_helper) const& {
   log_helper << log_extra_inheritable_;
   tracer_->LogSpanContextTo(*this, log_helper);
@@ -194,16 +272,82 @@ bool Span::Impl::ShouldLog() const {
          local_log_level_.value_or(logging::Level::kTrace) <= log_level_;
 }
 
+bool Span::Impl::HasErrorTag() const {
+  if (log_extra_local_ &&
+      IsErrorValue(log_extra_local_->GetValue(kErrorFlag))) {
+    return true;
+  }
+  return IsErrorValue(log_extra_inheritable_.GetValue(kErrorFlag));
+}
+
 namespace {
+
+// Spans are created for each request and for most of the calls within it, so
+// the memory of the Impls is reused instead of going to the allocator. The
+// memory may be returned to the pool of another thread.
+class ImplPool final {
+ public:
+  static constexpr std::size_t kMaxSize = 1000;
+
+  template <typename... Args>
+  static Span::Impl* Allocate(Args&&... args) {
+    auto& pool = GetPool();
+    RawPtr raw;
+    if (pool.empty()) {
+      raw.reset(::operator new(sizeof(Span::Impl)));
+    } else {
+      raw = std::move(pool.back());
+      pool.pop_back();
+    }
+
+    // if ctor throws, the memory is freed by raw
+    auto* impl = new (raw.get()) Span::Impl(std::forward<Args>(args)...);
+    // transfer ownership (noexcept)
+    raw.release();
+    return impl;
+  }
+
+  static void Deallocate(Span::Impl* impl) noexcept {
+    impl->~Impl();
+    RawPtr raw(impl);
+
+    auto& pool = GetPool();
+    if (pool.size() >= kMaxSize) return;
+    try {
+      pool.push_back(std::move(raw));
+    } catch (const std::bad_alloc&) {
+      // the memory is freed by raw
+    }
+  }
+
+ private:
+  static_assert(alignof(Span::Impl) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+  // The memory is always raw, it is allocated and freed without the Impl
+  // ctor and dtor
+  struct RawDeleter {
+    void operator()(void* ptr) const noexcept { ::operator delete(ptr); }
+  };
+  using RawPtr = std::unique_ptr<void, RawDeleter>;
+
+  using Pool = std::vector<RawPtr>;
+
+  static Pool& GetPool() {
+    thread_local Pool pool;
+    return pool;
+  }
+};
+
 template <typename... Args>
 Span::Impl* AllocateImpl(Args&&... args) {
-  return new Span::Impl(std::forward<Args>(args)...);
+  return ImplPool::Allocate(std::forward<Args>(args)...);
 }
+
 }  // namespace
 
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
   if (do_delete) {
-    std::default_delete<Impl>{}(impl);
+    ImplPool::Deallocate(impl);
   }
 }
 
@@ -309,6 +453,7 @@ tracing::ScopeTime Span::CreateScopeTime(std::string name) {
 
 void Span::AddNonInheritableTag(std::string key,
                                 logging::LogExtra::Value value) {
+  if (pimpl_->is_no_log_span_) return;
   if (!pimpl_->log_extra_local_) pimpl_->log_extra_local_.emplace();
   pimpl_->log_extra_local_->Extend(std::move(key), std::move(value));
 }
@@ -328,6 +473,15 @@ std::optional<logging::Level> Span::GetLocalLogLevel() const {
   return pimpl_->local_log_level_;
 }
 
+void Span::EnableTailSampling(const TailSamplingConfig& config) {
+  if (pimpl_->tail_sampling_buffer_) return;
+  if (impl::ShouldSampleSpan(config)) return;
+
+  pimpl_->tail_sampling_buffer_ =
+      std::make_shared<impl::TailSamplingBuffer>(config);
+  pimpl_->is_tail_sampling_root_ = true;
+}
+
 void Span::AddTag(std::string key, logging::LogExtra::Value value) {
   pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value));
 }
@@ -338,6 +492,11 @@ void Span::AddTags(const logging::LogExtra& log_extra, utils::InternalTag) {
 
 impl::TimeStorage& Span::GetTimeStorage() { return pimpl_->GetTimeStorage(); }
 
+impl::TailSamplingBuffer* Span::GetTailSamplingBuffer(
+    utils::InternalTag) const {
+  return pimpl_->GetTailSamplingBuffer();
+}
+
 std::string Span::GetTag(std::string_view tag) const {
   const auto& value = pimpl_->log_extra_inheritable_.GetValue(tag);
   const auto* s = std::get_if<std::string>(&value);
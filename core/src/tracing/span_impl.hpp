@@ -62,7 +62,8 @@ class Span::Impl
   std::string GetSpanId() && noexcept { return std::move(span_id_); }
   std::string GetParentId() && noexcept { return std::move(parent_id_); }
 
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
+  // Decides the sampling anew for a root span
+  void SetTraceId(std::string&& id);
   void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
@@ -70,6 +71,10 @@ class Span::Impl
   void DetachFromCoroStack();
   void AttachToCoroStack();
 
+  impl::TailSamplingBuffer* GetTailSamplingBuffer() const noexcept {
+    return tail_sampling_buffer_.get();
+  }
+
  private:
   void LogOpenTracing() const;
   static void AddOpentracingTags(formats::json::ValueBuilder& output,
@@ -77,9 +82,19 @@ class Span::Impl
 
   static std::string GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
+  bool HasErrorTag() const;
+
+  void UpdateSampling();
 
   const std::string name_;
-  const bool is_no_log_span_;
+  std::string trace_id_;
+  const bool is_root_;
+  // Decided for the root span by its trace id and inherited by the children
+  bool is_sampled_;
+  // The span record is never written, so the data that goes only to the span
+  // record is not collected
+  bool is_no_log_span_;
+  const logging::Level initial_log_level_;
   logging::Level log_level_;
   std::optional<logging::Level> local_log_level_;
 
@@ -91,14 +106,17 @@ class Span::Impl
   std::optional<logging::LogExtra> log_extra_local_;
   impl::TimeStorage time_storage_;
 
-  const std::chrono::system_clock::time_point start_system_time_;
+  std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
   std::string span_id_;
   std::string parent_id_;
   const ReferenceType reference_type_;
 
+  // Shared with the children, finished by the span that created it
+  std::shared_ptr<impl::TailSamplingBuffer> tail_sampling_buffer_;
+  bool is_tail_sampling_root_{false};
+
   friend class Span;
 };
 
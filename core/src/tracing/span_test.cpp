@@ -8,6 +8,8 @@
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/tracing/tail_sampling.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -651,4 +653,202 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+UTEST_F(Span, NotSampledTrace) {
+  tracing::Tracer::SetSpanSamplingRate(0.0);
+  {
+    tracing::Span root_span("root_span");
+    root_span.AddNonInheritableTag("local", "tag");
+    root_span.AddTag("inheritable", "tag");
+    {
+      tracing::Span child("child_span");
+      EXPECT_EQ(child.GetTraceId(), root_span.GetTraceId());
+      EXPECT_EQ(child.GetSpanId(), root_span.GetSpanId());
+      EXPECT_FALSE(child.ShouldLogDefault());
+      LOG_INFO() << "inside";
+    }
+    EXPECT_FALSE(root_span.ShouldLogDefault());
+  }
+  tracing::Tracer::SetSpanSamplingRate(1.0);
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  EXPECT_EQ(logs.find("stopwatch_name="), std::string::npos) << logs;
+  EXPECT_EQ(logs.find("local=tag"), std::string::npos) << logs;
+  EXPECT_NE(logs.find("text=inside"), std::string::npos) << logs;
+  EXPECT_NE(logs.find("inheritable=tag"), std::string::npos) << logs;
+}
+
+UTEST_F(Span, SamplingDecidedAtRoot) {
+  {
+    tracing::Span root_span("root_span");
+    tracing::Tracer::SetSpanSamplingRate(0.0);
+    tracing::Span child("child_span");
+    EXPECT_NE(child.GetSpanId(), root_span.GetSpanId());
+    EXPECT_TRUE(child.ShouldLogDefault());
+  }
+  tracing::Tracer::SetSpanSamplingRate(1.0);
+
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("stopwatch_name=child_span"),
+            std::string::npos);
+}
+
+UTEST_F(Span, SamplingFollowsTraceId) {
+  tracing::Tracer::SetSpanSamplingRate(0.5);
+  std::size_t sampled = 0;
+  constexpr std::size_t kTraces = 100;
+  for (std::size_t i = 0; i < kTraces; ++i) {
+    const auto trace_id = fmt::format("trace-{}", i);
+    // Spans of the same trace in different services
+    auto first = tracing::Span::MakeSpan("first", trace_id, "parent");
+    auto second = tracing::Span::MakeSpan("second", trace_id, "parent");
+    EXPECT_EQ(first.ShouldLogDefault(), second.ShouldLogDefault()) << trace_id;
+    if (first.ShouldLogDefault()) ++sampled;
+  }
+  tracing::Tracer::SetSpanSamplingRate(1.0);
+
+  EXPECT_GT(sampled, 0);
+  EXPECT_LT(sampled, kTraces);
+}
+
+namespace {
+
+tracing::TailSamplingConfig MakeTailSamplingConfig() {
+  tracing::TailSamplingConfig config;
+  config.latency_threshold = std::chrono::hours{1};
+  return config;
+}
+
+}  // namespace
+
+UTEST_F(Span, TailSamplingDiscardsLogs) {
+  {
+    tracing::Span span("span_name");
+    span.EnableTailSampling(MakeTailSamplingConfig());
+    LOG_INFO() << "buffered";
+    {
+      tracing::Span child("child");
+      LOG_INFO() << "child buffered";
+    }
+
+    logging::LogFlush();
+    EXPECT_EQ(GetStreamString().find("buffered"), std::string::npos);
+  }
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  EXPECT_EQ(logs.find("buffered"), std::string::npos) << logs;
+  EXPECT_NE(logs.find("stopwatch_name=child"), std::string::npos) << logs;
+  EXPECT_NE(logs.find("stopwatch_name=span_name"), std::string::npos) << logs;
+}
+
+UTEST_F(Span, TailSamplingFlushesOnError) {
+  {
+    tracing::Span span("span_name");
+    span.EnableTailSampling(MakeTailSamplingConfig());
+    LOG_INFO() << "first";
+    {
+      tracing::Span child("child");
+      LOG_INFO() << "second";
+    }
+    span.AddTag(tracing::kErrorFlag, true);
+  }
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  const auto first = logs.find("text=first");
+  const auto second = logs.find("text=second");
+  const auto span_record = logs.find("stopwatch_name=span_name");
+  ASSERT_NE(first, std::string::npos) << logs;
+  ASSERT_NE(second, std::string::npos) << logs;
+  EXPECT_LT(first, second);
+  EXPECT_LT(second, span_record);
+}
+
+UTEST_F(Span, TailSamplingFlushesErrorOfNotSampledTrace) {
+  tracing::Tracer::SetSpanSamplingRate(0.0);
+  {
+    tracing::Span span("span_name");
+    span.EnableTailSampling(MakeTailSamplingConfig());
+    LOG_INFO() << "failed request";
+    EXPECT_FALSE(span.ShouldLogDefault());
+    // As HttpHandlerBase does for 5xx responses of the spans that are not
+    // logged
+    span.AddTag(tracing::kHttpStatusCode, 500);
+    span.AddTag(tracing::kErrorFlag, true);
+  }
+  tracing::Tracer::SetSpanSamplingRate(1.0);
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  EXPECT_NE(logs.find("text=failed request"), std::string::npos) << logs;
+  EXPECT_EQ(logs.find("stopwatch_name=span_name"), std::string::npos) << logs;
+}
+
+UTEST_F(Span, TailSamplingFlushesOnLatency) {
+  {
+    tracing::Span span("span_name");
+    auto config = MakeTailSamplingConfig();
+    config.latency_threshold = std::chrono::milliseconds{1};
+    span.EnableTailSampling(config);
+    LOG_INFO() << "slow";
+    engine::SleepFor(std::chrono::milliseconds{2});
+  }
+
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("text=slow"), std::string::npos);
+}
+
+UTEST_F(Span, TailSamplingFlushLevel) {
+  {
+    tracing::Span span("span_name");
+    span.EnableTailSampling(MakeTailSamplingConfig());
+    LOG_INFO() << "before";
+    LOG_WARNING() << "warning";
+
+    logging::LogFlush();
+    const auto logs = GetStreamString();
+    const auto before = logs.find("text=before");
+    ASSERT_NE(before, std::string::npos) << logs;
+    EXPECT_LT(before, logs.find("text=warning"));
+
+    LOG_INFO() << "after";
+  }
+
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("text=after"), std::string::npos);
+}
+
+UTEST_F(Span, TailSamplingEvictsOldest) {
+  {
+    tracing::Span span("span_name");
+    auto config = MakeTailSamplingConfig();
+    config.buffer_size = 1024;
+    span.EnableTailSampling(config);
+
+    LOG_INFO() << "oldest";
+    for (int i = 0; i < 10; ++i) {
+      LOG_INFO() << "newer " << std::string(100, '*');
+    }
+    LOG_INFO() << "newest";
+    span.AddTag(tracing::kErrorFlag, true);
+  }
+
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  EXPECT_EQ(logs.find("text=oldest"), std::string::npos) << logs;
+  EXPECT_NE(logs.find("text=newest"), std::string::npos) << logs;
+}
+
+UTEST_F(Span, TailSamplingSampled) {
+  tracing::Span span("span_name");
+  auto config = MakeTailSamplingConfig();
+  config.sampling_rate = 1.0;
+  span.EnableTailSampling(config);
+
+  LOG_INFO() << "sampled";
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("text=sampled"), std::string::npos);
+}
+
 USERVER_NAMESPACE_END
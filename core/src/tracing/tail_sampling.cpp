@@ -0,0 +1,38 @@
+#include <userver/tracing/tail_sampling.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/logging/level_serialization.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+TailSamplingConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<TailSamplingConfig>) {
+  TailSamplingConfig config;
+
+  config.buffer_size = value["buffer-size"].As<std::size_t>(config.buffer_size);
+  config.latency_threshold =
+      value["latency-threshold"].As<std::chrono::milliseconds>(
+          config.latency_threshold);
+  config.sampling_rate =
+      value["sampling-rate"].As<double>(config.sampling_rate);
+  config.flush_level =
+      value["flush-level"].As<logging::Level>(config.flush_level);
+
+  if (config.sampling_rate < 0.0 || config.sampling_rate > 1.0) {
+    throw std::runtime_error(
+        fmt::format("Invalid '{}': sampling-rate should be in range [0, 1], "
+                    "current value is {}",
+                    value.GetPath(), config.sampling_rate));
+  }
+
+  return config;
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,190 @@
+#include <tracing/tail_sampling_buffer.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+#include <logging/spdlog.hpp>
+
+#include <logging/logger_with_info.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+struct Statistics {
+  std::atomic<std::int64_t> buffered_bytes{0};
+
+  std::atomic<std::uint64_t> records_buffered{0};
+  std::atomic<std::uint64_t> records_flushed{0};
+  std::atomic<std::uint64_t> records_discarded{0};
+  std::atomic<std::uint64_t> records_evicted{0};
+
+  std::atomic<std::uint64_t> requests_sampled{0};
+  std::atomic<std::uint64_t> requests_buffered{0};
+  std::atomic<std::uint64_t> requests_flushed_on_error{0};
+  std::atomic<std::uint64_t> requests_flushed_on_latency{0};
+  std::atomic<std::uint64_t> requests_flushed_on_level{0};
+  std::atomic<std::uint64_t> requests_discarded{0};
+};
+
+Statistics& GetStatistics() noexcept {
+  static Statistics statistics;
+  return statistics;
+}
+
+double GetRatio(std::uint64_t part, std::uint64_t total) {
+  return total == 0 ? 0.0 : static_cast<double>(part) / total;
+}
+
+}  // namespace
+
+TailSamplingBuffer::TailSamplingBuffer(const TailSamplingConfig& config)
+    : config_(config) {
+  ++GetStatistics().requests_buffered;
+}
+
+TailSamplingBuffer::~TailSamplingBuffer() {
+  if (is_finished_) return;
+
+  auto& stats = GetStatistics();
+  stats.buffered_bytes -= bytes_;
+  stats.records_discarded += records_.size();
+  ++stats.requests_discarded;
+}
+
+bool TailSamplingBuffer::TryBuffer(const logging::LoggerPtr& logger,
+                                   logging::Level level,
+                                   std::string_view message) {
+  auto& stats = GetStatistics();
+
+  if (level >= config_.flush_level) {
+    std::deque<Record> records;
+    {
+      std::lock_guard lock(mutex_);
+      if (is_finished_) return false;
+      records = Release();
+    }
+
+    ++stats.requests_flushed_on_level;
+    Write(records);
+    return false;
+  }
+
+  if (message.size() > config_.buffer_size) {
+    std::lock_guard lock(mutex_);
+    if (is_finished_) return false;
+    ++stats.records_evicted;
+    return true;
+  }
+
+  // Allocating outside of the lock
+  Record record{logger, level, std::chrono::system_clock::now(),
+                std::string{message}};
+
+  std::lock_guard lock(mutex_);
+  if (is_finished_) return false;
+
+  while (bytes_ + message.size() > config_.buffer_size) {
+    const auto evicted_size = records_.front().message.size();
+    bytes_ -= evicted_size;
+    stats.buffered_bytes -= evicted_size;
+    ++stats.records_evicted;
+    records_.pop_front();
+  }
+
+  bytes_ += message.size();
+  stats.buffered_bytes += message.size();
+  ++stats.records_buffered;
+  records_.push_back(std::move(record));
+  return true;
+}
+
+void TailSamplingBuffer::Finish(bool is_error,
+                                std::chrono::steady_clock::duration duration) {
+  std::deque<Record> records;
+  {
+    std::lock_guard lock(mutex_);
+    if (is_finished_) return;
+    records = Release();
+  }
+
+  auto& stats = GetStatistics();
+  if (is_error) {
+    ++stats.requests_flushed_on_error;
+  } else if (duration >= config_.latency_threshold) {
+    ++stats.requests_flushed_on_latency;
+  } else {
+    stats.records_discarded += records.size();
+    ++stats.requests_discarded;
+    return;
+  }
+
+  Write(records);
+}
+
+std::size_t TailSamplingBuffer::GetBufferedBytes() const {
+  std::lock_guard lock(mutex_);
+  return bytes_;
+}
+
+std::deque<TailSamplingBuffer::Record> TailSamplingBuffer::Release() {
+  is_finished_ = true;
+  GetStatistics().buffered_bytes -= bytes_;
+  bytes_ = 0;
+  return std::move(records_);
+}
+
+void TailSamplingBuffer::Write(const std::deque<Record>& records) {
+  for (const auto& record : records) {
+    record.logger->ptr->log(
+        record.time, spdlog::source_loc{},
+        static_cast<spdlog::level::level_enum>(record.level), record.message);
+  }
+  GetStatistics().records_flushed += records.size();
+}
+
+bool ShouldSampleSpan(const TailSamplingConfig& config) {
+  const bool is_sampled = config.sampling_rate > 0.0 &&
+                          utils::RandRange(1.0) < config.sampling_rate;
+  if (is_sampled) ++GetStatistics().requests_sampled;
+  return is_sampled;
+}
+
+formats::json::Value GetTailSamplingStatistics() {
+  const auto& stats = GetStatistics();
+  formats::json::ValueBuilder builder(formats::json::Type::kObject);
+
+  builder["buffered-bytes"] = stats.buffered_bytes.load();
+
+  const std::uint64_t records_flushed = stats.records_flushed;
+  const std::uint64_t records_discarded = stats.records_discarded;
+  builder["records"]["buffered"] = stats.records_buffered.load();
+  builder["records"]["flushed"] = records_flushed;
+  builder["records"]["discarded"] = records_discarded;
+  builder["records"]["evicted"] = stats.records_evicted.load();
+  builder["records"]["flush-ratio"] =
+      GetRatio(records_flushed, records_flushed + records_discarded);
+
+  const std::uint64_t flushed_on_error = stats.requests_flushed_on_error;
+  const std::uint64_t flushed_on_latency = stats.requests_flushed_on_latency;
+  const std::uint64_t flushed_on_level = stats.requests_flushed_on_level;
+  const std::uint64_t discarded = stats.requests_discarded;
+  const auto flushed = flushed_on_error + flushed_on_latency + flushed_on_level;
+  builder["requests"]["sampled"] = stats.requests_sampled.load();
+  builder["requests"]["buffered"] = stats.requests_buffered.load();
+  builder["requests"]["flushed-on-error"] = flushed_on_error;
+  builder["requests"]["flushed-on-latency"] = flushed_on_latency;
+  builder["requests"]["flushed-on-level"] = flushed_on_level;
+  builder["requests"]["discarded"] = discarded;
+  builder["requests"]["flush-ratio"] = GetRatio(flushed, flushed + discarded);
+
+  return builder.ExtractValue();
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
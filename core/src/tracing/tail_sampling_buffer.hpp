@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <userver/formats/json/value.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/logging/logger.hpp>
+#include <userver/tracing/tail_sampling.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// @brief Bounded buffer of the log records of a tracing::Span and of its
+/// children.
+///
+/// Thread safe, the children of the span may log from other task processors.
+class TailSamplingBuffer final {
+ public:
+  explicit TailSamplingBuffer(const TailSamplingConfig& config);
+
+  TailSamplingBuffer(const TailSamplingBuffer&) = delete;
+  TailSamplingBuffer& operator=(const TailSamplingBuffer&) = delete;
+
+  ~TailSamplingBuffer();
+
+  /// @returns true if the record was buffered or evicted and should not be
+  /// logged by the caller
+  /// @note A record with config.flush_level or higher writes out the buffered
+  /// records and stops the buffering, so the caller writes it in order.
+  bool TryBuffer(const logging::LoggerPtr& logger, logging::Level level,
+                 std::string_view message);
+
+  /// Writes out the buffered records if the span failed or was too slow,
+  /// discards them otherwise. Further records are not buffered.
+  void Finish(bool is_error, std::chrono::steady_clock::duration duration);
+
+  std::size_t GetBufferedBytes() const;
+
+ private:
+  struct Record {
+    logging::LoggerPtr logger;
+    logging::Level level;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+  };
+
+  std::deque<Record> Release();
+  static void Write(const std::deque<Record>& records);
+
+  const TailSamplingConfig config_;
+
+  mutable std::mutex mutex_;
+  std::deque<Record> records_;
+  std::size_t bytes_{0};
+  bool is_finished_{false};
+};
+
+/// @returns true if a span with the config should be logged without
+/// buffering, accounts the decision in the statistics
+bool ShouldSampleSpan(const TailSamplingConfig& config);
+
+formats::json::Value GetTailSamplingStatistics();
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <tracing/no_log_spans.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/tracing/noop.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/uuid4.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,6 +19,11 @@ auto& GlobalNoLogSpans() {
   return spans;
 }
 
+auto& GlobalSpanSamplingRate() {
+  static std::atomic<double> rate{1.0};
+  return rate;
+}
+
 auto& GlobalTracer() {
   static const std::string kEmptyServiceName;
   static rcu::Variable<TracerPtr> tracer(
@@ -63,6 +69,16 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
          spans->names.find(name) != spans->names.end();
 }
 
+void Tracer::SetSpanSamplingRate(double rate) {
+  UINVARIANT(rate >= 0.0 && rate <= 1.0,
+             "Span sampling rate should be in range [0, 1]");
+  GlobalSpanSamplingRate().store(rate, std::memory_order_relaxed);
+}
+
+double Tracer::GetSpanSamplingRate() {
+  return GlobalSpanSamplingRate().load(std::memory_order_relaxed);
+}
+
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
   GlobalTracer().Assign(tracer);
 }
@@ -1,8 +1,14 @@
 #include <benchmark/benchmark.h>
 
+#include <spdlog/sinks/null_sink.h>
+
+#include <logging/logger_with_info.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tracer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -39,6 +45,44 @@ void tracing_opentracing_ctr(benchmark::State& state) {
 }
 BENCHMARK(tracing_opentracing_ctr);
 
+constexpr std::size_t kNestedSpansDepth = 8;
+
+void CreateNestedSpans(std::size_t depth) {
+  if (depth == 0) return;
+
+  tracing::Span span("nested");
+  span.AddNonInheritableTag("depth", depth);
+  auto scope = span.CreateScopeTime("scope");
+  CreateNestedSpans(depth - 1);
+}
+
+// Sampled spans are formatted and written to a null sink, not sampled ones
+// are not logged at all
+void tracing_nested_spans(benchmark::State& state) {
+  const bool is_sampled = state.range(0);
+  auto logger = std::make_shared<logging::impl::LoggerWithInfo>(
+      logging::Format::kTskv,
+      utils::MakeSharedRef<spdlog::logger>(
+          "null", std::make_shared<spdlog::sinks::null_sink_mt>()));
+
+  engine::RunStandalone([&] {
+    auto old_logger = logging::SetDefaultLogger(logger);
+    logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+    tracing::Tracer::SetSpanSamplingRate(is_sampled ? 1.0 : 0.0);
+
+    for (auto _ : state) {
+      tracing::Span root("root");
+      CreateNestedSpans(kNestedSpansDepth);
+    }
+
+    tracing::Tracer::SetSpanSamplingRate(1.0);
+    logging::SetDefaultLogger(old_logger);
+    logging::SetDefaultLoggerLevel(logging::Level::kError);
+  });
+  state.SetItemsProcessed(state.iterations() * (kNestedSpansDepth + 1));
+}
+BENCHMARK(tracing_nested_spans)->Arg(false)->Arg(true);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
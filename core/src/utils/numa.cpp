@@ -0,0 +1,259 @@
+#include <utils/numa.hpp>
+
+#include <sched.h>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+namespace {
+
+struct Topology {
+  std::vector<std::vector<std::size_t>> node_cpus;
+  std::vector<std::size_t> cpu_to_node;
+};
+
+#ifdef __linux__
+std::string ReadSysfsLine(const std::string& path) {
+  std::ifstream file{path};
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+constexpr std::size_t kMaxNodes = 1024;
+constexpr std::size_t kMaskWordBits = sizeof(unsigned long) * CHAR_BIT;
+
+using NodeMask = std::array<unsigned long, kMaxNodes / kMaskWordBits>;
+
+NodeMask MakeNodeMask(std::size_t node) noexcept {
+  NodeMask mask{};
+  mask[node / kMaskWordBits] |= 1UL << (node % kMaskWordBits);
+  return mask;
+}
+
+// The kernel ignores the last bit of `maxnode`, as libnuma does we pass one
+// more bit than the mask has
+constexpr unsigned long kMaxNode = kMaxNodes + 1;
+#endif
+
+Topology LoadTopology() {
+  Topology topology;
+#ifdef __linux__
+  try {
+    const auto online = ReadSysfsLine("/sys/devices/system/node/online");
+    const auto nodes = online.empty() ? std::vector<std::size_t>{}
+                                      : ParseCpuList(online);
+    if (!nodes.empty()) {
+      topology.node_cpus.resize(nodes.back() + 1);
+    }
+    for (const auto node : nodes) {
+      const auto cpu_list = ReadSysfsLine(
+          fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+      if (cpu_list.empty()) continue;
+
+      auto& cpus = topology.node_cpus[node];
+      cpus = ParseCpuList(cpu_list);
+      if (topology.cpu_to_node.size() <= cpus.back()) {
+        topology.cpu_to_node.resize(cpus.back() + 1, 0);
+      }
+      for (const auto cpu : cpus) topology.cpu_to_node[cpu] = node;
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to read the NUMA topology, assuming a single "
+                     "node: "
+                  << ex;
+    topology = {};
+  }
+#endif
+  if (topology.node_cpus.empty()) topology.node_cpus.emplace_back();
+  return topology;
+}
+
+const Topology& GetTopology() {
+  static const Topology topology = LoadTopology();
+  return topology;
+}
+
+std::size_t ParseCpu(std::string_view cpu, std::string_view cpu_list) {
+  try {
+    return utils::FromString<std::size_t>(std::string{cpu});
+  } catch (const std::exception&) {
+    throw std::runtime_error(
+        fmt::format("Invalid CPU list '{}': bad number '{}'", cpu_list, cpu));
+  }
+}
+
+}  // namespace
+
+std::size_t GetNodesCount() { return GetTopology().node_cpus.size(); }
+
+const std::vector<std::size_t>& GetNodeCpus(std::size_t node) {
+  static const std::vector<std::size_t> kNoCpus;
+  const auto& node_cpus = GetTopology().node_cpus;
+  return node < node_cpus.size() ? node_cpus[node] : kNoCpus;
+}
+
+std::size_t GetCurrentNode() noexcept {
+#ifdef __linux__
+  const auto& cpu_to_node = GetTopology().cpu_to_node;
+  const auto cpu = ::sched_getcpu();
+  if (cpu >= 0 && static_cast<std::size_t>(cpu) < cpu_to_node.size()) {
+    return cpu_to_node[cpu];
+  }
+#endif
+  return 0;
+}
+
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> cpus;
+  std::string_view rest = cpu_list;
+  while (!rest.empty() && (rest.back() == '\n' || rest.back() == ' ')) {
+    rest.remove_suffix(1);
+  }
+  while (!rest.empty()) {
+    const auto comma = rest.find(',');
+    const auto range = rest.substr(0, comma);
+    rest = comma == std::string_view::npos ? std::string_view{}
+                                           : rest.substr(comma + 1);
+
+    const auto dash = range.find('-');
+    const auto first = ParseCpu(range.substr(0, dash), cpu_list);
+    const auto last = dash == std::string_view::npos
+                          ? first
+                          : ParseCpu(range.substr(dash + 1), cpu_list);
+    if (last < first) {
+      throw std::runtime_error(fmt::format(
+          "Invalid CPU list '{}': bad range '{}'", cpu_list, range));
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::vector<std::size_t> GetAllowedCpus() {
+  std::vector<std::size_t> cpus;
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  static constexpr ::pid_t kThisProcessPid = 0;
+  if (::sched_getaffinity(kThisProcessPid, sizeof(cpu_set), &cpu_set) != 0) {
+    return cpus;
+  }
+  for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) cpus.push_back(cpu);
+  }
+#endif
+  return cpus;
+}
+
+void ValidateCpus(const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  const auto allowed = GetAllowedCpus();
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(fmt::format(
+          "CPU {} does not fit into the affinity mask of {} CPUs", cpu,
+          CPU_SETSIZE));
+    }
+    if (!allowed.empty() &&
+        !std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+      throw std::runtime_error(fmt::format(
+          "CPU {} is offline or not allowed for the process, allowed CPUs: "
+          "{}",
+          cpu, fmt::join(allowed, ",")));
+    }
+  }
+#else
+  (void)cpus;
+#endif
+}
+
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(fmt::format(
+          "CPU {} does not fit into the affinity mask of {} CPUs", cpu,
+          CPU_SETSIZE));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  static constexpr ::pid_t kThisThreadPid = 0;
+  utils::CheckSyscall(
+      ::sched_setaffinity(kThisThreadPid, sizeof(cpu_set), &cpu_set),
+      "setting thread affinity");
+#else
+  (void)cpus;
+#endif
+}
+
+void SetCurrentThreadPreferredNode(std::size_t node) {
+#ifdef __linux__
+  if (node >= kMaxNodes) {
+    throw std::runtime_error(fmt::format("NUMA node {} is out of range", node));
+  }
+  const auto mask = MakeNodeMask(node);
+  if (::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), kMaxNode) !=
+      0) {
+    // e.g. forbidden by seccomp, the thread still works fine
+    const std::error_code error{errno, std::system_category()};
+    LOG_WARNING() << "Failed to prefer the memory of NUMA node " << node
+                  << ": " << error.message();
+  }
+#else
+  (void)node;
+#endif
+}
+
+void BindCurrentThreadToNode(std::size_t node) {
+  const auto& cpus = GetNodeCpus(node);
+  if (cpus.empty()) return;
+
+  SetCurrentThreadAffinity(cpus);
+  SetCurrentThreadPreferredNode(node);
+}
+
+bool BindMemoryToNode(void* addr, std::size_t size, std::size_t node) noexcept {
+#ifdef __linux__
+  if (node >= kMaxNodes) return false;
+  const auto mask = MakeNodeMask(node);
+  return ::syscall(SYS_mbind, addr, size, MPOL_PREFERRED, mask.data(),
+                   kMaxNode, 0) == 0;
+#else
+  (void)addr;
+  (void)size;
+  (void)node;
+  return false;
+#endif
+}
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
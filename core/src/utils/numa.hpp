@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+/// NUMA topology and affinity helpers. On systems without NUMA support (or
+/// without the sysfs topology, e.g. in some containers) the machine is
+/// reported as a single node and the binding functions do nothing.
+namespace utils::numa {
+
+/// Count of NUMA nodes of the machine, at least 1
+std::size_t GetNodesCount();
+
+/// CPUs of the `node`, empty if the topology is unknown
+const std::vector<std::size_t>& GetNodeCpus(std::size_t node);
+
+/// @brief Node of the CPU the current thread runs on.
+/// Cheap enough to be called on each task switch: uses sched_getcpu() and a
+/// precomputed CPU to node table.
+std::size_t GetCurrentNode() noexcept;
+
+/// @brief Parses the Linux cpulist format, e.g. "0-3,8,10-11".
+/// @throws std::runtime_error on invalid input
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// CPUs the current process is allowed to run on, empty if unknown
+std::vector<std::size_t> GetAllowedCpus();
+
+/// @brief Checks that the process may run on all the `cpus`, so that
+/// SetCurrentThreadAffinity() would not fail.
+/// @throws std::runtime_error otherwise
+void ValidateCpus(const std::vector<std::size_t>& cpus);
+
+/// Restricts the current thread to the `cpus`
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus);
+
+/// Makes the kernel allocate the memory of the current thread on the `node`,
+/// falling back to other nodes if it is exhausted
+void SetCurrentThreadPreferredNode(std::size_t node);
+
+/// Runs the current thread on the CPUs of the `node` and makes it prefer the
+/// memory of the `node`
+void BindCurrentThreadToNode(std::size_t node);
+
+/// @brief Makes the kernel take the not yet touched pages of the range from
+/// the `node`.
+/// @returns false if the policy could not be set, the memory is still usable
+bool BindMemoryToNode(void* addr, std::size_t size, std::size_t node) noexcept;
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
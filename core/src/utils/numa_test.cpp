@@ -0,0 +1,61 @@
+#include <utils/numa.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cpus = std::vector<std::size_t>;
+
+TEST(Numa, ParseCpuList) {
+  EXPECT_EQ(utils::numa::ParseCpuList("0"), Cpus({0}));
+  EXPECT_EQ(utils::numa::ParseCpuList("0-3"), Cpus({0, 1, 2, 3}));
+  EXPECT_EQ(utils::numa::ParseCpuList("0-1,8,10-11\n"),
+            Cpus({0, 1, 8, 10, 11}));
+  EXPECT_EQ(utils::numa::ParseCpuList("4,2-3,3"), Cpus({2, 3, 4}));
+  EXPECT_EQ(utils::numa::ParseCpuList(""), Cpus{});
+}
+
+TEST(Numa, ParseCpuListInvalid) {
+  EXPECT_THROW(utils::numa::ParseCpuList("a"), std::runtime_error);
+  EXPECT_THROW(utils::numa::ParseCpuList("3-1"), std::runtime_error);
+  EXPECT_THROW(utils::numa::ParseCpuList("1,,2"), std::runtime_error);
+  EXPECT_THROW(utils::numa::ParseCpuList("1-"), std::runtime_error);
+}
+
+TEST(Numa, Topology) {
+  const auto nodes = utils::numa::GetNodesCount();
+  ASSERT_GE(nodes, 1u);
+  EXPECT_LT(utils::numa::GetCurrentNode(), nodes);
+  EXPECT_TRUE(utils::numa::GetNodeCpus(nodes).empty());
+
+  for (std::size_t node = 0; node < nodes; ++node) {
+    const auto& cpus = utils::numa::GetNodeCpus(node);
+    EXPECT_TRUE(std::is_sorted(cpus.begin(), cpus.end()));
+  }
+}
+
+TEST(Numa, ValidateCpus) {
+  const auto allowed = utils::numa::GetAllowedCpus();
+  EXPECT_NO_THROW(utils::numa::ValidateCpus(allowed));
+  EXPECT_NO_THROW(utils::numa::ValidateCpus({}));
+#ifdef __linux__
+  EXPECT_FALSE(allowed.empty());
+  EXPECT_THROW(utils::numa::ValidateCpus({1'000'000}), std::runtime_error);
+#endif
+}
+
+TEST(Numa, BindCurrentThread) {
+  // Do not change the affinity of the main test thread
+  std::thread([] {
+    const auto node = utils::numa::GetCurrentNode();
+    EXPECT_NO_THROW(utils::numa::BindCurrentThreadToNode(node));
+    EXPECT_EQ(utils::numa::GetCurrentNode(), node);
+  }).join();
+}
+
+USERVER_NAMESPACE_END
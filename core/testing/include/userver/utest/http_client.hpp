@@ -14,6 +14,8 @@ class TaskProcessor;
 
 namespace utest {
 
+// The client has a single IO thread, so the limits set with
+// Client::SetMaxHostConnections() are exact
 std::shared_ptr<clients::http::Client> CreateHttpClient();
 
 std::shared_ptr<clients::http::Client> CreateHttpClient(
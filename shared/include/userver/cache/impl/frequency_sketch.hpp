@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+// Count-min sketch of access frequencies with 4 rows of saturating 4-bit
+// counters. The counters are halved once the number of increments reaches
+// 10 times the capacity, so that the old accesses are forgotten.
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity);
+
+  // Resets the frequencies
+  void SetCapacity(std::size_t capacity);
+
+  void Increment(std::size_t hash) noexcept;
+
+  std::uint32_t Estimate(std::size_t hash) const noexcept;
+
+  void Clear() noexcept;
+
+ private:
+  std::size_t GetIndex(std::size_t hash, std::size_t row) const noexcept;
+  void Age() noexcept;
+
+  std::vector<std::uint8_t> counters_;
+  std::size_t width_shift_{0};
+  std::size_t sample_size_{0};
+  std::size_t additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -129,6 +129,8 @@ class LruBase final {
 
   size_t GetSize() const;
 
+  std::size_t GetAdmissionRejections() const noexcept { return 0; }
+
  private:
   using Node = LruNode<T, U>;
   using List =
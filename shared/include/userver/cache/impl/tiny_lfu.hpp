@@ -0,0 +1,393 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/intrusive/list.hpp>
+#include <boost/intrusive/unordered_set.hpp>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+enum class TinyLfuSegment : std::uint8_t {
+  kWindow,
+  kProbation,
+  kProtected,
+};
+
+template <class Key, class Value>
+// NOLINTNEXTLINE(fuchsia-multiple-inheritance)
+class TinyLfuNode final : public LruListHook, public LruHashSetHook {
+ public:
+  TinyLfuNode(Key&& key, Value&& value)
+      : key_(std::move(key)), value_(std::move(value)) {}
+
+  void SetValue(Value&& value) { value_ = std::move(value); }
+
+  const Key& GetKey() const noexcept { return key_; }
+
+  const Value& GetValue() const noexcept { return value_; }
+  Value& GetValue() noexcept { return value_; }
+
+  TinyLfuSegment segment{TinyLfuSegment::kWindow};
+
+ private:
+  Key key_;
+  Value value_;
+};
+
+template <class Key, class Value>
+const Key& GetKey(const TinyLfuNode<Key, Value>& node) noexcept {
+  return node.GetKey();
+}
+
+// W-TinyLFU, see cache::CachePolicy::kTinyLFU. The window takes 1% of the
+// capacity, the protected segment takes 80% of the main segmented LRU.
+// Each Get and Put is counted as an access in the frequency sketch.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class TinyLfuBase final {
+ public:
+  explicit TinyLfuBase(size_t max_size, const Hash& hash, const Equal& equal);
+  ~TinyLfuBase() { Clear(); }
+
+  TinyLfuBase(TinyLfuBase&& other) noexcept
+      : buckets_(std::move(other.buckets_)),
+        map_(std::move(other.map_)),
+        lists_(std::move(other.lists_)),
+        sizes_(other.sizes_),
+        max_size_(other.max_size_),
+        sketch_(std::move(other.sketch_)),
+        admission_rejections_(other.admission_rejections_) {
+    other.buckets_.clear();
+    other.map_.clear();
+    for (auto& list : other.lists_) list.clear();
+    other.sizes_ = {};
+  }
+
+  TinyLfuBase& operator=(TinyLfuBase&& other) noexcept {
+    if (this != &other) Clear();
+
+    swap(other.buckets_, buckets_);
+    swap(other.map_, map_);
+    swap(other.lists_, lists_);
+    std::swap(other.sizes_, sizes_);
+    std::swap(other.max_size_, max_size_);
+    std::swap(other.sketch_, sketch_);
+    std::swap(other.admission_rejections_, admission_rejections_);
+
+    return *this;
+  }
+
+  TinyLfuBase(const TinyLfuBase&) = delete;
+  TinyLfuBase& operator=(const TinyLfuBase&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T&, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  const T* GetLeastUsedKey();
+
+  U* GetLeastUsedValue();
+
+  void SetMaxSize(size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  size_t GetSize() const { return map_.size(); }
+
+  std::size_t GetAdmissionRejections() const noexcept {
+    return admission_rejections_;
+  }
+
+ private:
+  using Node = TinyLfuNode<T, U>;
+  using List =
+      boost::intrusive::list<Node, boost::intrusive::constant_time_size<false>>;
+
+  static constexpr std::size_t kSegments = 3;
+
+  struct NodeHash : Hash {
+    NodeHash(const Hash& h) : Hash{h} {}
+
+    template <class NodeOrKey>
+    auto operator()(const NodeOrKey& x) const {
+      return Hash::operator()(impl::GetKey(x));
+    }
+  };
+
+  struct NodeEqual : Equal {
+    NodeEqual(const Equal& eq) : Equal{eq} {}
+
+    template <class NodeOrKey1, class NodeOrKey2>
+    auto operator()(const NodeOrKey1& x, const NodeOrKey2& y) const {
+      return Equal::operator()(impl::GetKey(x), impl::GetKey(y));
+    }
+  };
+
+  using Map = boost::intrusive::unordered_set<
+      Node, boost::intrusive::constant_time_size<true>,
+      boost::intrusive::hash<NodeHash>, boost::intrusive::equal<NodeEqual>>;
+
+  using BucketTraits = typename Map::bucket_traits;
+  using BucketType = typename Map::bucket_type;
+
+  std::size_t GetWindowMaxSize() const noexcept {
+    return std::max<std::size_t>(max_size_ / 100, 1);
+  }
+  std::size_t GetProtectedMaxSize() const noexcept {
+    return (max_size_ - std::min(max_size_, GetWindowMaxSize())) * 4 / 5;
+  }
+
+  List& GetList(TinyLfuSegment segment) noexcept {
+    return lists_[static_cast<std::size_t>(segment)];
+  }
+  std::size_t& GetSize(TinyLfuSegment segment) noexcept {
+    return sizes_[static_cast<std::size_t>(segment)];
+  }
+
+  std::size_t HashOf(const T& key) const { return map_.hash_function()(key); }
+
+  U& Add(const T& key, U value);
+  void OnAccess(Node& node) noexcept;
+  void MoveTo(Node& node, TinyLfuSegment segment) noexcept;
+  void EvictFromWindow();
+  Node* GetVictim() noexcept;
+  void DeleteNode(Node& node) noexcept;
+
+  std::vector<BucketType> buckets_;
+  Map map_;
+  std::array<List, kSegments> lists_;
+  std::array<std::size_t, kSegments> sizes_{};
+  std::size_t max_size_;
+  FrequencySketch sketch_;
+  std::size_t admission_rejections_{0};
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfuBase<T, U, Hash, Equal>::TinyLfuBase(size_t max_size, const Hash& hash,
+                                            const Equal& eq)
+    : buckets_(max_size ? max_size : 1),
+      map_(BucketTraits(buckets_.data(), buckets_.size()), hash, eq),
+      max_size_(max_size ? max_size : 1),
+      sketch_(max_size_) {
+  UASSERT(max_size > 0);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+bool TinyLfuBase<T, U, Hash, Eq>::Put(const T& key, U value) {
+  sketch_.Increment(HashOf(key));
+
+  auto it = map_.find(key, map_.hash_function(), map_.key_eq());
+  if (it != map_.end()) {
+    it->SetValue(std::move(value));
+    OnAccess(*it);
+    return false;
+  }
+
+  Add(key, std::move(value));
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename... Args>
+U* TinyLfuBase<T, U, Hash, Eq>::Emplace(const T& key, Args&&... args) {
+  auto* existing = Get(key);
+  if (existing) return existing;
+  return &Add(key, U{std::forward<Args>(args)...});
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::Erase(const T& key) {
+  auto it = map_.find(key, map_.hash_function(), map_.key_eq());
+  if (it == map_.end()) return;
+  DeleteNode(*it);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U* TinyLfuBase<T, U, Hash, Eq>::Get(const T& key) {
+  sketch_.Increment(HashOf(key));
+
+  auto it = map_.find(key, map_.hash_function(), map_.key_eq());
+  if (it == map_.end()) return nullptr;
+  OnAccess(*it);
+  return &it->GetValue();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+const T* TinyLfuBase<T, U, Hash, Eq>::GetLeastUsedKey() {
+  auto* node = GetVictim();
+  return node ? &node->GetKey() : nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U* TinyLfuBase<T, U, Hash, Eq>::GetLeastUsedValue() {
+  auto* node = GetVictim();
+  return node ? &node->GetValue() : nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::SetMaxSize(size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  if (!new_max_size) ++new_max_size;
+
+  if (max_size_ == new_max_size) return;
+  max_size_ = new_max_size;
+
+  while (map_.size() > max_size_) DeleteNode(*GetVictim());
+  while (GetSize(TinyLfuSegment::kWindow) > GetWindowMaxSize()) {
+    MoveTo(GetList(TinyLfuSegment::kWindow).front(),
+           TinyLfuSegment::kProbation);
+  }
+  while (GetSize(TinyLfuSegment::kProtected) > GetProtectedMaxSize()) {
+    MoveTo(GetList(TinyLfuSegment::kProtected).front(),
+           TinyLfuSegment::kProbation);
+  }
+
+  std::vector<BucketType> new_buckets(max_size_);
+  map_.rehash(BucketTraits(new_buckets.data(), max_size_));
+  buckets_.swap(new_buckets);
+  sketch_.SetCapacity(max_size_);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::Clear() noexcept {
+  for (auto& list : lists_) {
+    while (!list.empty()) DeleteNode(list.front());
+  }
+  sketch_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Eq>::VisitAll(Function&& func) const {
+  for (const auto& node : map_) {
+    func(node.GetKey(), node.GetValue());
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Eq>::VisitAll(Function&& func) {
+  for (auto& node : map_) {
+    func(node.GetKey(), node.GetValue());
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U& TinyLfuBase<T, U, Hash, Eq>::Add(const T& key, U value) {
+  auto node = std::make_unique<Node>(T{key}, std::move(value));
+  auto& ref = *node;
+  const auto [it, ok] = map_.insert(*node.release());  // noexcept
+  UASSERT(ok);
+  GetList(TinyLfuSegment::kWindow).push_back(ref);
+  ++GetSize(TinyLfuSegment::kWindow);
+
+  if (GetSize(TinyLfuSegment::kWindow) > GetWindowMaxSize()) EvictFromWindow();
+  return ref.GetValue();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::OnAccess(Node& node) noexcept {
+  switch (node.segment) {
+    case TinyLfuSegment::kWindow:
+    case TinyLfuSegment::kProtected: {
+      auto& list = GetList(node.segment);
+      list.splice(list.end(), list, list.iterator_to(node));
+      break;
+    }
+    case TinyLfuSegment::kProbation:
+      MoveTo(node, TinyLfuSegment::kProtected);
+      while (GetSize(TinyLfuSegment::kProtected) > GetProtectedMaxSize()) {
+        MoveTo(GetList(TinyLfuSegment::kProtected).front(),
+               TinyLfuSegment::kProbation);
+      }
+      break;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::MoveTo(Node& node,
+                                         TinyLfuSegment segment) noexcept {
+  auto& from = GetList(node.segment);
+  from.erase(from.iterator_to(node));
+  --GetSize(node.segment);
+
+  node.segment = segment;
+  GetList(segment).push_back(node);
+  ++GetSize(segment);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::EvictFromWindow() {
+  auto& candidate = GetList(TinyLfuSegment::kWindow).front();
+  if (map_.size() <= max_size_) {
+    MoveTo(candidate, TinyLfuSegment::kProbation);
+    return;
+  }
+
+  auto* victim = GetList(TinyLfuSegment::kProbation).empty()
+                     ? nullptr
+                     : &GetList(TinyLfuSegment::kProbation).front();
+  if (!victim && !GetList(TinyLfuSegment::kProtected).empty()) {
+    victim = &GetList(TinyLfuSegment::kProtected).front();
+  }
+  if (!victim) {
+    // The whole capacity is taken by the window
+    DeleteNode(candidate);
+    return;
+  }
+
+  // Ties are resolved in favor of the main segment, so that a scan does not
+  // replace the elements that were accessed as often as the scanned ones
+  if (sketch_.Estimate(HashOf(candidate.GetKey())) >
+      sketch_.Estimate(HashOf(victim->GetKey()))) {
+    DeleteNode(*victim);
+    MoveTo(candidate, TinyLfuSegment::kProbation);
+  } else {
+    ++admission_rejections_;
+    DeleteNode(candidate);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+TinyLfuNode<T, U>* TinyLfuBase<T, U, Hash, Eq>::GetVictim() noexcept {
+  for (const auto segment :
+       {TinyLfuSegment::kProbation, TinyLfuSegment::kProtected,
+        TinyLfuSegment::kWindow}) {
+    auto& list = GetList(segment);
+    if (!list.empty()) return &list.front();
+  }
+  return nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void TinyLfuBase<T, U, Hash, Eq>::DeleteNode(Node& node) noexcept {
+  std::unique_ptr<Node> holder(&node);
+  map_.erase(map_.iterator_to(node));
+  auto& list = GetList(node.segment);
+  list.erase(list.iterator_to(node));
+  --GetSize(node.segment);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -3,7 +3,11 @@
 /// @file userver/cache/lru_map.hpp
 /// @brief @copybrief cache::LruMap
 
+#include <type_traits>
+
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tiny_lfu.hpp>
+#include <userver/cache/policy.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,8 +18,12 @@ namespace cache {
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
 /// thread safety
+///
+/// The replacement policy is chosen via cache::CachePolicy. With
+/// cache::CachePolicy::kTinyLFU "least used" is the next eviction candidate.
 template <typename T, typename U, typename Hash = std::hash<T>,
-          typename Equal = std::equal_to<T>>
+          typename Equal = std::equal_to<T>,
+          CachePolicy Policy = CachePolicy::kLRU>
 class LruMap final {
  public:
   explicit LruMap(size_t max_size, const Hash& hash = Hash(),
@@ -82,8 +90,18 @@ class LruMap final {
 
   size_t GetSize() const { return impl_.GetSize(); }
 
+  /// Returns the number of new elements that were not admitted into the
+  /// cache because they were accessed less often than the eviction candidate.
+  /// Always 0 for cache::CachePolicy::kLRU.
+  std::size_t GetAdmissionRejections() const noexcept {
+    return impl_.GetAdmissionRejections();
+  }
+
  private:
-  impl::LruBase<T, U, Hash, Equal> impl_;
+  std::conditional_t<Policy == CachePolicy::kLRU,
+                     impl::LruBase<T, U, Hash, Equal>,
+                     impl::TinyLfuBase<T, U, Hash, Equal>>
+      impl_;
 };
 
 }  // namespace cache
@@ -3,7 +3,11 @@
 /// @file userver/cache/lru_set.hpp
 /// @brief @copybrief cache::LruSet
 
+#include <type_traits>
+
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tiny_lfu.hpp>
+#include <userver/cache/policy.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,8 +16,11 @@ namespace cache {
 /// @ingroup userver_containers
 ///
 /// LRU set, thread safety matches Standard Library thread safety
+///
+/// The replacement policy is chosen via cache::CachePolicy.
 template <typename T, typename Hash = std::hash<T>,
-          typename Equal = std::equal_to<T>>
+          typename Equal = std::equal_to<T>,
+          CachePolicy Policy = CachePolicy::kLRU>
 class LruSet final {
  public:
   explicit LruSet(size_t max_size, const Hash& hash = Hash(),
@@ -57,8 +64,19 @@ class LruSet final {
   /// @warning Returned pointer may be freed on the next set access!
   const T* GetLeastUsed() { return impl_.GetLeastUsedKey(); }
 
+  /// Returns the number of new keys that were not admitted into the set
+  /// because they were accessed less often than the eviction candidate.
+  /// Always 0 for cache::CachePolicy::kLRU.
+  std::size_t GetAdmissionRejections() const noexcept {
+    return impl_.GetAdmissionRejections();
+  }
+
  private:
-  impl::LruBase<T, impl::EmptyPlaceholder, Hash, Equal> impl_;
+  std::conditional_t<
+      Policy == CachePolicy::kLRU,
+      impl::LruBase<T, impl::EmptyPlaceholder, Hash, Equal>,
+      impl::TinyLfuBase<T, impl::EmptyPlaceholder, Hash, Equal>>
+      impl_;
 };
 
 }  // namespace cache
@@ -0,0 +1,643 @@
+#pragma once
+
+/// @file userver/cache/persistent_map.hpp
+/// @brief @copybrief cache::PersistentMap
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Hash map with O(1) copy, a hash array mapped trie.
+///
+/// Copies share the structure: a modification of a copy copies only the path
+/// from the root to the modified element, O(log32(size)) nodes, and leaves the
+/// other copies intact. Nodes owned by a single map are modified in place, so
+/// building a map from scratch does not copy paths.
+///
+/// Designed as a data type for components::CachingComponentBase: an
+/// incremental update copies the current cache contents in O(1), applies the
+/// delta and publishes the result, while the readers keep their snapshot.
+/// See components::CachingComponentBase::SetModifiedCopy.
+///
+/// Lookups walk O(log32(size)) nodes and are slower than the ones of
+/// std::unordered_map on big maps, use it where the cost of updates matters.
+///
+/// Different copies may be read and modified from different threads, the
+/// thread safety of a single copy matches the Standard Library thread safety.
+/// The elements are immutable, use insert_or_assign() to change a value.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentMap final {
+ private:
+  struct Node;
+  using NodePtr = boost::intrusive_ptr<Node>;
+  struct Leaf;
+  struct Inner;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentMap() = default;
+  explicit PersistentMap(const Hash& hash, const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  /// O(1), shares the structure with `other`
+  PersistentMap(const PersistentMap& other) = default;
+  PersistentMap(PersistentMap&& other) noexcept
+      : root_(std::move(other.root_)),
+        size_(std::exchange(other.size_, 0)),
+        hash_(std::move(other.hash_)),
+        equal_(std::move(other.equal_)) {}
+
+  PersistentMap& operator=(const PersistentMap& other) = default;
+  PersistentMap& operator=(PersistentMap&& other) noexcept {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    return *this;
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept { return const_iterator{}; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_iterator find(const Key& key) const;
+  size_type count(const Key& key) const { return find(key) != end() ? 1 : 0; }
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const {
+    const auto it = find(key);
+    if (it == end()) throw std::out_of_range("PersistentMap::at");
+    return it->second;
+  }
+
+  /// Adds the key/value or rewrites the value of an existing key
+  /// @returns true if the key is a new one
+  bool insert_or_assign(Key key, Value value);
+
+  /// Adds the key/value if there is no such key
+  /// @returns true if the element was inserted
+  bool insert(value_type value);
+
+  /// @returns the number of removed elements, 0 or 1
+  size_type erase(const Key& key);
+
+  void clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+  void swap(PersistentMap& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+  }
+
+  friend bool operator==(const PersistentMap& lhs, const PersistentMap& rhs) {
+    if (lhs.size_ != rhs.size_) return false;
+    if (lhs.root_ == rhs.root_) return true;
+    for (const auto& [key, value] : lhs) {
+      const auto it = rhs.find(key);
+      if (it == rhs.end() || !(it->second == value)) return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const PersistentMap& lhs, const PersistentMap& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  static constexpr std::size_t kBits = 5;
+  static constexpr std::size_t kHashBits =
+      std::numeric_limits<std::size_t>::digits;
+  // Branches on all the hash bits, then a collision node
+  static constexpr std::size_t kMaxDepth = (kHashBits + kBits - 1) / kBits + 1;
+
+  enum class Kind : std::uint8_t { kLeaf, kBranch, kCollision };
+
+  struct Node {
+    explicit Node(Kind kind) noexcept : kind(kind) {}
+
+    bool IsShared() const noexcept {
+      return refs.load(std::memory_order_acquire) != 1;
+    }
+
+    friend void intrusive_ptr_add_ref(Node* node) noexcept {
+      node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    friend void intrusive_ptr_release(Node* node) noexcept {
+      if (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+      if (node->kind == Kind::kLeaf) {
+        delete static_cast<Leaf*>(node);
+      } else {
+        Inner::Destroy(static_cast<Inner*>(node));
+      }
+    }
+
+    std::atomic<std::uint32_t> refs{0};
+    const Kind kind;
+  };
+
+  struct Leaf final : Node {
+    template <typename... Args>
+    Leaf(std::size_t hash, Args&&... args)
+        : Node(Kind::kLeaf), hash(hash), value(std::forward<Args>(args)...) {}
+
+    const std::size_t hash;
+    const value_type value;
+  };
+
+  // A branch indexes the children by 5 bits of the hash, a collision node
+  // keeps the leaves with equal hashes. Never empty. The children are stored
+  // right after the node, that saves an indirection per level on lookups.
+  struct Inner final : Node {
+    static NodePtr Make(Kind kind, std::size_t capacity) {
+      static_assert(sizeof(Inner) % alignof(NodePtr) == 0);
+      void* storage =
+          ::operator new(sizeof(Inner) + capacity * sizeof(NodePtr));
+      return NodePtr{new (storage) Inner(kind, capacity)};
+    }
+
+    static NodePtr Copy(const Inner& other, std::size_t capacity) {
+      UASSERT(capacity >= other.size);
+      auto result = Make(other.kind, capacity);
+      auto& inner = static_cast<Inner&>(*result);
+      inner.bitmap = other.bitmap;
+      inner.hash = other.hash;
+      for (const auto& child : other) inner.PushBack(child);
+      return result;
+    }
+
+    static void Destroy(Inner* node) noexcept {
+      node->~Inner();
+      ::operator delete(node);
+    }
+
+    NodePtr* begin() noexcept { return reinterpret_cast<NodePtr*>(this + 1); }
+    NodePtr* end() noexcept { return begin() + size; }
+    const NodePtr* begin() const noexcept {
+      return reinterpret_cast<const NodePtr*>(this + 1);
+    }
+    const NodePtr* end() const noexcept { return begin() + size; }
+
+    NodePtr& operator[](std::size_t index) noexcept { return begin()[index]; }
+    const NodePtr& operator[](std::size_t index) const noexcept {
+      return begin()[index];
+    }
+
+    void PushBack(NodePtr child) noexcept {
+      UASSERT(size < capacity);
+      new (end()) NodePtr(std::move(child));
+      ++size;
+    }
+
+    void Insert(std::size_t position, NodePtr child) noexcept {
+      UASSERT(position <= size);
+      PushBack(std::move(child));
+      std::rotate(begin() + position, end() - 1, end());
+    }
+
+    void Erase(std::size_t position) noexcept {
+      UASSERT(position < size);
+      std::move(begin() + position + 1, end(), begin() + position);
+      --size;
+      end()->~NodePtr();
+    }
+
+    std::uint32_t bitmap{0};
+    std::uint32_t size{0};
+    const std::uint32_t capacity;
+    std::size_t hash{0};
+
+   private:
+    Inner(Kind kind, std::size_t capacity) noexcept
+        : Node(kind), capacity(capacity) {}
+
+    ~Inner() {
+      for (auto& child : *this) child.~NodePtr();
+    }
+  };
+
+  static std::size_t GetHashOf(const Node& node) noexcept {
+    UASSERT(node.kind != Kind::kBranch);
+    return node.kind == Kind::kLeaf ? static_cast<const Leaf&>(node).hash
+                                    : static_cast<const Inner&>(node).hash;
+  }
+
+  static std::uint32_t GetBit(std::size_t hash, std::size_t shift) noexcept {
+    return std::uint32_t{1} << ((hash >> shift) & ((1 << kBits) - 1));
+  }
+
+  static std::size_t GetPosition(std::uint32_t bitmap,
+                                 std::uint32_t bit) noexcept {
+    return __builtin_popcount(bitmap & (bit - 1));
+  }
+
+  // Copies the node if it is shared with other maps
+  static Inner& Detach(NodePtr& node) {
+    UASSERT(node && node->kind != Kind::kLeaf);
+    if (node->IsShared()) {
+      const auto& inner = static_cast<const Inner&>(*node);
+      node = Inner::Copy(inner, inner.size);
+    }
+    return static_cast<Inner&>(*node);
+  }
+
+  // Copies the node if it is shared or full
+  static void InsertChild(NodePtr& node, std::size_t position, NodePtr child) {
+    UASSERT(node && node->kind != Kind::kLeaf);
+    const auto& inner = static_cast<const Inner&>(*node);
+    if (node->IsShared()) {
+      node = Inner::Copy(inner, inner.size + 1);
+    } else if (inner.size == inner.capacity) {
+      // Grow geometrically to amortize the insertions into an owned node
+      auto capacity = std::size_t{inner.size} * 2;
+      if (inner.kind == Kind::kBranch) {
+        capacity = std::min(capacity, std::size_t{1} << kBits);
+      }
+      node = Inner::Copy(inner, capacity);
+    }
+    static_cast<Inner&>(*node).Insert(position, std::move(child));
+  }
+
+  static NodePtr MakeBranch(NodePtr a, NodePtr b, std::size_t shift);
+
+  template <bool kAssign>
+  bool DoInsert(NodePtr& node, std::size_t shift, std::size_t hash, Key&& key,
+                Value&& value);
+
+  void DoErase(NodePtr& node, std::size_t shift, std::size_t hash,
+               const Key& key);
+
+  NodePtr root_;
+  size_type size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+/// @brief Forward iterator over the elements of cache::PersistentMap
+///
+/// Any modification of the map invalidates its iterators, the iterators of
+/// the other copies stay valid.
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename PersistentMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() noexcept = default;
+
+  reference operator*() const noexcept {
+    UASSERT(leaf_);
+    return leaf_->value;
+  }
+  pointer operator->() const noexcept { return &**this; }
+
+  const_iterator& operator++() noexcept {
+    UASSERT(leaf_);
+
+    // The path to the current leaf is restored by its hash rather than stored
+    // in the iterator, that keeps find() cheap
+    struct Frame {
+      const Inner* node;
+      std::size_t index;
+    };
+    std::array<Frame, kMaxDepth> path;
+    std::size_t depth = 0;
+    std::size_t shift = 0;
+
+    for (const Node* node = root_; node != leaf_; shift += kBits) {
+      const auto& inner = static_cast<const Inner&>(*node);
+      std::size_t index = 0;
+      if (inner.kind == Kind::kBranch) {
+        index = GetPosition(inner.bitmap, GetBit(leaf_->hash, shift));
+      } else {
+        while (inner[index].get() != leaf_) ++index;
+      }
+      UASSERT(depth < path.size() && index < inner.size);
+      path[depth++] = Frame{&inner, index};
+      node = inner[index].get();
+    }
+
+    while (depth > 0) {
+      auto& frame = path[depth - 1];
+      if (++frame.index < frame.node->size) {
+        leaf_ = GetFirstLeaf((*frame.node)[frame.index].get());
+        return *this;
+      }
+      --depth;
+    }
+    leaf_ = nullptr;
+    return *this;
+  }
+
+  const_iterator operator++(int) noexcept {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return leaf_ == other.leaf_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return leaf_ != other.leaf_;
+  }
+
+ private:
+  friend class PersistentMap;
+
+  const_iterator(const Node* root, const Leaf* leaf) noexcept
+      : root_(root), leaf_(leaf) {}
+
+  static const Leaf* GetFirstLeaf(const Node* node) noexcept {
+    while (node->kind != Kind::kLeaf) {
+      node = static_cast<const Inner&>(*node)[0].get();
+    }
+    return static_cast<const Leaf*>(node);
+  }
+
+  const Node* root_{nullptr};
+  const Leaf* leaf_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::begin() const noexcept
+    -> const_iterator {
+  if (!root_) return end();
+  return const_iterator{root_.get(), const_iterator::GetFirstLeaf(root_.get())};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::find(const Key& key) const
+    -> const_iterator {
+  const std::size_t hash = hash_(key);
+  const Node* node = root_.get();
+
+  for (std::size_t shift = 0; node; shift += kBits) {
+    switch (node->kind) {
+      case Kind::kLeaf: {
+        const auto& leaf = static_cast<const Leaf&>(*node);
+        if (leaf.hash != hash || !equal_(leaf.value.first, key)) return end();
+        return const_iterator{root_.get(), &leaf};
+      }
+      case Kind::kBranch: {
+        const auto& branch = static_cast<const Inner&>(*node);
+        const auto bit = GetBit(hash, shift);
+        if (!(branch.bitmap & bit)) return end();
+        node = branch[GetPosition(branch.bitmap, bit)].get();
+        break;
+      }
+      case Kind::kCollision: {
+        const auto& collision = static_cast<const Inner&>(*node);
+        if (collision.hash != hash) return end();
+        for (const auto& child : collision) {
+          const auto& leaf = static_cast<const Leaf&>(*child);
+          if (equal_(leaf.value.first, key)) {
+            return const_iterator{root_.get(), &leaf};
+          }
+        }
+        return end();
+      }
+    }
+  }
+  return end();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::insert_or_assign(Key key,
+                                                              Value value) {
+  const std::size_t hash = hash_(key);
+  const bool inserted =
+      DoInsert<true>(root_, 0, hash, std::move(key), std::move(value));
+  if (inserted) ++size_;
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::insert(value_type value) {
+  const std::size_t hash = hash_(value.first);
+  Key key = value.first;
+  const bool inserted =
+      DoInsert<false>(root_, 0, hash, std::move(key), std::move(value.second));
+  if (inserted) ++size_;
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::erase(const Key& key)
+    -> size_type {
+  // The path is copied only if there is something to erase
+  if (find(key) == end()) return 0;
+  DoErase(root_, 0, hash_(key), key);
+  --size_;
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::MakeBranch(NodePtr a, NodePtr b,
+                                                        std::size_t shift)
+    -> NodePtr {
+  const auto hash_a = GetHashOf(*a);
+  const auto hash_b = GetHashOf(*b);
+  UASSERT(hash_a != hash_b);
+  UASSERT(shift < kHashBits);
+
+  const auto bit_a = GetBit(hash_a, shift);
+  const auto bit_b = GetBit(hash_b, shift);
+  if (bit_a == bit_b) {
+    auto result = Inner::Make(Kind::kBranch, 1);
+    auto& branch = static_cast<Inner&>(*result);
+    branch.bitmap = bit_a;
+    branch.PushBack(MakeBranch(std::move(a), std::move(b), shift + kBits));
+    return result;
+  }
+
+  auto result = Inner::Make(Kind::kBranch, 2);
+  auto& branch = static_cast<Inner&>(*result);
+  branch.bitmap = bit_a | bit_b;
+  if (bit_a < bit_b) {
+    branch.PushBack(std::move(a));
+    branch.PushBack(std::move(b));
+  } else {
+    branch.PushBack(std::move(b));
+    branch.PushBack(std::move(a));
+  }
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <bool kAssign>
+bool PersistentMap<Key, Value, Hash, Equal>::DoInsert(NodePtr& node,
+                                                      std::size_t shift,
+                                                      std::size_t hash,
+                                                      Key&& key,
+                                                      Value&& value) {
+  if (!node) {
+    node = NodePtr{new Leaf(hash, std::move(key), std::move(value))};
+    return true;
+  }
+
+  switch (node->kind) {
+    case Kind::kLeaf: {
+      const auto& leaf = static_cast<const Leaf&>(*node);
+      if (leaf.hash == hash && equal_(leaf.value.first, key)) {
+        // Leaves are immutable and may be shared, replace the whole leaf
+        if (kAssign) {
+          node = NodePtr{new Leaf(hash, std::move(key), std::move(value))};
+        }
+        return false;
+      }
+
+      NodePtr new_leaf{new Leaf(hash, std::move(key), std::move(value))};
+      if (leaf.hash == hash) {
+        auto collision = Inner::Make(Kind::kCollision, 2);
+        auto& inner = static_cast<Inner&>(*collision);
+        inner.hash = hash;
+        inner.PushBack(std::move(node));
+        inner.PushBack(std::move(new_leaf));
+        node = std::move(collision);
+      } else {
+        node = MakeBranch(std::move(node), std::move(new_leaf), shift);
+      }
+      return true;
+    }
+
+    case Kind::kBranch: {
+      const auto bitmap = static_cast<const Inner&>(*node).bitmap;
+      const auto bit = GetBit(hash, shift);
+      const auto position = GetPosition(bitmap, bit);
+      if (!(bitmap & bit)) {
+        InsertChild(node, position,
+                    NodePtr{new Leaf(hash, std::move(key), std::move(value))});
+        static_cast<Inner&>(*node).bitmap |= bit;
+        return true;
+      }
+      return DoInsert<kAssign>(Detach(node)[position], shift + kBits, hash,
+                               std::move(key), std::move(value));
+    }
+
+    case Kind::kCollision: {
+      if (static_cast<const Inner&>(*node).hash != hash) {
+        NodePtr new_leaf{new Leaf(hash, std::move(key), std::move(value))};
+        node = MakeBranch(std::move(node), std::move(new_leaf), shift);
+        return true;
+      }
+
+      const auto& collision = static_cast<const Inner&>(*node);
+      for (std::size_t i = 0; i < collision.size; ++i) {
+        if (equal_(static_cast<const Leaf&>(*collision[i]).value.first, key)) {
+          if (kAssign) {
+            Detach(node)[i] =
+                NodePtr{new Leaf(hash, std::move(key), std::move(value))};
+          }
+          return false;
+        }
+      }
+      InsertChild(node, collision.size,
+                  NodePtr{new Leaf(hash, std::move(key), std::move(value))});
+      return true;
+    }
+  }
+
+  UASSERT_MSG(false, "Unexpected PersistentMap node kind");
+  return false;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentMap<Key, Value, Hash, Equal>::DoErase(NodePtr& node,
+                                                     std::size_t shift,
+                                                     std::size_t hash,
+                                                     const Key& key) {
+  UASSERT(node);
+
+  switch (node->kind) {
+    case Kind::kLeaf:
+      node.reset();
+      return;
+
+    case Kind::kBranch: {
+      auto& branch = Detach(node);
+      const auto bit = GetBit(hash, shift);
+      UASSERT(branch.bitmap & bit);
+      const auto position = GetPosition(branch.bitmap, bit);
+
+      auto& child = branch[position];
+      DoErase(child, shift + kBits, hash, key);
+      if (!child) {
+        branch.Erase(position);
+        branch.bitmap &= ~bit;
+      }
+
+      // Pull up a lone leaf or collision node, they are found by the hash
+      // at any depth
+      if (branch.size == 0) {
+        node.reset();
+      } else if (branch.size == 1 && branch[0]->kind != Kind::kBranch) {
+        node = NodePtr{branch[0]};
+      }
+      return;
+    }
+
+    case Kind::kCollision: {
+      auto& collision = Detach(node);
+      for (std::size_t i = 0; i < collision.size; ++i) {
+        const auto& leaf = static_cast<const Leaf&>(*collision[i]);
+        if (!equal_(leaf.value.first, key)) continue;
+
+        if (collision.size == 2) {
+          node = NodePtr{collision[1 - i]};
+        } else {
+          collision.Erase(i);
+        }
+        return;
+      }
+      UASSERT_MSG(false, "Erasing a missing PersistentMap key");
+      return;
+    }
+  }
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
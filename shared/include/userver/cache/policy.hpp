@@ -0,0 +1,25 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Replacement policy of cache::LruMap and cache::LruSet
+enum class CachePolicy {
+  /// Evicts the least recently used element
+  kLRU,
+
+  /// W-TinyLFU: new elements get into a small LRU window; an element leaving
+  /// the window replaces the eviction candidate of the main segmented LRU
+  /// only if it was accessed more often, according to a count-min sketch.
+  /// Resists scans over cold keys that would flush the hot elements from an
+  /// LRU.
+  kTinyLFU,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,125 @@
+#pragma once
+
+/// @file userver/formats/json/lazy_value.hpp
+/// @brief @copybrief formats::json::LazyValue
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @ingroup userver_formats
+///
+/// @brief Non-owning on-demand view of a JSON document.
+///
+/// Unlike formats::json::FromString, does not build a DOM: members are located
+/// by skimming over the text on each access, only the accessed scalars are
+/// parsed. Much cheaper than the full parsing if only a few fields of a big
+/// document are needed, e.g. a handler that reads several fields of a request
+/// body. Access the same fields repeatedly or iterate over the whole document
+/// with formats::json::Value instead.
+///
+/// The parts of the document that were skipped over are validated only
+/// structurally, duplicate keys are not detected and the first one wins.
+///
+/// @warning The document must outlive the LazyValue and all the values
+/// obtained from it.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/lazy_value_test.cpp  Sample formats::json::LazyValue usage
+class LazyValue final {
+ public:
+  using DefaultConstructed = Value::DefaultConstructed;
+
+  /// @throw ParseException if the document is empty
+  explicit LazyValue(std::string_view doc);
+
+  /// @brief Access member by key for read.
+  /// @throw TypeMismatchException if not a missing value, an object or null.
+  /// @throw ParseException if the object is malformed.
+  LazyValue operator[](std::string_view key) const;
+
+  /// @brief Access array member by index for read.
+  /// @throw TypeMismatchException if not an array value.
+  /// @throw OutOfBoundsException if index is greater or equal than size.
+  /// @throw ParseException if the array is malformed.
+  LazyValue operator[](std::size_t index) const;
+
+  /// @brief Returns true if *this holds a `key`.
+  /// @throw TypeMismatchException if `*this` is not an object or null.
+  bool HasMember(std::string_view key) const;
+
+  /// @brief Returns array size, object members count, or 0 for null.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  std::size_t GetSize() const;
+
+  /// @brief Returns true if *this holds nothing.
+  bool IsMissing() const noexcept { return raw_.empty(); }
+
+  bool IsNull() const noexcept;
+  bool IsBool() const noexcept;
+  bool IsNumber() const noexcept;
+  bool IsString() const noexcept;
+  bool IsArray() const noexcept;
+  bool IsObject() const noexcept;
+
+  /// @brief Parses *this into formats::json::Value.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  /// @throw ParseException if the value is malformed.
+  Value Materialize() const;
+
+  /// @brief Returns value of *this converted to T.
+  /// @throw Anything derived from std::exception.
+  template <typename T>
+  T As() const {
+    return Materialize().As<T>();
+  }
+
+  /// @brief Returns value of *this converted to T or T(args) if
+  /// this->IsMissing() or this->IsNull().
+  /// @throw Anything derived from std::exception.
+  template <typename T, typename First, typename... Rest>
+  T As(First&& default_arg, Rest&&... more_default_args) const {
+    if (IsMissing() || IsNull()) {
+      // intended raw ctor call, sometimes casts
+      // NOLINTNEXTLINE(google-readability-casting)
+      return T(std::forward<First>(default_arg),
+               std::forward<Rest>(more_default_args)...);
+    }
+    return As<T>();
+  }
+
+  /// @brief Returns value of *this converted to T or T() if
+  /// this->IsMissing() or this->IsNull().
+  /// @note Use as `value.As<T>({})`
+  template <typename T>
+  T As(DefaultConstructed) const {
+    return (IsMissing() || IsNull()) ? T() : As<T>();
+  }
+
+  /// @brief Returns the unparsed JSON text of *this, empty for missing values.
+  std::string_view GetRawJson() const noexcept { return raw_; }
+
+  /// @brief Returns full path to this value.
+  std::string GetPath() const;
+
+ private:
+  LazyValue(std::string_view raw, std::string path) noexcept;
+
+  int GetExtendedType() const;
+  void CheckNotMissing() const;
+
+  std::string_view raw_;
+  std::string path_;
+};
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,346 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+#include <fmt/format.h>
+
+#include <userver/formats/json/parser/array_parser.hpp>
+#include <userver/formats/json/parser/bool_parser.hpp>
+#include <userver/formats/json/parser/int_parser.hpp>
+#include <userver/formats/json/parser/number_parser.hpp>
+#include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/string_parser.hpp>
+#include <userver/formats/json/parser/typed_parser.hpp>
+#include <userver/formats/json/serialize_aggregate.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+template <typename T>
+class AggregateParser;
+
+namespace impl {
+
+// Skips a value of any type, used for the unknown members of the aggregates
+class SkipParser final : public BaseParser {
+ public:
+  void Reset() { depth_ = 0; }
+
+ private:
+  void Null() override;
+  void Bool(bool) override;
+  void Int64(int64_t) override;
+  void Uint64(uint64_t) override;
+  void Double(double) override;
+  void String(std::string_view) override;
+  void StartObject() override;
+  void Key(std::string_view) override;
+  void EndObject() override;
+  void StartArray() override;
+  void EndArray() override;
+
+  std::string GetPathItem() const override { return {}; }
+
+  std::string Expected() const override { return "value"; }
+
+  void MaybePopSelf();
+
+  std::size_t depth_{0};
+};
+
+template <typename T, typename = void>
+struct ParserFor {
+  static_assert(!sizeof(T),
+                "There is no SAX parser for the type. Use one of the types "
+                "supported by formats::json::parser::AggregateParser");
+};
+
+template <>
+struct ParserFor<bool> {
+  using Type = BoolParser;
+};
+
+template <>
+struct ParserFor<std::int32_t> {
+  using Type = Int32Parser;
+};
+
+template <>
+struct ParserFor<std::int64_t> {
+  using Type = Int64Parser;
+};
+
+template <>
+struct ParserFor<float> {
+  using Type = FloatParser;
+};
+
+template <>
+struct ParserFor<double> {
+  using Type = DoubleParser;
+};
+
+template <>
+struct ParserFor<std::string> {
+  using Type = StringParser;
+};
+
+template <>
+struct ParserFor<formats::json::Value> {
+  using Type = JsonValueParser;
+};
+
+template <typename T>
+struct ParserFor<T, std::enable_if_t<json::impl::kIsJsonAggregate<T>>> {
+  using Type = AggregateParser<T>;
+};
+
+// Proxy parser that owns the parser of the items
+template <typename Item>
+class VectorParser final {
+ public:
+  using ItemParser = typename ParserFor<Item>::Type;
+  using ResultType = std::vector<Item>;
+
+  VectorParser() = default;
+  VectorParser(const VectorParser&) = delete;
+  VectorParser& operator=(const VectorParser&) = delete;
+
+  void Reset() { parser_.Reset(); }
+
+  void Subscribe(Subscriber<ResultType>& subscriber) {
+    parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return parser_.GetParser(); }
+
+ private:
+  ItemParser item_parser_;
+  ArrayParser<Item, ItemParser> parser_{item_parser_};
+};
+
+template <typename Item>
+struct ParserFor<std::vector<Item>> {
+  using Type = VectorParser<Item>;
+};
+
+// Proxy parser of the std::optional fields: null leaves the field empty, any
+// other value is passed to the parser of the underlying type
+template <typename Item>
+class OptionalParser final : public BaseParser {
+ public:
+  using ItemParser = typename ParserFor<Item>::Type;
+
+  OptionalParser() = default;
+  OptionalParser(const OptionalParser&) = delete;
+  OptionalParser& operator=(const OptionalParser&) = delete;
+
+  void Reset() { item_parser_.Reset(); }
+
+  void Subscribe(Subscriber<Item>& subscriber) {
+    item_parser_.Subscribe(subscriber);
+  }
+
+  BaseParser& GetParser() { return *this; }
+
+ private:
+  void Null() override { parser_state_->PopMe(*this); }
+  void Bool(bool value) override { PushItemParser().Bool(value); }
+  void Int64(int64_t value) override { PushItemParser().Int64(value); }
+  void Uint64(uint64_t value) override { PushItemParser().Uint64(value); }
+  void Double(double value) override { PushItemParser().Double(value); }
+  void String(std::string_view value) override {
+    PushItemParser().String(value);
+  }
+  void StartObject() override { PushItemParser().StartObject(); }
+  void StartArray() override { PushItemParser().StartArray(); }
+
+  std::string GetPathItem() const override { return {}; }
+
+  std::string Expected() const override { return "value or null"; }
+
+  BaseParser& PushItemParser() {
+    parser_state_->PopMe(*this);
+    BaseParser& parser = item_parser_.GetParser();
+    parser_state_->PushParser(parser);
+    return parser;
+  }
+
+  ItemParser item_parser_;
+};
+
+// std::optional fields may be missing or null
+template <typename Field>
+struct FieldTraits {
+  using Parser = typename ParserFor<Field>::Type;
+  using Sink = SubscriberSink<Field>;
+};
+
+template <typename Field>
+struct FieldTraits<std::optional<Field>> {
+  using Parser = OptionalParser<Field>;
+  using Sink = SubscriberSinkOptional<Field>;
+};
+
+template <typename T, std::size_t... Indices>
+auto MakeFieldParsers(std::index_sequence<Indices...>) -> std::tuple<
+    typename FieldTraits<boost::pfr::tuple_element_t<Indices, T>>::Parser...>;
+
+template <typename T, std::size_t... Indices>
+auto MakeFieldSinks(T& value, std::index_sequence<Indices...>) {
+  return std::tuple<typename FieldTraits<
+      boost::pfr::tuple_element_t<Indices, T>>::Sink...>(
+      boost::pfr::get<Indices>(value)...);
+}
+
+}  // namespace impl
+
+/// @brief SAX parser for the aggregates with formats::json::AggregateFields
+/// specialized.
+///
+/// Parses the aggregate directly from the JSON text without building a
+/// formats::json::Value. The fields could be of `bool`, `std::int32_t`,
+/// `std::int64_t`, `float`, `double`, `std::string`, formats::json::Value
+/// types, other such aggregates, `std::vector` and `std::optional` of those.
+/// All the fields except the `std::optional` ones are required, the
+/// `std::optional` ones may also be `null`.
+///
+/// @see formats::json::parser::ParseToType
+template <typename T>
+class AggregateParser final : public TypedParser<T> {
+ public:
+  AggregateParser() { SubscribeFields(FieldIndices{}); }
+
+  AggregateParser(const AggregateParser&) = delete;
+  AggregateParser& operator=(const AggregateParser&) = delete;
+
+  void Reset() override {
+    state_ = State::kStart;
+    result_ = T{};
+    seen_.reset();
+  }
+
+ private:
+  static constexpr std::size_t kSize = boost::pfr::tuple_size_v<T>;
+  using FieldIndices = std::make_index_sequence<kSize>;
+
+  static constexpr const auto& kNames = AggregateFields<T>::kNames;
+
+  void StartObject() override {
+    if (state_ != State::kStart) this->Throw("object");
+    state_ = State::kInside;
+  }
+
+  void Key(std::string_view key) override {
+    UASSERT(state_ == State::kInside);
+
+    field_ = 0;
+    while (field_ < kSize && kNames[field_] != key) ++field_;
+
+    if (field_ == kSize) {
+      unknown_key_ = key;
+      skip_parser_.Reset();
+      this->parser_state_->PushParser(skip_parser_);
+      return;
+    }
+
+    seen_.set(field_);
+    PushField(FieldIndices{});
+  }
+
+  void EndObject() override {
+    UASSERT(state_ == State::kInside);
+    CheckRequiredFields(FieldIndices{});
+    this->SetResult(std::move(result_));
+  }
+
+  std::string Expected() const override { return "object"; }
+
+  std::string GetPathItem() const override {
+    if (state_ != State::kInside) return {};
+    return field_ == kSize ? unknown_key_ : std::string{kNames[field_]};
+  }
+
+  template <std::size_t... Indices>
+  void SubscribeFields(std::index_sequence<Indices...>) {
+    (std::get<Indices>(parsers_).Subscribe(std::get<Indices>(sinks_)), ...);
+  }
+
+  template <std::size_t... Indices>
+  void PushField(std::index_sequence<Indices...>) {
+    ((field_ == Indices && (PushParser(std::get<Indices>(parsers_)), true)) ||
+     ...);
+  }
+
+  template <typename Parser>
+  void PushParser(Parser& parser) {
+    parser.Reset();
+    this->parser_state_->PushParser(parser.GetParser());
+  }
+
+  template <std::size_t... Indices>
+  void CheckRequiredFields(std::index_sequence<Indices...>) const {
+    (CheckRequiredField<Indices>(), ...);
+  }
+
+  template <std::size_t Index>
+  void CheckRequiredField() const {
+    using Field = boost::pfr::tuple_element_t<Index, T>;
+    if (!meta::kIsOptional<Field> && !seen_.test(Index)) {
+      throw InternalParseError(fmt::format(
+          "field '{}' was expected, but '}}' found", kNames[Index]));
+    }
+  }
+
+  enum class State {
+    kStart,
+    kInside,
+  };
+
+  State state_{State::kStart};
+  std::size_t field_{0};
+  std::string unknown_key_;
+  std::bitset<kSize> seen_;
+  T result_{};
+  decltype(impl::MakeFieldSinks(result_, FieldIndices{})) sinks_{
+      impl::MakeFieldSinks(result_, FieldIndices{})};
+  decltype(impl::MakeFieldParsers<T>(FieldIndices{})) parsers_;
+  impl::SkipParser skip_parser_;
+};
+
+/// @brief Parses the JSON `input` into T without building a
+/// formats::json::Value.
+///
+/// T is an aggregate with formats::json::AggregateFields specialized, a
+/// `std::vector` of those or any other type supported by
+/// formats::json::parser::AggregateParser.
+template <typename T>
+T ParseToType(std::string_view input) {
+  T result{};
+  typename impl::ParserFor<T>::Type parser;
+  parser.Reset();
+  SubscriberSink<T> sink(result);
+  parser.Subscribe(sink);
+
+  ParserState state;
+  state.PushParser(parser.GetParser());
+  state.ProcessInput(input);
+
+  return result;
+}
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
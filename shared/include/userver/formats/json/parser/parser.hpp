@@ -1,5 +1,6 @@
 #pragma once
 
+#include <userver/formats/json/parser/aggregate_parser.hpp>
 #include <userver/formats/json/parser/array_parser.hpp>
 #include <userver/formats/json/parser/bool_parser.hpp>
 #include <userver/formats/json/parser/int_parser.hpp>
@@ -18,11 +18,31 @@ namespace logging {
 class LogHelper;
 }  // namespace logging
 
+namespace utils {
+class MonotonicArena;
+}  // namespace utils
+
 namespace formats::json {
 
 /// Parse JSON from string
 formats::json::Value FromString(std::string_view doc);
 
+/// @brief Parse JSON from string, all the nodes and strings of the document
+/// are allocated from a memory pool that is freed in one step with the last
+/// copy of the returned value.
+///
+/// Parsing and destruction of big documents are noticeably faster than with
+/// FromString. formats::json::ValueBuilder copies such values to the heap.
+formats::json::Value FromStringPooled(std::string_view doc);
+
+/// @brief Parse JSON from string, all the nodes and strings of the document
+/// are allocated from `arena`, e.g. from the per-request arena
+/// server::http::HttpRequest::GetArena().
+///
+/// @warning `arena` must outlive the returned value and all its copies.
+formats::json::Value FromStringPooled(std::string_view doc,
+                                      utils::MonotonicArena& arena);
+
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
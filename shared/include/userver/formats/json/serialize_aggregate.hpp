@@ -0,0 +1,130 @@
+#pragma once
+
+/// @file userver/formats/json/serialize_aggregate.hpp
+/// @brief Serializers and parsers for aggregates with declared field names.
+/// @ingroup userver_formats_serialize userver_formats_parse
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+#include <userver/formats/serialize/to.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @brief JSON names of the aggregate fields.
+///
+/// To get the JSON Serialize, Parse and WriteToStream for an aggregate and to
+/// be able to parse it with formats::json::parser::AggregateParser, specialize
+/// the template in the global namespace and list the names in the order of the
+/// fields declaration:
+///
+/// @code
+/// template <>
+/// struct formats::json::AggregateFields<MyStruct> {
+///   static constexpr std::string_view kNames[] = {"id", "name", "tags"};
+/// };
+/// @endcode
+///
+/// The `std::optional` fields are omitted from the output if empty and may be
+/// missing in the input. Unknown members of the input are ignored.
+template <typename T>
+struct AggregateFields {};
+
+namespace impl {
+
+template <typename T>
+using AggregateFieldNames = decltype(AggregateFields<T>::kNames);
+
+template <typename T>
+constexpr bool IsJsonAggregate() {
+  if constexpr (meta::kIsDetected<AggregateFieldNames, T>) {
+    static_assert(std::is_aggregate_v<T>,
+                  "formats::json::AggregateFields is specialized for a type "
+                  "that is not an aggregate");
+    static_assert(
+        std::size(AggregateFields<T>::kNames) == boost::pfr::tuple_size_v<T>,
+        "formats::json::AggregateFields should list the names of all the "
+        "fields of the aggregate");
+    return true;
+  } else {
+    return false;
+  }
+}
+
+template <typename T>
+inline constexpr bool kIsJsonAggregate = IsJsonAggregate<T>();
+
+template <typename Field>
+bool IsFieldEmpty(const Field& field) {
+  if constexpr (meta::kIsOptional<Field>) {
+    return !field.has_value();
+  } else {
+    return false;
+  }
+}
+
+template <typename T, std::size_t... Indices>
+T ParseAggregate(const formats::json::Value& value,
+                 std::index_sequence<Indices...>) {
+  // Initialization is guaranteed to occur left-to-right in brace-init
+  return T{value[AggregateFields<T>::kNames[Indices]]
+               .template As<boost::pfr::tuple_element_t<Indices, T>>()...};
+}
+
+}  // namespace impl
+
+/// Aggregates serialization into formats::json::Value
+template <typename T>
+std::enable_if_t<impl::kIsJsonAggregate<T>, Value> Serialize(
+    const T& value, serialize::To<Value>) {
+  ValueBuilder builder{formats::common::Type::kObject};
+  boost::pfr::for_each_field(
+      value, [&builder](const auto& field, std::size_t index) {
+        if (impl::IsFieldEmpty(field)) return;
+        builder[std::string{AggregateFields<T>::kNames[index]}] = field;
+      });
+  return builder.ExtractValue();
+}
+
+/// Aggregates serialization into formats::json::StringBuilder without building
+/// a formats::json::Value
+template <typename T>
+std::enable_if_t<impl::kIsJsonAggregate<T>> WriteToStream(const T& value,
+                                                          StringBuilder& sw) {
+  StringBuilder::ObjectGuard guard{sw};
+  boost::pfr::for_each_field(value, [&sw](const auto& field,
+                                          std::size_t index) {
+    if (impl::IsFieldEmpty(field)) return;
+    sw.Key(AggregateFields<T>::kNames[index]);
+    WriteToStream(field, sw);
+  });
+}
+
+/// Aggregates parsing from formats::json::Value
+template <typename T>
+std::enable_if_t<impl::kIsJsonAggregate<T>, T> Parse(const Value& value,
+                                                     parse::To<T>) {
+  value.CheckObject();
+  return impl::ParseAggregate<T>(
+      value, std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
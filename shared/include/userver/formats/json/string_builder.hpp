@@ -3,6 +3,7 @@
 /// @file userver/formats/json/string_builder.hpp
 /// @brief @copybrief formats::json::StringBuilder
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -66,6 +67,17 @@ class StringBuilder final : public serialize::SaxStream {
   /// @return JSON string
   std::string GetString() const;
 
+  /// @return Size of the JSON written since the construction or the last
+  /// ExtractString() call
+  std::size_t GetSize() const;
+
+  /// @brief Returns the JSON written since the construction or the last
+  /// ExtractString() call and clears it.
+  ///
+  /// The following writes continue the same document, which allows sending a
+  /// big document in parts while it is being built.
+  std::string ExtractString();
+
   void WriteNull();
   void WriteString(std::string_view value);
   void WriteBool(bool value);
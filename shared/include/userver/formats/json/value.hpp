@@ -21,6 +21,10 @@ namespace logging {
 class LogHelper;
 }  // namespace logging
 
+namespace utils {
+class MonotonicArena;
+}  // namespace utils
+
 namespace formats::json {
 namespace impl {
 class InlineObjectBuilder;
@@ -270,6 +274,9 @@ class Value final {
   friend class impl::StringBuffer;
 
   friend formats::json::Value FromString(std::string_view);
+  friend formats::json::Value FromStringPooled(std::string_view);
+  friend formats::json::Value FromStringPooled(std::string_view,
+                                               utils::MonotonicArena&);
   friend formats::json::Value FromStream(std::istream&);
   friend void Serialize(const formats::json::Value&, std::ostream&);
   friend std::string ToString(const formats::json::Value&);
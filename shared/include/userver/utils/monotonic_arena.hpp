@@ -0,0 +1,143 @@
+#pragma once
+
+/// @file userver/utils/monotonic_arena.hpp
+/// @brief @copybrief utils::MonotonicArena
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_containers
+///
+/// @brief Monotonic memory arena: allocations just bump a pointer, memory is
+/// released all at once on destruction.
+///
+/// Useful for many small short-lived allocations with a common lifetime, e.g.
+/// for the containers of a single request. The arena is not thread-safe.
+///
+/// @see utils::ArenaAllocator
+class MonotonicArena final {
+ public:
+  /// Arena that takes all the memory from the heap
+  MonotonicArena() noexcept;
+
+  /// Arena that serves the first allocations from `initial_buffer`, the buffer
+  /// must outlive the arena
+  MonotonicArena(void* initial_buffer, std::size_t size) noexcept;
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  ~MonotonicArena();
+
+  /// @brief Returns a memory chunk of `size` bytes aligned by `alignment`.
+  /// The chunk is valid until Release() or the arena destruction.
+  /// @throws std::bad_alloc
+  void* Allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /// Frees all the heap blocks, the initial buffer is reused
+  void Release() noexcept;
+
+  /// @returns Sum of the sizes of all the allocations since the last Release()
+  std::size_t GetAllocatedBytes() const noexcept { return allocated_bytes_; }
+
+  /// @returns Count of blocks taken from the heap since the last Release()
+  std::size_t GetHeapBlocksCount() const noexcept { return heap_blocks_count_; }
+
+ private:
+  struct BlockHeader;
+
+  void* AllocateSlow(std::size_t size, std::size_t alignment);
+
+  std::byte* const initial_buffer_;
+  const std::size_t initial_size_;
+
+  std::byte* current_;
+  std::byte* end_;
+  BlockHeader* heap_blocks_{nullptr};
+  std::size_t next_block_size_;
+  std::size_t heap_blocks_count_{0};
+  std::size_t allocated_bytes_{0};
+};
+
+inline void* MonotonicArena::Allocate(std::size_t size,
+                                      std::size_t alignment) {
+  UASSERT_MSG(alignment && !(alignment & (alignment - 1)),
+              "alignment must be a power of 2");
+  void* ptr = current_;
+  auto space = static_cast<std::size_t>(end_ - current_);
+  if (ptr && std::align(alignment, size, ptr, space)) {
+    current_ = static_cast<std::byte*>(ptr) + size;
+    allocated_bytes_ += size;
+    return ptr;
+  }
+  return AllocateSlow(size, alignment);
+}
+
+/// @ingroup userver_containers
+///
+/// @brief Standard allocator that takes memory from utils::MonotonicArena.
+///
+/// Deallocation is a no-op, the memory is reclaimed with the arena. A
+/// default constructed allocator has no arena and works as std::allocator, so
+/// that containers with such allocators may still be used outside of the arena
+/// scope.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator() noexcept = default;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (!arena_) return std::allocator<T>{}.allocate(n);
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    if (!arena_) std::allocator<T>{}.deallocate(p, n);
+  }
+
+  MonotonicArena* GetArena() const noexcept { return arena_; }
+
+ private:
+  MonotonicArena* arena_{nullptr};
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs,
+                const ArenaAllocator<U>& rhs) noexcept {
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs,
+                const ArenaAllocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,87 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <algorithm>
+#include <limits>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+constexpr std::size_t kDepth = 4;
+constexpr std::uint8_t kMaxCount = 15;
+constexpr std::size_t kMinWidth = 16;
+constexpr std::size_t kSampleFactor = 10;
+
+constexpr std::uint64_t kSeeds[kDepth] = {
+    0x9E3779B97F4A7C15ULL,
+    0xC2B2AE3D27D4EB4FULL,
+    0x165667B19E3779F9ULL,
+    0xD6E8FEB86659FD93ULL,
+};
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(std::size_t capacity) {
+  SetCapacity(capacity);
+}
+
+void FrequencySketch::SetCapacity(std::size_t capacity) {
+  std::size_t width = kMinWidth;
+  std::size_t width_bits = 4;
+  while (width < capacity) {
+    width *= 2;
+    ++width_bits;
+  }
+
+  counters_.assign(kDepth * width, 0);
+  width_shift_ = std::numeric_limits<std::uint64_t>::digits - width_bits;
+  sample_size_ = kSampleFactor * std::max(capacity, std::size_t{1});
+  additions_ = 0;
+}
+
+void FrequencySketch::Increment(std::size_t hash) noexcept {
+  std::size_t indexes[kDepth];
+  std::uint8_t min = kMaxCount;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    indexes[row] = GetIndex(hash, row);
+    min = std::min(min, counters_[indexes[row]]);
+  }
+  if (min == kMaxCount) return;
+
+  // Conservative update: only the smallest counters are incremented
+  for (const auto index : indexes) {
+    if (counters_[index] == min) ++counters_[index];
+  }
+  if (++additions_ >= sample_size_) Age();
+}
+
+std::uint32_t FrequencySketch::Estimate(std::size_t hash) const noexcept {
+  std::uint8_t min = kMaxCount;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    min = std::min(min, counters_[GetIndex(hash, row)]);
+  }
+  return min;
+}
+
+void FrequencySketch::Clear() noexcept {
+  std::fill(counters_.begin(), counters_.end(), 0);
+  additions_ = 0;
+}
+
+std::size_t FrequencySketch::GetIndex(std::size_t hash,
+                                      std::size_t row) const noexcept {
+  const auto width = counters_.size() / kDepth;
+  const auto mixed = (static_cast<std::uint64_t>(hash) + row) * kSeeds[row];
+  return row * width + ((mixed ^ (mixed >> 29)) >> width_shift_);
+}
+
+void FrequencySketch::Age() noexcept {
+  for (auto& counter : counters_) counter /= 2;
+  additions_ /= 2;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
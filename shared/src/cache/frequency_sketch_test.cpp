@@ -0,0 +1,47 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using cache::impl::FrequencySketch;
+
+TEST(FrequencySketch, Estimate) {
+  FrequencySketch sketch(100);
+  EXPECT_EQ(0, sketch.Estimate(42));
+
+  for (int i = 0; i < 5; ++i) sketch.Increment(42);
+  EXPECT_EQ(5, sketch.Estimate(42));
+  EXPECT_LE(sketch.Estimate(43), 1);
+}
+
+TEST(FrequencySketch, Saturation) {
+  FrequencySketch sketch(100);
+  for (int i = 0; i < 100; ++i) sketch.Increment(1);
+  EXPECT_EQ(15, sketch.Estimate(1));
+}
+
+TEST(FrequencySketch, Aging) {
+  FrequencySketch sketch(16);
+  for (int i = 0; i < 8; ++i) sketch.Increment(1);
+  EXPECT_EQ(8, sketch.Estimate(1));
+
+  // 10 * capacity increments in total halve the counters, other keys may
+  // collide with the first one and increment its counters before that
+  for (std::size_t i = 0; i < 152; ++i) sketch.Increment(1000 + i);
+  EXPECT_GE(sketch.Estimate(1), 4);
+  EXPECT_LE(sketch.Estimate(1), 7);
+}
+
+TEST(FrequencySketch, Clear) {
+  FrequencySketch sketch(100);
+  sketch.Increment(1);
+  sketch.Clear();
+  EXPECT_EQ(0, sketch.Estimate(1));
+
+  sketch.Increment(1);
+  sketch.SetCapacity(1000);
+  EXPECT_EQ(0, sketch.Estimate(1));
+}
+
+USERVER_NAMESPACE_END
@@ -169,4 +169,114 @@ TEST(Lru, GetLeastUsed) {
   EXPECT_EQ(*cache.GetLeastUsed(), 20);
 }
 
+namespace {
+
+using TinyLfu = cache::LruMap<int, int, std::hash<int>, std::equal_to<int>,
+                              cache::CachePolicy::kTinyLFU>;
+
+constexpr int kHotKeys = 50;
+constexpr int kScanKeys = 1000;
+
+template <typename Cache>
+void Access(Cache& cache, int key) {
+  if (!cache.Get(key)) cache.Put(key, key);
+}
+
+// Hot keys are accessed once per 2 * kHotKeys scanned keys, which is too
+// rare for an LRU of 100 elements to keep them
+template <typename Cache>
+void FillHotThenScan(Cache& cache) {
+  for (int i = 0; i < kHotKeys; ++i) {
+    for (int access = 0; access < 4; ++access) Access(cache, i);
+  }
+  for (int i = 0; i < kScanKeys; ++i) {
+    Access(cache, kHotKeys + i);
+    if (i % 2 == 0) Access(cache, i / 2 % kHotKeys);
+  }
+}
+
+}  // namespace
+
+TEST(LruTinyLfu, SetGet) {
+  TinyLfu cache(10);
+  EXPECT_EQ(nullptr, cache.Get(1));
+  cache.Put(1, 2);
+  EXPECT_EQ(2, cache.GetOr(1, -1));
+  cache.Put(1, 3);
+  EXPECT_EQ(3, cache.GetOr(1, -1));
+  cache.Erase(1);
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+TEST(LruTinyLfu, Overflow) {
+  TinyLfu cache(10);
+  for (int i = 0; i < 100; ++i) {
+    cache.Put(i, i);
+    EXPECT_LE(cache.GetSize(), 10);
+  }
+  EXPECT_EQ(10, cache.GetSize());
+  // the most recent element is always in the window
+  EXPECT_EQ(99, cache.GetOr(99, -1));
+}
+
+TEST(LruTinyLfu, ScanResistance) {
+  TinyLfu cache(100);
+  FillHotThenScan(cache);
+
+  for (int i = 0; i < kHotKeys; ++i) {
+    EXPECT_EQ(i, cache.GetOr(i, -1)) << i;
+  }
+  EXPECT_EQ(100, cache.GetSize());
+  EXPECT_GT(cache.GetAdmissionRejections(), 0);
+
+  Lru lru(100);
+  FillHotThenScan(lru);
+  EXPECT_EQ(nullptr, lru.Get(0));
+  EXPECT_EQ(0, lru.GetAdmissionRejections());
+}
+
+TEST(LruTinyLfu, SetMaxSize) {
+  TinyLfu cache(100);
+  FillHotThenScan(cache);
+
+  cache.SetMaxSize(10);
+  EXPECT_EQ(10, cache.GetSize());
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(10, cache.GetSize());
+
+  cache.SetMaxSize(1000);
+  for (int i = 0; i < 1000; ++i) cache.Put(i, i);
+  EXPECT_EQ(1000, cache.GetSize());
+}
+
+TEST(LruTinyLfu, VisitAllAndClear) {
+  TinyLfu cache(10);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(3, 30);
+
+  int sum = 0;
+  cache.VisitAll([&sum](int key, int value) { sum += key + value; });
+  EXPECT_EQ(66, sum);
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.GetSize());
+  EXPECT_EQ(nullptr, cache.GetLeastUsed());
+}
+
+TEST(LruTinyLfu, Move) {
+  TinyLfu cache(10);
+  cache.Put(1, 10);
+
+  TinyLfu other = std::move(cache);
+  EXPECT_EQ(10, other.GetOr(1, -1));
+
+  cache = TinyLfu(5);
+  cache.Put(2, 20);
+  other = std::move(cache);
+  EXPECT_EQ(-1, other.GetOr(1, -1));
+  EXPECT_EQ(20, other.GetOr(2, -1));
+}
+
 USERVER_NAMESPACE_END
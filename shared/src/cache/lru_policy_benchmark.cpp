@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Trace = std::vector<std::uint64_t>;
+
+constexpr std::size_t kCacheSize = 10'000;
+constexpr std::size_t kTraceSize = 1'000'000;
+constexpr std::uint64_t kKeys = 100 * kCacheSize;
+
+std::discrete_distribution<std::uint64_t> MakeZipf(std::uint64_t keys,
+                                                   double skew) {
+  std::vector<double> weights(keys);
+  for (std::uint64_t i = 0; i < keys; ++i) {
+    weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), skew);
+  }
+  return {weights.begin(), weights.end()};
+}
+
+// Zipf-distributed keys
+Trace MakeZipfTrace() {
+  std::minstd_rand rng{42};
+  auto zipf = MakeZipf(kKeys, 0.9);
+
+  Trace trace(kTraceSize);
+  for (auto& key : trace) key = zipf(rng);
+  return trace;
+}
+
+// Zipf-distributed keys interleaved with scans over cold keys that are
+// never accessed again, each scan is twice as long as the cache
+Trace MakeScanTrace() {
+  std::minstd_rand rng{42};
+  auto zipf = MakeZipf(kKeys, 0.9);
+  std::uint64_t cold_key = kKeys;
+
+  Trace trace;
+  trace.reserve(kTraceSize);
+  while (trace.size() < kTraceSize) {
+    for (std::size_t i = 0; i < 5 * kCacheSize; ++i) {
+      trace.push_back(zipf(rng));
+    }
+    for (std::size_t i = 0; i < 2 * kCacheSize; ++i) {
+      trace.push_back(cold_key++);
+    }
+  }
+  return trace;
+}
+
+const Trace& GetTrace(std::int64_t type) {
+  static const Trace kZipf = MakeZipfTrace();
+  static const Trace kScan = MakeScanTrace();
+  return type == 0 ? kZipf : kScan;
+}
+
+}  // namespace
+
+// Replays a trace of accesses, the keys that miss are put into the cache.
+// range(0): 0 for the Zipf trace, 1 for the scan-heavy trace.
+template <cache::CachePolicy Policy>
+void LruPolicyTraceReplay(benchmark::State& state) {
+  const auto& trace = GetTrace(state.range(0));
+
+  std::uint64_t hits = 0;
+  std::uint64_t total = 0;
+  std::size_t rejections = 0;
+  for (auto _ : state) {
+    cache::LruMap<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>,
+                  std::equal_to<std::uint64_t>, Policy>
+        lru(kCacheSize);
+    for (const auto key : trace) {
+      if (lru.Get(key)) {
+        ++hits;
+      } else {
+        lru.Put(key, key);
+      }
+    }
+    total += trace.size();
+    rejections += lru.GetAdmissionRejections();
+  }
+
+  state.SetItemsProcessed(total);
+  state.counters["hit_ratio"] = static_cast<double>(hits) / total;
+  state.counters["admission_rejections"] =
+      static_cast<double>(rejections) / state.iterations();
+}
+BENCHMARK_TEMPLATE(LruPolicyTraceReplay, cache::CachePolicy::kLRU)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(LruPolicyTraceReplay, cache::CachePolicy::kTinyLFU)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
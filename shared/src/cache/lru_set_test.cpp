@@ -128,4 +128,24 @@ TEST(LruSet, GetLeastUsed) {
   EXPECT_EQ(*cache.GetLeastUsed(), 2);
 }
 
+TEST(LruSetTinyLfu, ScanResistance) {
+  cache::LruSet<int, std::hash<int>, std::equal_to<int>,
+                cache::CachePolicy::kTinyLFU>
+      cache(10);
+  for (int i = 0; i < 5; ++i) {
+    for (int access = 0; access < 3; ++access) {
+      if (!cache.Has(i)) cache.Put(i);
+    }
+  }
+  for (int i = 0; i < 100; ++i) {
+    if (!cache.Has(100 + i)) cache.Put(100 + i);
+    if (i % 2 == 0 && !cache.Has(i / 2 % 5)) cache.Put(i / 2 % 5);
+  }
+
+  for (int i = 0; i < 5; ++i) EXPECT_TRUE(cache.Has(i)) << i;
+  EXPECT_EQ(10, cache.GetSize());
+  EXPECT_GT(cache.GetAdmissionRejections(), 0);
+  ASSERT_NE(nullptr, cache.GetLeastUsed());
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <userver/cache/persistent_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Rows changed by a single incremental update
+constexpr std::int64_t kDeltaSize = 50;
+
+using Value = std::string;
+using StdMap = std::unordered_map<std::int64_t, Value>;
+using PersistentMap = cache::PersistentMap<std::int64_t, Value>;
+
+Value MakeValue(std::int64_t i) { return "value-" + std::to_string(i); }
+
+void Put(StdMap& map, std::int64_t key, Value value) {
+  map.insert_or_assign(key, std::move(value));
+}
+
+void Put(PersistentMap& map, std::int64_t key, Value value) {
+  map.insert_or_assign(key, std::move(value));
+}
+
+template <typename Map>
+Map MakeMap(std::int64_t size) {
+  Map map;
+  for (std::int64_t i = 0; i < size; ++i) Put(map, i, MakeValue(i));
+  return map;
+}
+
+std::size_t GetAllocatedBytes() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
+// Copy of the current cache contents with a small delta applied, as in an
+// incremental cache update
+template <typename Map>
+void IncrementalUpdate(benchmark::State& state) {
+  const auto size = state.range(0);
+  auto current = MakeMap<Map>(size);
+  std::int64_t key = 0;
+
+  for (auto _ : state) {
+    auto next = current;
+    for (std::int64_t i = 0; i < kDeltaSize; ++i) {
+      key = (key + 7919) % size;
+      Put(next, key, MakeValue(i));
+    }
+    current = std::move(next);
+    benchmark::DoNotOptimize(current);
+  }
+}
+BENCHMARK_TEMPLATE(IncrementalUpdate, StdMap)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(IncrementalUpdate, PersistentMap)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+
+template <typename Map>
+void Lookup(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto map = MakeMap<Map>(size);
+  std::int64_t key = 0;
+
+  for (auto _ : state) {
+    key = (key + 7919) % size;
+    benchmark::DoNotOptimize(map.find(key));
+  }
+}
+BENCHMARK_TEMPLATE(Lookup, StdMap)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(Lookup, PersistentMap)->Arg(1'000'000);
+
+// Heap usage of the map, as reported by the allocator
+template <typename Map>
+void Memory(benchmark::State& state) {
+  const auto size = state.range(0);
+  for (auto _ : state) {
+    const auto before = GetAllocatedBytes();
+    auto map = MakeMap<Map>(size);
+    const auto after = GetAllocatedBytes();
+
+    state.counters["bytes_per_entry"] =
+        static_cast<double>(after - before) / size;
+    state.PauseTiming();
+    map = Map{};
+    state.ResumeTiming();
+  }
+}
+BENCHMARK_TEMPLATE(Memory, StdMap)
+    ->Arg(1'000'000)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Memory, PersistentMap)
+    ->Arg(1'000'000)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
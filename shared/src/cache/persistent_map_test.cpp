@@ -0,0 +1,157 @@
+#include <userver/cache/persistent_map.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentMap<int, std::string>;
+
+// Puts all the keys into a single collision node
+struct BadHash {
+  std::size_t operator()(int key) const noexcept { return key % 2; }
+};
+
+template <typename PMap>
+std::map<int, std::string> ToStdMap(const PMap& map) {
+  std::map<int, std::string> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, value).second) << "duplicate " << key;
+  }
+  EXPECT_EQ(result.size(), map.size());
+  return result;
+}
+
+// Keys differ only in the last levels of the trie
+struct HighBitsHash {
+  std::size_t operator()(int key) const noexcept {
+    return static_cast<std::size_t>(key) << 58;
+  }
+};
+
+}  // namespace
+
+TEST(PersistentMap, Basic) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+
+  EXPECT_TRUE(map.insert_or_assign(1, "one"));
+  EXPECT_TRUE(map.insert_or_assign(2, "two"));
+  EXPECT_FALSE(map.insert_or_assign(1, "uno"));
+  EXPECT_FALSE(map.insert({2, "dos"}));
+  EXPECT_EQ(map.size(), 2u);
+
+  EXPECT_EQ(map.at(1), "uno");
+  EXPECT_EQ(map.find(2)->second, "two");
+  EXPECT_EQ(map.find(3), map.end());
+  EXPECT_THROW(map.at(3), std::out_of_range);
+
+  EXPECT_EQ(map.erase(3), 0u);
+  EXPECT_EQ(map.erase(1), 1u);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.size(), 1u);
+
+  auto copy = map;
+  EXPECT_EQ(copy, map);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentMap, CopiesAreIndependent) {
+  Map original;
+  for (int i = 0; i < 10000; ++i) original.insert_or_assign(i, "a");
+
+  auto copy = original;
+  for (int i = 0; i < 10000; i += 3) copy.insert_or_assign(i, "b");
+  for (int i = 1; i < 10000; i += 3) copy.erase(i);
+  copy.insert_or_assign(-1, "c");
+
+  EXPECT_NE(copy, original);
+  EXPECT_EQ(original.size(), 10000u);
+  for (const auto& [key, value] : original) EXPECT_EQ(value, "a") << key;
+
+  EXPECT_EQ(copy.size(), 10000u - 3333u + 1u);
+  for (int i = 0; i < 10000; ++i) {
+    const auto it = copy.find(i);
+    switch (i % 3) {
+      case 0:
+        EXPECT_EQ(it->second, "b");
+        break;
+      case 1:
+        EXPECT_EQ(it, copy.end());
+        break;
+      default:
+        EXPECT_EQ(it->second, "a");
+    }
+  }
+  EXPECT_EQ(copy.at(-1), "c");
+}
+
+TEST(PersistentMap, Collisions) {
+  cache::PersistentMap<int, std::string, BadHash> map;
+  for (int i = 0; i < 100; ++i) map.insert_or_assign(i, std::to_string(i));
+  EXPECT_EQ(map.size(), 100u);
+
+  auto copy = map;
+  for (int i = 0; i < 100; i += 2) EXPECT_EQ(copy.erase(i), 1u);
+  EXPECT_EQ(copy.erase(0), 0u);
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.at(i), std::to_string(i));
+    EXPECT_EQ(copy.contains(i), i % 2 == 1) << i;
+  }
+  EXPECT_EQ(ToStdMap(copy).size(), 50u);
+
+  for (int i = 1; i < 99; i += 2) copy.erase(i);
+  EXPECT_EQ(ToStdMap(copy), (std::map<int, std::string>{{99, "99"}}));
+}
+
+TEST(PersistentMap, DeepTrie) {
+  cache::PersistentMap<int, std::string, HighBitsHash> map;
+  for (int i = 0; i < 64; ++i) map.insert_or_assign(i, std::to_string(i));
+
+  auto copy = map;
+  for (int i = 0; i < 64; i += 4) EXPECT_EQ(copy.erase(i), 1u);
+
+  EXPECT_EQ(ToStdMap(map).size(), 64u);
+  EXPECT_EQ(ToStdMap(copy).size(), 48u);
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_EQ(map.at(i), std::to_string(i));
+    EXPECT_EQ(copy.contains(i), i % 4 != 0) << i;
+  }
+}
+
+TEST(PersistentMap, Randomized) {
+  std::minstd_rand rng{42};
+  std::vector<std::pair<Map, std::map<int, std::string>>> versions(1);
+
+  for (int step = 0; step < 50000; ++step) {
+    if (step % 1000 == 0) versions.push_back(versions.back());
+
+    auto& [map, expected] = versions.back();
+    const int key = rng() % 2000;
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      const auto value = std::to_string(step);
+      EXPECT_EQ(map.insert_or_assign(key, value),
+                expected.insert_or_assign(key, value).second);
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+
+  for (const auto& [map, expected] : versions) {
+    EXPECT_EQ(ToStdMap(map), expected);
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include <formats/json/impl/allocator.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <userver/utils/monotonic_arena.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+// rapidjson aligns its nodes by 8 bytes, see RAPIDJSON_ALIGN
+constexpr std::size_t kArenaAlignment = 8;
+
+thread_local bool is_arena_parse_active = false;
+
+}  // namespace
+
+void* Allocator::Malloc(std::size_t size) {
+  // behavior of malloc(0) is implementation defined
+  if (!size) return nullptr;
+  if (arena_) return arena_->Allocate(size, kArenaAlignment);
+  return std::malloc(size);
+}
+
+void* Allocator::Realloc(void* original_ptr, std::size_t original_size,
+                         std::size_t new_size) {
+  if (!arena_) {
+    if (!new_size) {
+      std::free(original_ptr);
+      return nullptr;
+    }
+    return std::realloc(original_ptr, new_size);
+  }
+
+  if (new_size <= original_size) return new_size ? original_ptr : nullptr;
+
+  // The old chunk is reclaimed with the arena
+  void* new_ptr = arena_->Allocate(new_size, kArenaAlignment);
+  if (original_size) std::memcpy(new_ptr, original_ptr, original_size);
+  return new_ptr;
+}
+
+void Allocator::Free(void* ptr) noexcept {
+  if (is_arena_parse_active) return;
+  std::free(ptr);
+}
+
+ArenaParseScope::ArenaParseScope() noexcept
+    : was_active_(std::exchange(is_arena_parse_active, true)) {}
+
+ArenaParseScope::~ArenaParseScope() { is_arena_parse_active = was_active_; }
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+
+#include <userver/formats/json/impl/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+class MonotonicArena;
+}  // namespace utils
+
+namespace formats::json::impl {
+
+/// @brief rapidjson allocator that takes memory either from the heap or from
+/// utils::MonotonicArena.
+///
+/// Allocator has no way to find out whether a pointer belongs to an arena, so
+/// the arena-backed values are never freed node by node:
+/// - VersionedValuePtr forgets such values instead of destroying them;
+/// - parsing into an arena is done within ArenaParseScope.
+class Allocator final {
+ public:
+  static constexpr bool kNeedFree = true;
+
+  /// Heap allocator
+  Allocator() noexcept = default;
+
+  /// Arena allocator, `arena` must outlive all the allocated values
+  explicit Allocator(utils::MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+  void* Malloc(std::size_t size);
+  void* Realloc(void* original_ptr, std::size_t original_size,
+                std::size_t new_size);
+  static void Free(void* ptr) noexcept;
+
+  bool IsArenaBacked() const noexcept { return arena_ != nullptr; }
+
+ private:
+  utils::MonotonicArena* arena_{nullptr};
+};
+
+/// While alive, Allocator::Free is a no-op on the current thread. Required
+/// for parsing into an arena, as rapidjson destroys the partially built values
+/// on errors.
+class ArenaParseScope final {
+ public:
+  ArenaParseScope() noexcept;
+
+  ArenaParseScope(const ArenaParseScope&) = delete;
+  ArenaParseScope& operator=(const ArenaParseScope&) = delete;
+
+  ~ArenaParseScope();
+
+ private:
+  const bool was_active_;
+};
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
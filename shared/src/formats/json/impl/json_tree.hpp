@@ -7,6 +7,8 @@
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <formats/json/impl/allocator.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace formats::json::impl {
@@ -1,5 +1,7 @@
 #include <formats/json/impl/types_impl.hpp>
 
+#include <new>
+
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,9 +12,23 @@ VersionedValuePtr::Data::Data(Document&& doc)
     : Data(static_cast<Value&&>(doc)) {
   static_assert(
       // NOLINTNEXTLINE(misc-redundant-expression)
-      std::is_same_v<::rapidjson::CrtAllocator, Value::AllocatorType> &&
-          std::is_same_v<::rapidjson::CrtAllocator, Document::AllocatorType>,
-      "Both Document and Value must use CrtAllocator for the fast move");
+      std::is_same_v<Allocator, Value::AllocatorType> &&
+          std::is_same_v<Allocator, Document::AllocatorType>,
+      "Both Document and Value must use the same allocator for the fast move");
+}
+
+VersionedValuePtr::Data::Data(
+    Document&& doc, std::unique_ptr<utils::MonotonicArena> arena)
+    : owned_arena(std::move(arena)),
+      is_arena_backed(true),
+      native(static_cast<Value&&>(doc)) {}
+
+VersionedValuePtr::Data::~Data() {
+  if (is_arena_backed) {
+    // Forgetting the nodes instead of a recursive destruction, the memory is
+    // reclaimed with the arena
+    new (&native) Value();
+  }
 }
 
 VersionedValuePtr::VersionedValuePtr() noexcept = default;
@@ -26,6 +42,10 @@ VersionedValuePtr::operator bool() const { return !!data_; }
 
 bool VersionedValuePtr::IsUnique() const { return data_.use_count() == 1; }
 
+bool VersionedValuePtr::IsArenaBacked() const {
+  return data_ && data_->is_arena_backed;
+}
+
 const Value* VersionedValuePtr::Get() const {
   return data_ ? &data_->native : nullptr;
 }
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include <rapidjson/document.h>
 
 #include <userver/formats/json/impl/types.hpp>
+#include <userver/utils/monotonic_arena.hpp>
+
+#include <formats/json/impl/allocator.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,6 +22,18 @@ struct VersionedValuePtr::Data {
   // https://github.com/Tencent/rapidjson/issues/387
   explicit Data(Document&&);
 
+  // Document allocated from an arena, `owned_arena` is empty if the arena is
+  // owned by the caller
+  Data(Document&&, std::unique_ptr<utils::MonotonicArena> owned_arena);
+
+  ~Data();
+
+  // arena with the nodes of `native`, if owned
+  std::unique_ptr<utils::MonotonicArena> owned_arena;
+
+  // `native` nodes are allocated from an arena and are not freed one by one
+  const bool is_arena_backed{false};
+
   // native rapidjson value
   Value native;
 
@@ -1,7 +1,5 @@
 #include <userver/formats/json/inline.hpp>
 
-#include <type_traits>
-
 #include <rapidjson/allocators.h>
 #include <rapidjson/document.h>
 #include <rapidjson/rapidjson.h>
@@ -18,10 +16,8 @@ USERVER_NAMESPACE_BEGIN
 namespace formats::json::impl {
 namespace {
 
-::rapidjson::CrtAllocator g_allocator;
-
-static_assert(std::is_empty_v<::rapidjson::CrtAllocator>,
-              "allocator has no state");
+// heap allocator, may be shared between threads as it has no state
+Allocator g_allocator;
 
 impl::Value WrapStringView(std::string_view key) {
   // GenericValue ctor has an invalid type for size
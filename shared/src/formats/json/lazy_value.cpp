@@ -0,0 +1,405 @@
+#include <userver/formats/json/lazy_value.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <fmt/format.h>
+
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/json/impl/exttypes.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace {
+
+constexpr bool IsWhitespace(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+const char* FindNonWhitespace(const char* p, const char* end) noexcept {
+  while (p != end && IsWhitespace(*p)) ++p;
+  return p;
+}
+
+std::string_view Trim(std::string_view doc) noexcept {
+  const char* begin = FindNonWhitespace(doc.data(), doc.data() + doc.size());
+  const char* end = doc.data() + doc.size();
+  while (end != begin && IsWhitespace(*(end - 1))) --end;
+  return {begin, static_cast<std::size_t>(end - begin)};
+}
+
+[[noreturn]] void ThrowMalformed(std::string_view path, const char* what) {
+  throw ParseException(fmt::format("Malformed JSON at '{}': {}",
+                                   path.empty() ? common::kPathRoot : path,
+                                   what));
+}
+
+#ifdef __SSE2__
+constexpr std::size_t kChunkSize = sizeof(__m128i);
+
+__m128i Load(const char* p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+__m128i Equal(__m128i chunk, char c) noexcept {
+  return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c));
+}
+#endif
+
+// Returns the first '"' or '\\' or `end`
+const char* FindQuoteOrEscape(const char* p, const char* end) noexcept {
+#ifdef __SSE2__
+  for (; static_cast<std::size_t>(end - p) >= kChunkSize; p += kChunkSize) {
+    const auto chunk = Load(p);
+    const auto mask = _mm_movemask_epi8(
+        _mm_or_si128(Equal(chunk, '"'), Equal(chunk, '\\')));
+    if (mask) return p + __builtin_ctz(mask);
+  }
+#endif
+  for (; p != end; ++p) {
+    if (*p == '"' || *p == '\\') return p;
+  }
+  return end;
+}
+
+// Skips an object or an array that starts at `p`, tracks only the brackets
+// and the strings. Returns the position after the closing bracket or nullptr.
+class ContainerSkipper final {
+ public:
+  const char* Skip(const char* p, const char* end) noexcept {
+#ifdef __SSE2__
+    for (; static_cast<std::size_t>(end - p) >= kChunkSize; p += kChunkSize) {
+      const auto chunk = Load(p);
+      const auto specials = _mm_or_si128(Equal(chunk, '"'), Equal(chunk, '\\'));
+      const auto brackets =
+          _mm_or_si128(_mm_or_si128(Equal(chunk, '{'), Equal(chunk, '}')),
+                       _mm_or_si128(Equal(chunk, '['), Equal(chunk, ']')));
+      auto mask = static_cast<unsigned>(
+          _mm_movemask_epi8(_mm_or_si128(specials, brackets)));
+      if (skip_next_) {
+        mask &= ~1u;
+        skip_next_ = false;
+      }
+
+      while (mask) {
+        const auto i = static_cast<unsigned>(__builtin_ctz(mask));
+        mask &= mask - 1;
+        if (Step(p[i])) return p + i + 1;
+        if (skip_next_ && i + 1 < kChunkSize) {
+          mask &= ~(1u << (i + 1));
+          skip_next_ = false;
+        }
+      }
+    }
+#endif
+    for (; p != end; ++p) {
+      if (skip_next_) {
+        skip_next_ = false;
+        continue;
+      }
+      if (Step(*p)) return p + 1;
+    }
+    return nullptr;
+  }
+
+ private:
+  // Returns true on the closing bracket of the container
+  bool Step(char c) noexcept {
+    if (in_string_) {
+      if (c == '\\') {
+        skip_next_ = true;
+      } else if (c == '"') {
+        in_string_ = false;
+      }
+      return false;
+    }
+
+    switch (c) {
+      case '"':
+        in_string_ = true;
+        return false;
+      case '{':
+      case '[':
+        ++depth_;
+        return false;
+      case '}':
+      case ']':
+        return --depth_ == 0;
+      default:
+        return false;
+    }
+  }
+
+  std::size_t depth_{0};
+  bool in_string_{false};
+  bool skip_next_{false};
+};
+
+class Scanner final {
+ public:
+  Scanner(std::string_view raw, std::string_view path) noexcept
+      : p_(raw.data()), end_(raw.data() + raw.size()), path_(path) {}
+
+  bool IsEnd() const noexcept { return p_ == end_; }
+  char Peek() const noexcept { return *p_; }
+
+  void Skip(char expected, const char* what) {
+    if (p_ == end_ || *p_ != expected) ThrowMalformed(path_, what);
+    ++p_;
+  }
+
+  void SkipWhitespace() noexcept { p_ = FindNonWhitespace(p_, end_); }
+
+  // Returns the contents of the string without quotes
+  std::string_view SkipString(bool& has_escapes) {
+    UASSERT(*p_ == '"');
+    const char* begin = ++p_;
+    for (;;) {
+      p_ = FindQuoteOrEscape(p_, end_);
+      if (p_ == end_) ThrowMalformed(path_, "unterminated string");
+      if (*p_ == '"') break;
+
+      has_escapes = true;
+      if (end_ - p_ < 2) ThrowMalformed(path_, "unterminated string");
+      p_ += 2;
+    }
+    return {begin, static_cast<std::size_t>(p_++ - begin)};
+  }
+
+  // Returns the text of the value
+  std::string_view SkipValue() {
+    const char* begin = p_;
+    if (p_ == end_) ThrowMalformed(path_, "value expected");
+
+    switch (*p_) {
+      case '"': {
+        bool has_escapes = false;
+        SkipString(has_escapes);
+        break;
+      }
+      case '{':
+      case '[':
+        SkipContainer();
+        break;
+      default:
+        SkipScalar();
+    }
+    return {begin, static_cast<std::size_t>(p_ - begin)};
+  }
+
+ private:
+  void SkipContainer() {
+    p_ = ContainerSkipper{}.Skip(p_, end_);
+    if (!p_) ThrowMalformed(path_, "unterminated object or array");
+  }
+
+  void SkipScalar() {
+    const char* begin = p_;
+    while (p_ != end_ && !IsWhitespace(*p_) && *p_ != ',' && *p_ != '}' &&
+           *p_ != ']') {
+      ++p_;
+    }
+    if (p_ == begin) ThrowMalformed(path_, "value expected");
+  }
+
+  const char* p_;
+  const char* const end_;
+  const std::string_view path_;
+};
+
+// Calls `visitor(key, has_escapes, value)` for the members of the object
+// until it returns true
+template <typename Visitor>
+void VisitObject(std::string_view raw, std::string_view path,
+                 Visitor&& visitor) {
+  Scanner scanner{raw, path};
+  scanner.Skip('{', "object expected");
+  scanner.SkipWhitespace();
+  if (!scanner.IsEnd() && scanner.Peek() == '}') return;
+
+  for (;;) {
+    if (scanner.IsEnd() || scanner.Peek() != '"') {
+      ThrowMalformed(path, "object key expected");
+    }
+    bool has_escapes = false;
+    const auto key = scanner.SkipString(has_escapes);
+    scanner.SkipWhitespace();
+    scanner.Skip(':', "':' expected after the object key");
+    scanner.SkipWhitespace();
+    const auto value = scanner.SkipValue();
+    if (visitor(key, has_escapes, value)) return;
+
+    scanner.SkipWhitespace();
+    if (!scanner.IsEnd() && scanner.Peek() == '}') return;
+    scanner.Skip(',', "',' or '}' expected after the object member");
+    scanner.SkipWhitespace();
+  }
+}
+
+// Calls `visitor(value)` for the elements of the array until it returns true
+template <typename Visitor>
+void VisitArray(std::string_view raw, std::string_view path,
+                Visitor&& visitor) {
+  Scanner scanner{raw, path};
+  scanner.Skip('[', "array expected");
+  scanner.SkipWhitespace();
+  if (!scanner.IsEnd() && scanner.Peek() == ']') return;
+
+  for (;;) {
+    const auto value = scanner.SkipValue();
+    if (visitor(value)) return;
+
+    scanner.SkipWhitespace();
+    if (!scanner.IsEnd() && scanner.Peek() == ']') return;
+    scanner.Skip(',', "',' or ']' expected after the array element");
+    scanner.SkipWhitespace();
+  }
+}
+
+bool IsKeyEqual(std::string_view raw_key, bool has_escapes,
+                std::string_view key) {
+  if (!has_escapes) return raw_key == key;
+
+  std::string quoted;
+  quoted.reserve(raw_key.size() + 2);
+  quoted += '"';
+  quoted += raw_key;
+  quoted += '"';
+  return FromString(quoted).As<std::string>() == key;
+}
+
+}  // namespace
+
+LazyValue::LazyValue(std::string_view doc) : raw_(Trim(doc)) {
+  if (raw_.empty()) {
+    throw ParseException("JSON document is empty");
+  }
+}
+
+LazyValue::LazyValue(std::string_view raw, std::string path) noexcept
+    : raw_(raw), path_(std::move(path)) {}
+
+LazyValue LazyValue::operator[](std::string_view key) const {
+  auto child_path = common::MakeChildPath(path_, key);
+  if (IsMissing() || IsNull()) return {{}, std::move(child_path)};
+  if (!IsObject()) {
+    throw TypeMismatchException(GetExtendedType(), impl::objectValue,
+                                GetPath());
+  }
+
+  std::string_view result;
+  VisitObject(raw_, path_,
+              [&](std::string_view raw_key, bool has_escapes,
+                  std::string_view value) {
+                if (!IsKeyEqual(raw_key, has_escapes, key)) return false;
+                result = value;
+                return true;
+              });
+  return {result, std::move(child_path)};
+}
+
+LazyValue LazyValue::operator[](std::size_t index) const {
+  CheckNotMissing();
+  if (!IsArray()) {
+    throw TypeMismatchException(GetExtendedType(), impl::arrayValue,
+                                GetPath());
+  }
+
+  std::size_t size = 0;
+  std::string_view result;
+  VisitArray(raw_, path_, [&](std::string_view value) {
+    if (size++ != index) return false;
+    result = value;
+    return true;
+  });
+  if (index >= size) throw OutOfBoundsException(index, size, GetPath());
+  return {result, common::MakeChildPath(path_, index)};
+}
+
+bool LazyValue::HasMember(std::string_view key) const {
+  return !(*this)[key].IsMissing();
+}
+
+std::size_t LazyValue::GetSize() const {
+  CheckNotMissing();
+  std::size_t size = 0;
+  if (IsObject()) {
+    VisitObject(raw_, path_, [&size](auto, auto, auto) {
+      ++size;
+      return false;
+    });
+  } else if (IsArray()) {
+    VisitArray(raw_, path_, [&size](auto) {
+      ++size;
+      return false;
+    });
+  } else if (!IsNull()) {
+    throw TypeMismatchException(GetExtendedType(), impl::objectValue,
+                                GetPath());
+  }
+  return size;
+}
+
+bool LazyValue::IsNull() const noexcept {
+  return !IsMissing() && raw_.front() == 'n';
+}
+
+bool LazyValue::IsBool() const noexcept {
+  return !IsMissing() && (raw_.front() == 't' || raw_.front() == 'f');
+}
+
+bool LazyValue::IsNumber() const noexcept {
+  return !IsMissing() && (raw_.front() == '-' ||
+                          (raw_.front() >= '0' && raw_.front() <= '9'));
+}
+
+bool LazyValue::IsString() const noexcept {
+  return !IsMissing() && raw_.front() == '"';
+}
+
+bool LazyValue::IsArray() const noexcept {
+  return !IsMissing() && raw_.front() == '[';
+}
+
+bool LazyValue::IsObject() const noexcept {
+  return !IsMissing() && raw_.front() == '{';
+}
+
+Value LazyValue::Materialize() const {
+  CheckNotMissing();
+  return FromString(raw_);
+}
+
+std::string LazyValue::GetPath() const {
+  return path_.empty() ? common::kPathRoot : path_;
+}
+
+int LazyValue::GetExtendedType() const {
+  if (IsNull()) return impl::nullValue;
+  if (IsObject()) return impl::objectValue;
+  if (IsArray()) return impl::arrayValue;
+  if (IsString()) return impl::stringValue;
+  if (IsBool()) return impl::booleanValue;
+  if (IsNumber()) {
+    if (raw_.find_first_of(".eE") != std::string_view::npos) {
+      return impl::realValue;
+    }
+    return raw_.front() == '-' ? impl::intValue : impl::uintValue;
+  }
+  return impl::errorValue;
+}
+
+void LazyValue::CheckNotMissing() const {
+  if (IsMissing()) throw MemberMissingException(GetPath());
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
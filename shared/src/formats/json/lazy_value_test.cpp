@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Longer than a SIMD chunk to exercise both the vector and the scalar paths
+constexpr std::string_view kDoc = R"({
+  "skipped": {"nested": ["a \"quoted\" ] string", {"}": "{"}], "n": null},
+  "long_string_value_to_be_skipped": "0123456789abcdef0123456789abcdef",
+  "int": -42,
+  "double": 1.5e3,
+  "bool": true,
+  "null": null,
+  "str": "value with \\ and \" escapes",
+  "arr": [1, [2, 3], {"k": "v"}, "s"],
+  "esc\u0061ped": 1,
+  "obj": {"inner": {"leaf": 7}}
+})";
+
+}  // namespace
+
+TEST(FormatsJsonLazy, Sample) {
+  /// [Sample formats::json::LazyValue usage]
+  // #include <userver/formats/json/lazy_value.hpp>
+
+  const std::string body = R"({
+    "key1": 1,
+    "key2": {"key3":"val"},
+    "big_unused_field": [1, 2, 3]
+  })";
+  const formats::json::LazyValue json{body};
+
+  const auto key1 = json["key1"].As<int>();
+  ASSERT_EQ(key1, 1);
+
+  const auto key3 = json["key2"]["key3"].As<std::string>();
+  ASSERT_EQ(key3, "val");
+  /// [Sample formats::json::LazyValue usage]
+}
+
+TEST(FormatsJsonLazy, Scalars) {
+  const formats::json::LazyValue json{kDoc};
+
+  EXPECT_EQ(json["int"].As<int>(), -42);
+  EXPECT_EQ(json["double"].As<double>(), 1500.0);
+  EXPECT_TRUE(json["bool"].As<bool>());
+  EXPECT_TRUE(json["null"].IsNull());
+  EXPECT_EQ(json["str"].As<std::string>(), R"(value with \ and " escapes)");
+  EXPECT_EQ(json["escaped"].As<int>(), 1);
+  EXPECT_EQ(json["obj"]["inner"]["leaf"].As<int>(), 7);
+  EXPECT_EQ(json["obj"]["inner"]["leaf"].GetPath(), "obj.inner.leaf");
+  EXPECT_EQ(json.GetPath(), "/");
+}
+
+TEST(FormatsJsonLazy, Types) {
+  const formats::json::LazyValue json{kDoc};
+
+  EXPECT_TRUE(json.IsObject());
+  EXPECT_TRUE(json["arr"].IsArray());
+  EXPECT_TRUE(json["str"].IsString());
+  EXPECT_TRUE(json["int"].IsNumber());
+  EXPECT_TRUE(json["bool"].IsBool());
+  EXPECT_FALSE(json["int"].IsString());
+
+  EXPECT_EQ(json.GetSize(), 10);
+  EXPECT_EQ(json["arr"].GetSize(), 4);
+  EXPECT_EQ(json["null"].GetSize(), 0);
+  EXPECT_THROW(json["int"].GetSize(), formats::json::TypeMismatchException);
+}
+
+TEST(FormatsJsonLazy, Arrays) {
+  const formats::json::LazyValue json{kDoc};
+
+  EXPECT_EQ(json["arr"][0].As<int>(), 1);
+  EXPECT_EQ(json["arr"][1].As<std::vector<int>>(), (std::vector<int>{2, 3}));
+  EXPECT_EQ(json["arr"][2]["k"].As<std::string>(), "v");
+  EXPECT_EQ(json["arr"][3].As<std::string>(), "s");
+  EXPECT_EQ(json["arr"][2].GetPath(), "arr[2]");
+
+  EXPECT_THROW(json["arr"][4], formats::json::OutOfBoundsException);
+  EXPECT_THROW(json["int"][0], formats::json::TypeMismatchException);
+  EXPECT_THROW(json["missing"][0], formats::json::MemberMissingException);
+}
+
+TEST(FormatsJsonLazy, Missing) {
+  const formats::json::LazyValue json{kDoc};
+
+  EXPECT_TRUE(json["missing"].IsMissing());
+  EXPECT_TRUE(json["missing"]["deeper"].IsMissing());
+  EXPECT_TRUE(json["null"]["deeper"].IsMissing());
+  EXPECT_TRUE(json["skipped"]["}"].IsMissing());
+  EXPECT_FALSE(json.HasMember("missing"));
+  EXPECT_TRUE(json.HasMember("skipped"));
+
+  EXPECT_EQ(json["missing"].As<int>(5), 5);
+  EXPECT_EQ(json["null"].As<int>({}), 0);
+  EXPECT_THROW(json["missing"].As<int>(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(json["int"]["key"], formats::json::TypeMismatchException);
+}
+
+TEST(FormatsJsonLazy, Materialize) {
+  const formats::json::LazyValue json{kDoc};
+
+  EXPECT_EQ(json["skipped"].Materialize(),
+            formats::json::FromString(kDoc)["skipped"]);
+  EXPECT_EQ(json.Materialize(), formats::json::FromString(kDoc));
+}
+
+TEST(FormatsJsonLazy, Malformed) {
+  using formats::json::LazyValue;
+  using formats::json::ParseException;
+
+  EXPECT_THROW(LazyValue{" \n "}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": "unterminated)"}["b"], ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": [1, 2})"}["b"], ParseException);
+  EXPECT_THROW(LazyValue{R"({"a" 1})"}["a"], ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": 1 "b": 2})"}["b"], ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": })"}["a"], ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": tru})"}["a"].As<bool>(), ParseException);
+
+  // Skipped parts are not validated
+  EXPECT_EQ(LazyValue{R"({"a": tru, "b": 2})"}["b"].As<int>(), 2);
+}
+
+USERVER_NAMESPACE_END
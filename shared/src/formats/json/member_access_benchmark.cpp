@@ -1,8 +1,14 @@
 #include <benchmark/benchmark.h>
 
+#include <cstddef>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -46,6 +52,29 @@ constexpr char bench_json_data[] = R"({
   }
 })";
 
+// ~200 KB request body
+std::string BuildRequestBody() {
+  constexpr std::size_t kItems = 2000;
+  std::string result = R"({"items":[)";
+  for (std::size_t i = 0; i < kItems; ++i) {
+    if (i != 0) result += ',';
+    result += fmt::format(
+        R"({{"id":{0},"name":"item-{0}","tags":["new","sale"],"price":{0}.5,)"
+        R"("attrs":{{"color":"red","size":"XL","available":true}}}})",
+        i);
+  }
+  result += "]}";
+  return result;
+}
+
+std::size_t CountLeaves(const formats::json::Value& json) {
+  if (!json.IsObject() && !json.IsArray()) return 1;
+
+  std::size_t result = 0;
+  for (const auto& child : json) result += CountLeaves(child);
+  return result;
+}
+
 }  // anonymous namespace
 
 void json_path_short(benchmark::State& state) {
@@ -98,6 +127,33 @@ void json_path_long_and_deeply_nested(benchmark::State& state) {
 }
 BENCHMARK(json_path_long_and_deeply_nested);
 
+void json_parse_traverse_destroy(benchmark::State& state) {
+  const auto body = BuildRequestBody();
+  const bool pooled = state.range(0);
+
+  for (auto _ : state) {
+    const auto json = pooled ? formats::json::FromStringPooled(body)
+                             : formats::json::FromString(body);
+    benchmark::DoNotOptimize(CountLeaves(json));
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(json_parse_traverse_destroy)->Arg(false)->Arg(true);
+
+void json_parse_traverse_destroy_arena(benchmark::State& state) {
+  const auto body = BuildRequestBody();
+  // Like the per-request arena, the buffer is reused between the iterations
+  std::vector<std::byte> buffer(body.size() * 2);
+
+  for (auto _ : state) {
+    utils::MonotonicArena arena{buffer.data(), buffer.size()};
+    const auto json = formats::json::FromStringPooled(body, arena);
+    benchmark::DoNotOptimize(CountLeaves(json));
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(json_parse_traverse_destroy_arena);
+
 formats::json::ValueBuilder Build(size_t count) {
   formats::json::ValueBuilder builder;
   for (size_t i = 0; i < count; i++) builder[std::to_string(i)] = i;
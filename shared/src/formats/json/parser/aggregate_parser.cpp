@@ -0,0 +1,41 @@
+#include <userver/formats/json/parser/aggregate_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser::impl {
+
+void SkipParser::Null() { MaybePopSelf(); }
+
+void SkipParser::Bool(bool) { MaybePopSelf(); }
+
+void SkipParser::Int64(int64_t) { MaybePopSelf(); }
+
+void SkipParser::Uint64(uint64_t) { MaybePopSelf(); }
+
+void SkipParser::Double(double) { MaybePopSelf(); }
+
+void SkipParser::String(std::string_view) { MaybePopSelf(); }
+
+void SkipParser::StartObject() { ++depth_; }
+
+void SkipParser::Key(std::string_view) {}
+
+void SkipParser::EndObject() {
+  --depth_;
+  MaybePopSelf();
+}
+
+void SkipParser::StartArray() { ++depth_; }
+
+void SkipParser::EndArray() {
+  --depth_;
+  MaybePopSelf();
+}
+
+void SkipParser::MaybePopSelf() {
+  if (depth_ == 0) parser_state_->PopMe(*this);
+}
+
+}  // namespace formats::json::parser::impl
+
+USERVER_NAMESPACE_END
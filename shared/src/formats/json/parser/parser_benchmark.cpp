@@ -2,6 +2,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/formats/json/lazy_value.hpp>
 #include <userver/formats/json/parser/parser.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/parse/common_containers.hpp>
@@ -46,6 +47,16 @@ void JsonParseArrayDom(benchmark::State& state) {
 }
 BENCHMARK(JsonParseArrayDom)->RangeMultiplier(4)->Range(1, 1024);
 
+void JsonParseArrayDomPooled(benchmark::State& state) {
+  const auto input = BuildArray(state.range(0));
+  for (auto _ : state) {
+    auto json = formats::json::FromStringPooled(input);
+    const auto res = ParseDom(json);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseArrayDomPooled)->RangeMultiplier(4)->Range(1, 1024);
+
 void JsonParseArraySax(benchmark::State& state) {
   const auto input = BuildArray(state.range(0));
   for (auto _ : state) {
@@ -87,6 +98,15 @@ void JsonParseValueDom(benchmark::State& state) {
 }
 BENCHMARK(JsonParseValueDom)->RangeMultiplier(2)->Range(1, 16);
 
+void JsonParseValueDomPooled(benchmark::State& state) {
+  const auto input = BuildObject(state.range(0));
+  for (auto _ : state) {
+    const auto res = formats::json::FromStringPooled(input);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseValueDomPooled)->RangeMultiplier(2)->Range(1, 16);
+
 void JsonParseValueSax(benchmark::State& state) {
   const auto input = BuildObject(state.range(0));
   for (auto _ : state) {
@@ -97,4 +117,47 @@ void JsonParseValueSax(benchmark::State& state) {
 }
 BENCHMARK(JsonParseValueSax)->RangeMultiplier(2)->Range(1, 16);
 
+namespace {
+
+// ~2 KB request body of which a handler needs just a few fields
+std::string BuildRequestBody() {
+  std::string r = R"({"id": "a1b2c3d4", "user": {"name": "John", "age": 42},)";
+  for (size_t i = 0; i < 20; i++) {
+    r += fmt::format(
+        R"("extra_{}": {{"tags": ["one", "two", "three"], "weight": {}.5}},)",
+        i, i);
+  }
+  r += R"("items": [1, 2, 3, 4, 5], "comment": "a \"quoted\" text"})";
+  return r;
+}
+
+template <typename Json>
+auto TouchFewFields(const Json& json) {
+  return json["id"].template As<std::string>().size() +
+         json["user"]["age"].template As<int>() +
+         json["items"][2].template As<int>() +
+         json["extra_19"]["weight"].template As<double>() +
+         json["comment"].template As<std::string>().size();
+}
+
+}  // namespace
+
+void JsonParseFewFieldsDom(benchmark::State& state) {
+  const auto input = BuildRequestBody();
+  for (auto _ : state) {
+    const auto json = formats::json::FromString(input);
+    benchmark::DoNotOptimize(TouchFewFields(json));
+  }
+}
+BENCHMARK(JsonParseFewFieldsDom);
+
+void JsonParseFewFieldsLazy(benchmark::State& state) {
+  const auto input = BuildRequestBody();
+  for (auto _ : state) {
+    const formats::json::LazyValue json{input};
+    benchmark::DoNotOptimize(TouchFewFields(json));
+  }
+}
+BENCHMARK(JsonParseFewFieldsLazy);
+
 USERVER_NAMESPACE_END
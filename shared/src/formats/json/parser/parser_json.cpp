@@ -10,7 +10,7 @@ USERVER_NAMESPACE_BEGIN
 namespace formats::json::parser {
 
 namespace {
-::rapidjson::CrtAllocator g_allocator;
+impl::Allocator g_allocator;
 }  // namespace
 
 struct JsonValueParser::Impl {
@@ -6,7 +6,9 @@
 #include <boost/container/small_vector.hpp>
 
 #include <fmt/format.h>
+#include <rapidjson/encodedstream.h>
 #include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/reader.h>
 
 #include <userver/formats/common/path.hpp>
@@ -75,7 +77,10 @@ void ParserState::PushParser(BaseParser& parser) {
 
 void ParserState::ProcessInput(std::string_view sw) {
   rapidjson::Reader reader;
-  rapidjson::MemoryStream is(sw.data(), sw.size());
+  rapidjson::MemoryStream memory_stream(sw.data(), sw.size());
+  // rapidjson skips whitespaces with SIMD in this stream type
+  rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is(
+      memory_stream);
   reader.IterativeParseInit();
 
   auto& stack = impl_->stack;
@@ -5,7 +5,7 @@
 
 #include <userver/formats/json/value_builder.hpp>
 
-#include <userver/formats/json/impl/types.hpp>
+#include <formats/json/impl/allocator.hpp>
 
 // These tests ensure that array/object members are internally stored in plain
 // contiguous array. This assumption used in `json::Value::GetPath` to find
@@ -14,7 +14,7 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace {
-::rapidjson::CrtAllocator g_allocator;
+formats::json::impl::Allocator g_allocator;
 }  // namespace
 
 // Ensure contiguous allocation in rapidjson arrays
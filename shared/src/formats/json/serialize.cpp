@@ -16,7 +16,9 @@
 #include <userver/formats/json/value.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 
+#include <formats/json/impl/allocator.hpp>
 #include <formats/json/impl/json_tree.hpp>
 #include <formats/json/impl/types_impl.hpp>
 
@@ -26,7 +28,7 @@ namespace formats::json {
 
 namespace {
 
-::rapidjson::CrtAllocator g_allocator;
+impl::Allocator g_allocator;
 
 std::string_view AsStringView(const impl::Value& jval) {
   return {jval.GetString(), jval.GetStringLength()};
@@ -116,14 +118,11 @@ bool AcceptStable(const impl::Value& origin, Handler& handler) {
   }
 }
 
-}  // namespace
-
-Value FromString(std::string_view doc) {
+void ParseString(std::string_view doc, impl::Document& json) {
   if (doc.empty()) {
     throw ParseException("JSON document is empty");
   }
 
-  impl::Document json{&g_allocator};
   rapidjson::ParseResult ok =
       json.Parse<rapidjson::kParseDefaultFlags |
                  rapidjson::kParseIterativeFlag |
@@ -140,10 +139,40 @@ Value FromString(std::string_view doc) {
         fmt::format("JSON parse error at line {} column {}: {}", line, column,
                     rapidjson::GetParseError_En(ok.Code())));
   }
+}
+
+impl::VersionedValuePtr ParseStringToArena(
+    std::string_view doc, utils::MonotonicArena& arena,
+    std::unique_ptr<utils::MonotonicArena> owned_arena) {
+  // rapidjson frees the partially built nodes on errors
+  const impl::ArenaParseScope arena_scope;
+
+  impl::Allocator allocator{arena};
+  impl::Document json{&allocator};
+  ParseString(doc, json);
+  CheckKeyUniqueness(&json);
+  return impl::VersionedValuePtr::Create(std::move(json),
+                                         std::move(owned_arena));
+}
 
+}  // namespace
+
+Value FromString(std::string_view doc) {
+  impl::Document json{&g_allocator};
+  ParseString(doc, json);
   return Value{EnsureValid(std::move(json))};
 }
 
+Value FromStringPooled(std::string_view doc) {
+  auto arena = std::make_unique<utils::MonotonicArena>();
+  auto& arena_ref = *arena;
+  return Value{ParseStringToArena(doc, arena_ref, std::move(arena))};
+}
+
+Value FromStringPooled(std::string_view doc, utils::MonotonicArena& arena) {
+  return Value{ParseStringToArena(doc, arena, {})};
+}
+
 Value FromStream(std::istream& is) {
   if (!is) {
     throw BadStreamException(is);
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/parser/aggregate_parser.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/serialize_aggregate.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Item {
+  std::int64_t id;
+  std::string name;
+  std::vector<std::string> tags;
+  std::optional<double> price;
+};
+
+struct Order {
+  std::string order_id;
+  bool paid;
+  std::vector<Item> items;
+};
+
+}  // namespace
+
+/// [Sample formats::json::AggregateFields specialization]
+template <>
+struct formats::json::AggregateFields<Item> {
+  static constexpr std::string_view kNames[] = {"id", "name", "tags", "price"};
+};
+
+template <>
+struct formats::json::AggregateFields<Order> {
+  static constexpr std::string_view kNames[] = {"order-id", "paid", "items"};
+};
+/// [Sample formats::json::AggregateFields specialization]
+
+namespace {
+
+const Order kOrder{
+    "abc", true, {{1, "one", {"a", "b"}, 1.5}, {2, "two", {}, std::nullopt}}};
+
+constexpr std::string_view kOrderJson =
+    R"({"order-id":"abc","paid":true,"items":[)"
+    R"({"id":1,"name":"one","tags":["a","b"],"price":1.5},)"
+    R"({"id":2,"name":"two","tags":[]}]})";
+
+void ExpectEqual(const Order& lhs, const Order& rhs) {
+  EXPECT_EQ(lhs.order_id, rhs.order_id);
+  EXPECT_EQ(lhs.paid, rhs.paid);
+  ASSERT_EQ(lhs.items.size(), rhs.items.size());
+  for (std::size_t i = 0; i < lhs.items.size(); ++i) {
+    EXPECT_EQ(lhs.items[i].id, rhs.items[i].id);
+    EXPECT_EQ(lhs.items[i].name, rhs.items[i].name);
+    EXPECT_EQ(lhs.items[i].tags, rhs.items[i].tags);
+    EXPECT_EQ(lhs.items[i].price, rhs.items[i].price);
+  }
+}
+
+}  // namespace
+
+TEST(FormatsJsonAggregate, Serialize) {
+  EXPECT_EQ(formats::json::ValueBuilder{kOrder}.ExtractValue(),
+            formats::json::FromString(kOrderJson));
+}
+
+TEST(FormatsJsonAggregate, WriteToStream) {
+  /// [Sample formats::json::AggregateFields usage]
+  formats::json::StringBuilder sb;
+  WriteToStream(kOrder, sb);
+  EXPECT_EQ(sb.GetString(), kOrderJson);
+
+  const auto order =
+      formats::json::parser::ParseToType<Order>(sb.GetString());
+  /// [Sample formats::json::AggregateFields usage]
+  ExpectEqual(order, kOrder);
+}
+
+TEST(FormatsJsonAggregate, Parse) {
+  ExpectEqual(formats::json::FromString(kOrderJson).As<Order>(), kOrder);
+}
+
+TEST(FormatsJsonAggregate, SaxParse) {
+  namespace fjp = formats::json::parser;
+
+  const auto items = fjp::ParseToType<std::vector<Item>>(
+      R"([{"unknown": {"a": [1, {"b": null}]}, "name": "x", "id": 3,
+           "tags": ["t"], "other": 1, "price": 2}])");
+  ASSERT_EQ(items.size(), 1);
+  EXPECT_EQ(items[0].id, 3);
+  EXPECT_EQ(items[0].name, "x");
+  EXPECT_EQ(items[0].tags, std::vector<std::string>{"t"});
+  EXPECT_EQ(items[0].price, 2.0);
+
+  EXPECT_THROW(fjp::ParseToType<Item>(R"({"id": 1, "name": "x"})"),
+               fjp::ParseError);
+  EXPECT_THROW(fjp::ParseToType<Item>(R"({"id": "1", "name": "x"})"),
+               fjp::ParseError);
+  EXPECT_THROW(fjp::ParseToType<Item>(R"([])"), fjp::ParseError);
+}
+
+TEST(FormatsJsonAggregate, SaxParseNull) {
+  namespace fjp = formats::json::parser;
+  constexpr std::string_view kJson =
+      R"({"id": 1, "name": "x", "tags": [], "price": null})";
+
+  const auto item = fjp::ParseToType<Item>(kJson);
+  EXPECT_EQ(item.id, 1);
+  EXPECT_EQ(item.price, std::nullopt);
+  EXPECT_EQ(formats::json::FromString(kJson).As<Item>().price, std::nullopt);
+
+  EXPECT_THROW(
+      fjp::ParseToType<Item>(R"({"id": 1, "name": null, "tags": []})"),
+      fjp::ParseError);
+  EXPECT_THROW(
+      fjp::ParseToType<Item>(
+          R"({"id": 1, "name": "x", "tags": [], "price": "1"})"),
+      fjp::ParseError);
+}
+
+TEST(FormatsJsonAggregate, SaxParseErrorPath) {
+  namespace fjp = formats::json::parser;
+
+  try {
+    fjp::ParseToType<Order>(
+        R"({"order-id": "a", "paid": true, "items": [{"id": true}]})");
+    FAIL() << "ParseError expected";
+  } catch (const fjp::ParseError& e) {
+    EXPECT_NE(std::string{e.what()}.find("path 'items.[0].id'"),
+              std::string::npos)
+        << e.what();
+  }
+
+  try {
+    fjp::ParseToType<Item>(R"({"id": 1, "name": "x"})");
+    FAIL() << "ParseError expected";
+  } catch (const fjp::ParseError& e) {
+    EXPECT_NE(std::string{e.what()}.find("field 'tags' was expected"),
+              std::string::npos)
+        << e.what();
+  }
+}
+
+USERVER_NAMESPACE_END
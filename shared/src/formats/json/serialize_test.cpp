@@ -5,6 +5,7 @@
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utils/fmt_compat.hpp>
+#include <userver/utils/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -97,6 +98,62 @@ TEST(JsonToSortedString, Null) {
   ASSERT_EQ(formats::json::ToStableString(example), "null");
 }
 
+namespace {
+
+constexpr std::string_view kPooledDoc =
+    R"({"a":[1,2.5,{"b":"a string that does not fit into the node"}],)"
+    R"("c":null,"d":{"e":[true,"f"]}})";
+
+}  // namespace
+
+TEST(FormatsJson, FromStringPooled) {
+  const auto pooled = formats::json::FromStringPooled(kPooledDoc);
+  const auto expected = formats::json::FromString(kPooledDoc);
+  EXPECT_EQ(pooled, expected);
+  EXPECT_EQ(formats::json::ToString(pooled),
+            formats::json::ToString(expected));
+  EXPECT_EQ(pooled["a"][2]["b"].As<std::string>(),
+            "a string that does not fit into the node");
+
+  const auto clone = pooled.Clone();
+  EXPECT_EQ(clone, expected);
+}
+
+TEST(FormatsJson, FromStringPooledArena) {
+  utils::MonotonicArena arena;
+  {
+    auto value = formats::json::FromStringPooled(kPooledDoc, arena);
+    EXPECT_EQ(value, formats::json::FromString(kPooledDoc));
+    EXPECT_GT(arena.GetAllocatedBytes(), kPooledDoc.size());
+
+    const auto copy = value;
+    EXPECT_EQ(copy["d"]["e"][1].As<std::string>(), "f");
+  }
+
+  EXPECT_THROW(
+      formats::json::FromStringPooled(R"({"a":["bbbbbbbbbbbbbbbbbb",)", arena),
+      formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringPooled(R"({"a":1,"a":2})", arena),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringPooled("", arena),
+               formats::json::ParseException);
+}
+
+TEST(FormatsJson, FromStringPooledToValueBuilder) {
+  auto value = formats::json::FromStringPooled(kPooledDoc);
+  const auto part = value["d"];
+
+  // nodes are copied to the heap, `value` is freed with its pool
+  formats::json::ValueBuilder builder{std::move(value)};
+  builder["d"] = part;
+  builder["g"] = "h";
+  const auto result = builder.ExtractValue();
+
+  EXPECT_EQ(result["a"], formats::json::FromString(kPooledDoc)["a"]);
+  EXPECT_EQ(result["d"], part);
+  EXPECT_EQ(result["g"].As<std::string>(), "h");
+}
+
 TEST(JsonToSortedString, Object) {
   const formats::json::Value example =
       formats::json::FromString(R"({"D":{"C":2},"A":1,"B":"sample"})");
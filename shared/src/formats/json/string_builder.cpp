@@ -34,6 +34,14 @@ std::string StringBuilder::GetString() const {
   return {buffer.GetString(), buffer.GetLength()};
 }
 
+std::size_t StringBuilder::GetSize() const { return impl_->buffer.GetLength(); }
+
+std::string StringBuilder::ExtractString() {
+  auto result = GetString();
+  impl_->buffer.Clear();
+  return result;
+}
+
 void StringBuilder::WriteNull() { impl_->writer.Null(); }
 
 void StringBuilder::WriteString(std::string_view value) {
@@ -1,5 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/parser/aggregate_parser.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/serialize_aggregate.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
 
@@ -73,4 +80,81 @@ void JsonStringBuilder(benchmark::State& state) {
 }
 BENCHMARK(JsonStringBuilder)->RangeMultiplier(4)->Range(1, 1024);
 
+namespace {
+
+struct Entry {
+  std::int64_t id;
+  std::string name;
+  double score;
+  bool active;
+  std::vector<std::string> tags;
+  std::optional<std::string> comment;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::AggregateFields<Entry> {
+  static constexpr std::string_view kNames[] = {"id",     "name", "score",
+                                                "active", "tags", "comment"};
+};
+
+namespace {
+
+std::vector<Entry> BuildEntries(std::size_t size) {
+  std::vector<Entry> entries;
+  entries.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    entries.push_back(
+        {static_cast<std::int64_t>(i), "entry-" + std::to_string(i), i * 0.5,
+         i % 2 == 0, {"tag1", "tag2"},
+         i % 3 ? std::nullopt : std::optional<std::string>{"comment"}});
+  }
+  return entries;
+}
+
+}  // namespace
+
+void JsonSerializeAggregatesDom(benchmark::State& state) {
+  const auto entries = BuildEntries(state.range(0));
+  for (auto _ : state) {
+    const auto res = ToString(ValueBuilder{entries}.ExtractValue());
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonSerializeAggregatesDom)->RangeMultiplier(10)->Range(10, 10000);
+
+void JsonSerializeAggregatesDirect(benchmark::State& state) {
+  const auto entries = BuildEntries(state.range(0));
+  for (auto _ : state) {
+    StringBuilder sb;
+    WriteToStream(entries, sb);
+    const auto res = sb.GetString();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonSerializeAggregatesDirect)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+
+void JsonParseAggregatesDom(benchmark::State& state) {
+  const auto input = ToString(ValueBuilder{BuildEntries(state.range(0))}
+                                  .ExtractValue());
+  for (auto _ : state) {
+    auto res = FromString(input).As<std::vector<Entry>>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseAggregatesDom)->RangeMultiplier(10)->Range(10, 10000);
+
+void JsonParseAggregatesDirect(benchmark::State& state) {
+  const auto input = ToString(ValueBuilder{BuildEntries(state.range(0))}
+                                  .ExtractValue());
+  for (auto _ : state) {
+    auto res = parser::ParseToType<std::vector<Entry>>(input);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseAggregatesDirect)->RangeMultiplier(10)->Range(10, 10000);
+
 USERVER_NAMESPACE_END
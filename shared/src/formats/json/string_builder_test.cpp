@@ -142,6 +142,24 @@ TEST(JsonStringBuilder, Array) {
   EXPECT_EQ("[\"123\",true]", sw.GetString());
 }
 
+TEST(JsonStringBuilder, ExtractString) {
+  StringBuilder sw;
+  std::string result;
+  {
+    StringBuilder::ArrayGuard guard(sw);
+    sw.WriteString("123");
+    EXPECT_EQ(sw.GetSize(), 6);
+    result += sw.ExtractString();
+    EXPECT_EQ(sw.GetSize(), 0);
+
+    sw.WriteBool(true);
+  }
+  result += sw.ExtractString();
+
+  EXPECT_EQ("[\"123\",true]", result);
+  EXPECT_EQ(sw.GetString(), "");
+}
+
 TEST(JsonStringBuilder, RawValue) {
   StringBuilder sw;
   {
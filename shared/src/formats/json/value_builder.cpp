@@ -33,7 +33,7 @@ rapidjson::Type ToNativeType(Type type) {
   }
 }
 
-::rapidjson::CrtAllocator g_allocator;
+impl::Allocator g_allocator;
 
 }  // namespace
 
@@ -112,8 +112,9 @@ ValueBuilder::ValueBuilder(const formats::json::Value& other) {
 
 ValueBuilder::ValueBuilder(formats::json::Value&& other) {
   // As we have new native object created,
-  // we fill it with the other's native object.
-  if (other.IsUniqueReference())
+  // we fill it with the other's native object. Arena-backed nodes may not be
+  // freed one by one, so such values are always copied to the heap.
+  if (other.IsUniqueReference() && !other.root_.IsArenaBacked())
     value_->GetNative() = std::move(other.GetNative());
   else
     // rapidjson uses move semantics in assignment
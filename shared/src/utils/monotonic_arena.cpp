@@ -0,0 +1,79 @@
+#include <userver/utils/monotonic_arena.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+constexpr std::size_t kFirstHeapBlockSize = 4 * 1024;
+constexpr std::size_t kMaxHeapBlockSize = 64 * 1024;
+
+}  // namespace
+
+struct alignas(std::max_align_t) MonotonicArena::BlockHeader {
+  BlockHeader* next;
+};
+
+MonotonicArena::MonotonicArena() noexcept : MonotonicArena(nullptr, 0) {}
+
+MonotonicArena::MonotonicArena(void* initial_buffer, std::size_t size) noexcept
+    : initial_buffer_(static_cast<std::byte*>(initial_buffer)),
+      initial_size_(initial_buffer ? size : 0),
+      current_(initial_buffer_),
+      end_(initial_buffer_ + initial_size_),
+      next_block_size_(kFirstHeapBlockSize) {}
+
+MonotonicArena::~MonotonicArena() { Release(); }
+
+void MonotonicArena::Release() noexcept {
+  while (heap_blocks_) {
+    auto* next = heap_blocks_->next;
+    ::operator delete(heap_blocks_);
+    heap_blocks_ = next;
+  }
+
+  current_ = initial_buffer_;
+  end_ = initial_buffer_ + initial_size_;
+  next_block_size_ = kFirstHeapBlockSize;
+  heap_blocks_count_ = 0;
+  allocated_bytes_ = 0;
+}
+
+void* MonotonicArena::AllocateSlow(std::size_t size, std::size_t alignment) {
+  // The block start is aligned by max_align_t, over-aligned requests may need
+  // some padding
+  const auto padding =
+      alignment > alignof(std::max_align_t) ? alignment - 1 : 0;
+  if (size > std::numeric_limits<std::size_t>::max() - padding -
+                 sizeof(BlockHeader)) {
+    throw std::bad_alloc();
+  }
+  const auto block_size = std::max(next_block_size_, size + padding);
+
+  auto* block = static_cast<BlockHeader*>(
+      ::operator new(sizeof(BlockHeader) + block_size));
+  block->next = heap_blocks_;
+  heap_blocks_ = block;
+  ++heap_blocks_count_;
+  next_block_size_ = std::min(next_block_size_ * 2, kMaxHeapBlockSize);
+
+  current_ = reinterpret_cast<std::byte*>(block + 1);
+  end_ = current_ + block_size;
+
+  void* ptr = current_;
+  auto space = block_size;
+  [[maybe_unused]] const auto* aligned =
+      std::align(alignment, size, ptr, space);
+  UASSERT(aligned);
+
+  current_ = static_cast<std::byte*>(ptr) + size;
+  allocated_bytes_ += size;
+  return ptr;
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
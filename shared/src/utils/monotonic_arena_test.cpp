@@ -0,0 +1,94 @@
+#include <userver/utils/monotonic_arena.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+bool IsAligned(const void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(MonotonicArena, InitialBuffer) {
+  alignas(std::max_align_t) std::array<std::byte, 256> buffer{};
+  utils::MonotonicArena arena{buffer.data(), buffer.size()};
+
+  auto* first = static_cast<std::byte*>(arena.Allocate(1, 1));
+  auto* second = static_cast<std::byte*>(arena.Allocate(8, 8));
+  EXPECT_EQ(first, buffer.data());
+  EXPECT_EQ(second, buffer.data() + 8);
+  EXPECT_EQ(arena.GetAllocatedBytes(), std::size_t{9});
+  EXPECT_EQ(arena.GetHeapBlocksCount(), std::size_t{0});
+
+  auto* from_heap = static_cast<std::byte*>(arena.Allocate(buffer.size()));
+  EXPECT_TRUE(from_heap < buffer.data() ||
+              from_heap >= buffer.data() + buffer.size());
+  EXPECT_EQ(arena.GetHeapBlocksCount(), std::size_t{1});
+
+  arena.Release();
+  EXPECT_EQ(arena.GetAllocatedBytes(), std::size_t{0});
+  EXPECT_EQ(arena.GetHeapBlocksCount(), std::size_t{0});
+  EXPECT_EQ(arena.Allocate(1, 1), buffer.data());
+}
+
+TEST(MonotonicArena, Alignment) {
+  utils::MonotonicArena arena;
+  for (const std::size_t alignment : {1, 2, 8, 16, 64, 256, 4096}) {
+    arena.Allocate(1, 1);
+    EXPECT_TRUE(IsAligned(arena.Allocate(3, alignment), alignment))
+        << alignment;
+  }
+}
+
+TEST(MonotonicArena, LargeAllocations) {
+  utils::MonotonicArena arena;
+  constexpr std::size_t kSize = 1024 * 1024;
+  auto* data = static_cast<char*>(arena.Allocate(kSize));
+  data[0] = 'a';
+  data[kSize - 1] = 'z';
+  EXPECT_EQ(arena.GetHeapBlocksCount(), std::size_t{1});
+
+  // Blocks are not reused, a small allocation after a large one gets a new
+  // block only if the current one is exhausted
+  arena.Allocate(1);
+  EXPECT_EQ(arena.GetHeapBlocksCount(), std::size_t{2});
+}
+
+TEST(ArenaAllocator, Containers) {
+  utils::MonotonicArena arena;
+  utils::ArenaAllocator<int> allocator{arena};
+
+  std::vector<int, utils::ArenaAllocator<int>> vector{allocator};
+  for (int i = 0; i < 1000; ++i) vector.push_back(i);
+  EXPECT_EQ(vector.back(), 999);
+
+  using Map = std::unordered_map<
+      std::string, std::string, std::hash<std::string>,
+      std::equal_to<std::string>,
+      utils::ArenaAllocator<std::pair<const std::string, std::string>>>;
+  Map map{Map::allocator_type{arena}};
+  map["key"] = "value";
+  EXPECT_EQ(map.at("key"), "value");
+  EXPECT_EQ(map.get_allocator().GetArena(), &arena);
+
+  EXPECT_GE(arena.GetAllocatedBytes(), 1000 * sizeof(int));
+}
+
+TEST(ArenaAllocator, NoArena) {
+  std::vector<std::string, utils::ArenaAllocator<std::string>> vector;
+  vector.emplace_back("a string that does not fit into SSO buffer");
+  vector.resize(100);
+  EXPECT_EQ(vector.get_allocator().GetArena(), nullptr);
+  EXPECT_EQ(vector.front(), "a string that does not fit into SSO buffer");
+}
+
+USERVER_NAMESPACE_END
@@ -73,7 +73,8 @@ Config ParseConfig(int argc, char* argv[]) {
       "max-host-connections",
       po::value(&config.max_host_connections)
           ->default_value(config.max_host_connections),
-      "maximum HTTP connection number to a single host")(
+      "maximum HTTP connection number to a single host, split between the io "
+      "threads and rounded up to at least one per io thread")(
       "defer-events",
       po::value(&config.defer_events)->default_value(config.defer_events),
       "whether to defer curl events to a periodic timer");
@@ -0,0 +1,31 @@
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <logging/binary_format.hpp>
+
+// Converts logs of the `binary` format into TSKV. Reads the files given in
+// the command line or the standard input if there are none.
+int main(int argc, char** argv) {
+  namespace binary = USERVER_NAMESPACE::logging::impl::binary;
+
+  std::ios_base::sync_with_stdio(false);
+  try {
+    if (argc < 2) {
+      binary::ConvertToTskv(std::cin, std::cout);
+    }
+
+    for (int i = 1; i < argc; ++i) {
+      std::ifstream file(argv[i], std::ios::binary);
+      if (!file) {
+        throw std::runtime_error(std::string{"Failed to open "} + argv[i]);
+      }
+      binary::ConvertToTskv(file, std::cout);
+    }
+  } catch (const std::exception& e) {
+    std::cout.flush();
+    std::cerr << "log-converter: " << e.what() << '\n';
+    return 1;
+  }
+}